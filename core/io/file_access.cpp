@@ -30,6 +30,7 @@
 
 #include "file_access.h"
 
+#include "core/config/engine.h"
 #include "core/config/project_settings.h"
 #include "core/crypto/crypto_core.h"
 #include "core/io/file_access_compressed.h"
@@ -39,6 +40,7 @@
 #include "core/os/os.h"
 
 FileAccess::CreateFunc FileAccess::create_func[ACCESS_MAX] = {};
+FileAccess::CreateFunc FileAccess::create_mapped_func[ACCESS_MAX] = {};
 
 FileAccess::FileCloseFailNotify FileAccess::close_fail_notify = nullptr;
 
@@ -70,19 +72,20 @@ void FileAccess::_set_access_type(AccessType p_access) {
 	_access_type = p_access;
 }
 
-Ref<FileAccess> FileAccess::create_for_path(const String &p_path) {
-	Ref<FileAccess> ret;
+FileAccess::AccessType FileAccess::_get_access_type_for_path(const String &p_path) {
 	if (p_path.begins_with("res://")) {
-		ret = create(ACCESS_RESOURCES);
+		return ACCESS_RESOURCES;
 	} else if (p_path.begins_with("user://")) {
-		ret = create(ACCESS_USERDATA);
+		return ACCESS_USERDATA;
 	} else if (p_path.begins_with("pipe://")) {
-		ret = create(ACCESS_PIPE);
+		return ACCESS_PIPE;
 	} else {
-		ret = create(ACCESS_FILESYSTEM);
+		return ACCESS_FILESYSTEM;
 	}
+}
 
-	return ret;
+Ref<FileAccess> FileAccess::create_for_path(const String &p_path) {
+	return create(_get_access_type_for_path(p_path));
 }
 
 Error FileAccess::reopen(const String &p_path, int p_mode_flags) {
@@ -116,6 +119,35 @@ Ref<FileAccess> FileAccess::open(const String &p_path, int p_mode_flags, Error *
 	return ret;
 }
 
+Ref<FileAccess> FileAccess::_open_mapped(const String &p_path, bool p_pack, Error *r_error) {
+	const bool in_pack = PackedData::get_singleton() && !PackedData::get_singleton()->is_disabled() && PackedData::get_singleton()->has_path(p_path);
+	const AccessType access = _get_access_type_for_path(p_path);
+	// Reading from a mapping raises SIGBUS once the file is truncated, so only files nothing rewrites while they are read get mapped.
+	const bool mappable = p_pack || (access == ACCESS_RESOURCES && !Engine::get_singleton()->is_editor_hint());
+
+	if (!in_pack && mappable && create_mapped_func[access]) {
+		Ref<FileAccess> ret = create_mapped_func[access]();
+		ret->_set_access_type(access);
+		if (ret->open_internal(p_path, READ) == OK) {
+			if (r_error) {
+				*r_error = OK;
+			}
+			return ret;
+		}
+	}
+
+	// Files inside packs, and files that can't be mapped, are read the usual way.
+	return open(p_path, READ, r_error);
+}
+
+Ref<FileAccess> FileAccess::open_mapped(const String &p_path, Error *r_error) {
+	return _open_mapped(p_path, false, r_error);
+}
+
+Ref<FileAccess> FileAccess::open_mapped_pack(const String &p_path, Error *r_error) {
+	return _open_mapped(p_path, true, r_error);
+}
+
 Ref<FileAccess> FileAccess::_open(const String &p_path, ModeFlags p_mode_flags) {
 	Error err = OK;
 	Ref<FileAccess> fa = open(p_path, p_mode_flags, &err);
@@ -729,18 +761,11 @@ void FileAccess::store_buffer(const Vector<uint8_t> &p_buffer) {
 }
 
 void FileAccess::store_var(const Variant &p_var, bool p_full_objects) {
-	int len;
-	Error err = encode_variant(p_var, nullptr, len, p_full_objects);
-	ERR_FAIL_COND_MSG(err != OK, "Error when trying to encode Variant.");
-
 	Vector<uint8_t> buff;
-	buff.resize(len);
-
-	uint8_t *w = buff.ptrw();
-	err = encode_variant(p_var, &w[0], len, p_full_objects);
+	Error err = encode_variant(p_var, buff, p_full_objects);
 	ERR_FAIL_COND_MSG(err != OK, "Error when trying to encode Variant.");
 
-	store_32(len);
+	store_32(buff.size());
 	store_buffer(buff);
 }
 
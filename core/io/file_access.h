@@ -115,12 +115,15 @@ private:
 
 	AccessType _access_type = ACCESS_FILESYSTEM;
 	static CreateFunc create_func[ACCESS_MAX]; /** default file access creation function for a platform */
+	static CreateFunc create_mapped_func[ACCESS_MAX]; /** read-only memory mapped file access, if the platform has one */
 	template <typename T>
 	static Ref<FileAccess> _create_builtin() {
 		return memnew(T);
 	}
 
 	static Ref<FileAccess> _open(const String &p_path, ModeFlags p_mode_flags);
+	static AccessType _get_access_type_for_path(const String &p_path);
+	static Ref<FileAccess> _open_mapped(const String &p_path, bool p_pack, Error *r_error);
 
 public:
 	static void set_file_close_fail_notify_callback(FileCloseFailNotify p_cbk) { close_fail_notify = p_cbk; }
@@ -150,6 +153,12 @@ public:
 
 	virtual uint64_t get_buffer(uint8_t *p_dst, uint64_t p_length) const; ///< get an array of bytes
 	Vector<uint8_t> get_buffer(int64_t p_length) const;
+	/**
+	 * Returns the bytes in [p_position, p_position + p_length) without copying them, or nullptr
+	 * if the file isn't mapped into memory or the range is out of bounds.
+	 * The pointer stays valid until the file is closed, and doesn't move the read position.
+	 */
+	virtual const uint8_t *get_mapped_range(uint64_t p_position, uint64_t p_length) const { return nullptr; }
 	virtual String get_line() const;
 	virtual String get_token() const;
 	virtual Vector<String> get_csv_line(const String &p_delim = ",") const;
@@ -198,6 +207,8 @@ public:
 	static Ref<FileAccess> create(AccessType p_access); /// Create a file access (for the current platform) this is the only portable way of accessing files.
 	static Ref<FileAccess> create_for_path(const String &p_path);
 	static Ref<FileAccess> open(const String &p_path, int p_mode_flags, Error *r_error = nullptr); /// Create a file access (for the current platform) this is the only portable way of accessing files.
+	static Ref<FileAccess> open_mapped(const String &p_path, Error *r_error = nullptr); /// Open for reading, mapped into memory when the platform supports it. Only res:// files are mapped, and not in the editor, which rewrites them. Falls back to open().
+	static Ref<FileAccess> open_mapped_pack(const String &p_path, Error *r_error = nullptr); /// Like open_mapped(), but maps the file wherever it is. Truncating a mapped file crashes the reader, so packs must be replaced by renaming a new file over them, never rewritten in place.
 
 	static Ref<FileAccess> open_encrypted(const String &p_path, ModeFlags p_mode_flags, const Vector<uint8_t> &p_key);
 	static Ref<FileAccess> open_encrypted_pass(const String &p_path, ModeFlags p_mode_flags, const String &p_pass);
@@ -228,9 +239,16 @@ public:
 	static PackedByteArray _get_file_as_bytes(const String &p_path) { return get_file_as_bytes(p_path, &last_file_open_error); }
 	static String _get_file_as_string(const String &p_path) { return get_file_as_string(p_path, &last_file_open_error); }
 
+	// Replacing the default also drops the mapped variant registered for the previous default.
 	template <typename T>
 	static void make_default(AccessType p_access) {
 		create_func[p_access] = _create_builtin<T>;
+		create_mapped_func[p_access] = nullptr;
+	}
+
+	template <typename T>
+	static void make_mapped_default(AccessType p_access) {
+		create_mapped_func[p_access] = _create_builtin<T>;
 	}
 
 	FileAccess() {}
@@ -147,6 +147,8 @@ class FileAccessPack : public FileAccess {
 	mutable uint64_t pos;
 	mutable bool eof;
 	uint64_t off;
+	// Start of this file's bytes when the pack is mapped into memory and not encrypted.
+	const uint8_t *mapped = nullptr;
 
 	Ref<FileAccess> f;
 	virtual Error open_internal(const String &p_path, int p_mode_flags) override;
@@ -172,6 +174,7 @@ public:
 	virtual uint8_t get_8() const override;
 
 	virtual uint64_t get_buffer(uint8_t *p_dst, uint64_t p_length) const override;
+	virtual const uint8_t *get_mapped_range(uint64_t p_position, uint64_t p_length) const override;
 
 	virtual void set_big_endian(bool p_big_endian) override;
 
@@ -591,6 +591,878 @@ void JSON::_bind_methods() {
 	ADD_PROPERTY(PropertyInfo(Variant::NIL, "data", PROPERTY_HINT_NONE, "", PROPERTY_USAGE_DEFAULT | PROPERTY_USAGE_NIL_IS_VARIANT), "set_data", "get_data"); // Ensures that it can be serialized as binary.
 }
 
+////////////
+
+static const char *json_reader_tk_name[] = {
+	"'{'",
+	"'}'",
+	"'['",
+	"']'",
+	"string",
+	"number",
+	"'true'",
+	"'false'",
+	"'null'",
+	"':'",
+	"','",
+	"EOF",
+};
+
+static bool _parse_hex4(const uint8_t *p_str, char32_t &r_value) {
+	r_value = 0;
+	for (int i = 0; i < 4; i++) {
+		const char32_t c = p_str[i];
+		if (!is_hex_digit(c)) {
+			return false;
+		}
+		r_value <<= 4;
+		r_value |= is_digit(c) ? c - '0' : (c | 0x20) - 'a' + 10;
+	}
+	return true;
+}
+
+static void _append_utf8(LocalVector<uint8_t> &r_dst, char32_t p_char) {
+	if (p_char <= 0x7f) {
+		r_dst.push_back(p_char);
+	} else if (p_char <= 0x7ff) {
+		r_dst.push_back(0xc0 | (p_char >> 6));
+		r_dst.push_back(0x80 | (p_char & 0x3f));
+	} else if (p_char <= 0xffff) {
+		r_dst.push_back(0xe0 | (p_char >> 12));
+		r_dst.push_back(0x80 | ((p_char >> 6) & 0x3f));
+		r_dst.push_back(0x80 | (p_char & 0x3f));
+	} else {
+		r_dst.push_back(0xf0 | (p_char >> 18));
+		r_dst.push_back(0x80 | ((p_char >> 12) & 0x3f));
+		r_dst.push_back(0x80 | ((p_char >> 6) & 0x3f));
+		r_dst.push_back(0x80 | (p_char & 0x3f));
+	}
+}
+
+void JSONReader::_reset() {
+	file.unref();
+	stream.unref();
+	stream_ends = false;
+	source_buffer.clear();
+	buffer.clear();
+	data = nullptr;
+	pos = 0;
+	end = 0;
+	source_done = false;
+	checked_bom = false;
+
+	containers.clear();
+	expecting = EXPECT_VALUE;
+	event = EVENT_NONE;
+	skip_depth = 0;
+	value_levels.clear();
+	string_value = String();
+	number_value = 0.0;
+	bool_value = false;
+
+	error = OK;
+	err_str = String();
+	err_line = 0;
+	line = 0;
+}
+
+Error JSONReader::open_file(const Ref<FileAccess> &p_file) {
+	ERR_FAIL_COND_V(p_file.is_null(), ERR_INVALID_PARAMETER);
+	_reset();
+	file = p_file;
+	return OK;
+}
+
+Error JSONReader::open_stream(const Ref<StreamPeer> &p_stream, bool p_ends_when_empty) {
+	ERR_FAIL_COND_V(p_stream.is_null(), ERR_INVALID_PARAMETER);
+	_reset();
+	stream = p_stream;
+	stream_ends = p_ends_when_empty || Object::cast_to<StreamPeerBuffer>(p_stream.ptr());
+	return OK;
+}
+
+Error JSONReader::open_buffer(const Vector<uint8_t> &p_buffer) {
+	_reset();
+	source_buffer = p_buffer;
+	data = source_buffer.ptr();
+	end = source_buffer.size();
+	source_done = true;
+	return OK;
+}
+
+Error JSONReader::open_string(const String &p_string) {
+	return open_buffer(p_string.to_utf8_buffer());
+}
+
+Error JSONReader::_fill() {
+	if (source_done) {
+		return ERR_FILE_EOF;
+	}
+
+	// Keep the unconsumed bytes, and only grow the buffer when they fill it.
+	const uint32_t remaining = end - pos;
+	if (pos > 0) {
+		memmove(buffer.ptr(), buffer.ptr() + pos, remaining);
+		pos = 0;
+		end = remaining;
+	}
+	if (buffer.is_empty()) {
+		buffer.resize(CHUNK_SIZE);
+	} else if (end == buffer.size()) {
+		buffer.resize(buffer.size() * 2);
+	}
+	data = buffer.ptr();
+
+	const uint32_t space = buffer.size() - end;
+	uint32_t received = 0;
+	if (file.is_valid()) {
+		received = file->get_buffer(buffer.ptr() + end, space);
+		if (received == 0) {
+			source_done = true;
+		}
+	} else if (stream.is_valid()) {
+		const int available = stream->get_available_bytes();
+		if (available > 0) {
+			int stream_received = 0;
+			if (stream->get_partial_data(buffer.ptr() + end, MIN(uint32_t(available), space), stream_received) != OK) {
+				source_done = true;
+			}
+			received = stream_received;
+		} else if (stream_ends) {
+			source_done = true;
+		} else {
+			return ERR_BUSY;
+		}
+	} else {
+		source_done = true;
+	}
+
+	end += received;
+	return received ? OK : ERR_FILE_EOF;
+}
+
+Error JSONReader::_fail(const String &p_message) {
+	error = ERR_PARSE_ERROR;
+	err_str = p_message;
+	err_line = line;
+	return error;
+}
+
+Error JSONReader::_scan_string(uint32_t &r_length, bool &r_has_escapes) {
+	while (true) {
+		r_has_escapes = false;
+		uint32_t i = pos + 1;
+		while (i < end) {
+			const uint8_t c = data[i];
+			if (c == '"') {
+				r_length = i - pos - 1;
+				return OK;
+			} else if (c == 0) {
+				return _fail("Unterminated String");
+			} else if (c == '\\') {
+				r_has_escapes = true;
+				i++;
+			}
+			i++;
+		}
+
+		const Error err = _fill();
+		if (err == ERR_FILE_EOF) {
+			return _fail("Unterminated String");
+		} else if (err != OK) {
+			return err;
+		}
+	}
+}
+
+Error JSONReader::_decode_string(uint32_t p_length, bool p_has_escapes) {
+	const uint8_t *str = &data[pos + 1];
+	for (uint32_t i = 0; i < p_length; i++) {
+		if (str[i] == '\n') {
+			line++;
+		}
+	}
+
+	if (!p_has_escapes) {
+		string_value.parse_utf8((const char *)str, p_length);
+		return OK;
+	}
+
+	LocalVector<uint8_t> utf8;
+	utf8.reserve(p_length);
+	for (uint32_t i = 0; i < p_length; i++) {
+		if (str[i] != '\\') {
+			utf8.push_back(str[i]);
+			continue;
+		}
+
+		i++;
+		char32_t res = 0;
+		switch (str[i]) {
+			case 'b':
+				res = 8;
+				break;
+			case 't':
+				res = 9;
+				break;
+			case 'n':
+				res = 10;
+				break;
+			case 'f':
+				res = 12;
+				break;
+			case 'r':
+				res = 13;
+				break;
+			case 'u': {
+				if (i + 4 >= p_length || !_parse_hex4(&str[i + 1], res)) {
+					return _fail("Malformed hex constant in string");
+				}
+				i += 4;
+
+				if ((res & 0xfffffc00) == 0xd800) {
+					char32_t trail = 0;
+					if (i + 6 >= p_length || str[i + 1] != '\\' || str[i + 2] != 'u') {
+						return _fail("Invalid UTF-16 sequence in string, unpaired lead surrogate");
+					}
+					if (!_parse_hex4(&str[i + 3], trail)) {
+						return _fail("Malformed hex constant in string");
+					}
+					if ((trail & 0xfffffc00) != 0xdc00) {
+						return _fail("Invalid UTF-16 sequence in string, unpaired lead surrogate");
+					}
+					res = (res << 10UL) + trail - ((0xd800 << 10UL) + 0xdc00 - 0x10000);
+					i += 6;
+				} else if ((res & 0xfffffc00) == 0xdc00) {
+					return _fail("Invalid UTF-16 sequence in string, unpaired trail surrogate");
+				}
+			} break;
+			case '"':
+			case '\\':
+			case '/': {
+				res = str[i];
+			} break;
+			default: {
+				return _fail("Invalid escape sequence.");
+			}
+		}
+		_append_utf8(utf8, res);
+	}
+
+	string_value.parse_utf8((const char *)utf8.ptr(), utf8.size());
+	return OK;
+}
+
+Error JSONReader::_get_token(TokenType &r_type) {
+	if (!checked_bom) {
+		while (end - pos < 3) {
+			const Error err = _fill();
+			if (err == ERR_FILE_EOF) {
+				break;
+			} else if (err != OK) {
+				return err;
+			}
+		}
+		if (end - pos >= 3 && data[pos] == 0xef && data[pos + 1] == 0xbb && data[pos + 2] == 0xbf) {
+			pos += 3;
+		}
+		checked_bom = true;
+	}
+
+	while (true) {
+		// Whitespace is consumed right away, tokens only once they're complete.
+		while (pos < end && data[pos] <= 32 && data[pos] != 0) {
+			if (data[pos] == '\n') {
+				line++;
+			}
+			pos++;
+		}
+		if (pos == end) {
+			const Error err = _fill();
+			if (err == ERR_FILE_EOF) {
+				r_type = TK_EOF;
+				return OK;
+			} else if (err != OK) {
+				return err;
+			}
+			continue;
+		}
+
+		const uint8_t c = data[pos];
+		switch (c) {
+			case 0: {
+				r_type = TK_EOF;
+				return OK;
+			}
+			case '{': {
+				r_type = TK_CURLY_BRACKET_OPEN;
+				pos++;
+				return OK;
+			}
+			case '}': {
+				r_type = TK_CURLY_BRACKET_CLOSE;
+				pos++;
+				return OK;
+			}
+			case '[': {
+				r_type = TK_BRACKET_OPEN;
+				pos++;
+				return OK;
+			}
+			case ']': {
+				r_type = TK_BRACKET_CLOSE;
+				pos++;
+				return OK;
+			}
+			case ':': {
+				r_type = TK_COLON;
+				pos++;
+				return OK;
+			}
+			case ',': {
+				r_type = TK_COMMA;
+				pos++;
+				return OK;
+			}
+			case '"': {
+				uint32_t length = 0;
+				bool has_escapes = false;
+				Error err = _scan_string(length, has_escapes);
+				if (err != OK) {
+					return err;
+				}
+				err = _decode_string(length, has_escapes);
+				if (err != OK) {
+					return err;
+				}
+				pos += length + 2;
+				r_type = TK_STRING;
+				return OK;
+			}
+			default: {
+				if (c != '-' && !is_digit(c) && !is_ascii_alphabet_char(c)) {
+					return _fail("Unexpected character.");
+				}
+
+				// Numbers and identifiers end at the first character that can't be part of them,
+				// which may be in data not read yet.
+				const bool number = !is_ascii_alphabet_char(c);
+				uint32_t i = pos;
+				while (true) {
+					while (i < end && (number ? (is_digit(data[i]) || data[i] == '-' || data[i] == '+' || data[i] == '.' || data[i] == 'e' || data[i] == 'E') : is_ascii_alphabet_char(data[i]))) {
+						i++;
+					}
+					if (i < end) {
+						break;
+					}
+					const uint32_t scanned = i - pos;
+					const Error err = _fill();
+					if (err == ERR_FILE_EOF) {
+						break;
+					} else if (err != OK) {
+						return err;
+					}
+					i = pos + scanned;
+				}
+
+				const uint32_t length = i - pos;
+				if (number) {
+					char32_t stack_digits[64];
+					LocalVector<char32_t> heap_digits;
+					char32_t *digits = stack_digits;
+					if (length >= 64) {
+						heap_digits.resize(length + 1);
+						digits = heap_digits.ptr();
+					}
+					for (uint32_t j = 0; j < length; j++) {
+						digits[j] = data[pos + j];
+					}
+					digits[length] = 0;
+					const char32_t *number_end = digits;
+					number_value = String::to_float(digits, &number_end);
+					if (number_end == digits) {
+						return _fail("Unexpected character.");
+					}
+					pos += number_end - digits;
+					r_type = TK_NUMBER;
+					return OK;
+				}
+
+				const char *id = (const char *)&data[pos];
+				if (length == 4 && strncmp(id, "true", 4) == 0) {
+					r_type = TK_TRUE;
+				} else if (length == 5 && strncmp(id, "false", 5) == 0) {
+					r_type = TK_FALSE;
+				} else if (length == 4 && strncmp(id, "null", 4) == 0) {
+					r_type = TK_NULL;
+				} else {
+					return _fail("Expected 'true','false' or 'null', got '" + String::utf8(id, length) + "'.");
+				}
+				pos += length;
+				return OK;
+			}
+		}
+	}
+}
+
+void JSONReader::_value_done() {
+	if (containers.is_empty()) {
+		expecting = EXPECT_EOF;
+	} else {
+		expecting = containers[containers.size() - 1] == '{' ? EXPECT_OBJECT_COMMA_OR_END : EXPECT_ARRAY_COMMA_OR_END;
+	}
+}
+
+Error JSONReader::_end_container(Event p_event) {
+	containers.resize(containers.size() - 1);
+	event = p_event;
+	_value_done();
+	return OK;
+}
+
+Error JSONReader::read() {
+	if (error != OK) {
+		return error;
+	}
+
+	while (true) {
+		TokenType type = TK_EOF;
+		const Error err = _get_token(type);
+		if (err != OK) {
+			return err;
+		}
+
+		if (type == TK_EOF && !containers.is_empty()) {
+			return _fail(containers[containers.size() - 1] == '{' ? "Expected '}'" : "Expected ']'");
+		}
+
+		switch (expecting) {
+			case EXPECT_EOF: {
+				if (type != TK_EOF) {
+					return _fail("Expected 'EOF'");
+				}
+				event = EVENT_NONE;
+				return ERR_FILE_EOF;
+			}
+			case EXPECT_COLON: {
+				if (type != TK_COLON) {
+					return _fail("Expected ':'");
+				}
+				expecting = EXPECT_VALUE;
+				continue;
+			}
+			case EXPECT_ARRAY_COMMA_OR_END: {
+				if (type == TK_BRACKET_CLOSE) {
+					return _end_container(EVENT_ARRAY_END);
+				}
+				if (type != TK_COMMA) {
+					return _fail("Expected ','");
+				}
+				expecting = EXPECT_ARRAY_VALUE_OR_END;
+				continue;
+			}
+			case EXPECT_OBJECT_COMMA_OR_END: {
+				if (type == TK_CURLY_BRACKET_CLOSE) {
+					return _end_container(EVENT_OBJECT_END);
+				}
+				if (type != TK_COMMA) {
+					return _fail("Expected '}' or ','");
+				}
+				expecting = EXPECT_OBJECT_KEY_OR_END;
+				continue;
+			}
+			case EXPECT_OBJECT_KEY_OR_END: {
+				if (type == TK_CURLY_BRACKET_CLOSE) {
+					return _end_container(EVENT_OBJECT_END);
+				}
+				if (type != TK_STRING) {
+					return _fail("Expected key");
+				}
+				event = EVENT_KEY;
+				expecting = EXPECT_COLON;
+				return OK;
+			}
+			case EXPECT_ARRAY_VALUE_OR_END: {
+				if (type == TK_BRACKET_CLOSE) {
+					return _end_container(EVENT_ARRAY_END);
+				}
+			} break;
+			case EXPECT_VALUE: {
+			} break;
+		}
+
+		switch (type) {
+			case TK_CURLY_BRACKET_OPEN: {
+				containers.push_back('{');
+				event = EVENT_OBJECT_START;
+				expecting = EXPECT_OBJECT_KEY_OR_END;
+				return OK;
+			}
+			case TK_BRACKET_OPEN: {
+				containers.push_back('[');
+				event = EVENT_ARRAY_START;
+				expecting = EXPECT_ARRAY_VALUE_OR_END;
+				return OK;
+			}
+			case TK_STRING: {
+				event = EVENT_STRING;
+			} break;
+			case TK_NUMBER: {
+				event = EVENT_NUMBER;
+			} break;
+			case TK_TRUE:
+			case TK_FALSE: {
+				bool_value = type == TK_TRUE;
+				event = EVENT_BOOL;
+			} break;
+			case TK_NULL: {
+				event = EVENT_NULL;
+			} break;
+			default: {
+				return _fail("Expected value, got " + String(json_reader_tk_name[type]) + ".");
+			}
+		}
+
+		_value_done();
+		return OK;
+	}
+}
+
+Variant JSONReader::get_value() const {
+	switch (event) {
+		case EVENT_KEY:
+		case EVENT_STRING:
+			return string_value;
+		case EVENT_NUMBER:
+			return number_value;
+		case EVENT_BOOL:
+			return bool_value;
+		default:
+			return Variant();
+	}
+}
+
+Error JSONReader::skip_value() {
+	if (skip_depth == 0) {
+		if (event == EVENT_KEY) {
+			const Error err = read();
+			if (err != OK) {
+				return err;
+			}
+		}
+		if (event != EVENT_OBJECT_START && event != EVENT_ARRAY_START) {
+			return OK;
+		}
+		skip_depth = containers.size();
+	}
+
+	while (containers.size() >= skip_depth) {
+		const Error err = read();
+		if (err != OK) {
+			if (err != ERR_BUSY) {
+				skip_depth = 0;
+			}
+			return err;
+		}
+	}
+	skip_depth = 0;
+	return OK;
+}
+
+Error JSONReader::read_value(Variant &r_value) {
+	if (value_levels.is_empty()) {
+		if (event == EVENT_KEY) {
+			const Error err = read();
+			if (err != OK) {
+				return err;
+			}
+		}
+		ERR_FAIL_COND_V_MSG(event == EVENT_NONE || event == EVENT_OBJECT_END || event == EVENT_ARRAY_END, ERR_INVALID_PARAMETER, "The current event doesn't start a value.");
+
+		if (event == EVENT_OBJECT_START) {
+			value_levels.push_back({ Dictionary(), String() });
+		} else if (event == EVENT_ARRAY_START) {
+			value_levels.push_back({ Array(), String() });
+		} else {
+			r_value = get_value();
+			return OK;
+		}
+	}
+
+	while (true) {
+		const Error err = read();
+		if (err != OK) {
+			if (err != ERR_BUSY) {
+				value_levels.clear();
+			}
+			return err;
+		}
+
+		Variant value;
+		switch (event) {
+			case EVENT_KEY: {
+				value_levels[value_levels.size() - 1].key = string_value;
+				continue;
+			}
+			case EVENT_OBJECT_START:
+			case EVENT_ARRAY_START: {
+				if (value_levels.size() > Variant::MAX_RECURSION_DEPTH) {
+					value_levels.clear();
+					return _fail("JSON structure is too deep. Bailing.");
+				}
+				value_levels.push_back({ event == EVENT_OBJECT_START ? Variant(Dictionary()) : Variant(Array()), String() });
+				continue;
+			}
+			case EVENT_OBJECT_END:
+			case EVENT_ARRAY_END: {
+				value = value_levels[value_levels.size() - 1].value;
+				value_levels.resize(value_levels.size() - 1);
+				if (value_levels.is_empty()) {
+					r_value = value;
+					return OK;
+				}
+			} break;
+			default: {
+				value = get_value();
+			} break;
+		}
+
+		ValueLevel &parent = value_levels[value_levels.size() - 1];
+		if (parent.value.get_type() == Variant::DICTIONARY) {
+			Dictionary d = parent.value;
+			d[parent.key] = value;
+		} else {
+			Array a = parent.value;
+			a.push_back(value);
+		}
+	}
+}
+
+////////////
+
+void JSONWriter::open_file(const Ref<FileAccess> &p_file) {
+	flush();
+	file = p_file;
+	stream.unref();
+	levels.clear();
+	has_key = false;
+	done = false;
+	error = OK;
+}
+
+void JSONWriter::open_stream(const Ref<StreamPeer> &p_stream) {
+	flush();
+	file.unref();
+	stream = p_stream;
+	levels.clear();
+	has_key = false;
+	done = false;
+	error = OK;
+}
+
+void JSONWriter::_write(const char *p_data, int p_length) {
+	const uint32_t size = buffer.size();
+	buffer.resize(size + p_length);
+	memcpy(buffer.ptr() + size, p_data, p_length);
+	if (buffer.size() >= CHUNK_SIZE) {
+		flush();
+	}
+}
+
+void JSONWriter::_write(const String &p_string) {
+	const CharString utf8 = p_string.utf8();
+	_write(utf8.get_data(), utf8.length());
+}
+
+void JSONWriter::_write_indent(int p_level) {
+	if (indent.length() == 0) {
+		return;
+	}
+	_write("\n", 1);
+	for (int i = 0; i < p_level; i++) {
+		_write(indent.get_data(), indent.length());
+	}
+}
+
+Error JSONWriter::_begin_value() {
+	ERR_FAIL_COND_V_MSG(done, ERR_ALREADY_EXISTS, "The top-level value was already written.");
+	ERR_FAIL_COND_V_MSG(levels.size() > Variant::MAX_RECURSION_DEPTH, ERR_OUT_OF_MEMORY, "JSON structure is too deep. Bailing.");
+	if (levels.is_empty()) {
+		return OK;
+	}
+
+	Level &level = levels[levels.size() - 1];
+	if (level.object) {
+		ERR_FAIL_COND_V_MSG(!has_key, ERR_INVALID_PARAMETER, "Values in an object need a key first.");
+		has_key = false;
+		return OK;
+	}
+
+	if (level.count > 0) {
+		_write(",", 1);
+	}
+	level.count++;
+	_write_indent(levels.size());
+	return OK;
+}
+
+void JSONWriter::_end_value() {
+	if (levels.is_empty()) {
+		done = true;
+	}
+}
+
+Error JSONWriter::begin_object() {
+	const Error err = _begin_value();
+	if (err != OK) {
+		return err;
+	}
+	_write("{", 1);
+	levels.push_back({ true, 0 });
+	return error;
+}
+
+Error JSONWriter::end_object() {
+	ERR_FAIL_COND_V_MSG(levels.is_empty() || !levels[levels.size() - 1].object, ERR_INVALID_PARAMETER, "There is no object to end.");
+	ERR_FAIL_COND_V_MSG(has_key, ERR_INVALID_PARAMETER, "The last key has no value.");
+	const uint32_t count = levels[levels.size() - 1].count;
+	levels.resize(levels.size() - 1);
+	if (count == 0) {
+		// JSON::stringify() breaks the line after '{' even for empty objects.
+		_write_indent(0);
+	}
+	_write_indent(levels.size());
+	_write("}", 1);
+	_end_value();
+	return error;
+}
+
+Error JSONWriter::begin_array() {
+	const Error err = _begin_value();
+	if (err != OK) {
+		return err;
+	}
+	_write("[", 1);
+	levels.push_back({ false, 0 });
+	return error;
+}
+
+Error JSONWriter::end_array() {
+	ERR_FAIL_COND_V_MSG(levels.is_empty() || levels[levels.size() - 1].object, ERR_INVALID_PARAMETER, "There is no array to end.");
+	const uint32_t count = levels[levels.size() - 1].count;
+	levels.resize(levels.size() - 1);
+	if (count > 0) {
+		_write_indent(levels.size());
+	}
+	_write("]", 1);
+	_end_value();
+	return error;
+}
+
+Error JSONWriter::write_key(const String &p_key) {
+	ERR_FAIL_COND_V_MSG(levels.is_empty() || !levels[levels.size() - 1].object, ERR_INVALID_PARAMETER, "Keys can only be written in an object.");
+	ERR_FAIL_COND_V_MSG(has_key, ERR_INVALID_PARAMETER, "The last key has no value.");
+
+	Level &level = levels[levels.size() - 1];
+	if (level.count > 0) {
+		_write(",", 1);
+	}
+	level.count++;
+	_write_indent(levels.size());
+	_write("\"" + p_key.json_escape() + "\"");
+	if (indent.length() > 0) {
+		_write(": ", 2);
+	} else {
+		_write(":", 1);
+	}
+	has_key = true;
+	return error;
+}
+
+Error JSONWriter::write_value(const Variant &p_value) {
+	switch (p_value.get_type()) {
+		case Variant::PACKED_INT32_ARRAY:
+		case Variant::PACKED_INT64_ARRAY:
+		case Variant::PACKED_FLOAT32_ARRAY:
+		case Variant::PACKED_FLOAT64_ARRAY:
+		case Variant::PACKED_STRING_ARRAY:
+		case Variant::ARRAY: {
+			Array a = p_value;
+			ERR_FAIL_COND_V_MSG(markers.has(a.id()), ERR_INVALID_PARAMETER, "Converting circular structure to JSON.");
+			markers.insert(a.id());
+
+			Error err = begin_array();
+			for (int i = 0; i < a.size() && err == OK; i++) {
+				err = write_value(a[i]);
+			}
+			if (err == OK) {
+				err = end_array();
+			}
+
+			markers.erase(a.id());
+			return err;
+		}
+		case Variant::DICTIONARY: {
+			Dictionary d = p_value;
+			ERR_FAIL_COND_V_MSG(markers.has(d.id()), ERR_INVALID_PARAMETER, "Converting circular structure to JSON.");
+			markers.insert(d.id());
+
+			List<Variant> keys;
+			d.get_key_list(&keys);
+			if (sort_keys) {
+				keys.sort();
+			}
+
+			Error err = begin_object();
+			for (List<Variant>::Element *E = keys.front(); E && err == OK; E = E->next()) {
+				err = write_key(E->get());
+				if (err == OK) {
+					err = write_value(d[E->get()]);
+				}
+			}
+			if (err == OK) {
+				err = end_object();
+			}
+
+			markers.erase(d.id());
+			return err;
+		}
+		default: {
+			const Error err = _begin_value();
+			if (err != OK) {
+				return err;
+			}
+			_write(JSON::_stringify(p_value, "", 0, false, markers, full_precision));
+			_end_value();
+			return error;
+		}
+	}
+}
+
+Error JSONWriter::flush() {
+	if (buffer.is_empty() || error != OK) {
+		buffer.clear();
+		return error;
+	}
+
+	if (file.is_valid()) {
+		file->store_buffer(buffer.ptr(), buffer.size());
+		if (file->get_error() != OK && file->get_error() != ERR_FILE_EOF) {
+			error = ERR_FILE_CANT_WRITE;
+		}
+	} else if (stream.is_valid()) {
+		error = stream->put_data(buffer.ptr(), buffer.size());
+	} else {
+		error = ERR_UNCONFIGURED;
+	}
+	buffer.clear();
+	return error;
+}
+
+JSONWriter::~JSONWriter() {
+	flush();
+}
+
 ////
 
 ////////////
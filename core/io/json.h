@@ -31,14 +31,19 @@
 #ifndef JSON_H
 #define JSON_H
 
+#include "core/io/file_access.h"
 #include "core/io/resource.h"
 #include "core/io/resource_loader.h"
 #include "core/io/resource_saver.h"
+#include "core/io/stream_peer.h"
+#include "core/templates/local_vector.h"
 #include "core/variant/variant.h"
 
 class JSON : public Resource {
 	GDCLASS(JSON, Resource);
 
+	friend class JSONWriter;
+
 	enum TokenType {
 		TK_CURLY_BRACKET_OPEN,
 		TK_CURLY_BRACKET_CLOSE,
@@ -96,6 +101,177 @@ public:
 	inline String get_error_message() const { return err_str; }
 };
 
+// Pull parser reading JSON incrementally from a file, a stream peer or a buffer, without building the
+// Variant tree. Each read() moves to the next event; keys and scalar values are available until the
+// following one. Syntax, including the trailing commas JSON::parse() tolerates, matches JSON::parse().
+class JSONReader {
+public:
+	enum Event {
+		EVENT_NONE,
+		EVENT_OBJECT_START,
+		EVENT_OBJECT_END,
+		EVENT_ARRAY_START,
+		EVENT_ARRAY_END,
+		EVENT_KEY,
+		EVENT_STRING,
+		EVENT_NUMBER,
+		EVENT_BOOL,
+		EVENT_NULL,
+	};
+
+private:
+	enum Expecting {
+		EXPECT_VALUE,
+		EXPECT_ARRAY_VALUE_OR_END,
+		EXPECT_ARRAY_COMMA_OR_END,
+		EXPECT_OBJECT_KEY_OR_END,
+		EXPECT_OBJECT_COMMA_OR_END,
+		EXPECT_COLON,
+		EXPECT_EOF,
+	};
+
+	enum TokenType {
+		TK_CURLY_BRACKET_OPEN,
+		TK_CURLY_BRACKET_CLOSE,
+		TK_BRACKET_OPEN,
+		TK_BRACKET_CLOSE,
+		TK_STRING,
+		TK_NUMBER,
+		TK_TRUE,
+		TK_FALSE,
+		TK_NULL,
+		TK_COLON,
+		TK_COMMA,
+		TK_EOF,
+	};
+
+	static constexpr uint32_t CHUNK_SIZE = 65536;
+
+	Ref<FileAccess> file;
+	Ref<StreamPeer> stream;
+	bool stream_ends = false; // Whether running out of stream data means the end, rather than waiting for more.
+	Vector<uint8_t> source_buffer;
+
+	// Bytes not consumed yet are in [pos, end). A token is only consumed once complete, so running out of
+	// data in the middle of one refills the buffer and scans it again from the start.
+	LocalVector<uint8_t> buffer;
+	const uint8_t *data = nullptr;
+	uint32_t pos = 0;
+	uint32_t end = 0;
+	bool source_done = false;
+	bool checked_bom = false;
+
+	LocalVector<uint8_t> containers; // '{' or '[' for each open container.
+	Expecting expecting = EXPECT_VALUE;
+	Event event = EVENT_NONE;
+	String string_value;
+	double number_value = 0.0;
+	bool bool_value = false;
+
+	Error error = OK;
+	String err_str;
+	int err_line = 0;
+	int line = 0;
+
+	// Progress of a skip_value() or read_value() interrupted by ERR_BUSY.
+	struct ValueLevel {
+		Variant value; // The Dictionary or Array being built.
+		String key;
+	};
+	uint32_t skip_depth = 0;
+	LocalVector<ValueLevel> value_levels;
+
+	void _reset();
+	Error _fill();
+	Error _get_token(TokenType &r_type);
+	Error _scan_string(uint32_t &r_length, bool &r_has_escapes);
+	Error _decode_string(uint32_t p_length, bool p_has_escapes);
+	Error _fail(const String &p_message);
+	void _value_done();
+	Error _end_container(Event p_event);
+
+public:
+	Error open_file(const Ref<FileAccess> &p_file);
+	// Reads data as it becomes available. Unless p_ends_when_empty is set, read() returns ERR_BUSY when it
+	// needs more than the peer has, and can be called again later. StreamPeerBuffer always ends when empty.
+	Error open_stream(const Ref<StreamPeer> &p_stream, bool p_ends_when_empty = false);
+	Error open_buffer(const Vector<uint8_t> &p_buffer);
+	Error open_string(const String &p_string);
+
+	// Returns OK with a new event, ERR_FILE_EOF once the document and the input are over, ERR_BUSY when a
+	// stream has no data yet, or ERR_PARSE_ERROR, which sticks.
+	Error read();
+	Event get_event() const { return event; }
+	int get_depth() const { return containers.size(); }
+
+	const String &get_key() const { return string_value; }
+	const String &get_string() const { return string_value; }
+	double get_number() const { return number_value; }
+	bool get_bool() const { return bool_value; }
+	Variant get_value() const;
+
+	// Called on an EVENT_OBJECT_START or EVENT_ARRAY_START, moves past the matching end event, either
+	// dropping the contents or building them as a Variant. Other events are a single value already.
+	// After ERR_BUSY, call the same method again to resume, without calling read() in between.
+	Error skip_value();
+	Error read_value(Variant &r_value);
+
+	int get_error_line() const { return err_line; }
+	String get_error_message() const { return err_str; }
+};
+
+// Incremental writer producing the same text as JSON::stringify() with the same settings, flushed to a
+// file or stream peer in chunks instead of being built as a single String.
+class JSONWriter {
+	static constexpr uint32_t CHUNK_SIZE = 65536;
+
+	struct Level {
+		bool object = false;
+		uint32_t count = 0;
+	};
+
+	Ref<FileAccess> file;
+	Ref<StreamPeer> stream;
+	LocalVector<uint8_t> buffer;
+
+	CharString indent;
+	bool sort_keys = true;
+	bool full_precision = false;
+
+	LocalVector<Level> levels;
+	bool has_key = false;
+	bool done = false;
+	Error error = OK;
+	HashSet<const void *> markers;
+
+	void _write(const char *p_data, int p_length);
+	void _write(const String &p_string);
+	void _write_indent(int p_level);
+	Error _begin_value();
+	void _end_value();
+
+public:
+	void open_file(const Ref<FileAccess> &p_file);
+	void open_stream(const Ref<StreamPeer> &p_stream);
+
+	void set_indent(const String &p_indent) { indent = p_indent.utf8(); }
+	void set_sort_keys(bool p_sort_keys) { sort_keys = p_sort_keys; }
+	void set_full_precision(bool p_full_precision) { full_precision = p_full_precision; }
+
+	Error begin_object();
+	Error end_object();
+	Error begin_array();
+	Error end_array();
+	Error write_key(const String &p_key);
+	// Writes scalars directly, and arrays and dictionaries element by element.
+	Error write_value(const Variant &p_value);
+
+	Error flush();
+	Error get_error() const { return error; }
+
+	~JSONWriter();
+};
+
 class ResourceFormatLoaderJSON : public ResourceFormatLoader {
 public:
 	virtual Ref<Resource> load(const String &p_path, const String &p_original_path = "", Error *r_error = nullptr, bool p_use_sub_threads = false, float *r_progress = nullptr, CacheMode p_cache_mode = CACHE_MODE_REUSE) override;
@@ -846,10 +846,14 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 				(*r_len) += 4; // Size of count number.
 			}
 
+			// Every element takes at least 4 bytes, check before allocating.
+			ERR_FAIL_COND_V(count > len / 4, ERR_INVALID_DATA);
+
 			Array varr;
 			if (builtin_type != Variant::VARIANT_MAX) {
 				varr.set_typed(builtin_type, class_name, script);
 			}
+			varr.resize(count);
 
 			for (int i = 0; i < count; i++) {
 				int used = 0;
@@ -858,7 +862,7 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 				ERR_FAIL_COND_V_MSG(err != OK, err, "Error when trying to decode Variant.");
 				buf += used;
 				len -= used;
-				varr.push_back(v);
+				varr.set(i, v);
 				if (r_len) {
 					(*r_len) += used;
 				}
@@ -880,10 +884,7 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 
 			if (count) {
 				data.resize(count);
-				uint8_t *w = data.ptrw();
-				for (int32_t i = 0; i < count; i++) {
-					w[i] = buf[i];
-				}
+				memcpy(data.ptrw(), buf, count);
 			}
 
 			r_variant = data;
@@ -907,12 +908,15 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 			Vector<int32_t> data;
 
 			if (count) {
-				//const int*rbuf=(const int*)buf;
 				data.resize(count);
+#ifdef BIG_ENDIAN_ENABLED
 				int32_t *w = data.ptrw();
 				for (int32_t i = 0; i < count; i++) {
 					w[i] = decode_uint32(&buf[i * 4]);
 				}
+#else
+				memcpy(data.ptrw(), buf, count * sizeof(int32_t));
+#endif
 			}
 			r_variant = Variant(data);
 			if (r_len) {
@@ -931,12 +935,15 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 			Vector<int64_t> data;
 
 			if (count) {
-				//const int*rbuf=(const int*)buf;
 				data.resize(count);
+#ifdef BIG_ENDIAN_ENABLED
 				int64_t *w = data.ptrw();
 				for (int64_t i = 0; i < count; i++) {
 					w[i] = decode_uint64(&buf[i * 8]);
 				}
+#else
+				memcpy(data.ptrw(), buf, count * sizeof(int64_t));
+#endif
 			}
 			r_variant = Variant(data);
 			if (r_len) {
@@ -955,12 +962,15 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 			Vector<float> data;
 
 			if (count) {
-				//const float*rbuf=(const float*)buf;
 				data.resize(count);
+#ifdef BIG_ENDIAN_ENABLED
 				float *w = data.ptrw();
 				for (int32_t i = 0; i < count; i++) {
 					w[i] = decode_float(&buf[i * 4]);
 				}
+#else
+				memcpy(data.ptrw(), buf, count * sizeof(float));
+#endif
 			}
 			r_variant = data;
 
@@ -981,10 +991,14 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 
 			if (count) {
 				data.resize(count);
+#ifdef BIG_ENDIAN_ENABLED
 				double *w = data.ptrw();
 				for (int64_t i = 0; i < count; i++) {
 					w[i] = decode_double(&buf[i * 8]);
 				}
+#else
+				memcpy(data.ptrw(), buf, count * sizeof(double));
+#endif
 			}
 			r_variant = data;
 
@@ -1161,6 +1175,10 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 				carray.resize(count);
 				Color *w = carray.ptrw();
 
+#ifndef BIG_ENDIAN_ENABLED
+				static_assert(sizeof(Color) == 4 * 4);
+				memcpy(w, buf, count * 4 * 4);
+#else
 				for (int32_t i = 0; i < count; i++) {
 					// Colors should always be in single-precision.
 					w[i].r = decode_float(buf + i * 4 * 4 + 4 * 0);
@@ -1168,6 +1186,7 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 					w[i].b = decode_float(buf + i * 4 * 4 + 4 * 2);
 					w[i].a = decode_float(buf + i * 4 * 4 + 4 * 3);
 				}
+#endif
 
 				int adv = 4 * 4 * count;
 
@@ -1955,6 +1974,187 @@ Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bo
 	return OK;
 }
 
+// Grows r_buffer so that p_size bytes can be written at r_pos, and returns where to write them.
+// CowData rounds allocations up to a power of two, so growing one value at a time stays amortized.
+static uint8_t *_reserve_encode_buffer(Vector<uint8_t> &r_buffer, int p_pos, int p_size) {
+	if (p_pos + p_size > r_buffer.size()) {
+		r_buffer.resize(p_pos + p_size);
+	}
+	return r_buffer.ptrw() + p_pos;
+}
+
+// Upper bound on the encoded size of a value that holds no other values, or -1 if it can't be known cheaply.
+static int _get_encoded_size_bound(const Variant &p_variant) {
+	switch (p_variant.get_type()) {
+		case Variant::STRING:
+		case Variant::STRING_NAME:
+		case Variant::NODE_PATH:
+		case Variant::OBJECT:
+		case Variant::SIGNAL:
+		case Variant::DICTIONARY:
+		case Variant::ARRAY:
+		case Variant::PACKED_STRING_ARRAY: {
+			return -1;
+		}
+		case Variant::PACKED_BYTE_ARRAY: {
+			return 4 + 4 + p_variant.operator PackedByteArray().size() + 3;
+		}
+		case Variant::PACKED_INT32_ARRAY: {
+			return 4 + 4 + p_variant.operator PackedInt32Array().size() * 4;
+		}
+		case Variant::PACKED_INT64_ARRAY: {
+			return 4 + 4 + p_variant.operator PackedInt64Array().size() * 8;
+		}
+		case Variant::PACKED_FLOAT32_ARRAY: {
+			return 4 + 4 + p_variant.operator PackedFloat32Array().size() * 4;
+		}
+		case Variant::PACKED_FLOAT64_ARRAY: {
+			return 4 + 4 + p_variant.operator PackedFloat64Array().size() * 8;
+		}
+		case Variant::PACKED_VECTOR2_ARRAY: {
+			return 4 + 4 + p_variant.operator PackedVector2Array().size() * sizeof(real_t) * 2;
+		}
+		case Variant::PACKED_VECTOR3_ARRAY: {
+			return 4 + 4 + p_variant.operator PackedVector3Array().size() * sizeof(real_t) * 3;
+		}
+		case Variant::PACKED_COLOR_ARRAY: {
+			return 4 + 4 + p_variant.operator PackedColorArray().size() * 4 * 4;
+		}
+		default: {
+			// A double-precision Projection is the largest fixed-size value.
+			return 4 + 16 * 8;
+		}
+	}
+}
+
+static Error _encode_variant_appending(const Variant &p_variant, Vector<uint8_t> &r_buffer, int &r_pos, bool p_full_objects, int p_depth) {
+	ERR_FAIL_COND_V_MSG(p_depth > Variant::MAX_RECURSION_DEPTH, ERR_OUT_OF_MEMORY, "Potential infinite recursion detected. Bailing.");
+
+	switch (p_variant.get_type()) {
+		case Variant::STRING:
+		case Variant::STRING_NAME: {
+			// Converted once, where the two-pass encoder converts for both passes.
+			CharString utf8 = p_variant.operator String().utf8();
+			int size = 4 + 4 + utf8.length();
+			int pad = size % 4 ? 4 - size % 4 : 0;
+
+			uint8_t *buf = _reserve_encode_buffer(r_buffer, r_pos, size + pad);
+			encode_uint32(p_variant.get_type(), buf);
+			encode_uint32(utf8.length(), buf + 4);
+			memcpy(buf + 8, utf8.get_data(), utf8.length());
+			memset(buf + size, 0, pad);
+			r_pos += size + pad;
+		} break;
+		case Variant::DICTIONARY: {
+			Dictionary d = p_variant;
+
+			uint8_t *buf = _reserve_encode_buffer(r_buffer, r_pos, 8);
+			encode_uint32(Variant::DICTIONARY, buf);
+			encode_uint32(uint32_t(d.size()), buf + 4);
+			r_pos += 8;
+
+			List<Variant> keys;
+			d.get_key_list(&keys);
+
+			for (const Variant &E : keys) {
+				Error err = _encode_variant_appending(E, r_buffer, r_pos, p_full_objects, p_depth + 1);
+				ERR_FAIL_COND_V(err, err);
+				Variant *v = d.getptr(E);
+				ERR_FAIL_NULL_V(v, ERR_BUG);
+				err = _encode_variant_appending(*v, r_buffer, r_pos, p_full_objects, p_depth + 1);
+				ERR_FAIL_COND_V(err, err);
+			}
+		} break;
+		case Variant::ARRAY: {
+			Array array = p_variant;
+			uint32_t header = Variant::ARRAY;
+			String type_string;
+
+			if (array.is_typed()) {
+				Ref<Script> script = array.get_typed_script();
+				if (script.is_valid()) {
+					header |= HEADER_DATA_FIELD_TYPED_ARRAY_SCRIPT;
+					type_string = script->get_path();
+					ERR_FAIL_COND_V_MSG(type_string.is_empty() || !type_string.begins_with("res://"), ERR_UNAVAILABLE, "Failed to encode a path to a custom script for an array type.");
+				} else if (array.get_typed_class_name() != StringName()) {
+					header |= HEADER_DATA_FIELD_TYPED_ARRAY_CLASS_NAME;
+					type_string = array.get_typed_class_name();
+				} else {
+					header |= HEADER_DATA_FIELD_TYPED_ARRAY_BUILTIN;
+				}
+			}
+
+			uint8_t *buf = _reserve_encode_buffer(r_buffer, r_pos, 4);
+			encode_uint32(header, buf);
+			r_pos += 4;
+
+			if ((header & HEADER_DATA_FIELD_TYPED_ARRAY_MASK) == HEADER_DATA_FIELD_TYPED_ARRAY_BUILTIN) {
+				buf = _reserve_encode_buffer(r_buffer, r_pos, 4);
+				encode_uint32(array.get_typed_builtin(), buf);
+				r_pos += 4;
+			} else if (!type_string.is_empty()) {
+				// Class names and script paths are short, so bound the UTF-8 size instead of converting twice.
+				buf = _reserve_encode_buffer(r_buffer, r_pos, 4 + type_string.length() * 4 + 3);
+				int len = 0;
+				_encode_string(type_string, buf, len);
+				r_pos += len;
+			}
+
+			buf = _reserve_encode_buffer(r_buffer, r_pos, 4);
+			encode_uint32(uint32_t(array.size()), buf);
+			r_pos += 4;
+
+			for (const Variant &var : array) {
+				Error err = _encode_variant_appending(var, r_buffer, r_pos, p_full_objects, p_depth + 1);
+				ERR_FAIL_COND_V(err, err);
+			}
+		} break;
+		case Variant::PACKED_STRING_ARRAY: {
+			Vector<String> data = p_variant;
+
+			uint8_t *buf = _reserve_encode_buffer(r_buffer, r_pos, 8);
+			encode_uint32(Variant::PACKED_STRING_ARRAY, buf);
+			encode_uint32(data.size(), buf + 4);
+			r_pos += 8;
+
+			for (const String &str : data) {
+				CharString utf8 = str.utf8();
+				int size = 4 + utf8.length() + 1;
+				int pad = size % 4 ? 4 - size % 4 : 0;
+
+				buf = _reserve_encode_buffer(r_buffer, r_pos, size + pad);
+				encode_uint32(utf8.length() + 1, buf);
+				memcpy(buf + 4, utf8.get_data(), utf8.length() + 1);
+				memset(buf + size, 0, pad);
+				r_pos += size + pad;
+			}
+		} break;
+		default: {
+			int len = _get_encoded_size_bound(p_variant);
+			if (len < 0) {
+				// Objects, node paths and signals are rare enough to keep the sizing pass.
+				Error err = encode_variant(p_variant, nullptr, len, p_full_objects, p_depth);
+				ERR_FAIL_COND_V(err, err);
+			}
+
+			uint8_t *buf = _reserve_encode_buffer(r_buffer, r_pos, len);
+			Error err = encode_variant(p_variant, buf, len, p_full_objects, p_depth);
+			ERR_FAIL_COND_V(err, err);
+			r_pos += len;
+		} break;
+	}
+
+	return OK;
+}
+
+Error encode_variant(const Variant &p_variant, Vector<uint8_t> &r_buffer, bool p_full_objects, int p_depth) {
+	const int start = r_buffer.size();
+	int pos = start;
+	Error err = _encode_variant_appending(p_variant, r_buffer, pos, p_full_objects, p_depth);
+	r_buffer.resize(err == OK ? pos : start);
+	return err;
+}
+
 Vector<float> vector3_to_float32_array(const Vector3 *vecs, size_t count) {
 	// We always allocate a new array, and we don't memcpy.
 	// We also don't consider returning a pointer to the passed vectors when sizeof(real_t) == 4.
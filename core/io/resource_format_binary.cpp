@@ -151,18 +151,35 @@ static Error read_reals(real_t *dst, Ref<FileAccess> &f, size_t count) {
 	return OK;
 }
 
+// Parses a string straight from the file mapping when there is one, skipping the copy into a buffer.
+static bool _get_mapped_utf8(const Ref<FileAccess> &p_f, uint32_t p_len, String &r_string) {
+	const uint64_t pos = p_f->get_position();
+	const uint8_t *mapped = p_f->get_mapped_range(pos, p_len);
+	if (!mapped) {
+		return false;
+	}
+
+	// Stored strings are null-terminated, and parsing stops there.
+	r_string.parse_utf8((const char *)mapped, p_len);
+	p_f->seek(pos + p_len);
+	return true;
+}
+
 StringName ResourceLoaderBinary::_get_string() {
 	uint32_t id = f->get_32();
 	if (id & 0x80000000) {
 		uint32_t len = id & 0x7FFFFFFF;
-		if ((int)len > str_buf.size()) {
-			str_buf.resize(len);
-		}
 		if (len == 0) {
 			return StringName();
 		}
-		f->get_buffer((uint8_t *)&str_buf[0], len);
 		String s;
+		if (_get_mapped_utf8(f, len, s)) {
+			return s;
+		}
+		if ((int)len > str_buf.size()) {
+			str_buf.resize(len);
+		}
+		f->get_buffer((uint8_t *)&str_buf[0], len);
 		s.parse_utf8(&str_buf[0]);
 		return s;
 	}
@@ -889,14 +906,17 @@ static String get_ustring(Ref<FileAccess> f) {
 
 String ResourceLoaderBinary::get_unicode_string() {
 	int len = f->get_32();
+	if (len <= 0) {
+		return String();
+	}
+	String s;
+	if (_get_mapped_utf8(f, len, s)) {
+		return s;
+	}
 	if (len > str_buf.size()) {
 		str_buf.resize(len);
 	}
-	if (len == 0) {
-		return String();
-	}
 	f->get_buffer((uint8_t *)&str_buf[0], len);
-	String s;
 	s.parse_utf8(&str_buf[0]);
 	return s;
 }
@@ -1184,7 +1204,7 @@ Ref<Resource> ResourceFormatLoaderBinary::load(const String &p_path, const Strin
 	}
 
 	Error err;
-	Ref<FileAccess> f = FileAccess::open(p_path, FileAccess::READ, &err);
+	Ref<FileAccess> f = FileAccess::open_mapped(p_path, &err);
 
 	ERR_FAIL_COND_V_MSG(err != OK, Ref<Resource>(), "Cannot open file '" + p_path + "'.");
 
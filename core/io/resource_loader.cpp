@@ -242,6 +242,8 @@ ResourceLoader::LoadToken::~LoadToken() {
 }
 
 Ref<Resource> ResourceLoader::_load(const String &p_path, const String &p_original_path, const String &p_type_hint, ResourceFormatLoader::CacheMode p_cache_mode, Error *r_error, bool p_use_sub_threads, float *r_progress) {
+	MemoryTagScope tag_scope(Memory::TAG_RESOURCE);
+
 	load_nesting++;
 	if (load_paths_stack->size()) {
 		thread_load_mutex.lock();
@@ -292,6 +294,9 @@ void ResourceLoader::_thread_load_function(void *p_userdata) {
 	caller_task_id = load_task.task_id;
 	if (cleaning_tasks) {
 		load_task.status = THREAD_LOAD_FAILED;
+		if (load_task.high_priority) {
+			high_priority_dependency_loads--;
+		}
 		thread_load_mutex.unlock();
 		return;
 	}
@@ -327,6 +332,9 @@ void ResourceLoader::_thread_load_function(void *p_userdata) {
 	thread_load_mutex.lock();
 
 	load_task.resource = res;
+	if (load_task.high_priority) {
+		high_priority_dependency_loads--;
+	}
 
 	load_task.progress = 1.0; //it was fully loaded at this point, so force progress to 1.0
 	if (load_task.error != OK) {
@@ -516,7 +524,17 @@ Ref<ResourceLoader::LoadToken> ResourceLoader::_load_start(const String &p_path,
 		if (run_on_current_thread) {
 			load_task_ptr->thread_id = Thread::get_caller_id();
 		} else {
-			load_task_ptr->task_id = WorkerThreadPool::get_singleton()->add_native_task(&ResourceLoader::_thread_load_function, load_task_ptr);
+			// Dependencies of a load distributed across threads may take up to half of the pool as high priority tasks,
+			// so a scene's resources don't load nearly one at a time under the low priority thread limit. The rest are
+			// queued as low priority, leaving the other half of the pool to high priority work from elsewhere.
+			if (p_thread_mode == LOAD_THREAD_DISTRIBUTE && load_nesting > 0) {
+				const int max_high_priority_loads = MAX(1, WorkerThreadPool::get_singleton()->get_thread_count() / 2);
+				if (high_priority_dependency_loads < max_high_priority_loads) {
+					load_task_ptr->high_priority = true;
+					high_priority_dependency_loads++;
+				}
+			}
+			load_task_ptr->task_id = WorkerThreadPool::get_singleton()->add_native_task(&ResourceLoader::_thread_load_function, load_task_ptr, load_task_ptr->high_priority);
 		}
 	}
 
@@ -1209,6 +1227,7 @@ thread_local uint32_t SafeBinaryMutex<ResourceLoader::BINARY_MUTEX_TAG>::count =
 SafeBinaryMutex<ResourceLoader::BINARY_MUTEX_TAG> ResourceLoader::thread_load_mutex;
 HashMap<String, ResourceLoader::ThreadLoadTask> ResourceLoader::thread_load_tasks;
 bool ResourceLoader::cleaning_tasks = false;
+int ResourceLoader::high_priority_dependency_loads = 0;
 
 HashMap<String, ResourceLoader::LoadToken *> ResourceLoader::user_load_tokens;
 
@@ -180,6 +180,7 @@ private:
 		Ref<Resource> resource;
 		bool xl_remapped = false;
 		bool use_sub_threads = false;
+		bool high_priority = false; // Counted in high_priority_dependency_loads while it runs.
 		HashSet<String> sub_tasks;
 	};
 
@@ -191,6 +192,7 @@ private:
 	static SafeBinaryMutex<BINARY_MUTEX_TAG> thread_load_mutex;
 	static HashMap<String, ThreadLoadTask> thread_load_tasks;
 	static bool cleaning_tasks;
+	static int high_priority_dependency_loads;
 
 	static HashMap<String, LoadToken *> user_load_tokens;
 
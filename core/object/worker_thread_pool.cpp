@@ -49,6 +49,8 @@ WorkerThreadPool *WorkerThreadPool::singleton = nullptr;
 thread_local CommandQueueMT *WorkerThreadPool::flushing_cmd_queue = nullptr;
 
 void WorkerThreadPool::_process_task(Task *p_task) {
+	MemoryTagScope memory_tag_scope(p_task->memory_tag);
+
 #ifdef THREADS_ENABLED
 	int pool_thread_index = thread_ids[Thread::get_caller_id()];
 	ThreadData &curr_thread = threads[pool_thread_index];
@@ -81,7 +83,8 @@ void WorkerThreadPool::_process_task(Task *p_task) {
 
 	if (p_task->group) {
 		// Handling a group
-		bool do_post = false;
+		// An empty group only gets a task when it had to wait for dependencies, and that task completes it.
+		bool do_post = p_task->group->max == 0;
 
 		while (true) {
 			uint32_t work_index = p_task->group->index.postincrement();
@@ -110,8 +113,13 @@ void WorkerThreadPool::_process_task(Task *p_task) {
 		}
 
 		if (do_post) {
-			p_task->group->done_semaphore.post();
+			// Set under the mutex so dependency registration sees either this or the dependents being posted.
+			task_mutex.lock();
 			p_task->group->completed.set_to(true);
+			_post_dependents(p_task->group->self);
+			task_mutex.unlock();
+			// Waiters are only released once the group is seen as completed and its dependents are posted.
+			p_task->group->done_semaphore.post();
 		}
 		uint32_t max_users = p_task->group->tasks_used + 1; // Add 1 because the thread waiting for it is also user. Read before to avoid another thread freeing task after increment.
 		uint32_t finished_users = p_task->group->finished.increment();
@@ -150,6 +158,7 @@ void WorkerThreadPool::_process_task(Task *p_task) {
 				threads[i].signaled = true;
 			}
 		}
+		_post_dependents(p_task->self);
 	}
 
 #ifdef THREADS_ENABLED
@@ -175,8 +184,9 @@ void WorkerThreadPool::_process_task(Task *p_task) {
 void WorkerThreadPool::_thread_function(void *p_user) {
 	ThreadData *thread_data = (ThreadData *)p_user;
 	while (true) {
-		Task *task_to_process = nullptr;
-		{
+		// Tasks this thread posted itself can be taken without contending for the global mutex.
+		Task *task_to_process = singleton->_pop_local_task(thread_data);
+		if (!task_to_process) {
 			MutexLock lock(singleton->task_mutex);
 			if (singleton->exit_threads) {
 				return;
@@ -187,8 +197,13 @@ void WorkerThreadPool::_thread_function(void *p_user) {
 				task_to_process = singleton->task_queue.first()->self();
 				singleton->task_queue.remove(singleton->task_queue.first());
 			} else {
-				thread_data->cond_var.wait(lock);
-				DEV_ASSERT(singleton->exit_threads || thread_data->signaled);
+				// Checked with the mutex held, since local queues are only ever pushed to while holding it.
+				// That way a notification can't be missed between this check and the wait below.
+				task_to_process = singleton->_steal_task(thread_data);
+				if (!task_to_process) {
+					thread_data->cond_var.wait(lock);
+					DEV_ASSERT(singleton->exit_threads || thread_data->signaled);
+				}
 			}
 		}
 
@@ -211,6 +226,12 @@ void WorkerThreadPool::_post_tasks_and_unlock(Task **p_tasks, uint32_t p_count,
 		return;
 	}
 
+	_post_tasks(p_tasks, p_count, p_high_priority);
+
+	task_mutex.unlock();
+}
+
+void WorkerThreadPool::_post_tasks(Task **p_tasks, uint32_t p_count, bool p_high_priority) {
 	uint32_t to_process = 0;
 	uint32_t to_promote = 0;
 
@@ -218,7 +239,11 @@ void WorkerThreadPool::_post_tasks_and_unlock(Task **p_tasks, uint32_t p_count,
 
 	for (uint32_t i = 0; i < p_count; i++) {
 		p_tasks[i]->low_priority = !p_high_priority;
-		if (p_high_priority || low_priority_threads_used < max_low_priority_threads) {
+		if (p_high_priority && caller_pool_thread) {
+			// Nested task: keep it close to the thread that posted it. Idle threads will steal it if needed.
+			_push_local_task(caller_pool_thread, p_tasks[i]);
+			to_process++;
+		} else if (p_high_priority || low_priority_threads_used < max_low_priority_threads) {
 			task_queue.add_last(&p_tasks[i]->task_elem);
 			if (!p_high_priority) {
 				low_priority_threads_used++;
@@ -232,8 +257,6 @@ void WorkerThreadPool::_post_tasks_and_unlock(Task **p_tasks, uint32_t p_count,
 	}
 
 	_notify_threads(caller_pool_thread, to_process, to_promote);
-
-	task_mutex.unlock();
 }
 
 void WorkerThreadPool::_notify_threads(const ThreadData *p_current_thread_data, uint32_t p_process_count, uint32_t p_promote_count) {
@@ -300,6 +323,66 @@ void WorkerThreadPool::_notify_threads(const ThreadData *p_current_thread_data,
 	}
 }
 
+void WorkerThreadPool::_push_local_task(ThreadData *p_thread_data, Task *p_task) {
+	// Must be called with task_mutex held, so waiting threads can't miss the task.
+	p_thread_data->local_queue_lock.lock();
+	p_thread_data->local_queue.add(&p_task->task_elem);
+	p_thread_data->local_queue_size.increment();
+	p_thread_data->local_queue_lock.unlock();
+}
+
+WorkerThreadPool::Task *WorkerThreadPool::_pop_local_task(ThreadData *p_thread_data) {
+	if (p_thread_data->local_queue_size.get() == 0) {
+		return nullptr;
+	}
+
+	Task *task = nullptr;
+	p_thread_data->local_queue_lock.lock();
+	SelfList<Task> *newest = p_thread_data->local_queue.first();
+	if (newest) {
+		p_thread_data->local_queue.remove(newest);
+		p_thread_data->local_queue_size.decrement();
+		task = newest->self();
+	}
+	p_thread_data->local_queue_lock.unlock();
+	return task;
+}
+
+WorkerThreadPool::Task *WorkerThreadPool::_steal_task(const ThreadData *p_thief) {
+	uint32_t thread_count = threads.size();
+	uint32_t start = p_thief ? p_thief->index + 1 : 0;
+	for (uint32_t i = 0; i < thread_count; i++) {
+		ThreadData &victim = threads[(start + i) % thread_count];
+		if (&victim == p_thief || victim.local_queue_size.get() == 0) {
+			continue;
+		}
+
+		Task *task = nullptr;
+		victim.local_queue_lock.lock();
+		SelfList<Task> *oldest = victim.local_queue.last();
+		if (oldest) {
+			victim.local_queue.remove(oldest);
+			victim.local_queue_size.decrement();
+			task = oldest->self();
+		}
+		victim.local_queue_lock.unlock();
+
+		if (task) {
+			return task;
+		}
+	}
+	return nullptr;
+}
+
+bool WorkerThreadPool::_has_local_tasks() const {
+	for (uint32_t i = 0; i < threads.size(); i++) {
+		if (threads[i].local_queue_size.get()) {
+			return true;
+		}
+	}
+	return false;
+}
+
 bool WorkerThreadPool::_try_promote_low_priority_task() {
 	if (low_priority_task_queue.first()) {
 		Task *low_prio_task = low_priority_task_queue.first()->self();
@@ -312,11 +395,57 @@ bool WorkerThreadPool::_try_promote_low_priority_task() {
 	}
 }
 
+bool WorkerThreadPool::_is_completed(TaskID p_id) const {
+	const Task *const *taskp = tasks.getptr(p_id);
+	if (taskp) {
+		return (*taskp)->completed;
+	}
+	const Group *const *groupp = groups.getptr(p_id);
+	if (groupp) {
+		return (*groupp)->completed.is_set();
+	}
+	// Already awaited and released, so it must have completed.
+	return true;
+}
+
+uint32_t WorkerThreadPool::_register_dependencies(Task *p_task, const TaskID *p_dependencies, uint32_t p_dependency_count) {
+	p_task->pending_dependencies = 0;
+	for (uint32_t i = 0; i < p_dependency_count; i++) {
+		TaskID dependency = p_dependencies[i];
+		ERR_CONTINUE_MSG(dependency < 1 || (uint64_t)dependency >= last_task, "Invalid Task or Group ID.");
+		if (_is_completed(dependency)) {
+			continue;
+		}
+		dependent_tasks[dependency].push_back(p_task);
+		p_task->pending_dependencies++;
+	}
+	return p_task->pending_dependencies;
+}
+
+void WorkerThreadPool::_post_dependents(TaskID p_id) {
+	LocalVector<Task *> *dependents = dependent_tasks.getptr(p_id);
+	if (!dependents) {
+		return;
+	}
+	for (Task *dependent : *dependents) {
+		DEV_ASSERT(dependent->pending_dependencies > 0);
+		dependent->pending_dependencies--;
+		if (dependent->pending_dependencies == 0) {
+			_post_tasks(&dependent, 1, !dependent->low_priority);
+		}
+	}
+	dependent_tasks.erase(p_id);
+}
+
 WorkerThreadPool::TaskID WorkerThreadPool::add_native_task(void (*p_func)(void *), void *p_userdata, bool p_high_priority, const String &p_description) {
 	return _add_task(Callable(), p_func, p_userdata, nullptr, p_high_priority, p_description);
 }
 
-WorkerThreadPool::TaskID WorkerThreadPool::_add_task(const Callable &p_callable, void (*p_func)(void *), void *p_userdata, BaseTemplateUserdata *p_template_userdata, bool p_high_priority, const String &p_description) {
+WorkerThreadPool::TaskID WorkerThreadPool::add_native_task_after(const TaskID *p_dependencies, uint32_t p_dependency_count, void (*p_func)(void *), void *p_userdata, bool p_high_priority, const String &p_description) {
+	return _add_task(Callable(), p_func, p_userdata, nullptr, p_high_priority, p_description, p_dependencies, p_dependency_count);
+}
+
+WorkerThreadPool::TaskID WorkerThreadPool::_add_task(const Callable &p_callable, void (*p_func)(void *), void *p_userdata, BaseTemplateUserdata *p_template_userdata, bool p_high_priority, const String &p_description, const TaskID *p_dependencies, uint32_t p_dependency_count) {
 	task_mutex.lock();
 	// Get a free task
 	Task *task = task_allocator.alloc();
@@ -327,8 +456,16 @@ WorkerThreadPool::TaskID WorkerThreadPool::_add_task(const Callable &p_callable,
 	task->native_func_userdata = p_userdata;
 	task->description = p_description;
 	task->template_userdata = p_template_userdata;
+	task->memory_tag = Memory::get_current_tag();
 	tasks.insert(id, task);
 
+	if (_register_dependencies(task, p_dependencies, p_dependency_count)) {
+		// Posted by the last dependency to complete.
+		task->low_priority = !p_high_priority;
+		task_mutex.unlock();
+		return id;
+	}
+
 	_post_tasks_and_unlock(&task, 1, p_high_priority);
 
 	return id;
@@ -433,7 +570,7 @@ void WorkerThreadPool::_wait_collaboratively(ThreadData *p_caller_pool_thread, T
 				if (!exit_threads && was_signaled) {
 					// This thread was awaken for some additional reason, but it's about to exit.
 					// Let's find out what may be pending and forward the requests.
-					uint32_t to_process = task_queue.first() ? 1 : 0;
+					uint32_t to_process = (task_queue.first() || _has_local_tasks()) ? 1 : 0;
 					uint32_t to_promote = p_caller_pool_thread->current_task->low_priority && low_priority_task_queue.first() ? 1 : 0;
 					if (to_process || to_promote) {
 						// This thread must be left alone since it won't loop again.
@@ -452,11 +589,18 @@ void WorkerThreadPool::_wait_collaboratively(ThreadData *p_caller_pool_thread, T
 					}
 				}
 
-				if (singleton->task_queue.first()) {
+				// Own nested tasks first, since they are likely what is being waited for.
+				task_to_process = _pop_local_task(p_caller_pool_thread);
+
+				if (!task_to_process && task_queue.first()) {
 					task_to_process = task_queue.first()->self();
 					task_queue.remove(task_queue.first());
 				}
 
+				if (!task_to_process) {
+					task_to_process = _steal_task(p_caller_pool_thread);
+				}
+
 				if (!task_to_process) {
 					p_caller_pool_thread->awaited_task = p_task;
 
@@ -511,7 +655,7 @@ void WorkerThreadPool::notify_yield_over(TaskID p_task_id) {
 	task_mutex.unlock();
 }
 
-WorkerThreadPool::GroupID WorkerThreadPool::_add_group_task(const Callable &p_callable, void (*p_func)(void *, uint32_t), void *p_userdata, BaseTemplateUserdata *p_template_userdata, int p_elements, int p_tasks, bool p_high_priority, const String &p_description) {
+WorkerThreadPool::GroupID WorkerThreadPool::_add_group_task(const Callable &p_callable, void (*p_func)(void *, uint32_t), void *p_userdata, BaseTemplateUserdata *p_template_userdata, int p_elements, int p_tasks, bool p_high_priority, const String &p_description, const TaskID *p_dependencies, uint32_t p_dependency_count) {
 	ERR_FAIL_COND_V(p_elements < 0, INVALID_TASK_ID);
 	if (p_tasks < 0) {
 		p_tasks = MAX(1u, threads.size());
@@ -523,8 +667,12 @@ WorkerThreadPool::GroupID WorkerThreadPool::_add_group_task(const Callable &p_ca
 	group->max = p_elements;
 	group->self = id;
 
+	// An empty group must still not complete before its dependencies do.
+	// A single task that finds no elements completes it once it is posted.
+	const bool empty_after_dependencies = p_elements == 0 && p_dependency_count > 0;
+
 	Task **tasks_posted = nullptr;
-	if (p_elements == 0) {
+	if (p_elements == 0 && !empty_after_dependencies) {
 		// Should really not call it with zero Elements, but at least it should work.
 		group->completed.set_to(true);
 		group->done_semaphore.post();
@@ -535,6 +683,9 @@ WorkerThreadPool::GroupID WorkerThreadPool::_add_group_task(const Callable &p_ca
 		}
 
 	} else {
+		if (empty_after_dependencies) {
+			p_tasks = 1;
+		}
 		group->tasks_used = p_tasks;
 		tasks_posted = (Task **)alloca(sizeof(Task *) * p_tasks);
 		for (int i = 0; i < p_tasks; i++) {
@@ -545,6 +696,7 @@ WorkerThreadPool::GroupID WorkerThreadPool::_add_group_task(const Callable &p_ca
 			task->group = group;
 			task->callable = p_callable;
 			task->template_userdata = p_template_userdata;
+			task->memory_tag = Memory::get_current_tag();
 			tasks_posted[i] = task;
 			// No task ID is used.
 		}
@@ -552,6 +704,19 @@ WorkerThreadPool::GroupID WorkerThreadPool::_add_group_task(const Callable &p_ca
 
 	groups[id] = group;
 
+	if (p_tasks > 0 && p_dependency_count > 0) {
+		uint32_t pending = 0;
+		for (int i = 0; i < p_tasks; i++) {
+			pending = _register_dependencies(tasks_posted[i], p_dependencies, p_dependency_count);
+			tasks_posted[i]->low_priority = !p_high_priority;
+		}
+		if (pending) {
+			// All the tasks of the group share the same dependencies, so they will be posted together.
+			task_mutex.unlock();
+			return id;
+		}
+	}
+
 	_post_tasks_and_unlock(tasks_posted, p_tasks, p_high_priority);
 
 	return id;
@@ -561,6 +726,10 @@ WorkerThreadPool::GroupID WorkerThreadPool::add_native_group_task(void (*p_func)
 	return _add_group_task(Callable(), p_func, p_userdata, nullptr, p_elements, p_tasks, p_high_priority, p_description);
 }
 
+WorkerThreadPool::GroupID WorkerThreadPool::add_native_group_task_after(const TaskID *p_dependencies, uint32_t p_dependency_count, void (*p_func)(void *, uint32_t), void *p_userdata, int p_elements, int p_tasks, bool p_high_priority, const String &p_description) {
+	return _add_group_task(Callable(), p_func, p_userdata, nullptr, p_elements, p_tasks, p_high_priority, p_description, p_dependencies, p_dependency_count);
+}
+
 WorkerThreadPool::GroupID WorkerThreadPool::add_group_task(const Callable &p_action, int p_elements, int p_tasks, bool p_high_priority, const String &p_description) {
 	return _add_group_task(p_action, nullptr, nullptr, nullptr, p_elements, p_tasks, p_high_priority, p_description);
 }
@@ -680,6 +849,7 @@ void WorkerThreadPool::finish() {
 	}
 	for (ThreadData &data : threads) {
 		data.thread.wait_to_finish();
+		data.local_queue.clear();
 	}
 
 	{
@@ -687,6 +857,7 @@ void WorkerThreadPool::finish() {
 		for (KeyValue<TaskID, Task *> &E : tasks) {
 			task_allocator.free(E.value);
 		}
+		dependent_tasks.clear();
 	}
 
 	threads.clear();
@@ -35,6 +35,7 @@
 #include "core/os/memory.h"
 #include "core/os/os.h"
 #include "core/os/semaphore.h"
+#include "core/os/spin_lock.h"
 #include "core/os/thread.h"
 #include "core/templates/local_vector.h"
 #include "core/templates/paged_allocator.h"
@@ -90,6 +91,8 @@ private:
 		bool low_priority = false;
 		BaseTemplateUserdata *template_userdata = nullptr;
 		int pool_thread_index = -1;
+		uint32_t pending_dependencies = 0; // Tasks and groups that must complete before this one is posted.
+		Memory::Tag memory_tag = Memory::TAG_GENERAL; // The one of the thread that posted it.
 
 		void free_template_userdata();
 		Task() :
@@ -121,6 +124,12 @@ private:
 		Task *awaited_task = nullptr; // Null if not awaiting the condition variable, or special value (YIELDING).
 		ConditionVariable cond_var;
 
+		// Tasks posted from this thread. The owner pops the newest one (LIFO),
+		// whereas other threads steal the oldest one (FIFO).
+		SpinLock local_queue_lock;
+		SelfList<Task>::List local_queue;
+		SafeNumeric<uint32_t> local_queue_size;
+
 		ThreadData() :
 				ready_for_scripting(false),
 				signaled(false),
@@ -146,6 +155,9 @@ private:
 			PagedAllocator<HashMapElement<GroupID, Group *>, false, GROUPS_PAGE_SIZE>>
 			groups;
 
+	// Tasks not posted yet, keyed by the ID of a task or group they depend on.
+	HashMap<TaskID, LocalVector<Task *>> dependent_tasks;
+
 	uint32_t max_low_priority_threads = 0;
 	uint32_t low_priority_threads_used = 0;
 	uint32_t notify_index = 0; // For rotating across threads, no help distributing load.
@@ -157,16 +169,25 @@ private:
 	void _process_task(Task *task);
 
 	void _post_tasks_and_unlock(Task **p_tasks, uint32_t p_count, bool p_high_priority);
+	void _post_tasks(Task **p_tasks, uint32_t p_count, bool p_high_priority);
+	void _push_local_task(ThreadData *p_thread_data, Task *p_task);
+	Task *_pop_local_task(ThreadData *p_thread_data);
+	Task *_steal_task(const ThreadData *p_thief);
+	bool _has_local_tasks() const;
 	void _notify_threads(const ThreadData *p_current_thread_data, uint32_t p_process_count, uint32_t p_promote_count);
 
 	bool _try_promote_low_priority_task();
 
+	bool _is_completed(TaskID p_id) const;
+	uint32_t _register_dependencies(Task *p_task, const TaskID *p_dependencies, uint32_t p_dependency_count);
+	void _post_dependents(TaskID p_id);
+
 	static WorkerThreadPool *singleton;
 
 	static thread_local CommandQueueMT *flushing_cmd_queue;
 
-	TaskID _add_task(const Callable &p_callable, void (*p_func)(void *), void *p_userdata, BaseTemplateUserdata *p_template_userdata, bool p_high_priority, const String &p_description);
-	GroupID _add_group_task(const Callable &p_callable, void (*p_func)(void *, uint32_t), void *p_userdata, BaseTemplateUserdata *p_template_userdata, int p_elements, int p_tasks, bool p_high_priority, const String &p_description);
+	TaskID _add_task(const Callable &p_callable, void (*p_func)(void *), void *p_userdata, BaseTemplateUserdata *p_template_userdata, bool p_high_priority, const String &p_description, const TaskID *p_dependencies = nullptr, uint32_t p_dependency_count = 0);
+	GroupID _add_group_task(const Callable &p_callable, void (*p_func)(void *, uint32_t), void *p_userdata, BaseTemplateUserdata *p_template_userdata, int p_elements, int p_tasks, bool p_high_priority, const String &p_description, const TaskID *p_dependencies = nullptr, uint32_t p_dependency_count = 0);
 
 	template <typename C, typename M, typename U>
 	struct TaskUserData : public BaseTemplateUserdata {
@@ -206,6 +227,20 @@ public:
 	TaskID add_native_task(void (*p_func)(void *), void *p_userdata, bool p_high_priority = false, const String &p_description = String());
 	TaskID add_task(const Callable &p_action, bool p_high_priority = false, const String &p_description = String());
 
+	// The *_after() variants don't post the task until all the given tasks and/or groups have completed,
+	// so phases can be chained without a thread blocking in between. Dependencies still have to be
+	// awaited eventually, as usual, so their IDs are released.
+	template <typename C, typename M, typename U>
+	TaskID add_template_task_after(const TaskID *p_dependencies, uint32_t p_dependency_count, C *p_instance, M p_method, U p_userdata, bool p_high_priority = false, const String &p_description = String()) {
+		typedef TaskUserData<C, M, U> TUD;
+		TUD *ud = memnew(TUD);
+		ud->instance = p_instance;
+		ud->method = p_method;
+		ud->userdata = p_userdata;
+		return _add_task(Callable(), nullptr, nullptr, ud, p_high_priority, p_description, p_dependencies, p_dependency_count);
+	}
+	TaskID add_native_task_after(const TaskID *p_dependencies, uint32_t p_dependency_count, void (*p_func)(void *), void *p_userdata, bool p_high_priority = false, const String &p_description = String());
+
 	bool is_task_completed(TaskID p_task_id) const;
 	Error wait_for_task_completion(TaskID p_task_id);
 
@@ -222,6 +257,16 @@ public:
 		return _add_group_task(Callable(), nullptr, nullptr, ud, p_elements, p_tasks, p_high_priority, p_description);
 	}
 	GroupID add_native_group_task(void (*p_func)(void *, uint32_t), void *p_userdata, int p_elements, int p_tasks = -1, bool p_high_priority = false, const String &p_description = String());
+	template <typename C, typename M, typename U>
+	GroupID add_template_group_task_after(const TaskID *p_dependencies, uint32_t p_dependency_count, C *p_instance, M p_method, U p_userdata, int p_elements, int p_tasks = -1, bool p_high_priority = false, const String &p_description = String()) {
+		typedef GroupUserData<C, M, U> GroupUD;
+		GroupUD *ud = memnew(GroupUD);
+		ud->instance = p_instance;
+		ud->method = p_method;
+		ud->userdata = p_userdata;
+		return _add_group_task(Callable(), nullptr, nullptr, ud, p_elements, p_tasks, p_high_priority, p_description, p_dependencies, p_dependency_count);
+	}
+	GroupID add_native_group_task_after(const TaskID *p_dependencies, uint32_t p_dependency_count, void (*p_func)(void *, uint32_t), void *p_userdata, int p_elements, int p_tasks = -1, bool p_high_priority = false, const String &p_description = String());
 	GroupID add_group_task(const Callable &p_action, int p_elements, int p_tasks = -1, bool p_high_priority = false, const String &p_description = String());
 	uint32_t get_group_processed_element_count(GroupID p_group) const;
 	bool is_group_task_completed(GroupID p_group) const;
@@ -0,0 +1,113 @@
+/**************************************************************************/
+/*  arena_allocator.cpp                                                   */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "arena_allocator.h"
+
+#include "core/error/error_macros.h"
+
+void *ArenaAllocator::_alloc_slow(size_t p_bytes, size_t p_alignment) {
+	// Chunk data is only aligned to max_align_t, stricter alignments may need padding.
+	const size_t needed = p_bytes + (p_alignment > alignof(max_align_t) ? p_alignment : 0);
+
+	// Chunks after the current one are left over from before the last reset or rewind, reuse them if they fit.
+	Chunk *next = current ? current->next : first;
+	if (!next || next->size < needed) {
+		const size_t size = MAX(chunk_size, needed);
+		Chunk *chunk = static_cast<Chunk *>(Memory::alloc_static(CHUNK_DATA_OFFSET + size));
+		ERR_FAIL_NULL_V(chunk, nullptr);
+		memnew_placement(chunk, Chunk);
+		chunk->size = size;
+		chunk->next = next;
+		if (current) {
+			current->next = chunk;
+		} else {
+			first = chunk;
+		}
+		next = chunk;
+	}
+
+	current = next;
+	offset = 0;
+	return alloc(p_bytes, p_alignment);
+}
+
+void ArenaAllocator::rewind(const Marker &p_marker) {
+	if (p_marker.chunk) {
+		current = p_marker.chunk;
+		offset = p_marker.offset;
+	} else {
+		reset();
+	}
+}
+
+void ArenaAllocator::reset() {
+	current = first;
+	offset = 0;
+}
+
+void ArenaAllocator::clear() {
+	while (first) {
+		Chunk *next = first->next;
+		Memory::free_static(first);
+		first = next;
+	}
+	current = nullptr;
+	offset = 0;
+}
+
+size_t ArenaAllocator::get_used() const {
+	size_t used = 0;
+	for (Chunk *chunk = first; chunk && chunk != current; chunk = chunk->next) {
+		used += chunk->size;
+	}
+	return used + offset;
+}
+
+size_t ArenaAllocator::get_capacity() const {
+	size_t capacity = 0;
+	for (Chunk *chunk = first; chunk; chunk = chunk->next) {
+		capacity += chunk->size;
+	}
+	return capacity;
+}
+
+ArenaAllocator &ArenaAllocator::get_thread_scratch() {
+	static thread_local ArenaAllocator scratch;
+	return scratch;
+}
+
+ArenaAllocator::ArenaAllocator(size_t p_chunk_size) {
+	ERR_FAIL_COND(p_chunk_size == 0);
+	chunk_size = p_chunk_size;
+}
+
+ArenaAllocator::~ArenaAllocator() {
+	clear();
+}
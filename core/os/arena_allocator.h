@@ -0,0 +1,119 @@
+/**************************************************************************/
+/*  arena_allocator.h                                                     */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef ARENA_ALLOCATOR_H
+#define ARENA_ALLOCATOR_H
+
+#include "core/os/memory.h"
+#include "core/typedefs.h"
+
+#include <type_traits>
+
+/**
+ * Bump allocator for short-lived scratch data, like per-frame cull results or command buffers.
+ * Allocations are never freed individually. Instead, the whole arena is reset (or rewound to a
+ * marker, see ArenaScope), and the memory it grew to is kept around for the next frame.
+ * Not thread-safe, use one arena per thread (see get_thread_scratch()).
+ */
+class ArenaAllocator {
+	struct Chunk {
+		Chunk *next = nullptr;
+		size_t size = 0;
+	};
+
+	static constexpr size_t CHUNK_DATA_OFFSET = (sizeof(Chunk) % alignof(max_align_t) == 0) ? sizeof(Chunk) : (sizeof(Chunk) + alignof(max_align_t) - (sizeof(Chunk) % alignof(max_align_t)));
+
+	Chunk *first = nullptr;
+	Chunk *current = nullptr;
+	size_t offset = 0;
+	size_t chunk_size = 0;
+
+	_FORCE_INLINE_ static uint8_t *_get_chunk_data(Chunk *p_chunk) { return reinterpret_cast<uint8_t *>(p_chunk) + CHUNK_DATA_OFFSET; }
+	void *_alloc_slow(size_t p_bytes, size_t p_alignment);
+
+public:
+	struct Marker {
+		Chunk *chunk = nullptr;
+		size_t offset = 0;
+	};
+
+	_FORCE_INLINE_ void *alloc(size_t p_bytes, size_t p_alignment = alignof(max_align_t)) {
+		DEV_ASSERT(p_alignment > 0 && (p_alignment & (p_alignment - 1)) == 0);
+		if (likely(current)) {
+			const uintptr_t base = reinterpret_cast<uintptr_t>(_get_chunk_data(current));
+			const size_t aligned = ((base + offset + p_alignment - 1) & ~uintptr_t(p_alignment - 1)) - base;
+			if (likely(aligned + p_bytes <= current->size)) {
+				offset = aligned + p_bytes;
+				return reinterpret_cast<void *>(base + aligned);
+			}
+		}
+		return _alloc_slow(p_bytes, p_alignment);
+	}
+
+	// Only for types that need no destruction, since the arena never runs destructors.
+	template <typename T>
+	_FORCE_INLINE_ T *alloc_array(size_t p_count) {
+		static_assert(std::is_trivially_destructible_v<T>, "Arena allocated types must be trivially destructible.");
+		T *ptr = static_cast<T *>(alloc(sizeof(T) * p_count, alignof(T)));
+		if constexpr (!std::is_trivially_constructible_v<T>) {
+			for (size_t i = 0; i < p_count; i++) {
+				memnew_placement(&ptr[i], T);
+			}
+		}
+		return ptr;
+	}
+
+	_FORCE_INLINE_ Marker get_marker() const { return Marker{ current, offset }; }
+	void rewind(const Marker &p_marker);
+	void reset();
+	void clear();
+
+	size_t get_used() const;
+	size_t get_capacity() const;
+
+	// An arena owned by the calling thread, for scratch data that doesn't outlive an ArenaScope.
+	static ArenaAllocator &get_thread_scratch();
+
+	explicit ArenaAllocator(size_t p_chunk_size = 64 * 1024);
+	~ArenaAllocator();
+};
+
+// Rewinds the arena to where it was when the scope started, freeing everything allocated within it.
+class ArenaScope {
+	ArenaAllocator &arena;
+	ArenaAllocator::Marker marker;
+
+public:
+	_FORCE_INLINE_ explicit ArenaScope(ArenaAllocator &p_arena) :
+			arena(p_arena), marker(p_arena.get_marker()) {}
+	_FORCE_INLINE_ ~ArenaScope() { arena.rewind(marker); }
+};
+
+#endif // ARENA_ALLOCATOR_H
@@ -58,19 +58,34 @@ void operator delete(void *p_mem, void *p_pointer, size_t check, const char *p_d
 }
 #endif
 
-#ifdef DEBUG_ENABLED
 SafeNumeric<uint64_t> Memory::mem_usage;
 SafeNumeric<uint64_t> Memory::max_usage;
-#endif
+SafeNumeric<uint64_t> Memory::tag_usage[TAG_MAX];
+thread_local Memory::Tag Memory::current_tag = TAG_GENERAL;
 
 SafeNumeric<uint64_t> Memory::alloc_count;
 
-void *Memory::alloc_static(size_t p_bytes, bool p_pad_align) {
+#ifndef DEBUG_ENABLED
+// Set on the first allocation, as it can't change once blocks were allocated without a header.
+// Allocations happen before command line arguments are parsed (and before any thread is started),
+// hence the environment variable. Constant-initialized, so it is valid for static constructors too.
+static int8_t usage_tracked = -1;
+#endif
+
+bool Memory::is_usage_tracked() {
 #ifdef DEBUG_ENABLED
-	bool prepad = true;
+	return true;
 #else
-	bool prepad = p_pad_align;
+	if (unlikely(usage_tracked < 0)) {
+		usage_tracked = getenv("GODOT_TRACK_MEMORY") != nullptr ? 1 : 0;
+	}
+	return usage_tracked;
 #endif
+}
+
+void *Memory::alloc_static(size_t p_bytes, bool p_pad_align) {
+	const bool tracked = is_usage_tracked();
+	bool prepad = tracked || p_pad_align;
 
 	void *mem = malloc(p_bytes + (prepad ? DATA_OFFSET : 0));
 
@@ -84,10 +99,14 @@ void *Memory::alloc_static(size_t p_bytes, bool p_pad_align) {
 		uint64_t *s = (uint64_t *)(s8 + SIZE_OFFSET);
 		*s = p_bytes;
 
-#ifdef DEBUG_ENABLED
-		uint64_t new_mem_usage = mem_usage.add(p_bytes);
-		max_usage.exchange_if_greater(new_mem_usage);
-#endif
+		if (tracked) {
+			const Tag tag = current_tag;
+			*s |= uint64_t(tag) << TAG_SHIFT;
+			tag_usage[tag].add(p_bytes);
+
+			uint64_t new_mem_usage = mem_usage.add(p_bytes);
+			max_usage.exchange_if_greater(new_mem_usage);
+		}
 		return s8 + DATA_OFFSET;
 	} else {
 		return mem;
@@ -101,37 +120,40 @@ void *Memory::realloc_static(void *p_memory, size_t p_bytes, bool p_pad_align) {
 
 	uint8_t *mem = (uint8_t *)p_memory;
 
-#ifdef DEBUG_ENABLED
-	bool prepad = true;
-#else
-	bool prepad = p_pad_align;
-#endif
+	const bool tracked = is_usage_tracked();
+	bool prepad = tracked || p_pad_align;
 
 	if (prepad) {
 		mem -= DATA_OFFSET;
 		uint64_t *s = (uint64_t *)(mem + SIZE_OFFSET);
 
-#ifdef DEBUG_ENABLED
-		if (p_bytes > *s) {
-			uint64_t new_mem_usage = mem_usage.add(p_bytes - *s);
-			max_usage.exchange_if_greater(new_mem_usage);
-		} else {
-			mem_usage.sub(*s - p_bytes);
+		// Reallocations stay attributed to the tag the memory was first allocated with.
+		const Tag tag = tracked ? Tag(*s >> TAG_SHIFT) : TAG_GENERAL;
+		if (tracked) {
+			const uint64_t old_bytes = *s & SIZE_MASK;
+			if (p_bytes > old_bytes) {
+				tag_usage[tag].add(p_bytes - old_bytes);
+				uint64_t new_mem_usage = mem_usage.add(p_bytes - old_bytes);
+				max_usage.exchange_if_greater(new_mem_usage);
+			} else {
+				tag_usage[tag].sub(old_bytes - p_bytes);
+				mem_usage.sub(old_bytes - p_bytes);
+			}
 		}
-#endif
 
 		if (p_bytes == 0) {
 			free(mem);
 			return nullptr;
 		} else {
-			*s = p_bytes;
-
 			mem = (uint8_t *)realloc(mem, p_bytes + DATA_OFFSET);
 			ERR_FAIL_NULL_V(mem, nullptr);
 
 			s = (uint64_t *)(mem + SIZE_OFFSET);
 
 			*s = p_bytes;
+			if (tracked) {
+				*s |= uint64_t(tag) << TAG_SHIFT;
+			}
 
 			return mem + DATA_OFFSET;
 		}
@@ -149,21 +171,19 @@ void Memory::free_static(void *p_ptr, bool p_pad_align) {
 
 	uint8_t *mem = (uint8_t *)p_ptr;
 
-#ifdef DEBUG_ENABLED
-	bool prepad = true;
-#else
-	bool prepad = p_pad_align;
-#endif
+	const bool tracked = is_usage_tracked();
+	bool prepad = tracked || p_pad_align;
 
 	alloc_count.decrement();
 
 	if (prepad) {
 		mem -= DATA_OFFSET;
 
-#ifdef DEBUG_ENABLED
-		uint64_t *s = (uint64_t *)(mem + SIZE_OFFSET);
-		mem_usage.sub(*s);
-#endif
+		if (tracked) {
+			uint64_t *s = (uint64_t *)(mem + SIZE_OFFSET);
+			tag_usage[*s >> TAG_SHIFT].sub(*s & SIZE_MASK);
+			mem_usage.sub(*s & SIZE_MASK);
+		}
 
 		free(mem);
 	} else {
@@ -176,19 +196,16 @@ uint64_t Memory::get_mem_available() {
 }
 
 uint64_t Memory::get_mem_usage() {
-#ifdef DEBUG_ENABLED
-	return mem_usage.get();
-#else
-	return 0;
-#endif
+	return mem_usage.get(); // Stays at 0 unless usage is tracked.
 }
 
 uint64_t Memory::get_mem_max_usage() {
-#ifdef DEBUG_ENABLED
-	return max_usage.get();
-#else
-	return 0;
-#endif
+	return max_usage.get(); // Stays at 0 unless usage is tracked.
+}
+
+uint64_t Memory::get_mem_usage_by_tag(Tag p_tag) {
+	ERR_FAIL_INDEX_V(p_tag, TAG_MAX, 0);
+	return tag_usage[p_tag].get();
 }
 
 _GlobalNil::_GlobalNil() {
@@ -39,10 +39,31 @@
 #include <type_traits>
 
 class Memory {
-#ifdef DEBUG_ENABLED
+public:
+	// Subsystems that allocations are attributed to, see MemoryTagScope.
+	enum Tag : uint8_t {
+		TAG_GENERAL,
+		TAG_SCENE,
+		TAG_RESOURCE,
+		TAG_SCRIPT,
+		TAG_RENDERING,
+		TAG_PHYSICS,
+		TAG_NAVIGATION,
+		TAG_AUDIO,
+		TAG_MAX
+	};
+
+private:
+	friend class MemoryTagScope;
+
 	static SafeNumeric<uint64_t> mem_usage;
 	static SafeNumeric<uint64_t> max_usage;
-#endif
+
+	// The tag is kept in the top bits of the allocation size, which is stored with every allocation while usage is tracked.
+	static constexpr int TAG_SHIFT = 56;
+	static constexpr uint64_t SIZE_MASK = (uint64_t(1) << TAG_SHIFT) - 1;
+	static SafeNumeric<uint64_t> tag_usage[TAG_MAX];
+	static thread_local Tag current_tag;
 
 	static SafeNumeric<uint64_t> alloc_count;
 
@@ -65,6 +86,27 @@ public:
 	static uint64_t get_mem_available();
 	static uint64_t get_mem_usage();
 	static uint64_t get_mem_max_usage();
+	static uint64_t get_mem_usage_by_tag(Tag p_tag);
+
+	// Always true in debug builds. Release builds only track usage when the GODOT_TRACK_MEMORY environment
+	// variable is set, since every allocation then needs a header to remember its size and tag.
+	static bool is_usage_tracked();
+	static Tag get_current_tag() { return current_tag; }
+};
+
+// Attributes the allocations made by the current thread to a subsystem until the scope ends.
+// Tasks posted to the WorkerThreadPool keep the tag of the thread that posted them.
+class MemoryTagScope {
+	Memory::Tag previous;
+
+public:
+	_FORCE_INLINE_ explicit MemoryTagScope(Memory::Tag p_tag) {
+		previous = Memory::current_tag;
+		Memory::current_tag = p_tag;
+	}
+	_FORCE_INLINE_ ~MemoryTagScope() {
+		Memory::current_tag = previous;
+	}
 };
 
 class DefaultAllocator {
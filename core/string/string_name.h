@@ -48,7 +48,12 @@ class StringName {
 	enum {
 		STRING_TABLE_BITS = 16,
 		STRING_TABLE_LEN = 1 << STRING_TABLE_BITS,
-		STRING_TABLE_MASK = STRING_TABLE_LEN - 1
+		STRING_TABLE_MASK = STRING_TABLE_LEN - 1,
+		// Buckets are guarded by a set of locks rather than a single one,
+		// so threads interning unrelated names rarely wait on each other.
+		STRING_TABLE_LOCK_BITS = 8,
+		STRING_TABLE_LOCK_COUNT = 1 << STRING_TABLE_LOCK_BITS,
+		STRING_TABLE_LOCK_MASK = STRING_TABLE_LOCK_COUNT - 1
 	};
 
 	struct _Data {
@@ -60,6 +65,9 @@ class StringName {
 		uint32_t debug_references = 0;
 #endif
 		String get_name() const { return cname ? String(cname) : name; }
+		// Avoid building a String from `cname` just to compare it.
+		bool is_named(const char *p_name) const { return cname ? strcmp(cname, p_name) == 0 : name == p_name; }
+		bool is_named(const String &p_name) const { return cname ? p_name == cname : name == p_name; }
 		int idx = 0;
 		uint32_t hash = 0;
 		_Data *prev = nullptr;
@@ -69,13 +77,20 @@ class StringName {
 
 	static _Data *_table[STRING_TABLE_LEN];
 
+	// Padded so that locks of neighboring buckets don't share a cache line.
+	struct alignas(64) _TableLock {
+		Mutex mutex;
+	};
+	static _TableLock _table_locks[STRING_TABLE_LOCK_COUNT];
+	_FORCE_INLINE_ static Mutex &_get_table_lock(uint32_t p_idx) { return _table_locks[p_idx & STRING_TABLE_LOCK_MASK].mutex; }
+
 	_Data *_data = nullptr;
 
 	void unref();
 	friend void register_core_types();
 	friend void unregister_core_types();
 	friend class Main;
-	static Mutex mutex;
+	static Mutex mutex; // Only guards assign_static_unique_class_name().
 	static void setup();
 	static void cleanup();
 	static bool configured;
@@ -59,6 +59,214 @@ static _FORCE_INLINE_ char32_t lower_case(char32_t c) {
 	return (is_ascii_upper_case(c) ? (c + ('a' - 'A')) : c);
 }
 
+static _FORCE_INLINE_ char32_t upper_case(char32_t c) {
+	return (is_ascii_lower_case(c) ? (c - ('a' - 'A')) : c);
+}
+
+// Vectorized helpers for the ASCII fast paths and character search. SSE2 and NEON are part of the
+// x86_64 and arm64 baselines, so they're used without runtime detection; other targets use the scalar
+// loops. Each helper handles full vectors and leaves the remainder, or the exact position of a hit
+// inside the last vector, to a scalar loop.
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define USTRING_SSE2
+#include <emmintrin.h>
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define USTRING_NEON
+#include <arm_neon.h>
+#endif
+
+// Returns how many leading bytes are ASCII, excluding NUL and, if requested, carriage returns.
+static _FORCE_INLINE_ int _utf8_ascii_run(const uint8_t *p_src, int p_len, bool p_skip_cr) {
+	int i = 0;
+#if defined(USTRING_SSE2)
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i cr = _mm_set1_epi8(p_skip_cr ? '\r' : 0);
+	for (; i + 16 <= p_len; i += 16) {
+		const __m128i v = _mm_loadu_si128((const __m128i *)(p_src + i));
+		const __m128i stop = _mm_or_si128(_mm_cmpeq_epi8(v, zero), _mm_cmpeq_epi8(v, cr));
+		if (_mm_movemask_epi8(_mm_or_si128(v, stop))) {
+			break;
+		}
+	}
+#elif defined(USTRING_NEON)
+	const uint8x16_t high = vdupq_n_u8(0x80);
+	const uint8x16_t zero = vdupq_n_u8(0);
+	const uint8x16_t cr = vdupq_n_u8(p_skip_cr ? '\r' : 0);
+	for (; i + 16 <= p_len; i += 16) {
+		const uint8x16_t v = vld1q_u8(p_src + i);
+		const uint8x16_t stop = vorrq_u8(vcgeq_u8(v, high), vorrq_u8(vceqq_u8(v, zero), vceqq_u8(v, cr)));
+		if (vmaxvq_u8(stop)) {
+			break;
+		}
+	}
+#endif
+	for (; i < p_len; i++) {
+		const uint8_t c = p_src[i];
+		if (c >= 0x80 || c == 0 || (p_skip_cr && c == '\r')) {
+			break;
+		}
+	}
+	return i;
+}
+
+// Widens bytes already known to be ASCII to UTF-32.
+static _FORCE_INLINE_ void _utf8_ascii_widen(const uint8_t *p_src, char32_t *p_dst, int p_len) {
+	int i = 0;
+#if defined(USTRING_SSE2)
+	const __m128i zero = _mm_setzero_si128();
+	for (; i + 16 <= p_len; i += 16) {
+		const __m128i v = _mm_loadu_si128((const __m128i *)(p_src + i));
+		const __m128i lo = _mm_unpacklo_epi8(v, zero);
+		const __m128i hi = _mm_unpackhi_epi8(v, zero);
+		_mm_storeu_si128((__m128i *)(p_dst + i), _mm_unpacklo_epi16(lo, zero));
+		_mm_storeu_si128((__m128i *)(p_dst + i + 4), _mm_unpackhi_epi16(lo, zero));
+		_mm_storeu_si128((__m128i *)(p_dst + i + 8), _mm_unpacklo_epi16(hi, zero));
+		_mm_storeu_si128((__m128i *)(p_dst + i + 12), _mm_unpackhi_epi16(hi, zero));
+	}
+#elif defined(USTRING_NEON)
+	for (; i + 16 <= p_len; i += 16) {
+		const uint8x16_t v = vld1q_u8(p_src + i);
+		const uint16x8_t lo = vmovl_u8(vget_low_u8(v));
+		const uint16x8_t hi = vmovl_u8(vget_high_u8(v));
+		vst1q_u32((uint32_t *)(p_dst + i), vmovl_u16(vget_low_u16(lo)));
+		vst1q_u32((uint32_t *)(p_dst + i + 4), vmovl_u16(vget_high_u16(lo)));
+		vst1q_u32((uint32_t *)(p_dst + i + 8), vmovl_u16(vget_low_u16(hi)));
+		vst1q_u32((uint32_t *)(p_dst + i + 12), vmovl_u16(vget_high_u16(hi)));
+	}
+#endif
+	for (; i < p_len; i++) {
+		p_dst[i] = p_src[i];
+	}
+}
+
+// Returns how many leading characters are ASCII.
+static _FORCE_INLINE_ int _utf32_ascii_run(const char32_t *p_src, int p_len) {
+	int i = 0;
+#if defined(USTRING_SSE2)
+	const __m128i non_ascii = _mm_set1_epi32(~0x7f);
+	const __m128i zero = _mm_setzero_si128();
+	for (; i + 16 <= p_len; i += 16) {
+		__m128i v = _mm_loadu_si128((const __m128i *)(p_src + i));
+		v = _mm_or_si128(v, _mm_loadu_si128((const __m128i *)(p_src + i + 4)));
+		v = _mm_or_si128(v, _mm_loadu_si128((const __m128i *)(p_src + i + 8)));
+		v = _mm_or_si128(v, _mm_loadu_si128((const __m128i *)(p_src + i + 12)));
+		if (_mm_movemask_epi8(_mm_cmpeq_epi32(_mm_and_si128(v, non_ascii), zero)) != 0xffff) {
+			break;
+		}
+	}
+#elif defined(USTRING_NEON)
+	for (; i + 16 <= p_len; i += 16) {
+		uint32x4_t v = vld1q_u32((const uint32_t *)(p_src + i));
+		v = vorrq_u32(v, vld1q_u32((const uint32_t *)(p_src + i + 4)));
+		v = vorrq_u32(v, vld1q_u32((const uint32_t *)(p_src + i + 8)));
+		v = vorrq_u32(v, vld1q_u32((const uint32_t *)(p_src + i + 12)));
+		if (vmaxvq_u32(v) > 0x7f) {
+			break;
+		}
+	}
+#endif
+	for (; i < p_len; i++) {
+		if (p_src[i] > 0x7f) {
+			break;
+		}
+	}
+	return i;
+}
+
+// Narrows characters already known to be ASCII to bytes.
+static _FORCE_INLINE_ void _utf32_ascii_narrow(const char32_t *p_src, uint8_t *p_dst, int p_len) {
+	int i = 0;
+#if defined(USTRING_SSE2)
+	for (; i + 16 <= p_len; i += 16) {
+		const __m128i a = _mm_packs_epi32(_mm_loadu_si128((const __m128i *)(p_src + i)), _mm_loadu_si128((const __m128i *)(p_src + i + 4)));
+		const __m128i b = _mm_packs_epi32(_mm_loadu_si128((const __m128i *)(p_src + i + 8)), _mm_loadu_si128((const __m128i *)(p_src + i + 12)));
+		_mm_storeu_si128((__m128i *)(p_dst + i), _mm_packus_epi16(a, b));
+	}
+#elif defined(USTRING_NEON)
+	for (; i + 16 <= p_len; i += 16) {
+		const uint16x8_t a = vcombine_u16(vmovn_u32(vld1q_u32((const uint32_t *)(p_src + i))), vmovn_u32(vld1q_u32((const uint32_t *)(p_src + i + 4))));
+		const uint16x8_t b = vcombine_u16(vmovn_u32(vld1q_u32((const uint32_t *)(p_src + i + 8))), vmovn_u32(vld1q_u32((const uint32_t *)(p_src + i + 12))));
+		vst1q_u8(p_dst + i, vcombine_u8(vmovn_u16(a), vmovn_u16(b)));
+	}
+#endif
+	for (; i < p_len; i++) {
+		p_dst[i] = uint8_t(p_src[i]);
+	}
+}
+
+// Returns the index of the first occurrence of p_char in [p_from, p_to), or -1.
+static _FORCE_INLINE_ int _utf32_find_char(const char32_t *p_src, int p_from, int p_to, char32_t p_char) {
+	int i = p_from;
+#if defined(USTRING_SSE2)
+	const __m128i needle = _mm_set1_epi32(int(p_char));
+	for (; i + 8 <= p_to; i += 8) {
+		const __m128i a = _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i *)(p_src + i)), needle);
+		const __m128i b = _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i *)(p_src + i + 4)), needle);
+		if (_mm_movemask_epi8(_mm_or_si128(a, b))) {
+			break;
+		}
+	}
+#elif defined(USTRING_NEON)
+	const uint32x4_t needle = vdupq_n_u32(p_char);
+	for (; i + 8 <= p_to; i += 8) {
+		const uint32x4_t a = vceqq_u32(vld1q_u32((const uint32_t *)(p_src + i)), needle);
+		const uint32x4_t b = vceqq_u32(vld1q_u32((const uint32_t *)(p_src + i + 4)), needle);
+		if (vmaxvq_u32(vorrq_u32(a, b))) {
+			break;
+		}
+	}
+#endif
+	for (; i < p_to; i++) {
+		if (p_src[i] == p_char) {
+			return i;
+		}
+	}
+	return -1;
+}
+
+// Maps the ASCII letters between p_from and p_to (inclusive) by p_offset, in place, as long as the
+// characters are ASCII. Returns how many characters were handled, the rest need the full case tables.
+static _FORCE_INLINE_ int _utf32_ascii_map_case(char32_t *p_str, int p_len, char32_t p_from, char32_t p_to, int p_offset) {
+	int i = 0;
+#if defined(USTRING_SSE2)
+	const __m128i non_ascii = _mm_set1_epi32(~0x7f);
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i below = _mm_set1_epi32(int(p_from) - 1);
+	const __m128i above = _mm_set1_epi32(int(p_to) + 1);
+	const __m128i offset = _mm_set1_epi32(p_offset);
+	for (; i + 4 <= p_len; i += 4) {
+		const __m128i v = _mm_loadu_si128((const __m128i *)(p_str + i));
+		if (_mm_movemask_epi8(_mm_cmpeq_epi32(_mm_and_si128(v, non_ascii), zero)) != 0xffff) {
+			break;
+		}
+		const __m128i in_range = _mm_and_si128(_mm_cmpgt_epi32(v, below), _mm_cmplt_epi32(v, above));
+		_mm_storeu_si128((__m128i *)(p_str + i), _mm_add_epi32(v, _mm_and_si128(in_range, offset)));
+	}
+#elif defined(USTRING_NEON)
+	const uint32x4_t from = vdupq_n_u32(p_from);
+	const uint32x4_t to = vdupq_n_u32(p_to);
+	const uint32x4_t offset = vreinterpretq_u32_s32(vdupq_n_s32(p_offset));
+	for (; i + 4 <= p_len; i += 4) {
+		const uint32x4_t v = vld1q_u32((const uint32_t *)(p_str + i));
+		if (vmaxvq_u32(v) > 0x7f) {
+			break;
+		}
+		const uint32x4_t in_range = vandq_u32(vcgeq_u32(v, from), vcleq_u32(v, to));
+		vst1q_u32((uint32_t *)(p_str + i), vaddq_u32(v, vandq_u32(in_range, offset)));
+	}
+#endif
+	for (; i < p_len; i++) {
+		const char32_t c = p_str[i];
+		if (c > 0x7f) {
+			break;
+		}
+		if (c >= p_from && c <= p_to) {
+			p_str[i] = c + p_offset;
+		}
+	}
+	return i;
+}
+
 const char CharString::_null = 0;
 const char16_t Char16String::_null = 0;
 const char32_t String::_null = 0;
@@ -1506,13 +1714,24 @@ char32_t String::char_lowercase(char32_t p_char) {
 }
 
 String String::to_upper() const {
-	String upper = *this;
+	const int len = length();
+	const char32_t *src = get_data();
 
-	for (int i = 0; i < upper.size(); i++) {
-		const char32_t s = upper[i];
-		const char32_t t = _find_upper(s);
-		if (s != t) { // avoid copy on write
-			upper[i] = t;
+	// Find the first character that changes, to avoid copy on write for strings that don't.
+	int i = 0;
+	while (i < len && char32_t(src[i] <= 0x7f ? upper_case(src[i]) : _find_upper(src[i])) == src[i]) {
+		i++;
+	}
+	if (i == len) {
+		return *this;
+	}
+
+	String upper = *this;
+	char32_t *dst = upper.ptrw();
+	while (i < len) {
+		i += _utf32_ascii_map_case(dst + i, len - i, 'a', 'z', 'A' - 'a');
+		for (; i < len && dst[i] > 0x7f; i++) {
+			dst[i] = _find_upper(dst[i]);
 		}
 	}
 
@@ -1520,13 +1739,24 @@ String String::to_upper() const {
 }
 
 String String::to_lower() const {
-	String lower = *this;
+	const int len = length();
+	const char32_t *src = get_data();
 
-	for (int i = 0; i < lower.size(); i++) {
-		const char32_t s = lower[i];
-		const char32_t t = _find_lower(s);
-		if (s != t) { // avoid copy on write
-			lower[i] = t;
+	// Find the first character that changes, to avoid copy on write for strings that don't.
+	int i = 0;
+	while (i < len && char32_t(src[i] <= 0x7f ? lower_case(src[i]) : _find_lower(src[i])) == src[i]) {
+		i++;
+	}
+	if (i == len) {
+		return *this;
+	}
+
+	String lower = *this;
+	char32_t *dst = lower.ptrw();
+	while (i < len) {
+		i += _utf32_ascii_map_case(dst + i, len - i, 'A', 'Z', 'a' - 'A');
+		for (; i < len && dst[i] > 0x7f; i++) {
+			dst[i] = _find_lower(dst[i]);
 		}
 	}
 
@@ -1854,14 +2084,17 @@ Error String::parse_utf8(const char *p_utf8, int p_len, bool p_skip_cr) {
 	int cstr_size = 0;
 	int str_size = 0;
 
+	// Decoding stops at the first NUL either way, knowing the length lets the ASCII runs be scanned in bulk.
+	if (p_len < 0) {
+		p_len = strlen(p_utf8);
+	}
+
 	/* HANDLE BOM (Byte Order Mark) */
-	if (p_len < 0 || p_len >= 3) {
+	if (p_len >= 3) {
 		bool has_bom = uint8_t(p_utf8[0]) == 0xef && uint8_t(p_utf8[1]) == 0xbb && uint8_t(p_utf8[2]) == 0xbf;
 		if (has_bom) {
 			//8-bit encoding, byte order has no meaning in UTF-8, just skip it
-			if (p_len >= 0) {
-				p_len -= 3;
-			}
+			p_len -= 3;
 			p_utf8 += 3;
 		}
 	}
@@ -1870,7 +2103,7 @@ Error String::parse_utf8(const char *p_utf8, int p_len, bool p_skip_cr) {
 	bool decode_failed = false;
 	{
 		const char *ptrtmp = p_utf8;
-		const char *ptrtmp_limit = p_len >= 0 ? &p_utf8[p_len] : nullptr;
+		const char *ptrtmp_limit = &p_utf8[p_len];
 		int skip = 0;
 		uint8_t c_start = 0;
 		while (ptrtmp != ptrtmp_limit && *ptrtmp) {
@@ -1885,6 +2118,13 @@ Error String::parse_utf8(const char *p_utf8, int p_len, bool p_skip_cr) {
 					ptrtmp++;
 					continue;
 				}
+				if (c < 0x80) {
+					const int run = _utf8_ascii_run((const uint8_t *)ptrtmp, ptrtmp_limit - ptrtmp, p_skip_cr);
+					str_size += run;
+					cstr_size += run;
+					ptrtmp += run;
+					continue;
+				}
 				/* Determine the number of characters in sequence */
 				if ((c & 0x80) == 0) {
 					skip = 0;
@@ -1959,9 +2199,15 @@ Error String::parse_utf8(const char *p_utf8, int p_len, bool p_skip_cr) {
 			}
 			/* Determine the number of characters in sequence */
 			if ((c & 0x80) == 0) {
-				*(dst++) = c;
+				// The run can't include a carriage return, so it's within what the first pass counted.
+				const int run = _utf8_ascii_run((const uint8_t *)p_utf8, cstr_size, p_skip_cr);
+				_utf8_ascii_widen((const uint8_t *)p_utf8, dst, run);
+				dst += run;
+				p_utf8 += run;
+				cstr_size -= run;
 				unichar = 0;
 				skip = 0;
+				continue;
 			} else if ((c & 0xe0) == 0xc0) {
 				unichar = (0xff >> 3) & c;
 				skip = 1;
@@ -2035,7 +2281,9 @@ CharString String::utf8() const {
 	for (int i = 0; i < l; i++) {
 		uint32_t c = d[i];
 		if (c <= 0x7f) { // 7 bits.
-			fl += 1;
+			const int run = _utf32_ascii_run(&d[i], l - i);
+			fl += run;
+			i += run - 1;
 		} else if (c <= 0x7ff) { // 11 bits
 			fl += 2;
 		} else if (c <= 0xffff) { // 16 bits
@@ -2068,7 +2316,10 @@ CharString String::utf8() const {
 		uint32_t c = d[i];
 
 		if (c <= 0x7f) { // 7 bits.
-			APPEND_CHAR(c);
+			const int run = _utf32_ascii_run(&d[i], l - i);
+			_utf32_ascii_narrow(&d[i], cdst, run);
+			cdst += run;
+			i += run - 1;
 		} else if (c <= 0x7ff) { // 11 bits
 			APPEND_CHAR(uint32_t(0xc0 | ((c >> 6) & 0x1f))); // Top 5 bits.
 			APPEND_CHAR(uint32_t(0x80 | (c & 0x3f))); // Bottom 6 bits.
@@ -3062,17 +3313,17 @@ int String::find(const String &p_str, int p_from) const {
 	const char32_t *src = get_data();
 	const char32_t *str = p_str.get_data();
 
-	for (int i = p_from; i <= (len - src_len); i++) {
-		bool found = true;
-		for (int j = 0; j < src_len; j++) {
-			int read_pos = i + j;
-
-			if (read_pos >= len) {
-				ERR_PRINT("read_pos>=len");
-				return -1;
-			}
+	// Jump between occurrences of the first character, and only compare the rest there.
+	const int last = len - src_len;
+	for (int i = p_from; i <= last; i++) {
+		i = _utf32_find_char(src, i, last + 1, str[0]);
+		if (i < 0) {
+			break;
+		}
 
-			if (src[read_pos] != str[j]) {
+		bool found = true;
+		for (int j = 1; j < src_len; j++) {
+			if (src[i + j] != str[j]) {
 				found = false;
 				break;
 			}
@@ -3104,35 +3355,30 @@ int String::find(const char *p_str, int p_from) const {
 		src_len++;
 	}
 
+	if (src_len == 0) {
+		return p_from <= len ? p_from : -1;
+	}
 	if (src_len == 1) {
-		const char32_t needle = p_str[0];
+		return p_from < len ? _utf32_find_char(src, p_from, len, (char32_t)p_str[0]) : -1;
+	}
 
-		for (int i = p_from; i < len; i++) {
-			if (src[i] == needle) {
-				return i;
-			}
+	const int last = len - src_len;
+	for (int i = p_from; i <= last; i++) {
+		i = _utf32_find_char(src, i, last + 1, (char32_t)p_str[0]);
+		if (i < 0) {
+			break;
 		}
 
-	} else {
-		for (int i = p_from; i <= (len - src_len); i++) {
-			bool found = true;
-			for (int j = 0; j < src_len; j++) {
-				int read_pos = i + j;
-
-				if (read_pos >= len) {
-					ERR_PRINT("read_pos>=len");
-					return -1;
-				}
-
-				if (src[read_pos] != (char32_t)p_str[j]) {
-					found = false;
-					break;
-				}
+		bool found = true;
+		for (int j = 1; j < src_len; j++) {
+			if (src[i + j] != (char32_t)p_str[j]) {
+				found = false;
+				break;
 			}
+		}
 
-			if (found) {
-				return i;
-			}
+		if (found) {
+			return i;
 		}
 	}
 
@@ -3140,7 +3386,12 @@ int String::find(const char *p_str, int p_from) const {
 }
 
 int String::find_char(const char32_t &p_char, int p_from) const {
-	return _cowdata.find(p_char, p_from);
+	// Searches the terminator too, like CowData::find() did.
+	const int size = _cowdata.size();
+	if (p_from < 0 || p_from >= size) {
+		return -1;
+	}
+	return _utf32_find_char(_cowdata.ptr(), p_from, size, p_char);
 }
 
 int String::findmk(const Vector<String> &p_keys, int p_from, int *r_key) const {
@@ -0,0 +1,613 @@
+/**************************************************************************/
+/*  dense_hash_map.h                                                      */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef DENSE_HASH_MAP_H
+#define DENSE_HASH_MAP_H
+
+#include "core/os/memory.h"
+#include "core/templates/hashfuncs.h"
+#include "core/templates/pair.h"
+
+/**
+ * A HashMap variant that stores its entries contiguously, in insertion order,
+ * with a separate index using open addressing and Robin Hood hashing (the same
+ * probing as HashMap).
+ *
+ * Compared to HashMap, inserting doesn't allocate an element, and iterating is
+ * a linear walk over an array. In exchange:
+ * - Erasing moves the last entry into the erased entry's place, so the order
+ *   is only kept until something is erased.
+ * - Pointers and iterators to entries are invalidated when the map grows or
+ *   when an entry is erased.
+ * - Inserting at the front is not supported.
+ *
+ * The assignment operator copies the pairs from one map to the other.
+ */
+
+template <typename TKey, typename TValue,
+		typename Hasher = HashMapHasherDefault,
+		typename Comparator = HashMapComparatorDefault<TKey>>
+class DenseHashMap {
+public:
+	static constexpr uint32_t MIN_CAPACITY_INDEX = 2; // Use a prime.
+	static constexpr float MAX_OCCUPANCY = 0.75;
+	static constexpr uint32_t EMPTY_HASH = 0;
+
+private:
+	typedef KeyValue<TKey, TValue> Element;
+
+	Element *elements = nullptr;
+	uint32_t *hashes = nullptr;
+	uint32_t *indices = nullptr; // Index in elements, for each used slot in hashes.
+
+	uint32_t capacity_index = 0;
+	uint32_t num_elements = 0;
+
+	_FORCE_INLINE_ uint32_t _hash(const TKey &p_key) const {
+		uint32_t hash = Hasher::hash(p_key);
+
+		if (unlikely(hash == EMPTY_HASH)) {
+			hash = EMPTY_HASH + 1;
+		}
+
+		return hash;
+	}
+
+	static _FORCE_INLINE_ uint32_t _get_probe_length(const uint32_t p_pos, const uint32_t p_hash, const uint32_t p_capacity, const uint64_t p_capacity_inv) {
+		const uint32_t original_pos = fastmod(p_hash, p_capacity_inv, p_capacity);
+		return fastmod(p_pos - original_pos + p_capacity, p_capacity_inv, p_capacity);
+	}
+
+	static _FORCE_INLINE_ uint32_t _get_element_capacity(uint32_t p_capacity_index) {
+		return MAX_OCCUPANCY * hash_table_size_primes[p_capacity_index];
+	}
+
+	bool _lookup_pos(const TKey &p_key, uint32_t &r_pos) const {
+		if (hashes == nullptr || num_elements == 0) {
+			return false; // Failed lookups, no elements
+		}
+
+		const uint32_t capacity = hash_table_size_primes[capacity_index];
+		const uint64_t capacity_inv = hash_table_size_primes_inv[capacity_index];
+		uint32_t hash = _hash(p_key);
+		uint32_t pos = fastmod(hash, capacity_inv, capacity);
+		uint32_t distance = 0;
+
+		while (true) {
+			if (hashes[pos] == EMPTY_HASH) {
+				return false;
+			}
+
+			if (distance > _get_probe_length(pos, hashes[pos], capacity, capacity_inv)) {
+				return false;
+			}
+
+			if (hashes[pos] == hash && Comparator::compare(elements[indices[pos]].key, p_key)) {
+				r_pos = pos;
+				return true;
+			}
+
+			pos = fastmod((pos + 1), capacity_inv, capacity);
+			distance++;
+		}
+	}
+
+	void _insert_with_hash(uint32_t p_hash, uint32_t p_index) {
+		const uint32_t capacity = hash_table_size_primes[capacity_index];
+		const uint64_t capacity_inv = hash_table_size_primes_inv[capacity_index];
+		uint32_t hash = p_hash;
+		uint32_t index = p_index;
+		uint32_t distance = 0;
+		uint32_t pos = fastmod(hash, capacity_inv, capacity);
+
+		while (true) {
+			if (hashes[pos] == EMPTY_HASH) {
+				hashes[pos] = hash;
+				indices[pos] = index;
+				return;
+			}
+
+			// Not an empty slot, let's check the probing length of the existing one.
+			uint32_t existing_probe_len = _get_probe_length(pos, hashes[pos], capacity, capacity_inv);
+			if (existing_probe_len < distance) {
+				SWAP(hash, hashes[pos]);
+				SWAP(index, indices[pos]);
+				distance = existing_probe_len;
+			}
+
+			pos = fastmod((pos + 1), capacity_inv, capacity);
+			distance++;
+		}
+	}
+
+	// Empties a slot, shifting the following ones back so lookups don't need tombstones.
+	void _remove_slot(uint32_t p_pos) {
+		const uint32_t capacity = hash_table_size_primes[capacity_index];
+		const uint64_t capacity_inv = hash_table_size_primes_inv[capacity_index];
+		uint32_t pos = p_pos;
+		uint32_t next_pos = fastmod((pos + 1), capacity_inv, capacity);
+		while (hashes[next_pos] != EMPTY_HASH && _get_probe_length(next_pos, hashes[next_pos], capacity, capacity_inv) != 0) {
+			SWAP(hashes[next_pos], hashes[pos]);
+			SWAP(indices[next_pos], indices[pos]);
+			pos = next_pos;
+			next_pos = fastmod((pos + 1), capacity_inv, capacity);
+		}
+
+		hashes[pos] = EMPTY_HASH;
+	}
+
+	uint32_t _find_slot_of_index(uint32_t p_index) const {
+		const uint32_t capacity = hash_table_size_primes[capacity_index];
+		const uint64_t capacity_inv = hash_table_size_primes_inv[capacity_index];
+		const uint32_t hash = _hash(elements[p_index].key);
+		uint32_t pos = fastmod(hash, capacity_inv, capacity);
+		while (hashes[pos] != hash || indices[pos] != p_index) {
+			pos = fastmod((pos + 1), capacity_inv, capacity);
+		}
+		return pos;
+	}
+
+	void _resize_and_rehash(uint32_t p_new_capacity_index) {
+		uint32_t old_capacity = hash_table_size_primes[capacity_index];
+
+		// Capacity can't be 0.
+		capacity_index = MAX((uint32_t)MIN_CAPACITY_INDEX, p_new_capacity_index);
+
+		uint32_t capacity = hash_table_size_primes[capacity_index];
+
+		uint32_t *old_hashes = hashes;
+		uint32_t *old_indices = indices;
+
+		// Entries are moved bitwise, like LocalVector does.
+		elements = reinterpret_cast<Element *>(Memory::realloc_static(elements, sizeof(Element) * _get_element_capacity(capacity_index)));
+		hashes = reinterpret_cast<uint32_t *>(Memory::alloc_static(sizeof(uint32_t) * capacity));
+		indices = reinterpret_cast<uint32_t *>(Memory::alloc_static(sizeof(uint32_t) * capacity));
+
+		for (uint32_t i = 0; i < capacity; i++) {
+			hashes[i] = EMPTY_HASH;
+		}
+
+		if (old_hashes == nullptr) {
+			// Nothing to do.
+			return;
+		}
+
+		for (uint32_t i = 0; i < old_capacity; i++) {
+			if (old_hashes[i] == EMPTY_HASH) {
+				continue;
+			}
+
+			_insert_with_hash(old_hashes[i], old_indices[i]);
+		}
+
+		Memory::free_static(old_hashes);
+		Memory::free_static(old_indices);
+	}
+
+	_FORCE_INLINE_ bool _is_full() const {
+		return hashes == nullptr || num_elements + 1 > _get_element_capacity(capacity_index);
+	}
+
+	void _grow() {
+		if (hashes == nullptr) {
+			// Allocate on demand to save memory.
+			_resize_and_rehash(capacity_index);
+		} else {
+			ERR_FAIL_COND_MSG(capacity_index + 1 == HASH_TABLE_SIZE_MAX, "Hash table maximum capacity reached, aborting insertion.");
+			_resize_and_rehash(capacity_index + 1);
+		}
+	}
+
+	_FORCE_INLINE_ uint32_t _insert_new(const TKey &p_key, const TValue &p_value) {
+		if (unlikely(_is_full())) {
+			// The key or value may be an element of this map, which growing moves. Copy them first.
+			const TKey key = p_key;
+			const TValue value = p_value;
+			_grow();
+			return _construct_new(key, value);
+		}
+		return _construct_new(p_key, p_value);
+	}
+
+	_FORCE_INLINE_ uint32_t _construct_new(const TKey &p_key, const TValue &p_value) {
+		const uint32_t index = num_elements;
+		memnew_placement(&elements[index], Element(p_key, p_value));
+		_insert_with_hash(_hash(p_key), index);
+		num_elements++;
+		return index;
+	}
+
+	_FORCE_INLINE_ uint32_t _insert(const TKey &p_key, const TValue &p_value) {
+		uint32_t pos = 0;
+		if (_lookup_pos(p_key, pos)) {
+			elements[indices[pos]].value = p_value;
+			return indices[pos];
+		}
+		return _insert_new(p_key, p_value);
+	}
+
+public:
+	_FORCE_INLINE_ uint32_t get_capacity() const { return hash_table_size_primes[capacity_index]; }
+	_FORCE_INLINE_ uint32_t size() const { return num_elements; }
+
+	/* Standard Godot Container API */
+
+	bool is_empty() const {
+		return num_elements == 0;
+	}
+
+	void clear() {
+		if (hashes == nullptr || num_elements == 0) {
+			return;
+		}
+		uint32_t capacity = hash_table_size_primes[capacity_index];
+		for (uint32_t i = 0; i < capacity; i++) {
+			hashes[i] = EMPTY_HASH;
+		}
+
+		if constexpr (!std::is_trivially_destructible_v<Element>) {
+			for (uint32_t i = 0; i < num_elements; i++) {
+				elements[i].~Element();
+			}
+		}
+
+		num_elements = 0;
+	}
+
+	TValue &get(const TKey &p_key) {
+		uint32_t pos = 0;
+		bool exists = _lookup_pos(p_key, pos);
+		CRASH_COND_MSG(!exists, "DenseHashMap key not found.");
+		return elements[indices[pos]].value;
+	}
+
+	const TValue &get(const TKey &p_key) const {
+		uint32_t pos = 0;
+		bool exists = _lookup_pos(p_key, pos);
+		CRASH_COND_MSG(!exists, "DenseHashMap key not found.");
+		return elements[indices[pos]].value;
+	}
+
+	const TValue *getptr(const TKey &p_key) const {
+		uint32_t pos = 0;
+		bool exists = _lookup_pos(p_key, pos);
+
+		if (exists) {
+			return &elements[indices[pos]].value;
+		}
+		return nullptr;
+	}
+
+	TValue *getptr(const TKey &p_key) {
+		uint32_t pos = 0;
+		bool exists = _lookup_pos(p_key, pos);
+
+		if (exists) {
+			return &elements[indices[pos]].value;
+		}
+		return nullptr;
+	}
+
+	_FORCE_INLINE_ bool has(const TKey &p_key) const {
+		uint32_t _pos = 0;
+		return _lookup_pos(p_key, _pos);
+	}
+
+	bool erase(const TKey &p_key) {
+		uint32_t pos = 0;
+		bool exists = _lookup_pos(p_key, pos);
+
+		if (!exists) {
+			return false;
+		}
+
+		const uint32_t index = indices[pos];
+		const uint32_t last = num_elements - 1;
+		_remove_slot(pos);
+
+		elements[index].~Element();
+		if (index != last) {
+			// Fill the hole with the last entry, so entries stay contiguous.
+			indices[_find_slot_of_index(last)] = index;
+			memcpy((void *)&elements[index], (const void *)&elements[last], sizeof(Element));
+		}
+
+		num_elements--;
+		return true;
+	}
+
+	// Replace the key of an entry in-place, without invalidating iterators or changing the entries position during iteration.
+	// p_old_key must exist in the map and p_new_key must not, unless it is equal to p_old_key.
+	bool replace_key(const TKey &p_old_key, const TKey &p_new_key) {
+		if (p_old_key == p_new_key) {
+			return true;
+		}
+		uint32_t pos = 0;
+		ERR_FAIL_COND_V(_lookup_pos(p_new_key, pos), false);
+		ERR_FAIL_COND_V(!_lookup_pos(p_old_key, pos), false);
+		const uint32_t index = indices[pos];
+		_remove_slot(pos);
+
+		const_cast<TKey &>(elements[index].key) = p_new_key;
+		_insert_with_hash(_hash(p_new_key), index);
+
+		return true;
+	}
+
+	// Reserves space for a number of elements, useful to avoid many resizes and rehashes.
+	// If adding a known (possibly large) number of elements at once, must be larger than old capacity.
+	void reserve(uint32_t p_new_capacity) {
+		uint32_t new_index = capacity_index;
+
+		while (_get_element_capacity(new_index) < p_new_capacity) {
+			ERR_FAIL_COND_MSG(new_index + 1 == (uint32_t)HASH_TABLE_SIZE_MAX, nullptr);
+			new_index++;
+		}
+
+		if (new_index == capacity_index) {
+			return;
+		}
+
+		if (hashes == nullptr) {
+			capacity_index = new_index;
+			return; // Unallocated yet.
+		}
+		_resize_and_rehash(new_index);
+	}
+
+	/** Iterator API **/
+
+	struct ConstIterator {
+		_FORCE_INLINE_ const KeyValue<TKey, TValue> &operator*() const {
+			return *E;
+		}
+		_FORCE_INLINE_ const KeyValue<TKey, TValue> *operator->() const { return E; }
+		_FORCE_INLINE_ ConstIterator &operator++() {
+			if (E) {
+				E = (E + 1 == end) ? nullptr : E + 1;
+			}
+			return *this;
+		}
+		_FORCE_INLINE_ ConstIterator &operator--() {
+			if (E) {
+				E = (E == begin) ? nullptr : E - 1;
+			}
+			return *this;
+		}
+
+		_FORCE_INLINE_ bool operator==(const ConstIterator &b) const { return E == b.E; }
+		_FORCE_INLINE_ bool operator!=(const ConstIterator &b) const { return E != b.E; }
+
+		_FORCE_INLINE_ explicit operator bool() const {
+			return E != nullptr;
+		}
+
+		_FORCE_INLINE_ ConstIterator(const KeyValue<TKey, TValue> *p_E, const KeyValue<TKey, TValue> *p_begin, const KeyValue<TKey, TValue> *p_end) {
+			E = p_E;
+			begin = p_begin;
+			end = p_end;
+		}
+		_FORCE_INLINE_ ConstIterator() {}
+
+	private:
+		const KeyValue<TKey, TValue> *E = nullptr;
+		const KeyValue<TKey, TValue> *begin = nullptr;
+		const KeyValue<TKey, TValue> *end = nullptr;
+	};
+
+	struct Iterator {
+		_FORCE_INLINE_ KeyValue<TKey, TValue> &operator*() const {
+			return *E;
+		}
+		_FORCE_INLINE_ KeyValue<TKey, TValue> *operator->() const { return E; }
+		_FORCE_INLINE_ Iterator &operator++() {
+			if (E) {
+				E = (E + 1 == end) ? nullptr : E + 1;
+			}
+			return *this;
+		}
+		_FORCE_INLINE_ Iterator &operator--() {
+			if (E) {
+				E = (E == begin) ? nullptr : E - 1;
+			}
+			return *this;
+		}
+
+		_FORCE_INLINE_ bool operator==(const Iterator &b) const { return E == b.E; }
+		_FORCE_INLINE_ bool operator!=(const Iterator &b) const { return E != b.E; }
+
+		_FORCE_INLINE_ explicit operator bool() const {
+			return E != nullptr;
+		}
+
+		_FORCE_INLINE_ Iterator(KeyValue<TKey, TValue> *p_E, KeyValue<TKey, TValue> *p_begin, KeyValue<TKey, TValue> *p_end) {
+			E = p_E;
+			begin = p_begin;
+			end = p_end;
+		}
+		_FORCE_INLINE_ Iterator() {}
+
+		operator ConstIterator() const {
+			return ConstIterator(E, begin, end);
+		}
+
+	private:
+		KeyValue<TKey, TValue> *E = nullptr;
+		KeyValue<TKey, TValue> *begin = nullptr;
+		KeyValue<TKey, TValue> *end = nullptr;
+	};
+
+	_FORCE_INLINE_ Iterator begin() {
+		return _iterator_at(0);
+	}
+	_FORCE_INLINE_ Iterator end() {
+		return Iterator();
+	}
+	_FORCE_INLINE_ Iterator last() {
+		return _iterator_at(num_elements - 1);
+	}
+
+	_FORCE_INLINE_ Iterator find(const TKey &p_key) {
+		uint32_t pos = 0;
+		bool exists = _lookup_pos(p_key, pos);
+		if (!exists) {
+			return end();
+		}
+		return _iterator_at(indices[pos]);
+	}
+
+	// Erasing moves the last entry into the erased one's place, iterators to it are not valid afterwards.
+	_FORCE_INLINE_ void remove(const Iterator &p_iter) {
+		if (p_iter) {
+			erase(p_iter->key);
+		}
+	}
+
+	_FORCE_INLINE_ ConstIterator begin() const {
+		return _const_iterator_at(0);
+	}
+	_FORCE_INLINE_ ConstIterator end() const {
+		return ConstIterator();
+	}
+	_FORCE_INLINE_ ConstIterator last() const {
+		return _const_iterator_at(num_elements - 1);
+	}
+
+	_FORCE_INLINE_ ConstIterator find(const TKey &p_key) const {
+		uint32_t pos = 0;
+		bool exists = _lookup_pos(p_key, pos);
+		if (!exists) {
+			return end();
+		}
+		return _const_iterator_at(indices[pos]);
+	}
+
+	/* Indexing */
+
+	const TValue &operator[](const TKey &p_key) const {
+		uint32_t pos = 0;
+		bool exists = _lookup_pos(p_key, pos);
+		CRASH_COND(!exists);
+		return elements[indices[pos]].value;
+	}
+
+	TValue &operator[](const TKey &p_key) {
+		uint32_t pos = 0;
+		bool exists = _lookup_pos(p_key, pos);
+		if (!exists) {
+			// Insert first, it may reallocate the elements.
+			const uint32_t index = _insert_new(p_key, TValue());
+			return elements[index].value;
+		} else {
+			return elements[indices[pos]].value;
+		}
+	}
+
+	/* Insert */
+
+	Iterator insert(const TKey &p_key, const TValue &p_value) {
+		return _iterator_at(_insert(p_key, p_value));
+	}
+
+	// Skips the lookup, p_key must not be in the map already.
+	Iterator insert_new(const TKey &p_key, const TValue &p_value) {
+		DEV_ASSERT(!has(p_key));
+		return _iterator_at(_insert_new(p_key, p_value));
+	}
+
+	// Inserts all entries of another map (anything with size() that iterates over KeyValue) with at most one resize.
+	// Existing keys are overwritten.
+	template <typename TMap>
+	void insert_all(const TMap &p_map) {
+		reserve(num_elements + p_map.size());
+		for (const KeyValue<TKey, TValue> &E : p_map) {
+			_insert(E.key, E.value);
+		}
+	}
+
+	/* Constructors */
+
+	DenseHashMap(const DenseHashMap &p_other) {
+		capacity_index = MIN_CAPACITY_INDEX;
+		reserve(p_other.num_elements);
+		for (uint32_t i = 0; i < p_other.num_elements; i++) {
+			_insert_new(p_other.elements[i].key, p_other.elements[i].value);
+		}
+	}
+
+	void operator=(const DenseHashMap &p_other) {
+		if (this == &p_other) {
+			return; // Ignore self assignment.
+		}
+		if (num_elements != 0) {
+			clear();
+		}
+
+		reserve(p_other.num_elements);
+		for (uint32_t i = 0; i < p_other.num_elements; i++) {
+			_insert_new(p_other.elements[i].key, p_other.elements[i].value);
+		}
+	}
+
+	DenseHashMap(uint32_t p_initial_capacity) {
+		// Capacity can't be 0.
+		capacity_index = MIN_CAPACITY_INDEX;
+		reserve(p_initial_capacity);
+	}
+	DenseHashMap() {
+		capacity_index = MIN_CAPACITY_INDEX;
+	}
+
+	~DenseHashMap() {
+		clear();
+
+		if (hashes != nullptr) {
+			Memory::free_static(elements);
+			Memory::free_static(hashes);
+			Memory::free_static(indices);
+		}
+	}
+
+private:
+	_FORCE_INLINE_ Iterator _iterator_at(uint32_t p_index) {
+		if (p_index >= num_elements) {
+			return Iterator();
+		}
+		return Iterator(elements + p_index, elements, elements + num_elements);
+	}
+	_FORCE_INLINE_ ConstIterator _const_iterator_at(uint32_t p_index) const {
+		if (p_index >= num_elements) {
+			return ConstIterator();
+		}
+		return ConstIterator(elements + p_index, elements, elements + num_elements);
+	}
+};
+
+#endif // DENSE_HASH_MAP_H
@@ -40,6 +40,7 @@
 #include "core/templates/rid.h"
 #include "core/templates/safe_refcount.h"
 
+#include <atomic>
 #include <stdio.h>
 #include <typeinfo>
 
@@ -69,72 +70,130 @@ public:
 
 template <typename T, bool THREAD_SAFE = false>
 class RID_Alloc : public RID_AllocBase {
-	T **chunks = nullptr;
+	struct Chunk {
+		T *data;
+		// The high bit marks an allocated but uninitialized element, all bits set mark a free one.
+		std::atomic<uint32_t> *validators;
+	};
+
+	// In thread safe mode only allocating and freeing take the lock, lookups just load max_alloc, the chunk
+	// array and the validator. Chunks never move once allocated, and a full chunk array is replaced by a larger
+	// copy instead of being reallocated. The replaced arrays are kept until destruction, so any array a reader
+	// loaded still points to every chunk below the max_alloc it loaded before.
+	std::atomic<Chunk *> chunks = { nullptr };
+	uint32_t chunk_capacity = 0;
+	Chunk **retired_chunks = nullptr;
+	uint32_t retired_chunk_count = 0;
 	uint32_t **free_list_chunks = nullptr;
-	uint32_t **validator_chunks = nullptr;
 
 	uint32_t elements_in_chunk;
-	uint32_t max_alloc = 0;
+	std::atomic<uint32_t> max_alloc = { 0 };
 	uint32_t alloc_count = 0;
 
 	const char *description = nullptr;
 
 	mutable SpinLock spin_lock;
 
-	_FORCE_INLINE_ RID _allocate_rid() {
-		if (THREAD_SAFE) {
-			spin_lock.lock();
-		}
-
-		if (alloc_count == max_alloc) {
-			//allocate a new chunk
-			uint32_t chunk_count = alloc_count == 0 ? 0 : (max_alloc / elements_in_chunk);
+	static constexpr std::memory_order ACQUIRE = THREAD_SAFE ? std::memory_order_acquire : std::memory_order_relaxed;
+	static constexpr std::memory_order RELEASE = THREAD_SAFE ? std::memory_order_release : std::memory_order_relaxed;
 
-			//grow chunks
-			chunks = (T **)memrealloc(chunks, sizeof(T *) * (chunk_count + 1));
-			chunks[chunk_count] = (T *)memalloc(sizeof(T) * elements_in_chunk); //but don't initialize
+	void _grow() {
+		uint32_t current_max = max_alloc.load(std::memory_order_relaxed);
+		uint32_t chunk_count = current_max / elements_in_chunk;
+		Chunk *chunk_array = chunks.load(std::memory_order_relaxed);
 
-			//grow validators
-			validator_chunks = (uint32_t **)memrealloc(validator_chunks, sizeof(uint32_t *) * (chunk_count + 1));
-			validator_chunks[chunk_count] = (uint32_t *)memalloc(sizeof(uint32_t) * elements_in_chunk);
-			//grow free lists
-			free_list_chunks = (uint32_t **)memrealloc(free_list_chunks, sizeof(uint32_t *) * (chunk_count + 1));
-			free_list_chunks[chunk_count] = (uint32_t *)memalloc(sizeof(uint32_t) * elements_in_chunk);
-
-			//initialize
-			for (uint32_t i = 0; i < elements_in_chunk; i++) {
-				// Don't initialize chunk.
-				validator_chunks[chunk_count][i] = 0xFFFFFFFF;
-				free_list_chunks[chunk_count][i] = alloc_count + i;
+		if (chunk_count == chunk_capacity) {
+			//grow chunk array
+			uint32_t new_capacity = chunk_capacity ? chunk_capacity * 2 : 1;
+			Chunk *new_array = (Chunk *)memalloc(sizeof(Chunk) * new_capacity);
+			if (chunk_array) {
+				memcpy(new_array, chunk_array, sizeof(Chunk) * chunk_count);
+				if (THREAD_SAFE) {
+					retired_chunks = (Chunk **)memrealloc(retired_chunks, sizeof(Chunk *) * (retired_chunk_count + 1));
+					retired_chunks[retired_chunk_count++] = chunk_array;
+				} else {
+					memfree(chunk_array);
+				}
 			}
+			chunk_array = new_array;
+			chunk_capacity = new_capacity;
 
-			max_alloc += elements_in_chunk;
+			//grow free lists
+			free_list_chunks = (uint32_t **)memrealloc(free_list_chunks, sizeof(uint32_t *) * new_capacity);
 		}
 
-		uint32_t free_index = free_list_chunks[alloc_count / elements_in_chunk][alloc_count % elements_in_chunk];
+		Chunk &chunk = chunk_array[chunk_count];
+		chunk.data = (T *)memalloc(sizeof(T) * elements_in_chunk); //but don't initialize
+		chunk.validators = (std::atomic<uint32_t> *)memalloc(sizeof(std::atomic<uint32_t>) * elements_in_chunk);
+		free_list_chunks[chunk_count] = (uint32_t *)memalloc(sizeof(uint32_t) * elements_in_chunk);
 
-		uint32_t free_chunk = free_index / elements_in_chunk;
-		uint32_t free_element = free_index % elements_in_chunk;
+		//initialize
+		for (uint32_t i = 0; i < elements_in_chunk; i++) {
+			// Don't initialize chunk.
+			memnew_placement(&chunk.validators[i], std::atomic<uint32_t>(0xFFFFFFFF));
+			free_list_chunks[chunk_count][i] = current_max + i;
+		}
 
+		// Readers check max_alloc first, so the chunk must be visible before it grows.
+		chunks.store(chunk_array, RELEASE);
+		max_alloc.store(current_max + elements_in_chunk, RELEASE);
+	}
+
+	_FORCE_INLINE_ RID _allocate_rid() {
 		uint32_t validator = (uint32_t)(_gen_id() & 0x7FFFFFFF);
 		CRASH_COND_MSG(validator == 0x7FFFFFFF, "Overflow in RID validator");
-		uint64_t id = validator;
-		id <<= 32;
-		id |= free_index;
 
-		validator_chunks[free_chunk][free_element] = validator;
+		if (THREAD_SAFE) {
+			spin_lock.lock();
+		}
 
-		validator_chunks[free_chunk][free_element] |= 0x80000000; //mark uninitialized bit
+		if (alloc_count == max_alloc.load(std::memory_order_relaxed)) {
+			_grow();
+		}
 
+		uint32_t free_index = free_list_chunks[alloc_count / elements_in_chunk][alloc_count % elements_in_chunk];
 		alloc_count++;
 
+		const Chunk &chunk = chunks.load(std::memory_order_relaxed)[free_index / elements_in_chunk];
+
 		if (THREAD_SAFE) {
 			spin_lock.unlock();
 		}
 
+		// The index is ours once popped from the free list, and the chunk array loaded under the lock stays valid.
+		chunk.validators[free_index % elements_in_chunk].store(validator | 0x80000000, RELEASE); //mark uninitialized bit
+
+		uint64_t id = validator;
+		id <<= 32;
+		id |= free_index;
 		return _make_from_id(id);
 	}
 
+	_FORCE_INLINE_ std::atomic<uint32_t> *_get_validator(uint32_t p_idx, T **r_data = nullptr) const {
+		if (unlikely(p_idx >= max_alloc.load(ACQUIRE))) {
+			return nullptr;
+		}
+		const Chunk &chunk = chunks.load(ACQUIRE)[p_idx / elements_in_chunk];
+		if (r_data) {
+			*r_data = &chunk.data[p_idx % elements_in_chunk];
+		}
+		return &chunk.validators[p_idx % elements_in_chunk];
+	}
+
+	// The element is only marked as initialized by initialize_rid() once constructed,
+	// so concurrent lookups never see it half built.
+	_FORCE_INLINE_ T *_get_uninitialized(const RID &p_rid, std::atomic<uint32_t> *&r_validator) {
+		uint64_t id = p_rid.get_id();
+		T *mem = nullptr;
+		r_validator = _get_validator(uint32_t(id & 0xFFFFFFFF), &mem);
+		ERR_FAIL_NULL_V(r_validator, nullptr);
+
+		uint32_t value = r_validator->load(ACQUIRE);
+		ERR_FAIL_COND_V_MSG(!(value & 0x80000000), nullptr, "Initializing already initialized RID");
+		ERR_FAIL_COND_V_MSG((value & 0x7FFFFFFF) != uint32_t(id >> 32), nullptr, "Attempting to initialize the wrong RID");
+		return mem;
+	}
+
 public:
 	RID make_rid() {
 		RID rid = _allocate_rid();
@@ -152,134 +211,83 @@ public:
 		return _allocate_rid();
 	}
 
-	_FORCE_INLINE_ T *get_or_null(const RID &p_rid, bool p_initialize = false) {
+	_FORCE_INLINE_ T *get_or_null(const RID &p_rid) {
 		if (p_rid == RID()) {
 			return nullptr;
 		}
-		if (THREAD_SAFE) {
-			spin_lock.lock();
-		}
 
 		uint64_t id = p_rid.get_id();
-		uint32_t idx = uint32_t(id & 0xFFFFFFFF);
-		if (unlikely(idx >= max_alloc)) {
-			if (THREAD_SAFE) {
-				spin_lock.unlock();
-			}
+		T *ptr = nullptr;
+		std::atomic<uint32_t> *current = _get_validator(uint32_t(id & 0xFFFFFFFF), &ptr);
+		if (unlikely(!current)) {
 			return nullptr;
 		}
 
-		uint32_t idx_chunk = idx / elements_in_chunk;
-		uint32_t idx_element = idx % elements_in_chunk;
-
 		uint32_t validator = uint32_t(id >> 32);
-
-		if (unlikely(p_initialize)) {
-			if (unlikely(!(validator_chunks[idx_chunk][idx_element] & 0x80000000))) {
-				if (THREAD_SAFE) {
-					spin_lock.unlock();
-				}
-				ERR_FAIL_V_MSG(nullptr, "Initializing already initialized RID");
-			}
-
-			if (unlikely((validator_chunks[idx_chunk][idx_element] & 0x7FFFFFFF) != validator)) {
-				if (THREAD_SAFE) {
-					spin_lock.unlock();
-				}
-				ERR_FAIL_V_MSG(nullptr, "Attempting to initialize the wrong RID");
-			}
-
-			validator_chunks[idx_chunk][idx_element] &= 0x7FFFFFFF; //initialized
-
-		} else if (unlikely(validator_chunks[idx_chunk][idx_element] != validator)) {
-			if (THREAD_SAFE) {
-				spin_lock.unlock();
-			}
-			if ((validator_chunks[idx_chunk][idx_element] & 0x80000000) && validator_chunks[idx_chunk][idx_element] != 0xFFFFFFFF) {
+		uint32_t value = current->load(ACQUIRE);
+		if (unlikely(value != validator)) {
+			// Only complain about the RID itself, a stale one may race with its slot being reallocated.
+			if ((value & 0x80000000) && value != 0xFFFFFFFF && (value & 0x7FFFFFFF) == validator) {
 				ERR_FAIL_V_MSG(nullptr, "Attempting to use an uninitialized RID");
 			}
 			return nullptr;
 		}
 
-		T *ptr = &chunks[idx_chunk][idx_element];
-
-		if (THREAD_SAFE) {
-			spin_lock.unlock();
-		}
-
 		return ptr;
 	}
 	void initialize_rid(RID p_rid) {
-		T *mem = get_or_null(p_rid, true);
+		std::atomic<uint32_t> *validator = nullptr;
+		T *mem = _get_uninitialized(p_rid, validator);
 		ERR_FAIL_NULL(mem);
 		memnew_placement(mem, T);
+		validator->store(uint32_t(p_rid.get_id() >> 32), RELEASE); //initialized
 	}
 	void initialize_rid(RID p_rid, const T &p_value) {
-		T *mem = get_or_null(p_rid, true);
+		std::atomic<uint32_t> *validator = nullptr;
+		T *mem = _get_uninitialized(p_rid, validator);
 		ERR_FAIL_NULL(mem);
 		memnew_placement(mem, T(p_value));
+		validator->store(uint32_t(p_rid.get_id() >> 32), RELEASE); //initialized
 	}
 
 	_FORCE_INLINE_ bool owns(const RID &p_rid) const {
-		if (THREAD_SAFE) {
-			spin_lock.lock();
-		}
-
 		uint64_t id = p_rid.get_id();
-		uint32_t idx = uint32_t(id & 0xFFFFFFFF);
-		if (unlikely(idx >= max_alloc)) {
-			if (THREAD_SAFE) {
-				spin_lock.unlock();
-			}
+		std::atomic<uint32_t> *current = _get_validator(uint32_t(id & 0xFFFFFFFF));
+		if (unlikely(!current)) {
 			return false;
 		}
 
-		uint32_t idx_chunk = idx / elements_in_chunk;
-		uint32_t idx_element = idx % elements_in_chunk;
-
 		uint32_t validator = uint32_t(id >> 32);
-
-		bool owned = (validator != 0x7FFFFFFF) && (validator_chunks[idx_chunk][idx_element] & 0x7FFFFFFF) == validator;
-
-		if (THREAD_SAFE) {
-			spin_lock.unlock();
-		}
-
-		return owned;
+		return (validator != 0x7FFFFFFF) && (current->load(ACQUIRE) & 0x7FFFFFFF) == validator;
 	}
 
 	_FORCE_INLINE_ void free(const RID &p_rid) {
-		if (THREAD_SAFE) {
-			spin_lock.lock();
-		}
-
 		uint64_t id = p_rid.get_id();
 		uint32_t idx = uint32_t(id & 0xFFFFFFFF);
-		if (unlikely(idx >= max_alloc)) {
-			if (THREAD_SAFE) {
-				spin_lock.unlock();
-			}
-			ERR_FAIL();
-		}
-
-		uint32_t idx_chunk = idx / elements_in_chunk;
-		uint32_t idx_element = idx % elements_in_chunk;
+		T *ptr = nullptr;
+		std::atomic<uint32_t> *current = _get_validator(idx, &ptr);
+		ERR_FAIL_NULL(current);
 
 		uint32_t validator = uint32_t(id >> 32);
-		if (unlikely(validator_chunks[idx_chunk][idx_element] & 0x80000000)) {
-			if (THREAD_SAFE) {
-				spin_lock.unlock();
-			}
+		uint32_t value = current->load(ACQUIRE);
+		if (unlikely(value & 0x80000000)) {
 			ERR_FAIL_MSG("Attempted to free an uninitialized or invalid RID.");
-		} else if (unlikely(validator_chunks[idx_chunk][idx_element] != validator)) {
-			if (THREAD_SAFE) {
-				spin_lock.unlock();
-			}
+		} else if (unlikely(value != validator)) {
 			ERR_FAIL();
 		}
 
-		chunks[idx_chunk][idx_element].~T();
-		validator_chunks[idx_chunk][idx_element] = 0xFFFFFFFF; // go invalid
+		// Going invalid before destruction keeps lookups away from the element, and in thread safe mode
+		// only one of several threads freeing the same RID gets past this point.
+		if (THREAD_SAFE) {
+			ERR_FAIL_COND(!current->compare_exchange_strong(value, 0xFFFFFFFF, std::memory_order_acq_rel));
+		} else {
+			current->store(0xFFFFFFFF, std::memory_order_relaxed);
+		}
+		ptr->~T();
+
+		if (THREAD_SAFE) {
+			spin_lock.lock();
+		}
 
 		alloc_count--;
 		free_list_chunks[alloc_count / elements_in_chunk][alloc_count % elements_in_chunk] = idx;
@@ -296,8 +304,10 @@ public:
 		if (THREAD_SAFE) {
 			spin_lock.lock();
 		}
-		for (size_t i = 0; i < max_alloc; i++) {
-			uint64_t validator = validator_chunks[i / elements_in_chunk][i % elements_in_chunk];
+		const Chunk *chunk_array = chunks.load(std::memory_order_relaxed);
+		uint32_t current_max = max_alloc.load(std::memory_order_relaxed);
+		for (size_t i = 0; i < current_max; i++) {
+			uint64_t validator = chunk_array[i / elements_in_chunk].validators[i % elements_in_chunk].load(ACQUIRE);
 			if (validator != 0xFFFFFFFF) {
 				p_owned->push_back(_make_from_id((validator << 32) | i));
 			}
@@ -312,9 +322,11 @@ public:
 		if (THREAD_SAFE) {
 			spin_lock.lock();
 		}
+		const Chunk *chunk_array = chunks.load(std::memory_order_relaxed);
+		uint32_t current_max = max_alloc.load(std::memory_order_relaxed);
 		uint32_t idx = 0;
-		for (size_t i = 0; i < max_alloc; i++) {
-			uint64_t validator = validator_chunks[i / elements_in_chunk][i % elements_in_chunk];
+		for (size_t i = 0; i < current_max; i++) {
+			uint64_t validator = chunk_array[i / elements_in_chunk].validators[i % elements_in_chunk].load(ACQUIRE);
 			if (validator != 0xFFFFFFFF) {
 				p_rid_buffer[idx] = _make_from_id((validator << 32) | i);
 				idx++;
@@ -334,32 +346,41 @@ public:
 	}
 
 	~RID_Alloc() {
+		Chunk *chunk_array = chunks.load(std::memory_order_acquire);
+		uint32_t current_max = max_alloc.load(std::memory_order_acquire);
+
 		if (alloc_count) {
 			print_error(vformat("ERROR: %d RID allocations of type '%s' were leaked at exit.",
 					alloc_count, description ? description : typeid(T).name()));
 
-			for (size_t i = 0; i < max_alloc; i++) {
-				uint64_t validator = validator_chunks[i / elements_in_chunk][i % elements_in_chunk];
+			for (size_t i = 0; i < current_max; i++) {
+				const Chunk &chunk = chunk_array[i / elements_in_chunk];
+				uint64_t validator = chunk.validators[i % elements_in_chunk].load(std::memory_order_relaxed);
 				if (validator & 0x80000000) {
 					continue; //uninitialized
 				}
 				if (validator != 0xFFFFFFFF) {
-					chunks[i / elements_in_chunk][i % elements_in_chunk].~T();
+					chunk.data[i % elements_in_chunk].~T();
 				}
 			}
 		}
 
-		uint32_t chunk_count = max_alloc / elements_in_chunk;
+		uint32_t chunk_count = current_max / elements_in_chunk;
 		for (uint32_t i = 0; i < chunk_count; i++) {
-			memfree(chunks[i]);
-			memfree(validator_chunks[i]);
+			memfree(chunk_array[i].data);
+			memfree(chunk_array[i].validators);
 			memfree(free_list_chunks[i]);
 		}
 
-		if (chunks) {
-			memfree(chunks);
+		if (chunk_array) {
+			memfree(chunk_array);
 			memfree(free_list_chunks);
-			memfree(validator_chunks);
+		}
+		for (uint32_t i = 0; i < retired_chunk_count; i++) {
+			memfree(retired_chunks[i]);
+		}
+		if (retired_chunks) {
+			memfree(retired_chunks);
 		}
 	}
 };
@@ -30,7 +30,7 @@
 
 #include "dictionary.h"
 
-#include "core/templates/hash_map.h"
+#include "core/templates/pair.h"
 #include "core/templates/safe_refcount.h"
 #include "core/variant/variant.h"
 // required in this order by VariantInternal, do not remove this comment.
@@ -39,10 +39,264 @@
 #include "core/variant/type_info.h"
 #include "core/variant/variant_internal.h"
 
+// Storage tuned for small dictionaries, which are the most common (a handful of keys).
+// Elements are allocated in chunks of growing size instead of one by one, and never move, so pointers to
+// keys and values stay valid while the dictionary grows, as they did with HashMap. Insertion order is kept
+// in a linked list. Up to LINEAR_LIMIT elements, lookups scan the list. Past that, an open addressing index is used.
+class CompactVariantMap {
+public:
+	struct Element {
+		KeyValue<Variant, Variant> data;
+		Element *prev = nullptr;
+		Element *next = nullptr;
+		uint32_t hash = 0;
+
+		Element(const Variant &p_key, uint32_t p_hash) :
+				data(p_key, Variant()), hash(p_hash) {}
+	};
+
+	struct Iterator {
+		Element *E = nullptr;
+
+		_FORCE_INLINE_ KeyValue<Variant, Variant> &operator*() const { return E->data; }
+		_FORCE_INLINE_ Iterator &operator++() {
+			E = E->next;
+			return *this;
+		}
+		_FORCE_INLINE_ bool operator!=(const Iterator &p_other) const { return E != p_other.E; }
+	};
+
+	struct ConstIterator {
+		const Element *E = nullptr;
+
+		_FORCE_INLINE_ const KeyValue<Variant, Variant> &operator*() const { return E->data; }
+		_FORCE_INLINE_ ConstIterator &operator++() {
+			E = E->next;
+			return *this;
+		}
+		_FORCE_INLINE_ bool operator!=(const ConstIterator &p_other) const { return E != p_other.E; }
+	};
+
+private:
+	static constexpr uint32_t LINEAR_LIMIT = 8;
+	static constexpr uint32_t FIRST_CHUNK_CAPACITY = 4;
+	static constexpr uint32_t MIN_INDEX_CAPACITY = 32;
+
+	struct Chunk {
+		Chunk *next = nullptr;
+		uint32_t capacity = 0;
+		uint32_t used = 0;
+	};
+
+	struct FreeSlot {
+		FreeSlot *next = nullptr;
+	};
+
+	static constexpr size_t CHUNK_DATA_OFFSET = (sizeof(Chunk) % alignof(Element) == 0) ? sizeof(Chunk) : (sizeof(Chunk) + alignof(Element) - (sizeof(Chunk) % alignof(Element)));
+
+	Chunk *chunks = nullptr; // Most recently allocated first.
+	FreeSlot *free_slots = nullptr;
+	Element *head = nullptr;
+	Element *tail = nullptr;
+	Element **index = nullptr;
+	uint32_t index_capacity = 0; // Always a power of two.
+	uint32_t num_elements = 0;
+
+	Element *_lookup(const Variant &p_key, uint32_t p_hash) const {
+		if (index) {
+			const uint32_t mask = index_capacity - 1;
+			for (uint32_t pos = p_hash & mask;; pos = (pos + 1) & mask) {
+				Element *E = index[pos];
+				if (!E) {
+					return nullptr;
+				}
+				if (E->hash == p_hash && StringLikeVariantComparator::compare(E->data.key, p_key)) {
+					return E;
+				}
+			}
+		}
+
+		for (Element *E = head; E; E = E->next) {
+			if (E->hash == p_hash && StringLikeVariantComparator::compare(E->data.key, p_key)) {
+				return E;
+			}
+		}
+		return nullptr;
+	}
+
+	void _index_add(Element *p_element) {
+		const uint32_t mask = index_capacity - 1;
+		uint32_t pos = p_element->hash & mask;
+		while (index[pos]) {
+			pos = (pos + 1) & mask;
+		}
+		index[pos] = p_element;
+	}
+
+	void _index_remove(Element *p_element) {
+		const uint32_t mask = index_capacity - 1;
+		uint32_t pos = p_element->hash & mask;
+		while (index[pos] != p_element) {
+			pos = (pos + 1) & mask;
+		}
+		index[pos] = nullptr;
+
+		// Backward shift deletion, so lookups don't need tombstones.
+		for (uint32_t next = (pos + 1) & mask; index[next]; next = (next + 1) & mask) {
+			const uint32_t ideal = index[next]->hash & mask;
+			if (((next - ideal) & mask) >= ((next - pos) & mask)) {
+				index[pos] = index[next];
+				index[next] = nullptr;
+				pos = next;
+			}
+		}
+	}
+
+	void _rebuild_index() {
+		if (index) {
+			Memory::free_static(index);
+		}
+		index_capacity = MIN_INDEX_CAPACITY;
+		while (index_capacity < num_elements * 2) {
+			index_capacity *= 2;
+		}
+		index = static_cast<Element **>(Memory::alloc_static(sizeof(Element *) * index_capacity));
+		memset(index, 0, sizeof(Element *) * index_capacity);
+
+		for (Element *E = head; E; E = E->next) {
+			_index_add(E);
+		}
+	}
+
+	Element *_insert(const Variant &p_key, uint32_t p_hash) {
+		void *mem = nullptr;
+		if (free_slots) {
+			mem = free_slots;
+			free_slots = free_slots->next;
+		} else {
+			if (!chunks || chunks->used == chunks->capacity) {
+				const uint32_t capacity = chunks ? chunks->capacity * 2 : FIRST_CHUNK_CAPACITY;
+				Chunk *chunk = static_cast<Chunk *>(Memory::alloc_static(CHUNK_DATA_OFFSET + sizeof(Element) * capacity));
+				memnew_placement(chunk, Chunk);
+				chunk->capacity = capacity;
+				chunk->next = chunks;
+				chunks = chunk;
+			}
+			mem = reinterpret_cast<uint8_t *>(chunks) + CHUNK_DATA_OFFSET + sizeof(Element) * chunks->used;
+			chunks->used++;
+		}
+
+		Element *E = memnew_placement(mem, Element(p_key, p_hash));
+		if (tail) {
+			tail->next = E;
+			E->prev = tail;
+		} else {
+			head = E;
+		}
+		tail = E;
+		num_elements++;
+
+		if (index && num_elements * 2 <= index_capacity) {
+			_index_add(E);
+		} else if (index || num_elements > LINEAR_LIMIT) {
+			_rebuild_index();
+		}
+		return E;
+	}
+
+public:
+	_FORCE_INLINE_ uint32_t size() const { return num_elements; }
+	_FORCE_INLINE_ bool is_empty() const { return num_elements == 0; }
+
+	_FORCE_INLINE_ Element *find(const Variant &p_key) { return _lookup(p_key, VariantHasher::hash(p_key)); }
+	_FORCE_INLINE_ const Element *find(const Variant &p_key) const { return _lookup(p_key, VariantHasher::hash(p_key)); }
+	_FORCE_INLINE_ bool has(const Variant &p_key) const { return find(p_key) != nullptr; }
+
+	Variant &operator[](const Variant &p_key) {
+		const uint32_t hash = VariantHasher::hash(p_key);
+		Element *E = _lookup(p_key, hash);
+		if (!E) {
+			E = _insert(p_key, hash);
+		}
+		return E->data.value;
+	}
+
+	const Variant &operator[](const Variant &p_key) const {
+		const Element *E = find(p_key);
+		CRASH_COND(!E);
+		return E->data.value;
+	}
+
+	bool erase(const Variant &p_key) {
+		Element *E = find(p_key);
+		if (!E) {
+			return false;
+		}
+
+		if (index) {
+			_index_remove(E);
+		}
+		if (E->prev) {
+			E->prev->next = E->next;
+		} else {
+			head = E->next;
+		}
+		if (E->next) {
+			E->next->prev = E->prev;
+		} else {
+			tail = E->prev;
+		}
+		num_elements--;
+
+		E->~Element();
+		FreeSlot *slot = memnew_placement(E, FreeSlot);
+		slot->next = free_slots;
+		free_slots = slot;
+		return true;
+	}
+
+	void clear() {
+		for (Element *E = head; E;) {
+			Element *next = E->next;
+			E->~Element();
+			E = next;
+		}
+		while (chunks) {
+			Chunk *next = chunks->next;
+			Memory::free_static(chunks);
+			chunks = next;
+		}
+		if (index) {
+			Memory::free_static(index);
+		}
+
+		free_slots = nullptr;
+		head = nullptr;
+		tail = nullptr;
+		index = nullptr;
+		index_capacity = 0;
+		num_elements = 0;
+	}
+
+	_FORCE_INLINE_ const Element *front() const { return head; }
+
+	_FORCE_INLINE_ Iterator begin() { return Iterator{ head }; }
+	_FORCE_INLINE_ Iterator end() { return Iterator(); }
+	_FORCE_INLINE_ ConstIterator begin() const { return ConstIterator{ head }; }
+	_FORCE_INLINE_ ConstIterator end() const { return ConstIterator(); }
+
+	CompactVariantMap() {}
+	CompactVariantMap(const CompactVariantMap &p_other) = delete;
+	void operator=(const CompactVariantMap &p_other) = delete;
+	~CompactVariantMap() {
+		clear();
+	}
+};
+
 struct DictionaryPrivate {
 	SafeRefCount refcount;
 	Variant *read_only = nullptr; // If enabled, a pointer is used to a temporary value that is used to return read-only values.
-	HashMap<Variant, Variant, VariantHasher, StringLikeVariantComparator> variant_map;
+	CompactVariantMap variant_map;
 };
 
 void Dictionary::get_key_list(List<Variant> *p_keys) const {
@@ -112,33 +366,33 @@ const Variant &Dictionary::operator[](const Variant &p_key) const {
 }
 
 const Variant *Dictionary::getptr(const Variant &p_key) const {
-	HashMap<Variant, Variant, VariantHasher, StringLikeVariantComparator>::ConstIterator E(_p->variant_map.find(p_key));
+	const CompactVariantMap::Element *E = _p->variant_map.find(p_key);
 	if (!E) {
 		return nullptr;
 	}
-	return &E->value;
+	return &E->data.value;
 }
 
 Variant *Dictionary::getptr(const Variant &p_key) {
-	HashMap<Variant, Variant, VariantHasher, StringLikeVariantComparator>::Iterator E(_p->variant_map.find(p_key));
+	CompactVariantMap::Element *E = _p->variant_map.find(p_key);
 	if (!E) {
 		return nullptr;
 	}
 	if (unlikely(_p->read_only != nullptr)) {
-		*_p->read_only = E->value;
+		*_p->read_only = E->data.value;
 		return _p->read_only;
 	} else {
-		return &E->value;
+		return &E->data.value;
 	}
 }
 
 Variant Dictionary::get_valid(const Variant &p_key) const {
-	HashMap<Variant, Variant, VariantHasher, StringLikeVariantComparator>::ConstIterator E(_p->variant_map.find(p_key));
+	const CompactVariantMap::Element *E = _p->variant_map.find(p_key);
 
 	if (!E) {
 		return Variant();
 	}
-	return E->value;
+	return E->data.value;
 }
 
 Variant Dictionary::get(const Variant &p_key, const Variant &p_default) const {
@@ -218,8 +472,8 @@ bool Dictionary::recursive_equal(const Dictionary &p_dictionary, int recursion_c
 	}
 	recursion_count++;
 	for (const KeyValue<Variant, Variant> &this_E : _p->variant_map) {
-		HashMap<Variant, Variant, VariantHasher, StringLikeVariantComparator>::ConstIterator other_E(p_dictionary._p->variant_map.find(this_E.key));
-		if (!other_E || !this_E.value.hash_compare(other_E->value, recursion_count, false)) {
+		const CompactVariantMap::Element *other_E = p_dictionary._p->variant_map.find(this_E.key);
+		if (!other_E || !this_E.value.hash_compare(other_E->data.value, recursion_count, false)) {
 			return false;
 		}
 	}
@@ -332,24 +586,16 @@ Array Dictionary::values() const {
 const Variant *Dictionary::next(const Variant *p_key) const {
 	if (p_key == nullptr) {
 		// caller wants to get the first element
-		if (_p->variant_map.begin()) {
-			return &_p->variant_map.begin()->key;
-		}
-		return nullptr;
+		const CompactVariantMap::Element *E = _p->variant_map.front();
+		return E ? &E->data.key : nullptr;
 	}
-	HashMap<Variant, Variant, VariantHasher, StringLikeVariantComparator>::Iterator E = _p->variant_map.find(*p_key);
+	const CompactVariantMap::Element *E = _p->variant_map.find(*p_key);
 
-	if (!E) {
+	if (!E || !E->next) {
 		return nullptr;
 	}
 
-	++E;
-
-	if (E) {
-		return &E->key;
-	}
-
-	return nullptr;
+	return &E->next->data.key;
 }
 
 Dictionary Dictionary::duplicate(bool p_deep) const {
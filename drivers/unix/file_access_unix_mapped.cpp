@@ -0,0 +1,236 @@
+/**************************************************************************/
+/*  file_access_unix_mapped.cpp                                           */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "file_access_unix_mapped.h"
+
+#if defined(UNIX_ENABLED)
+
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+Error FileAccessUnixMapped::open_internal(const String &p_path, int p_mode_flags) {
+	_unmap();
+
+	ERR_FAIL_COND_V_MSG(p_mode_flags != READ, ERR_UNAVAILABLE, "Mapped files can only be opened for reading.");
+
+	path_src = p_path;
+	path = fix_path(p_path);
+
+	int fd = ::open(path.utf8().get_data(), O_RDONLY | O_CLOEXEC);
+	if (fd == -1) {
+		return errno == ENOENT ? ERR_FILE_NOT_FOUND : ERR_FILE_CANT_OPEN;
+	}
+
+	struct stat st = {};
+	if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode)) {
+		::close(fd);
+		return ERR_FILE_CANT_OPEN;
+	}
+	if (st.st_size == 0 || (uint64_t)st.st_size > (uint64_t)SIZE_MAX) {
+		// Empty files can't be mapped, and files larger than the address space shouldn't be.
+		::close(fd);
+		return ERR_UNAVAILABLE;
+	}
+
+	void *mapping = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	// The mapping keeps its own reference to the file.
+	::close(fd);
+	if (mapping == MAP_FAILED) {
+		return ERR_FILE_CANT_OPEN;
+	}
+
+	data = (const uint8_t *)mapping;
+	length = st.st_size;
+	pos = 0;
+	eof = false;
+	return OK;
+}
+
+void FileAccessUnixMapped::_unmap() {
+	if (!data) {
+		return;
+	}
+
+	munmap((void *)data, length);
+	data = nullptr;
+	length = 0;
+}
+
+bool FileAccessUnixMapped::is_open() const {
+	return data != nullptr;
+}
+
+String FileAccessUnixMapped::get_path() const {
+	return path_src;
+}
+
+String FileAccessUnixMapped::get_path_absolute() const {
+	return path;
+}
+
+void FileAccessUnixMapped::seek(uint64_t p_position) {
+	ERR_FAIL_NULL_MSG(data, "File must be opened before use.");
+
+	pos = p_position;
+	eof = false;
+}
+
+void FileAccessUnixMapped::seek_end(int64_t p_position) {
+	ERR_FAIL_NULL_MSG(data, "File must be opened before use.");
+
+	pos = length + p_position;
+	eof = false;
+}
+
+uint64_t FileAccessUnixMapped::get_position() const {
+	ERR_FAIL_NULL_V_MSG(data, 0, "File must be opened before use.");
+	return pos;
+}
+
+uint64_t FileAccessUnixMapped::get_length() const {
+	ERR_FAIL_NULL_V_MSG(data, 0, "File must be opened before use.");
+	return length;
+}
+
+bool FileAccessUnixMapped::eof_reached() const {
+	return eof;
+}
+
+uint8_t FileAccessUnixMapped::get_8() const {
+	ERR_FAIL_NULL_V_MSG(data, 0, "File must be opened before use.");
+
+	if (pos >= length) {
+		eof = true;
+		return 0;
+	}
+	return data[pos++];
+}
+
+uint16_t FileAccessUnixMapped::get_16() const {
+	uint16_t b = 0;
+	get_buffer((uint8_t *)&b, 2);
+
+	if (big_endian) {
+		b = BSWAP16(b);
+	}
+
+	return b;
+}
+
+uint32_t FileAccessUnixMapped::get_32() const {
+	uint32_t b = 0;
+	get_buffer((uint8_t *)&b, 4);
+
+	if (big_endian) {
+		b = BSWAP32(b);
+	}
+
+	return b;
+}
+
+uint64_t FileAccessUnixMapped::get_64() const {
+	uint64_t b = 0;
+	get_buffer((uint8_t *)&b, 8);
+
+	if (big_endian) {
+		b = BSWAP64(b);
+	}
+
+	return b;
+}
+
+uint64_t FileAccessUnixMapped::get_buffer(uint8_t *p_dst, uint64_t p_length) const {
+	ERR_FAIL_COND_V(!p_dst && p_length > 0, -1);
+	ERR_FAIL_NULL_V_MSG(data, -1, "File must be opened before use.");
+
+	uint64_t read = p_length;
+	if (pos >= length) {
+		read = 0;
+	} else if (read > length - pos) {
+		read = length - pos;
+	}
+	if (read < p_length) {
+		eof = true;
+	}
+
+	if (read > 0) {
+		memcpy(p_dst, data + pos, read);
+		pos += read;
+	}
+	return read;
+}
+
+const uint8_t *FileAccessUnixMapped::get_mapped_range(uint64_t p_position, uint64_t p_length) const {
+	if (!data || p_position > length || p_length > length - p_position) {
+		return nullptr;
+	}
+	return data + p_position;
+}
+
+Error FileAccessUnixMapped::get_error() const {
+	return eof ? ERR_FILE_EOF : OK;
+}
+
+void FileAccessUnixMapped::flush() {
+	ERR_FAIL_MSG("Mapped files are read-only.");
+}
+
+void FileAccessUnixMapped::store_8(uint8_t p_dest) {
+	ERR_FAIL_MSG("Mapped files are read-only.");
+}
+
+void FileAccessUnixMapped::store_16(uint16_t p_dest) {
+	ERR_FAIL_MSG("Mapped files are read-only.");
+}
+
+void FileAccessUnixMapped::store_32(uint32_t p_dest) {
+	ERR_FAIL_MSG("Mapped files are read-only.");
+}
+
+void FileAccessUnixMapped::store_64(uint64_t p_dest) {
+	ERR_FAIL_MSG("Mapped files are read-only.");
+}
+
+void FileAccessUnixMapped::store_buffer(const uint8_t *p_src, uint64_t p_length) {
+	ERR_FAIL_MSG("Mapped files are read-only.");
+}
+
+void FileAccessUnixMapped::close() {
+	_unmap();
+}
+
+FileAccessUnixMapped::~FileAccessUnixMapped() {
+	_unmap();
+}
+
+#endif // UNIX_ENABLED
@@ -37,6 +37,7 @@
 #include "core/debugger/script_debugger.h"
 #include "drivers/unix/dir_access_unix.h"
 #include "drivers/unix/file_access_unix.h"
+#include "drivers/unix/file_access_unix_mapped.h"
 #include "drivers/unix/file_access_unix_pipe.h"
 #include "drivers/unix/net_socket_posix.h"
 #include "drivers/unix/thread_posix.h"
@@ -162,6 +163,12 @@ void OS_Unix::initialize_core() {
 	FileAccess::make_default<FileAccessUnix>(FileAccess::ACCESS_USERDATA);
 	FileAccess::make_default<FileAccessUnix>(FileAccess::ACCESS_FILESYSTEM);
 	FileAccess::make_default<FileAccessUnixPipe>(FileAccess::ACCESS_PIPE);
+#ifndef WEB_ENABLED
+	// Emscripten emulates mappings by copying the whole file, so only map on real Unix systems.
+	// FileAccess::open_mapped() decides which files may be mapped, packs are usually opened by absolute path.
+	FileAccess::make_mapped_default<FileAccessUnixMapped>(FileAccess::ACCESS_RESOURCES);
+	FileAccess::make_mapped_default<FileAccessUnixMapped>(FileAccess::ACCESS_FILESYSTEM);
+#endif
 	DirAccess::make_default<DirAccessUnix>(DirAccess::ACCESS_RESOURCES);
 	DirAccess::make_default<DirAccessUnix>(DirAccess::ACCESS_USERDATA);
 	DirAccess::make_default<DirAccessUnix>(DirAccess::ACCESS_FILESYSTEM);
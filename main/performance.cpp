@@ -91,6 +91,16 @@ void Performance::_bind_methods() {
 	BIND_ENUM_CONSTANT(NAVIGATION_EDGE_MERGE_COUNT);
 	BIND_ENUM_CONSTANT(NAVIGATION_EDGE_CONNECTION_COUNT);
 	BIND_ENUM_CONSTANT(NAVIGATION_EDGE_FREE_COUNT);
+	BIND_ENUM_CONSTANT(MEMORY_TAG_GENERAL);
+	BIND_ENUM_CONSTANT(MEMORY_TAG_SCENE);
+	BIND_ENUM_CONSTANT(MEMORY_TAG_RESOURCE);
+	BIND_ENUM_CONSTANT(MEMORY_TAG_SCRIPT);
+	BIND_ENUM_CONSTANT(MEMORY_TAG_RENDERING);
+	BIND_ENUM_CONSTANT(MEMORY_TAG_PHYSICS);
+	BIND_ENUM_CONSTANT(MEMORY_TAG_NAVIGATION);
+	BIND_ENUM_CONSTANT(MEMORY_TAG_AUDIO);
+	BIND_ENUM_CONSTANT(OBJECT_POOLED_INSTANCE_COUNT);
+	BIND_ENUM_CONSTANT(OBJECT_POOL_REUSE_COUNT);
 	BIND_ENUM_CONSTANT(MONITOR_MAX);
 }
 
@@ -103,6 +113,10 @@ int Performance::_get_node_count() const {
 	return sml->get_node_count();
 }
 
+SceneTree *Performance::_get_scene_tree() const {
+	return Object::cast_to<SceneTree>(OS::get_singleton()->get_main_loop());
+}
+
 String Performance::get_monitor_name(Monitor p_monitor) const {
 	ERR_FAIL_INDEX_V(p_monitor, MONITOR_MAX, String());
 	static const char *names[MONITOR_MAX] = {
@@ -141,6 +155,16 @@ String Performance::get_monitor_name(Monitor p_monitor) const {
 		"navigation/edges_merged",
 		"navigation/edges_connected",
 		"navigation/edges_free",
+		"memory/tag_general",
+		"memory/tag_scene",
+		"memory/tag_resources",
+		"memory/tag_script",
+		"memory/tag_rendering",
+		"memory/tag_physics",
+		"memory/tag_navigation",
+		"memory/tag_audio",
+		"object/pooled_instances",
+		"object/pool_reuses",
 
 	};
 
@@ -225,6 +249,26 @@ double Performance::get_monitor(Monitor p_monitor) const {
 			return NavigationServer3D::get_singleton()->get_process_info(NavigationServer3D::INFO_EDGE_CONNECTION_COUNT);
 		case NAVIGATION_EDGE_FREE_COUNT:
 			return NavigationServer3D::get_singleton()->get_process_info(NavigationServer3D::INFO_EDGE_FREE_COUNT);
+		case MEMORY_TAG_GENERAL:
+			return Memory::get_mem_usage_by_tag(Memory::TAG_GENERAL);
+		case MEMORY_TAG_SCENE:
+			return Memory::get_mem_usage_by_tag(Memory::TAG_SCENE);
+		case MEMORY_TAG_RESOURCE:
+			return Memory::get_mem_usage_by_tag(Memory::TAG_RESOURCE);
+		case MEMORY_TAG_SCRIPT:
+			return Memory::get_mem_usage_by_tag(Memory::TAG_SCRIPT);
+		case MEMORY_TAG_RENDERING:
+			return Memory::get_mem_usage_by_tag(Memory::TAG_RENDERING);
+		case MEMORY_TAG_PHYSICS:
+			return Memory::get_mem_usage_by_tag(Memory::TAG_PHYSICS);
+		case MEMORY_TAG_NAVIGATION:
+			return Memory::get_mem_usage_by_tag(Memory::TAG_NAVIGATION);
+		case MEMORY_TAG_AUDIO:
+			return Memory::get_mem_usage_by_tag(Memory::TAG_AUDIO);
+		case OBJECT_POOLED_INSTANCE_COUNT:
+			return _get_scene_tree() ? _get_scene_tree()->get_pooled_instance_count() : 0;
+		case OBJECT_POOL_REUSE_COUNT:
+			return _get_scene_tree() ? _get_scene_tree()->get_pool_reuse_count() : 0;
 
 		default: {
 		}
@@ -272,6 +316,16 @@ Performance::MonitorType Performance::get_monitor_type(Monitor p_monitor) const
 		MONITOR_TYPE_QUANTITY,
 		MONITOR_TYPE_QUANTITY,
 		MONITOR_TYPE_QUANTITY,
+		MONITOR_TYPE_MEMORY,
+		MONITOR_TYPE_MEMORY,
+		MONITOR_TYPE_MEMORY,
+		MONITOR_TYPE_MEMORY,
+		MONITOR_TYPE_MEMORY,
+		MONITOR_TYPE_MEMORY,
+		MONITOR_TYPE_MEMORY,
+		MONITOR_TYPE_MEMORY,
+		MONITOR_TYPE_QUANTITY,
+		MONITOR_TYPE_QUANTITY,
 
 	};
 
@@ -37,6 +37,7 @@
 #define PERF_WARN_OFFLINE_FUNCTION
 #define PERF_WARN_PROCESS_SYNC
 
+class SceneTree;
 template <typename T>
 class TypedArray;
 
@@ -47,6 +48,7 @@ class Performance : public Object {
 	static void _bind_methods();
 
 	int _get_node_count() const;
+	SceneTree *_get_scene_tree() const;
 
 	double _process_time;
 	double _physics_process_time;
@@ -100,6 +102,16 @@ public:
 		NAVIGATION_EDGE_MERGE_COUNT,
 		NAVIGATION_EDGE_CONNECTION_COUNT,
 		NAVIGATION_EDGE_FREE_COUNT,
+		MEMORY_TAG_GENERAL,
+		MEMORY_TAG_SCENE,
+		MEMORY_TAG_RESOURCE,
+		MEMORY_TAG_SCRIPT,
+		MEMORY_TAG_RENDERING,
+		MEMORY_TAG_PHYSICS,
+		MEMORY_TAG_NAVIGATION,
+		MEMORY_TAG_AUDIO,
+		OBJECT_POOLED_INSTANCE_COUNT,
+		OBJECT_POOL_REUSE_COUNT,
 		MONITOR_MAX
 	};
 
@@ -702,6 +702,8 @@ void GDScript::_restore_old_static_data() {
 #endif
 
 Error GDScript::reload(bool p_keep_state) {
+	MemoryTagScope tag_scope(Memory::TAG_SCRIPT);
+
 	if (reloading) {
 		return OK;
 	}
@@ -2801,6 +2803,8 @@ GDScriptLanguage::GDScriptLanguage() {
 		_debug_max_call_stack = 0;
 	}
 
+	lower_typed_functions = GLOBAL_DEF("debug/settings/gdscript/lower_typed_functions", true);
+
 #ifdef DEBUG_ENABLED
 	GLOBAL_DEF("debug/gdscript/warnings/enable", true);
 	GLOBAL_DEF("debug/gdscript/warnings/exclude_addons", true);
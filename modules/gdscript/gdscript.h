@@ -441,6 +441,7 @@ class GDScriptLanguage : public ScriptLanguage {
 
 	static thread_local CallStack _call_stack;
 	int _debug_max_call_stack = 0;
+	bool lower_typed_functions = true;
 
 	void _add_global(const StringName &p_name, const Variant &p_value);
 
@@ -541,6 +542,9 @@ public:
 
 	_FORCE_INLINE_ static GDScriptLanguage *get_singleton() { return singleton; }
 
+	_FORCE_INLINE_ bool is_lowering_typed_functions() const { return lower_typed_functions; }
+	void set_lowering_typed_functions(bool p_enabled) { lower_typed_functions = p_enabled; }
+
 	virtual String get_name() const override;
 
 	/* LANGUAGE FUNCTIONS */
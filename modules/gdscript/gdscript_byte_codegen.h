@@ -97,6 +97,10 @@ class GDScriptByteCodeGenerator : public GDScriptCodeGenerator {
 	int max_locals = 0;
 	int current_line = 0;
 	int instr_args_max = 0;
+	int inline_cache_count = 0;
+
+	// Position of the last OPCODE_OPERATOR_VALIDATED, while a following jump can still be fused with it.
+	int fusable_operator_pos = -1;
 
 #ifdef DEBUG_ENABLED
 	List<int> temp_stack;
@@ -445,8 +449,16 @@ class GDScriptByteCodeGenerator : public GDScriptCodeGenerator {
 
 	void patch_jump(int p_address) {
 		opcodes.write[p_address] = opcodes.size();
+		// The jump lands after the operator, so it can't be fused anymore.
+		fusable_operator_pos = -1;
+	}
+
+	int add_inline_cache() {
+		return inline_cache_count++;
 	}
 
+	bool try_fuse_operator_jump_if_not(const Address &p_condition);
+
 public:
 	virtual uint32_t add_parameter(const StringName &p_name, bool p_is_optional, const GDScriptDataType &p_type) override;
 	virtual uint32_t add_local(const StringName &p_name, const GDScriptDataType &p_type) override;
@@ -3183,6 +3183,9 @@ Error GDScriptCompiler::compile(const GDScriptParser *p_parser, GDScript *p_scri
 
 	ScriptLambdaInfo old_lambda_info = _get_script_lambda_replacement_info(p_script);
 
+	// Member indices and functions may change, so the lookups cached by the VM can't be trusted anymore.
+	GDScriptFunction::invalidate_inline_caches();
+
 	// Create scripts for subclasses beforehand so they can be referenced
 	make_scripts(p_script, root, p_keep_state);
 
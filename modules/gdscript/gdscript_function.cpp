@@ -31,6 +31,12 @@
 #include "gdscript_function.h"
 
 #include "gdscript.h"
+#include "gdscript_lowered_function.h"
+
+#include "core/core_string_names.h"
+#include "scene/main/node.h"
+
+SafeNumeric<uint32_t> GDScriptFunction::inline_cache_version;
 
 Variant GDScriptFunction::get_constant(int p_idx) const {
 	ERR_FAIL_INDEX_V(p_idx, constants.size(), "<errconst>");
@@ -42,6 +48,161 @@ StringName GDScriptFunction::get_global_name(int p_idx) const {
 	return global_names[p_idx];
 }
 
+bool GDScriptFunction::_find_inline_cache_entry(const InlineCache &p_cache, const void *p_receiver, InlineCacheEntry &r_entry) const {
+	const uint32_t version = inline_cache_version.get();
+	const uint32_t sequence = p_cache.sequence.load(std::memory_order_acquire);
+	if (sequence & 1) {
+		// Being written to.
+		return false;
+	}
+
+	for (int i = 0; i < InlineCache::MAX_ENTRIES; i++) {
+		const InlineCache::Slot &slot = p_cache.slots[i];
+		if (slot.receiver.load(std::memory_order_relaxed) != p_receiver || slot.version.load(std::memory_order_relaxed) != version) {
+			continue;
+		}
+
+		r_entry.receiver = p_receiver;
+		r_entry.version = version;
+		r_entry.function = slot.function.load(std::memory_order_relaxed);
+		r_entry.method = slot.method.load(std::memory_order_relaxed);
+		r_entry.member_index = slot.member_index.load(std::memory_order_relaxed);
+
+		std::atomic_thread_fence(std::memory_order_acquire);
+		return p_cache.sequence.load(std::memory_order_relaxed) == sequence;
+	}
+	return false;
+}
+
+void GDScriptFunction::_add_inline_cache_entry(InlineCache &p_cache, const InlineCacheEntry &p_entry) {
+	MutexLock lock(inline_cache_mutex);
+
+	const uint32_t version = inline_cache_version.get();
+	int slot_index = -1;
+	for (int i = 0; i < InlineCache::MAX_ENTRIES; i++) {
+		const InlineCache::Slot &slot = p_cache.slots[i];
+		if (slot.receiver.load(std::memory_order_relaxed) && slot.version.load(std::memory_order_relaxed) == version) {
+			if (slot.receiver.load(std::memory_order_relaxed) == p_entry.receiver) {
+				// Added by another thread in the meantime.
+				return;
+			}
+		} else if (slot_index == -1) {
+			// Empty or outdated slot.
+			slot_index = i;
+		}
+	}
+
+	if (slot_index == -1) {
+		slot_index = p_cache.next_replaced;
+		p_cache.next_replaced = (p_cache.next_replaced + 1) % InlineCache::MAX_ENTRIES;
+	}
+
+	InlineCache::Slot &slot = p_cache.slots[slot_index];
+	const uint32_t sequence = p_cache.sequence.load(std::memory_order_relaxed);
+	p_cache.sequence.store(sequence + 1, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release);
+
+	slot.receiver.store(p_entry.receiver, std::memory_order_relaxed);
+	slot.version.store(version, std::memory_order_relaxed);
+	slot.function.store(p_entry.function, std::memory_order_relaxed);
+	slot.method.store(p_entry.method, std::memory_order_relaxed);
+	slot.member_index.store(p_entry.member_index, std::memory_order_relaxed);
+
+	p_cache.sequence.store(sequence + 2, std::memory_order_release);
+}
+
+bool GDScriptFunction::_call_inline_cached(InlineCache &p_cache, Object *p_object, const StringName &p_method, const Variant **p_args, int p_argcount, Variant &r_ret, Callable::CallError &r_err) {
+	if (p_method == CoreStringNames::get_singleton()->_free || p_method == SNAME("_ready")) {
+		// Both are handled specially by Object::callp() and GDScriptInstance::callp().
+		return false;
+	}
+
+	ScriptInstance *script_instance = p_object->get_script_instance();
+	GDScriptInstance *gdscript_instance = nullptr;
+	const void *receiver = nullptr;
+	if (script_instance) {
+		if (script_instance->is_placeholder() || script_instance->get_language() != GDScriptLanguage::get_singleton()) {
+			return false;
+		}
+		gdscript_instance = static_cast<GDScriptInstance *>(script_instance);
+		receiver = gdscript_instance->script.ptr();
+	} else {
+		receiver = &p_object->get_class_name();
+	}
+
+	InlineCacheEntry entry;
+	if (!_find_inline_cache_entry(p_cache, receiver, entry)) {
+		entry.receiver = receiver;
+		if (gdscript_instance) {
+			// Same lookup as GDScriptInstance::callp(). Native methods are left to the full lookup,
+			// since they depend on the class of the object and not only on its script.
+			for (GDScript *sptr = gdscript_instance->script.ptr(); sptr && !entry.function; sptr = sptr->_base) {
+				HashMap<StringName, GDScriptFunction *>::Iterator E = sptr->member_functions.find(p_method);
+				if (E) {
+					entry.function = E->value;
+				}
+			}
+			if (!entry.function) {
+				return false;
+			}
+		} else {
+			// Only nodes, since other classes may override Object::callp(), and extension classes may be unloaded.
+			const StringName &class_name = p_object->get_class_name();
+			if (!Object::cast_to<Node>(p_object) || ClassDB::get_api_type(class_name) == ClassDB::API_EXTENSION || ClassDB::get_api_type(class_name) == ClassDB::API_EDITOR_EXTENSION) {
+				return false;
+			}
+			entry.method = ClassDB::get_method(class_name, p_method);
+			if (!entry.method) {
+				return false;
+			}
+		}
+
+		_add_inline_cache_entry(p_cache, entry);
+	}
+
+#ifdef DEBUG_ENABLED
+	// Same as Object::callp(), so the object refuses to be freed while the call runs.
+	_ObjectDebugLock debug_lock(p_object);
+#endif
+
+	r_err.error = Callable::CallError::CALL_OK;
+	if (entry.function) {
+		r_ret = entry.function->call(gdscript_instance, p_args, p_argcount, r_err);
+	} else {
+		r_ret = entry.method->call(p_object, p_args, p_argcount, r_err);
+	}
+	return true;
+}
+
+bool GDScriptFunction::_get_named_inline_cached(InlineCache &p_cache, Object *p_object, const StringName &p_name, Variant &r_ret) {
+	// Only script members are cached, native properties have too many special cases.
+	ScriptInstance *script_instance = p_object->get_script_instance();
+	if (!script_instance || script_instance->is_placeholder() || script_instance->get_language() != GDScriptLanguage::get_singleton()) {
+		return false;
+	}
+	GDScriptInstance *gdscript_instance = static_cast<GDScriptInstance *>(script_instance);
+	GDScript *script = gdscript_instance->script.ptr();
+
+	InlineCacheEntry entry;
+	if (!_find_inline_cache_entry(p_cache, script, entry)) {
+		// Same lookup as GDScriptInstance::get(), members with a getter are left to it.
+		HashMap<StringName, GDScript::MemberInfo>::ConstIterator E = script->member_indices.find(p_name);
+		if (!E || E->value.getter) {
+			return false;
+		}
+		entry.receiver = script;
+		entry.member_index = E->value.index;
+
+		_add_inline_cache_entry(p_cache, entry);
+	}
+
+	if (unlikely(entry.member_index >= gdscript_instance->members.size())) {
+		return false;
+	}
+	r_ret = gdscript_instance->members[entry.member_index];
+	return true;
+}
+
 struct _GDFKC {
 	int order = 0;
 	List<int> pos;
@@ -117,6 +278,15 @@ GDScriptFunction::GDScriptFunction() {
 GDScriptFunction::~GDScriptFunction() {
 	get_script()->member_functions.erase(name);
 
+	// Other functions may have cached this one.
+	invalidate_inline_caches();
+	if (_inline_caches_ptr) {
+		memdelete_arr(_inline_caches_ptr);
+	}
+	if (lowered) {
+		memdelete(lowered);
+	}
+
 	for (int i = 0; i < lambdas.size(); i++) {
 		memdelete(lambdas[i]);
 	}
@@ -35,13 +35,19 @@
 
 #include "core/object/ref_counted.h"
 #include "core/object/script_language.h"
+#include "core/os/mutex.h"
 #include "core/os/thread.h"
 #include "core/string/string_name.h"
+#include "core/templates/local_vector.h"
 #include "core/templates/pair.h"
+#include "core/templates/safe_refcount.h"
 #include "core/templates/self_list.h"
 #include "core/variant/variant.h"
 
+#include <atomic>
+
 class GDScriptInstance;
+class GDScriptLoweredFunction;
 class GDScript;
 
 class GDScriptDataType {
@@ -253,6 +259,7 @@ public:
 		OPCODE_JUMP,
 		OPCODE_JUMP_IF,
 		OPCODE_JUMP_IF_NOT,
+		OPCODE_OPERATOR_VALIDATED_JUMP_IF_NOT, // Fused OPCODE_OPERATOR_VALIDATED and OPCODE_JUMP_IF_NOT on its result.
 		OPCODE_JUMP_TO_DEF_ARGUMENT,
 		OPCODE_JUMP_IF_SHARED,
 		OPCODE_RETURN,
@@ -377,6 +384,7 @@ private:
 	friend class GDScriptCompiler;
 	friend class GDScriptByteCodeGenerator;
 	friend class GDScriptLanguage;
+	friend class GDScriptLoweredFunction;
 
 	StringName name;
 	StringName source;
@@ -451,6 +459,50 @@ private:
 	MethodBind **_methods_ptr = nullptr;
 	GDScriptFunction **_lambdas_ptr = nullptr;
 
+	GDScriptLoweredFunction *lowered = nullptr; // Set when the function only computes on typed scalars.
+
+	static bool _can_run_lowered();
+
+	// Inline caches of the calls and property reads on untyped values. Each one remembers the lookups
+	// done for the last few receivers seen at its site, keyed on their script or native class.
+	struct InlineCacheEntry {
+		const void *receiver = nullptr; // The `GDScript` of script instances, or the class name of native objects.
+		uint32_t version = 0;
+		GDScriptFunction *function = nullptr;
+		MethodBind *method = nullptr;
+		int member_index = -1;
+	};
+
+	struct InlineCache {
+		static constexpr int MAX_ENTRIES = 4;
+
+		struct Slot {
+			std::atomic<const void *> receiver = { nullptr };
+			std::atomic<uint32_t> version = { 0 };
+			std::atomic<GDScriptFunction *> function = { nullptr };
+			std::atomic<MethodBind *> method = { nullptr };
+			std::atomic<int> member_index = { -1 };
+		};
+
+		// Slots are rewritten in place under the function's mutex, and the sequence is odd while that happens.
+		// Readers that see it change while copying a slot out fall back to the full lookup.
+		std::atomic<uint32_t> sequence = { 0 };
+		Slot slots[MAX_ENTRIES];
+		uint32_t next_replaced = 0; // Once all slots are taken, the oldest one is replaced.
+	};
+
+	InlineCache *_inline_caches_ptr = nullptr;
+	int _inline_cache_count = 0;
+	Mutex inline_cache_mutex;
+
+	// Changes whenever a function is freed or a script recompiled, which outdates all the entries.
+	static SafeNumeric<uint32_t> inline_cache_version;
+
+	bool _find_inline_cache_entry(const InlineCache &p_cache, const void *p_receiver, InlineCacheEntry &r_entry) const;
+	void _add_inline_cache_entry(InlineCache &p_cache, const InlineCacheEntry &p_entry);
+	bool _call_inline_cached(InlineCache &p_cache, Object *p_object, const StringName &p_method, const Variant **p_args, int p_argcount, Variant &r_ret, Callable::CallError &r_err);
+	bool _get_named_inline_cached(InlineCache &p_cache, Object *p_object, const StringName &p_name, Variant &r_ret);
+
 #ifdef DEBUG_ENABLED
 	CharString func_cname;
 	const char *_func_cname = nullptr;
@@ -514,10 +566,13 @@ public:
 	_FORCE_INLINE_ int get_argument_count() const { return _argument_count; }
 	_FORCE_INLINE_ Variant get_rpc_config() const { return rpc_config; }
 	_FORCE_INLINE_ int get_max_stack_size() const { return _stack_size; }
+	_FORCE_INLINE_ bool is_lowered() const { return lowered != nullptr; }
 
 	Variant get_constant(int p_idx) const;
 	StringName get_global_name(int p_idx) const;
 
+	static void invalidate_inline_caches() { inline_cache_version.increment(); }
+
 	Variant call(GDScriptInstance *p_instance, const Variant **p_args, int p_argcount, Callable::CallError &r_err, CallState *p_state = nullptr);
 	void debug_get_stack_member_state(int p_line, List<Pair<StringName, int>> *r_stackvars) const;
 
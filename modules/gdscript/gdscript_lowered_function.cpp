@@ -0,0 +1,1213 @@
+/**************************************************************************/
+/*  gdscript_lowered_function.cpp                                         */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "gdscript_lowered_function.h"
+
+#include "gdscript_function.h"
+
+#include "core/templates/rb_map.h"
+#include "core/variant/variant_internal.h"
+#include "core/variant/variant_utility.h"
+
+// One bytecode instruction, in the terms of the lowered form.
+struct GDScriptLoweredFunction::Decoded {
+	enum Kind {
+		OPERATOR,
+		JUMP,
+		JUMP_IF,
+		JUMP_IF_NOT,
+		ASSIGN,
+		ASSIGN_BOOL,
+		CONSTRUCT,
+		TYPE_ADJUST,
+		UTILITY,
+		ITERATE_BEGIN,
+		ITERATE,
+		RETURN,
+		END,
+		NOP,
+	};
+
+	Kind kind = NOP;
+	int ip = 0;
+	int size = 0;
+	int dst = -1;
+	int args[3] = { -1, -1, -1 };
+	int argc = 0;
+	int target = -1; // Bytecode address of the jump destination.
+	Variant::Operator op = Variant::OP_MAX;
+	Operation utility = OP_COPY;
+	bool value = false; // Assigned value of `ASSIGN_BOOL`.
+	bool jump_if_not = false; // Operator fused with a conditional jump on its result.
+	Variant::Type type = Variant::NIL; // Target type of assignments, constructors and returns. `NIL` when untyped.
+	Variant::Type arg_types[3] = { Variant::NIL, Variant::NIL, Variant::NIL }; // Operand types expected by validated calls.
+	bool validated = false;
+};
+
+struct OperatorSignature {
+	Variant::Operator op = Variant::OP_MAX;
+	Variant::Type a = Variant::NIL;
+	Variant::Type b = Variant::NIL;
+};
+
+struct ConstructorSignature {
+	Variant::Type type = Variant::NIL;
+	int argc = 0;
+	Variant::Type arg_type = Variant::NIL;
+};
+
+struct UtilitySignature {
+	GDScriptLoweredFunction::Operation op = GDScriptLoweredFunction::OP_COPY;
+	Variant::Type return_type = Variant::NIL;
+	int argc = 0;
+	Variant::Type arg_types[3] = { Variant::NIL, Variant::NIL, Variant::NIL };
+};
+
+template <typename K, typename V>
+static const V *_find_signature(const RBMap<K, V> &p_map, const K &p_key) {
+	const typename RBMap<K, V>::Element *E = p_map.find(p_key);
+	return E ? &E->value() : nullptr;
+}
+
+static const Variant::Type scalar_types[] = { Variant::BOOL, Variant::INT, Variant::FLOAT };
+
+static bool _is_scalar(Variant::Type p_type) {
+	return p_type == Variant::BOOL || p_type == Variant::INT || p_type == Variant::FLOAT;
+}
+
+// The bytecode only keeps evaluator pointers, so look up which operator and operand types they were made for.
+static const RBMap<Variant::ValidatedOperatorEvaluator, OperatorSignature> &_get_operator_signatures() {
+	static const RBMap<Variant::ValidatedOperatorEvaluator, OperatorSignature> signatures = []() {
+		RBMap<Variant::ValidatedOperatorEvaluator, OperatorSignature> map;
+		const Variant::Type right_types[] = { Variant::NIL, Variant::BOOL, Variant::INT, Variant::FLOAT };
+		for (int op = 0; op < Variant::OP_MAX; op++) {
+			for (Variant::Type a : scalar_types) {
+				for (Variant::Type b : right_types) {
+					Variant::ValidatedOperatorEvaluator evaluator = Variant::get_validated_operator_evaluator((Variant::Operator)op, a, b);
+					if (evaluator == nullptr) {
+						continue;
+					}
+					if (map.has(evaluator)) {
+						// Shared by several signatures (e.g. after identical code folding), so it can't be told apart.
+						map[evaluator].op = Variant::OP_MAX;
+						continue;
+					}
+					OperatorSignature signature;
+					signature.op = (Variant::Operator)op;
+					signature.a = a;
+					signature.b = b;
+					map.insert(evaluator, signature);
+				}
+			}
+		}
+		return map;
+	}();
+	return signatures;
+}
+
+static const RBMap<Variant::ValidatedConstructor, ConstructorSignature> &_get_constructor_signatures() {
+	static const RBMap<Variant::ValidatedConstructor, ConstructorSignature> signatures = []() {
+		RBMap<Variant::ValidatedConstructor, ConstructorSignature> map;
+		for (Variant::Type type : scalar_types) {
+			for (int i = 0; i < Variant::get_constructor_count(type); i++) {
+				ConstructorSignature signature;
+				signature.type = type;
+				signature.argc = Variant::get_constructor_argument_count(type, i);
+				if (signature.argc > 1) {
+					continue;
+				}
+				if (signature.argc == 1) {
+					signature.arg_type = Variant::get_constructor_argument_type(type, i, 0);
+					if (!_is_scalar(signature.arg_type)) {
+						continue;
+					}
+				}
+				Variant::ValidatedConstructor constructor = Variant::get_validated_constructor(type, i);
+				if (map.has(constructor)) {
+					map[constructor].type = Variant::NIL;
+					continue;
+				}
+				map.insert(constructor, signature);
+			}
+		}
+		return map;
+	}();
+	return signatures;
+}
+
+static const RBMap<Variant::ValidatedUtilityFunction, UtilitySignature> &_get_utility_signatures() {
+	static const RBMap<Variant::ValidatedUtilityFunction, UtilitySignature> signatures = []() {
+		static const struct {
+			const char *name;
+			GDScriptLoweredFunction::Operation op;
+		} utilities[] = {
+			{ "sqrt", GDScriptLoweredFunction::OP_SQRT },
+			{ "sin", GDScriptLoweredFunction::OP_SIN },
+			{ "cos", GDScriptLoweredFunction::OP_COS },
+			{ "absi", GDScriptLoweredFunction::OP_ABS_INT },
+			{ "absf", GDScriptLoweredFunction::OP_ABS_FLOAT },
+			{ "floorf", GDScriptLoweredFunction::OP_FLOOR },
+			{ "ceilf", GDScriptLoweredFunction::OP_CEIL },
+			{ "mini", GDScriptLoweredFunction::OP_MIN_INT },
+			{ "maxi", GDScriptLoweredFunction::OP_MAX_INT },
+			{ "minf", GDScriptLoweredFunction::OP_MIN_FLOAT },
+			{ "maxf", GDScriptLoweredFunction::OP_MAX_FLOAT },
+			{ "clampi", GDScriptLoweredFunction::OP_CLAMP_INT },
+			{ "clampf", GDScriptLoweredFunction::OP_CLAMP_FLOAT },
+		};
+
+		RBMap<Variant::ValidatedUtilityFunction, UtilitySignature> map;
+		for (const auto &utility : utilities) {
+			StringName name = utility.name;
+			Variant::ValidatedUtilityFunction function = Variant::get_validated_utility_function(name);
+			if (function == nullptr) {
+				continue;
+			}
+			UtilitySignature signature;
+			signature.op = utility.op;
+			signature.return_type = Variant::get_utility_function_return_type(name);
+			signature.argc = Variant::get_utility_function_argument_count(name);
+			ERR_CONTINUE(signature.argc > 3);
+			for (int i = 0; i < signature.argc; i++) {
+				signature.arg_types[i] = Variant::get_utility_function_argument_type(name, i);
+			}
+			map.insert(function, signature);
+		}
+		return map;
+	}();
+	return signatures;
+}
+
+// Picks the lowered operation for an operator, and the type both operands have to be converted to.
+static bool _lower_operator(Variant::Operator p_op, Variant::Type p_a, Variant::Type p_b, GDScriptLoweredFunction::Operation &r_operation, Variant::Type &r_operand_type) {
+	const Variant::Type return_type = Variant::get_operator_return_type(p_op, p_a, p_b);
+	if (!_is_scalar(return_type)) {
+		return false;
+	}
+
+	const bool is_float = p_a == Variant::FLOAT || p_b == Variant::FLOAT;
+	r_operand_type = is_float ? Variant::FLOAT : Variant::INT;
+
+#define NUMERIC_OP(m_op, m_name)                                                                                     \
+	case Variant::m_op:                                                                                              \
+		r_operation = is_float ? GDScriptLoweredFunction::OP_##m_name##_FLOAT : GDScriptLoweredFunction::OP_##m_name##_INT; \
+		break;
+
+	switch (p_op) {
+		NUMERIC_OP(OP_ADD, ADD)
+		NUMERIC_OP(OP_SUBTRACT, SUBTRACT)
+		NUMERIC_OP(OP_MULTIPLY, MULTIPLY)
+		NUMERIC_OP(OP_DIVIDE, DIVIDE)
+		NUMERIC_OP(OP_NEGATE, NEGATE)
+		NUMERIC_OP(OP_EQUAL, EQUAL)
+		NUMERIC_OP(OP_NOT_EQUAL, NOT_EQUAL)
+		NUMERIC_OP(OP_LESS, LESS)
+		NUMERIC_OP(OP_LESS_EQUAL, LESS_EQUAL)
+		NUMERIC_OP(OP_GREATER, GREATER)
+		NUMERIC_OP(OP_GREATER_EQUAL, GREATER_EQUAL)
+		case Variant::OP_POSITIVE:
+			r_operation = GDScriptLoweredFunction::OP_COPY;
+			r_operand_type = p_a;
+			break;
+		case Variant::OP_MODULE:
+			r_operation = GDScriptLoweredFunction::OP_MODULE_INT;
+			break;
+		case Variant::OP_SHIFT_LEFT:
+			r_operation = GDScriptLoweredFunction::OP_SHIFT_LEFT_INT;
+			break;
+		case Variant::OP_SHIFT_RIGHT:
+			r_operation = GDScriptLoweredFunction::OP_SHIFT_RIGHT_INT;
+			break;
+		case Variant::OP_BIT_AND:
+			r_operation = GDScriptLoweredFunction::OP_BIT_AND_INT;
+			break;
+		case Variant::OP_BIT_OR:
+			r_operation = GDScriptLoweredFunction::OP_BIT_OR_INT;
+			break;
+		case Variant::OP_BIT_XOR:
+			r_operation = GDScriptLoweredFunction::OP_BIT_XOR_INT;
+			break;
+		case Variant::OP_BIT_NEGATE:
+			r_operation = GDScriptLoweredFunction::OP_BIT_NEGATE_INT;
+			break;
+		case Variant::OP_AND:
+			r_operation = GDScriptLoweredFunction::OP_AND;
+			r_operand_type = Variant::BOOL;
+			break;
+		case Variant::OP_OR:
+			r_operation = GDScriptLoweredFunction::OP_OR;
+			r_operand_type = Variant::BOOL;
+			break;
+		case Variant::OP_XOR:
+			r_operation = GDScriptLoweredFunction::OP_XOR;
+			r_operand_type = Variant::BOOL;
+			break;
+		case Variant::OP_NOT:
+			r_operation = GDScriptLoweredFunction::OP_NOT;
+			r_operand_type = Variant::BOOL;
+			break;
+		default:
+			return false;
+	}
+
+#undef NUMERIC_OP
+
+	if (is_float && (r_operation == GDScriptLoweredFunction::OP_MODULE_INT || (r_operation >= GDScriptLoweredFunction::OP_SHIFT_LEFT_INT && r_operation <= GDScriptLoweredFunction::OP_BIT_NEGATE_INT))) {
+		return false;
+	}
+
+	// Make sure the result has the type Variant would give it.
+	Variant::Type lowered_type;
+	if (r_operation == GDScriptLoweredFunction::OP_COPY) {
+		lowered_type = p_a;
+	} else if (r_operation >= GDScriptLoweredFunction::OP_EQUAL_INT && r_operation <= GDScriptLoweredFunction::OP_NOT) {
+		lowered_type = Variant::BOOL;
+	} else {
+		lowered_type = r_operand_type;
+	}
+	return lowered_type == return_type;
+}
+
+static bool _is_unary_operator(Variant::Operator p_op) {
+	return p_op == Variant::OP_NEGATE || p_op == Variant::OP_POSITIVE || p_op == Variant::OP_NOT || p_op == Variant::OP_BIT_NEGATE;
+}
+
+int GDScriptLoweredFunction::_address_to_register(const GDScriptFunction *p_function, int p_address) {
+	const int index = p_address & GDScriptFunction::ADDR_MASK;
+	switch ((p_address & GDScriptFunction::ADDR_TYPE_MASK) >> GDScriptFunction::ADDR_BITS) {
+		case GDScriptFunction::ADDR_TYPE_STACK:
+			return index < p_function->get_max_stack_size() ? index : -1;
+		case GDScriptFunction::ADDR_TYPE_CONSTANT:
+			return index < p_function->constants.size() ? p_function->get_max_stack_size() + index : -1;
+		default:
+			// Members would need `self`, which lowered functions don't have.
+			return -1;
+	}
+}
+
+bool GDScriptLoweredFunction::_decode(const GDScriptFunction *p_function, int p_ip, Decoded &r_decoded) {
+	const int *code = p_function->_code_ptr;
+	const int code_size = p_function->_code_size;
+
+	r_decoded = Decoded();
+	r_decoded.ip = p_ip;
+
+#define CHECK_SIZE(m_size)               \
+	if (p_ip + (m_size) > code_size) {   \
+		return false;                    \
+	}                                    \
+	r_decoded.size = (m_size);
+
+#define REGISTER(m_offset) _address_to_register(p_function, code[p_ip + (m_offset)])
+
+	switch (code[p_ip]) {
+		case GDScriptFunction::OPCODE_OPERATOR: {
+			constexpr int pointer_size = sizeof(Variant::ValidatedOperatorEvaluator) / sizeof(*code);
+			CHECK_SIZE(7 + pointer_size);
+			r_decoded.kind = Decoded::OPERATOR;
+			r_decoded.op = (Variant::Operator)code[p_ip + 4];
+			if (r_decoded.op < 0 || r_decoded.op >= Variant::OP_MAX) {
+				return false;
+			}
+			r_decoded.args[0] = REGISTER(1);
+			r_decoded.argc = 1;
+			if (!_is_unary_operator(r_decoded.op)) {
+				r_decoded.args[1] = REGISTER(2);
+				r_decoded.argc = 2;
+			}
+			r_decoded.dst = REGISTER(3);
+		} break;
+		case GDScriptFunction::OPCODE_OPERATOR_VALIDATED:
+		case GDScriptFunction::OPCODE_OPERATOR_VALIDATED_JUMP_IF_NOT: {
+			const bool jump_if_not = code[p_ip] == GDScriptFunction::OPCODE_OPERATOR_VALIDATED_JUMP_IF_NOT;
+			CHECK_SIZE(jump_if_not ? 6 : 5);
+			const int index = code[p_ip + 4];
+			if (index < 0 || index >= p_function->_operator_funcs_count) {
+				return false;
+			}
+			const OperatorSignature *signature = _find_signature(_get_operator_signatures(), p_function->_operator_funcs_ptr[index]);
+			if (signature == nullptr || signature->op == Variant::OP_MAX) {
+				return false;
+			}
+			r_decoded.kind = Decoded::OPERATOR;
+			r_decoded.validated = true;
+			r_decoded.op = signature->op;
+			r_decoded.args[0] = REGISTER(1);
+			r_decoded.arg_types[0] = signature->a;
+			r_decoded.argc = 1;
+			if (signature->b != Variant::NIL) {
+				r_decoded.args[1] = REGISTER(2);
+				r_decoded.arg_types[1] = signature->b;
+				r_decoded.argc = 2;
+			}
+			r_decoded.dst = REGISTER(3);
+			if (jump_if_not) {
+				r_decoded.jump_if_not = true;
+				r_decoded.target = code[p_ip + 5];
+			}
+		} break;
+		case GDScriptFunction::OPCODE_JUMP: {
+			CHECK_SIZE(2);
+			r_decoded.kind = Decoded::JUMP;
+			r_decoded.target = code[p_ip + 1];
+		} break;
+		case GDScriptFunction::OPCODE_JUMP_IF:
+		case GDScriptFunction::OPCODE_JUMP_IF_NOT: {
+			CHECK_SIZE(3);
+			r_decoded.kind = code[p_ip] == GDScriptFunction::OPCODE_JUMP_IF ? Decoded::JUMP_IF : Decoded::JUMP_IF_NOT;
+			r_decoded.args[0] = REGISTER(1);
+			r_decoded.argc = 1;
+			r_decoded.target = code[p_ip + 2];
+		} break;
+		case GDScriptFunction::OPCODE_ASSIGN: {
+			CHECK_SIZE(3);
+			r_decoded.kind = Decoded::ASSIGN;
+			r_decoded.dst = REGISTER(1);
+			r_decoded.args[0] = REGISTER(2);
+			r_decoded.argc = 1;
+		} break;
+		case GDScriptFunction::OPCODE_ASSIGN_TRUE:
+		case GDScriptFunction::OPCODE_ASSIGN_FALSE: {
+			CHECK_SIZE(2);
+			r_decoded.kind = Decoded::ASSIGN_BOOL;
+			r_decoded.dst = REGISTER(1);
+			r_decoded.value = code[p_ip] == GDScriptFunction::OPCODE_ASSIGN_TRUE;
+			r_decoded.type = Variant::BOOL;
+		} break;
+		case GDScriptFunction::OPCODE_ASSIGN_TYPED_BUILTIN: {
+			CHECK_SIZE(4);
+			r_decoded.kind = Decoded::ASSIGN;
+			r_decoded.dst = REGISTER(1);
+			r_decoded.args[0] = REGISTER(2);
+			r_decoded.argc = 1;
+			r_decoded.type = (Variant::Type)code[p_ip + 3];
+			if (!_is_scalar(r_decoded.type)) {
+				return false;
+			}
+		} break;
+		case GDScriptFunction::OPCODE_CONSTRUCT_VALIDATED:
+		case GDScriptFunction::OPCODE_CALL_UTILITY_VALIDATED: {
+			CHECK_SIZE(2);
+			const int instr_arg_count = code[p_ip + 1];
+			if (instr_arg_count < 1 || instr_arg_count > 4) {
+				return false;
+			}
+			CHECK_SIZE(4 + instr_arg_count);
+			const int argc = instr_arg_count - 1;
+			const int index = code[p_ip + 3 + instr_arg_count];
+			for (int i = 0; i < argc; i++) {
+				r_decoded.args[i] = REGISTER(2 + i);
+			}
+			r_decoded.argc = argc;
+			r_decoded.dst = REGISTER(1 + instr_arg_count);
+			r_decoded.validated = true;
+
+			if (code[p_ip] == GDScriptFunction::OPCODE_CONSTRUCT_VALIDATED) {
+				if (index < 0 || index >= p_function->_constructors_count) {
+					return false;
+				}
+				const ConstructorSignature *signature = _find_signature(_get_constructor_signatures(), p_function->_constructors_ptr[index]);
+				if (signature == nullptr || signature->type == Variant::NIL || signature->argc != argc) {
+					return false;
+				}
+				r_decoded.kind = Decoded::CONSTRUCT;
+				r_decoded.type = signature->type;
+				r_decoded.arg_types[0] = signature->arg_type;
+			} else {
+				if (index < 0 || index >= p_function->_utilities_count) {
+					return false;
+				}
+				const UtilitySignature *signature = _find_signature(_get_utility_signatures(), p_function->_utilities_ptr[index]);
+				if (signature == nullptr || signature->argc != argc) {
+					return false;
+				}
+				r_decoded.kind = Decoded::UTILITY;
+				r_decoded.utility = signature->op;
+				r_decoded.type = signature->return_type;
+				for (int i = 0; i < argc; i++) {
+					r_decoded.arg_types[i] = signature->arg_types[i];
+				}
+			}
+		} break;
+		case GDScriptFunction::OPCODE_TYPE_ADJUST_BOOL:
+		case GDScriptFunction::OPCODE_TYPE_ADJUST_INT:
+		case GDScriptFunction::OPCODE_TYPE_ADJUST_FLOAT: {
+			CHECK_SIZE(2);
+			r_decoded.kind = Decoded::TYPE_ADJUST;
+			r_decoded.dst = REGISTER(1);
+			r_decoded.type = code[p_ip] == GDScriptFunction::OPCODE_TYPE_ADJUST_BOOL ? Variant::BOOL : (code[p_ip] == GDScriptFunction::OPCODE_TYPE_ADJUST_INT ? Variant::INT : Variant::FLOAT);
+		} break;
+		case GDScriptFunction::OPCODE_ITERATE_BEGIN_INT:
+		case GDScriptFunction::OPCODE_ITERATE_INT: {
+			CHECK_SIZE(5);
+			r_decoded.kind = code[p_ip] == GDScriptFunction::OPCODE_ITERATE_BEGIN_INT ? Decoded::ITERATE_BEGIN : Decoded::ITERATE;
+			r_decoded.args[0] = REGISTER(1); // Counter.
+			r_decoded.args[1] = REGISTER(2); // Size.
+			r_decoded.args[2] = REGISTER(3); // Iterator.
+			r_decoded.argc = 3;
+			r_decoded.target = code[p_ip + 4];
+		} break;
+		case GDScriptFunction::OPCODE_RETURN: {
+			CHECK_SIZE(2);
+			r_decoded.kind = Decoded::RETURN;
+			if (code[p_ip + 1] == GDScriptFunction::ADDR_NIL) {
+				r_decoded.kind = Decoded::END;
+			} else {
+				r_decoded.args[0] = REGISTER(1);
+				r_decoded.argc = 1;
+			}
+		} break;
+		case GDScriptFunction::OPCODE_RETURN_TYPED_BUILTIN: {
+			CHECK_SIZE(3);
+			r_decoded.kind = Decoded::RETURN;
+			r_decoded.args[0] = REGISTER(1);
+			r_decoded.argc = 1;
+			r_decoded.type = (Variant::Type)code[p_ip + 2];
+			if (!_is_scalar(r_decoded.type)) {
+				return false;
+			}
+		} break;
+		case GDScriptFunction::OPCODE_END: {
+			CHECK_SIZE(1);
+			r_decoded.kind = Decoded::END;
+		} break;
+		case GDScriptFunction::OPCODE_LINE: {
+			CHECK_SIZE(2);
+			r_decoded.kind = Decoded::NOP;
+		} break;
+		default:
+			return false;
+	}
+
+#undef REGISTER
+#undef CHECK_SIZE
+
+	for (int i = 0; i < r_decoded.argc; i++) {
+		if (r_decoded.args[i] < 0) {
+			return false;
+		}
+	}
+
+	// Only stack slots past `self`, the class and `null` can be written.
+	auto is_writable = [p_function](int p_register) {
+		return p_register >= GDScriptFunction::FIXED_ADDRESSES_MAX && p_register < p_function->get_max_stack_size();
+	};
+	switch (r_decoded.kind) {
+		case Decoded::OPERATOR:
+		case Decoded::ASSIGN:
+		case Decoded::ASSIGN_BOOL:
+		case Decoded::CONSTRUCT:
+		case Decoded::TYPE_ADJUST:
+		case Decoded::UTILITY:
+			return is_writable(r_decoded.dst);
+		case Decoded::ITERATE_BEGIN:
+		case Decoded::ITERATE:
+			return is_writable(r_decoded.args[0]) && is_writable(r_decoded.args[2]);
+		default:
+			return true;
+	}
+}
+
+// Result type of an instruction, `NIL` while its operands aren't known yet, or `VARIANT_MAX` if it can't be lowered.
+Variant::Type GDScriptLoweredFunction::_get_result_type(const Decoded &p_decoded, const LocalVector<Variant::Type> &p_register_types) {
+	switch (p_decoded.kind) {
+		case Decoded::OPERATOR: {
+			const Variant::Type a = p_register_types[p_decoded.args[0]];
+			const Variant::Type b = p_decoded.argc > 1 ? p_register_types[p_decoded.args[1]] : Variant::NIL;
+			if (a == Variant::NIL || (p_decoded.argc > 1 && b == Variant::NIL)) {
+				return Variant::NIL;
+			}
+			Operation operation;
+			Variant::Type operand_type;
+			if (!_lower_operator(p_decoded.op, a, b, operation, operand_type)) {
+				return Variant::VARIANT_MAX;
+			}
+			return Variant::get_operator_return_type(p_decoded.op, a, b);
+		}
+		case Decoded::ASSIGN:
+			return p_decoded.type != Variant::NIL ? p_decoded.type : p_register_types[p_decoded.args[0]];
+		case Decoded::ASSIGN_BOOL:
+		case Decoded::CONSTRUCT:
+		case Decoded::TYPE_ADJUST:
+		case Decoded::UTILITY:
+			return p_decoded.type;
+		default:
+			return Variant::NIL;
+	}
+}
+
+GDScriptLoweredFunction *GDScriptLoweredFunction::create(const GDScriptFunction *p_function) {
+	const int stack_size = p_function->get_max_stack_size();
+	if (p_function->_code_ptr == nullptr || p_function->_default_arg_count > 0 || stack_size > MAX_STACK_SIZE) {
+		return nullptr;
+	}
+
+	// Decode the whole function first; anything unsupported rules it out.
+	LocalVector<Decoded> decoded;
+	LocalVector<int> ip_to_decoded;
+	ip_to_decoded.resize(p_function->_code_size + 1);
+	for (int &index : ip_to_decoded) {
+		index = -1;
+	}
+	for (int ip = 0; ip < p_function->_code_size;) {
+		Decoded instruction;
+		if (!_decode(p_function, ip, instruction)) {
+			return nullptr;
+		}
+		ip_to_decoded[ip] = decoded.size();
+		decoded.push_back(instruction);
+		ip += instruction.size;
+	}
+	for (Decoded &instruction : decoded) {
+		if (instruction.target != -1) {
+			if (instruction.target < 0 || instruction.target >= p_function->_code_size || ip_to_decoded[instruction.target] == -1) {
+				return nullptr;
+			}
+			instruction.target = ip_to_decoded[instruction.target];
+		}
+	}
+
+	// Registers are the stack slots, then the constants, then two scratch registers for conversions, then `0` and `1`.
+	const int constant_count = p_function->constants.size();
+	const int scratch = stack_size + constant_count;
+	const int zero = scratch + 2;
+	const int one = zero + 1;
+
+	LocalVector<Variant::Type> register_types;
+	register_types.resize(one + 1);
+	for (Variant::Type &type : register_types) {
+		type = Variant::NIL;
+	}
+	if (p_function->argument_types.size() != p_function->_argument_count) {
+		return nullptr;
+	}
+	for (int i = 0; i < p_function->_argument_count; i++) {
+		const GDScriptDataType &type = p_function->argument_types[i];
+		if (!type.has_type || type.kind != GDScriptDataType::BUILTIN || !_is_scalar(type.builtin_type)) {
+			return nullptr;
+		}
+		register_types[GDScriptFunction::FIXED_ADDRESSES_MAX + i] = type.builtin_type;
+	}
+	for (const KeyValue<int, Variant::Type> &E : p_function->temporary_slots) {
+		if (E.key < stack_size) {
+			register_types[E.key] = E.value;
+		}
+	}
+	for (int i = 0; i < constant_count; i++) {
+		const Variant::Type type = p_function->constants[i].get_type();
+		if (_is_scalar(type)) {
+			register_types[stack_size + i] = type;
+		}
+	}
+
+	// Each stack slot must always hold the same type. Find it from the values written to it.
+	bool changed = true;
+	while (changed) {
+		changed = false;
+		for (const Decoded &instruction : decoded) {
+			if (instruction.kind == Decoded::ITERATE_BEGIN || instruction.kind == Decoded::ITERATE) {
+				for (int i = 0; i < 3; i += 2) {
+					Variant::Type &type = register_types[instruction.args[i]];
+					if (type == Variant::NIL) {
+						type = Variant::INT;
+						changed = true;
+					} else if (type != Variant::INT) {
+						return nullptr;
+					}
+				}
+				continue;
+			}
+			if (instruction.dst == -1) {
+				continue;
+			}
+			const Variant::Type result_type = _get_result_type(instruction, register_types);
+			if (result_type == Variant::VARIANT_MAX || (result_type != Variant::NIL && !_is_scalar(result_type))) {
+				return nullptr;
+			}
+			if (result_type == Variant::NIL) {
+				continue;
+			}
+			Variant::Type &type = register_types[instruction.dst];
+			if (type == Variant::NIL) {
+				type = result_type;
+				changed = true;
+			} else if (type != result_type) {
+				return nullptr;
+			}
+		}
+	}
+
+	// Every read needs a known type, matching what validated instructions were compiled for.
+	for (const Decoded &instruction : decoded) {
+		for (int i = 0; i < instruction.argc; i++) {
+			const Variant::Type type = register_types[instruction.args[i]];
+			if (!_is_scalar(type)) {
+				return nullptr;
+			}
+			if (instruction.validated && instruction.kind != Decoded::CONSTRUCT && type != instruction.arg_types[i]) {
+				return nullptr;
+			}
+		}
+		switch (instruction.kind) {
+			case Decoded::CONSTRUCT:
+				if (instruction.argc == 1 && register_types[instruction.args[0]] != instruction.arg_types[0]) {
+					return nullptr;
+				}
+				break;
+			case Decoded::ASSIGN:
+			case Decoded::RETURN: {
+				const Variant::Type from = register_types[instruction.args[0]];
+				if (instruction.type != Variant::NIL && from != instruction.type && !Variant::can_convert_strict(from, instruction.type)) {
+					return nullptr;
+				}
+			} break;
+			case Decoded::ITERATE_BEGIN:
+			case Decoded::ITERATE:
+				if (register_types[instruction.args[1]] != Variant::INT) {
+					return nullptr;
+				}
+				break;
+			default:
+				break;
+		}
+		if (instruction.dst != -1 && _get_result_type(instruction, register_types) != register_types[instruction.dst]) {
+			return nullptr;
+		}
+	}
+
+	// Slots start out as `null` in the VM, which lowered code can't represent, so each read must follow a write
+	// on every path. Arguments and typed temporaries are set before the first instruction.
+	uint64_t initialized = 0;
+	for (int i = 0; i < p_function->_argument_count; i++) {
+		initialized |= uint64_t(1) << (GDScriptFunction::FIXED_ADDRESSES_MAX + i);
+	}
+	for (const KeyValue<int, Variant::Type> &E : p_function->temporary_slots) {
+		if (E.key < stack_size) {
+			initialized |= uint64_t(1) << E.key;
+		}
+	}
+
+	auto slot_mask = [stack_size](int p_register) -> uint64_t {
+		return p_register < stack_size ? uint64_t(1) << p_register : 0;
+	};
+
+	LocalVector<uint64_t> written_before;
+	LocalVector<bool> reached;
+	written_before.resize(decoded.size());
+	reached.resize(decoded.size());
+	for (uint32_t i = 0; i < decoded.size(); i++) {
+		written_before[i] = 0;
+		reached[i] = false;
+	}
+	LocalVector<int> pending;
+	written_before[0] = initialized;
+	reached[0] = true;
+	pending.push_back(0);
+
+	while (!pending.is_empty()) {
+		const int index = pending[pending.size() - 1];
+		pending.remove_at(pending.size() - 1);
+		const Decoded &instruction = decoded[index];
+
+		uint64_t written = written_before[index];
+		uint64_t written_on_jump = written;
+		if (instruction.kind == Decoded::ITERATE_BEGIN || instruction.kind == Decoded::ITERATE) {
+			// The iterator is only assigned when the loop goes on.
+			written_on_jump |= slot_mask(instruction.args[0]);
+			written = written_on_jump | slot_mask(instruction.args[2]);
+		} else if (instruction.dst != -1) {
+			written |= slot_mask(instruction.dst);
+			written_on_jump = written;
+		}
+
+		int successors[2] = { -1, -1 };
+		uint64_t successor_written[2] = { written, written_on_jump };
+		switch (instruction.kind) {
+			case Decoded::JUMP:
+				successors[1] = instruction.target;
+				break;
+			case Decoded::RETURN:
+			case Decoded::END:
+				break;
+			default:
+				successors[0] = index + 1 < (int)decoded.size() ? index + 1 : -1;
+				successors[1] = instruction.target;
+				break;
+		}
+		for (int i = 0; i < 2; i++) {
+			const int successor = successors[i];
+			if (successor == -1) {
+				continue;
+			}
+			if (!reached[successor]) {
+				reached[successor] = true;
+				written_before[successor] = successor_written[i];
+				pending.push_back(successor);
+			} else if ((written_before[successor] & successor_written[i]) != written_before[successor]) {
+				written_before[successor] &= successor_written[i];
+				pending.push_back(successor);
+			}
+		}
+	}
+
+	for (uint32_t i = 0; i < decoded.size(); i++) {
+		if (!reached[i]) {
+			continue;
+		}
+		uint64_t read = 0;
+		for (int j = 0; j < decoded[i].argc; j++) {
+			if ((decoded[i].kind == Decoded::ITERATE_BEGIN && j != 1) || (decoded[i].kind == Decoded::ITERATE && j == 2)) {
+				continue; // Loops write their counter and iterator.
+			}
+			read |= slot_mask(decoded[i].args[j]);
+		}
+		if ((read & written_before[i]) != read) {
+			return nullptr;
+		}
+	}
+
+	// Emit the lowered instructions.
+	GDScriptLoweredFunction *lowered = memnew(GDScriptLoweredFunction);
+	LocalVector<Instruction> &instructions = lowered->instructions;
+
+	auto emit = [&instructions](Operation p_op, int p_dst, int p_a = 0, int p_b = 0, int p_c = 0) {
+		Instruction instruction;
+		instruction.op = p_op;
+		instruction.dst = p_dst;
+		instruction.a = p_a;
+		instruction.b = p_b;
+		instruction.c = p_c;
+		instructions.push_back(instruction);
+	};
+
+	auto emit_conversion = [&emit](int p_dst, int p_src, Variant::Type p_from, Variant::Type p_to) {
+		if (p_to == Variant::FLOAT && p_from != Variant::FLOAT) {
+			emit(OP_INT_TO_FLOAT, p_dst, p_src);
+		} else if (p_to == Variant::INT && p_from == Variant::FLOAT) {
+			emit(OP_FLOAT_TO_INT, p_dst, p_src);
+		} else if (p_to == Variant::BOOL && p_from == Variant::INT) {
+			emit(OP_INT_TO_BOOL, p_dst, p_src);
+		} else if (p_to == Variant::BOOL && p_from == Variant::FLOAT) {
+			emit(OP_FLOAT_TO_BOOL, p_dst, p_src);
+		} else if (p_dst != p_src) {
+			emit(OP_COPY, p_dst, p_src);
+		}
+	};
+
+	// Operands only get converted when their representation differs, since integers can stand for booleans as is.
+	auto operand = [&emit_conversion, scratch](int p_register, Variant::Type p_from, Variant::Type p_to, int p_scratch) {
+		if (p_from == p_to || (p_from != Variant::FLOAT && p_to != Variant::FLOAT)) {
+			return p_register;
+		}
+		emit_conversion(scratch + p_scratch, p_register, p_from, p_to);
+		return scratch + p_scratch;
+	};
+
+	LocalVector<int> decoded_to_instruction;
+	decoded_to_instruction.resize(decoded.size());
+	for (uint32_t i = 0; i < decoded.size(); i++) {
+		const Decoded &instruction = decoded[i];
+		decoded_to_instruction[i] = instructions.size();
+
+		switch (instruction.kind) {
+			case Decoded::OPERATOR: {
+				const Variant::Type a_type = register_types[instruction.args[0]];
+				const Variant::Type b_type = instruction.argc > 1 ? register_types[instruction.args[1]] : Variant::NIL;
+				Operation operation;
+				Variant::Type operand_type;
+				_lower_operator(instruction.op, a_type, b_type, operation, operand_type);
+				const int a = operand(instruction.args[0], a_type, operand_type, 0);
+				const int b = instruction.argc > 1 ? operand(instruction.args[1], b_type, operand_type, 1) : 0;
+				emit(operation, instruction.dst, a, b);
+				if (instruction.jump_if_not) {
+					emit(OP_JUMP_IF_NOT, instruction.target, instruction.dst);
+				}
+			} break;
+			case Decoded::JUMP: {
+				emit(OP_JUMP, instruction.target);
+			} break;
+			case Decoded::JUMP_IF:
+			case Decoded::JUMP_IF_NOT: {
+				const int condition = operand(instruction.args[0], register_types[instruction.args[0]], Variant::BOOL, 0);
+				emit(instruction.kind == Decoded::JUMP_IF ? OP_JUMP_IF : OP_JUMP_IF_NOT, instruction.target, condition);
+			} break;
+			case Decoded::ASSIGN: {
+				const Variant::Type from = register_types[instruction.args[0]];
+				emit_conversion(instruction.dst, instruction.args[0], from, instruction.type != Variant::NIL ? instruction.type : from);
+			} break;
+			case Decoded::ASSIGN_BOOL: {
+				emit(OP_COPY, instruction.dst, instruction.value ? one : zero);
+			} break;
+			case Decoded::CONSTRUCT: {
+				if (instruction.argc == 0) {
+					emit(OP_COPY, instruction.dst, zero); // `false`, `0` and `0.0` all have no bits set.
+				} else {
+					emit_conversion(instruction.dst, instruction.args[0], instruction.arg_types[0], instruction.type);
+				}
+			} break;
+			case Decoded::UTILITY: {
+				emit(instruction.utility, instruction.dst, instruction.args[0], instruction.args[1], instruction.args[2]);
+			} break;
+			case Decoded::ITERATE_BEGIN:
+			case Decoded::ITERATE: {
+				emit(instruction.kind == Decoded::ITERATE_BEGIN ? OP_ITERATE_BEGIN : OP_ITERATE, instruction.target, instruction.args[0], instruction.args[1], instruction.args[2]);
+			} break;
+			case Decoded::RETURN: {
+				const Variant::Type from = register_types[instruction.args[0]];
+				if (instruction.type == Variant::NIL || instruction.type == from) {
+					emit(OP_RETURN, 0, instruction.args[0], from);
+				} else {
+					emit_conversion(scratch, instruction.args[0], from, instruction.type);
+					emit(OP_RETURN, 0, scratch, instruction.type);
+				}
+			} break;
+			case Decoded::END: {
+				emit(OP_RETURN_NIL, 0);
+			} break;
+			case Decoded::TYPE_ADJUST:
+			case Decoded::NOP:
+				// Registers already have their type.
+				break;
+		}
+	}
+
+	// Jumps were emitted with the index of the decoded instruction.
+	for (Instruction &instruction : instructions) {
+		if (instruction.op >= OP_JUMP && instruction.op <= OP_ITERATE) {
+			instruction.dst = decoded_to_instruction[instruction.dst];
+		}
+	}
+
+	lowered->initial_registers.resize(register_types.size());
+	for (Register &reg : lowered->initial_registers) {
+		reg.i = 0;
+	}
+	for (int i = 0; i < constant_count; i++) {
+		const Variant &constant = p_function->constants[i];
+		Register &reg = lowered->initial_registers[stack_size + i];
+		switch (constant.get_type()) {
+			case Variant::BOOL:
+				reg.i = *VariantInternal::get_bool(&constant) ? 1 : 0;
+				break;
+			case Variant::INT:
+				reg.i = *VariantInternal::get_int(&constant);
+				break;
+			case Variant::FLOAT:
+				reg.f = *VariantInternal::get_float(&constant);
+				break;
+			default:
+				break;
+		}
+	}
+	lowered->initial_registers[one].i = 1;
+
+	lowered->argument_types.resize(p_function->_argument_count);
+	for (int i = 0; i < p_function->_argument_count; i++) {
+		lowered->argument_types[i] = p_function->argument_types[i].builtin_type;
+	}
+
+	return lowered;
+}
+
+Variant GDScriptLoweredFunction::_box(const Register &p_register, Variant::Type p_type) {
+	switch (p_type) {
+		case Variant::BOOL:
+			return p_register.i != 0;
+		case Variant::INT:
+			return p_register.i;
+		case Variant::FLOAT:
+			return p_register.f;
+		default:
+			return Variant();
+	}
+}
+
+bool GDScriptLoweredFunction::call(const Variant **p_args, int p_argcount, Variant &r_ret) const {
+	if (unlikely(p_argcount != (int)argument_types.size())) {
+		return false;
+	}
+
+	Register *regs = (Register *)alloca(sizeof(Register) * initial_registers.size());
+	memcpy(regs, initial_registers.ptr(), sizeof(Register) * initial_registers.size());
+
+	for (int i = 0; i < p_argcount; i++) {
+		const Variant *arg = p_args[i];
+		Register &reg = regs[GDScriptFunction::FIXED_ADDRESSES_MAX + i];
+		const Variant::Type arg_type = arg->get_type();
+		switch (argument_types[i]) {
+			case Variant::BOOL:
+				if (arg_type != Variant::BOOL) {
+					return false;
+				}
+				reg.i = *VariantInternal::get_bool(arg) ? 1 : 0;
+				break;
+			case Variant::INT:
+				if (arg_type != Variant::INT) {
+					return false;
+				}
+				reg.i = *VariantInternal::get_int(arg);
+				break;
+			case Variant::FLOAT:
+				if (arg_type == Variant::FLOAT) {
+					reg.f = *VariantInternal::get_float(arg);
+				} else if (arg_type == Variant::INT) {
+					reg.f = (double)*VariantInternal::get_int(arg);
+				} else {
+					return false;
+				}
+				break;
+			default:
+				return false;
+		}
+	}
+
+	const Instruction *code = instructions.ptr();
+	const Instruction *ip = code;
+
+#define I(m_field) regs[ip->m_field].i
+#define F(m_field) regs[ip->m_field].f
+
+	while (true) {
+		switch (ip->op) {
+			case OP_COPY:
+				regs[ip->dst] = regs[ip->a];
+				break;
+			case OP_INT_TO_FLOAT:
+				F(dst) = (double)I(a);
+				break;
+			case OP_FLOAT_TO_INT:
+				// NaN and values outside of the `int` range have no defined conversion, so the VM gives whatever the platform does.
+				if (unlikely(!(F(a) >= -9223372036854775808.0 && F(a) < 9223372036854775808.0))) {
+					return false;
+				}
+				I(dst) = (int64_t)F(a);
+				break;
+			case OP_INT_TO_BOOL:
+				I(dst) = I(a) != 0;
+				break;
+			case OP_FLOAT_TO_BOOL:
+				I(dst) = F(a) != 0.0;
+				break;
+			case OP_ADD_INT:
+				I(dst) = I(a) + I(b);
+				break;
+			case OP_SUBTRACT_INT:
+				I(dst) = I(a) - I(b);
+				break;
+			case OP_MULTIPLY_INT:
+				I(dst) = I(a) * I(b);
+				break;
+			case OP_DIVIDE_INT:
+				// Dividing INT64_MIN by -1 overflows, so like dividing by zero, let the VM handle it.
+				if (unlikely(I(b) == 0 || (I(b) == -1 && I(a) == INT64_MIN))) {
+					return false; // Let the VM report the error.
+				}
+				I(dst) = I(a) / I(b);
+				break;
+			case OP_MODULE_INT:
+				// Same overflow as the division.
+				if (unlikely(I(b) == 0 || (I(b) == -1 && I(a) == INT64_MIN))) {
+					return false;
+				}
+				I(dst) = I(a) % I(b);
+				break;
+			case OP_NEGATE_INT:
+				I(dst) = -I(a);
+				break;
+			case OP_SHIFT_LEFT_INT:
+				if (unlikely(I(a) < 0 || I(b) < 0 || I(b) >= 64)) {
+					return false;
+				}
+				I(dst) = I(a) << I(b);
+				break;
+			case OP_SHIFT_RIGHT_INT:
+				if (unlikely(I(a) < 0 || I(b) < 0 || I(b) >= 64)) {
+					return false;
+				}
+				I(dst) = I(a) >> I(b);
+				break;
+			case OP_BIT_AND_INT:
+				I(dst) = I(a) & I(b);
+				break;
+			case OP_BIT_OR_INT:
+				I(dst) = I(a) | I(b);
+				break;
+			case OP_BIT_XOR_INT:
+				I(dst) = I(a) ^ I(b);
+				break;
+			case OP_BIT_NEGATE_INT:
+				I(dst) = ~I(a);
+				break;
+			case OP_ADD_FLOAT:
+				F(dst) = F(a) + F(b);
+				break;
+			case OP_SUBTRACT_FLOAT:
+				F(dst) = F(a) - F(b);
+				break;
+			case OP_MULTIPLY_FLOAT:
+				F(dst) = F(a) * F(b);
+				break;
+			case OP_DIVIDE_FLOAT:
+				F(dst) = F(a) / F(b);
+				break;
+			case OP_NEGATE_FLOAT:
+				F(dst) = -F(a);
+				break;
+			case OP_EQUAL_INT:
+				I(dst) = I(a) == I(b);
+				break;
+			case OP_NOT_EQUAL_INT:
+				I(dst) = I(a) != I(b);
+				break;
+			case OP_LESS_INT:
+				I(dst) = I(a) < I(b);
+				break;
+			case OP_LESS_EQUAL_INT:
+				I(dst) = I(a) <= I(b);
+				break;
+			case OP_GREATER_INT:
+				I(dst) = I(a) > I(b);
+				break;
+			case OP_GREATER_EQUAL_INT:
+				I(dst) = I(a) >= I(b);
+				break;
+			case OP_EQUAL_FLOAT:
+				I(dst) = F(a) == F(b);
+				break;
+			case OP_NOT_EQUAL_FLOAT:
+				I(dst) = F(a) != F(b);
+				break;
+			case OP_LESS_FLOAT:
+				I(dst) = F(a) < F(b);
+				break;
+			case OP_LESS_EQUAL_FLOAT:
+				I(dst) = F(a) <= F(b);
+				break;
+			case OP_GREATER_FLOAT:
+				I(dst) = F(a) > F(b);
+				break;
+			case OP_GREATER_EQUAL_FLOAT:
+				I(dst) = F(a) >= F(b);
+				break;
+			case OP_AND:
+				I(dst) = I(a) != 0 && I(b) != 0;
+				break;
+			case OP_OR:
+				I(dst) = I(a) != 0 || I(b) != 0;
+				break;
+			case OP_XOR:
+				I(dst) = (I(a) != 0) != (I(b) != 0);
+				break;
+			case OP_NOT:
+				I(dst) = I(a) == 0;
+				break;
+			case OP_SQRT:
+				F(dst) = VariantUtilityFunctions::sqrt(F(a));
+				break;
+			case OP_SIN:
+				F(dst) = VariantUtilityFunctions::sin(F(a));
+				break;
+			case OP_COS:
+				F(dst) = VariantUtilityFunctions::cos(F(a));
+				break;
+			case OP_ABS_INT:
+				I(dst) = VariantUtilityFunctions::absi(I(a));
+				break;
+			case OP_ABS_FLOAT:
+				F(dst) = VariantUtilityFunctions::absf(F(a));
+				break;
+			case OP_FLOOR:
+				F(dst) = VariantUtilityFunctions::floorf(F(a));
+				break;
+			case OP_CEIL:
+				F(dst) = VariantUtilityFunctions::ceilf(F(a));
+				break;
+			case OP_MIN_INT:
+				I(dst) = VariantUtilityFunctions::mini(I(a), I(b));
+				break;
+			case OP_MAX_INT:
+				I(dst) = VariantUtilityFunctions::maxi(I(a), I(b));
+				break;
+			case OP_MIN_FLOAT:
+				F(dst) = VariantUtilityFunctions::minf(F(a), F(b));
+				break;
+			case OP_MAX_FLOAT:
+				F(dst) = VariantUtilityFunctions::maxf(F(a), F(b));
+				break;
+			case OP_CLAMP_INT:
+				I(dst) = VariantUtilityFunctions::clampi(I(a), I(b), I(c));
+				break;
+			case OP_CLAMP_FLOAT:
+				F(dst) = VariantUtilityFunctions::clampf(F(a), F(b), F(c));
+				break;
+			case OP_JUMP:
+				ip = code + ip->dst;
+				continue;
+			case OP_JUMP_IF:
+				if (I(a) != 0) {
+					ip = code + ip->dst;
+					continue;
+				}
+				break;
+			case OP_JUMP_IF_NOT:
+				if (I(a) == 0) {
+					ip = code + ip->dst;
+					continue;
+				}
+				break;
+			case OP_ITERATE_BEGIN:
+				I(a) = 0;
+				if (I(b) <= 0) {
+					ip = code + ip->dst;
+					continue;
+				}
+				I(c) = 0;
+				break;
+			case OP_ITERATE:
+				I(a)++;
+				if (I(a) >= I(b)) {
+					ip = code + ip->dst;
+					continue;
+				}
+				I(c) = I(a);
+				break;
+			case OP_RETURN:
+				r_ret = _box(regs[ip->a], (Variant::Type)ip->b);
+				return true;
+			case OP_RETURN_NIL:
+				r_ret = Variant();
+				return true;
+		}
+		ip++;
+	}
+
+#undef F
+#undef I
+}
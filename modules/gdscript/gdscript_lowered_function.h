@@ -0,0 +1,148 @@
+/**************************************************************************/
+/*  gdscript_lowered_function.h                                           */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef GDSCRIPT_LOWERED_FUNCTION_H
+#define GDSCRIPT_LOWERED_FUNCTION_H
+
+#include "core/templates/local_vector.h"
+#include "core/variant/variant.h"
+
+class GDScriptFunction;
+
+// Alternative form of fully typed GDScript functions that only compute on `bool`, `int` and `float` values.
+// The bytecode is translated to instructions working on unboxed registers, which skips the Variant
+// dispatch and type bookkeeping done by the VM.
+// Such functions can't have side effects, so whenever the lowered code runs into a case it doesn't handle
+// (an unexpected argument type, a division by zero), the call is simply started over in the VM.
+class GDScriptLoweredFunction {
+public:
+	enum Operation : uint8_t {
+		OP_COPY,
+		OP_INT_TO_FLOAT,
+		OP_FLOAT_TO_INT,
+		OP_INT_TO_BOOL,
+		OP_FLOAT_TO_BOOL,
+		OP_ADD_INT,
+		OP_SUBTRACT_INT,
+		OP_MULTIPLY_INT,
+		OP_DIVIDE_INT,
+		OP_MODULE_INT,
+		OP_NEGATE_INT,
+		OP_SHIFT_LEFT_INT,
+		OP_SHIFT_RIGHT_INT,
+		OP_BIT_AND_INT,
+		OP_BIT_OR_INT,
+		OP_BIT_XOR_INT,
+		OP_BIT_NEGATE_INT,
+		OP_ADD_FLOAT,
+		OP_SUBTRACT_FLOAT,
+		OP_MULTIPLY_FLOAT,
+		OP_DIVIDE_FLOAT,
+		OP_NEGATE_FLOAT,
+		OP_EQUAL_INT,
+		OP_NOT_EQUAL_INT,
+		OP_LESS_INT,
+		OP_LESS_EQUAL_INT,
+		OP_GREATER_INT,
+		OP_GREATER_EQUAL_INT,
+		OP_EQUAL_FLOAT,
+		OP_NOT_EQUAL_FLOAT,
+		OP_LESS_FLOAT,
+		OP_LESS_EQUAL_FLOAT,
+		OP_GREATER_FLOAT,
+		OP_GREATER_EQUAL_FLOAT,
+		OP_AND,
+		OP_OR,
+		OP_XOR,
+		OP_NOT,
+		OP_SQRT,
+		OP_SIN,
+		OP_COS,
+		OP_ABS_INT,
+		OP_ABS_FLOAT,
+		OP_FLOOR,
+		OP_CEIL,
+		OP_MIN_INT,
+		OP_MAX_INT,
+		OP_MIN_FLOAT,
+		OP_MAX_FLOAT,
+		OP_CLAMP_INT,
+		OP_CLAMP_FLOAT,
+		OP_JUMP,
+		OP_JUMP_IF,
+		OP_JUMP_IF_NOT,
+		OP_ITERATE_BEGIN,
+		OP_ITERATE,
+		OP_RETURN,
+		OP_RETURN_NIL,
+	};
+
+	// Booleans are stored as 0 or 1 in `i`.
+	union Register {
+		int64_t i;
+		double f;
+	};
+
+	// Jumps keep their destination in `dst`. Loops use `a` for the counter, `b` for the size, and `c` for the iterator.
+	struct Instruction {
+		Operation op = OP_RETURN_NIL;
+		int32_t dst = 0;
+		int32_t a = 0;
+		int32_t b = 0;
+		int32_t c = 0;
+	};
+
+	enum {
+		MAX_STACK_SIZE = 64, // One bit per stack slot when checking that reads come after writes.
+	};
+
+private:
+	LocalVector<Instruction> instructions;
+	LocalVector<Register> initial_registers;
+	LocalVector<Variant::Type> argument_types;
+
+	struct Decoded;
+
+	static int _address_to_register(const GDScriptFunction *p_function, int p_address);
+	static bool _decode(const GDScriptFunction *p_function, int p_ip, Decoded &r_decoded);
+	static Variant::Type _get_result_type(const Decoded &p_decoded, const LocalVector<Variant::Type> &p_register_types);
+	static Variant _box(const Register &p_register, Variant::Type p_type);
+
+public:
+	// Returns `nullptr` when the function uses anything the lowered form can't express.
+	static GDScriptLoweredFunction *create(const GDScriptFunction *p_function);
+
+	// Returns `false` without any effect when the call has to go through the VM.
+	bool call(const Variant **p_args, int p_argcount, Variant &r_ret) const;
+
+	uint32_t get_instruction_count() const { return instructions.size(); }
+};
+
+#endif // GDSCRIPT_LOWERED_FUNCTION_H
@@ -0,0 +1,13 @@
+class Freer extends Node:
+	func free_target(target):
+		@warning_ignore("unsafe_method_access")
+		target.free()
+
+# Calls through the inline cache of an untyped call site must lock the object, like regular calls do.
+func test():
+	var freer = Freer.new()
+	var receiver = freer
+	@warning_ignore("unsafe_method_access")
+	receiver.free_target(receiver)
+	print(is_instance_valid(freer))
+	freer.free()
@@ -0,0 +1,61 @@
+# Call sites and property reads on untyped values cache their lookups per receiver,
+# and must keep dispatching to the right one when receivers change or outnumber the cache.
+
+class A:
+	var value = 1
+	func get_value():
+		return value
+
+class B:
+	var value = 2
+	func get_value():
+		return value * 10
+
+class C extends A:
+	func get_value():
+		return -value
+
+class D:
+	var value = "d"
+	func get_value():
+		return value
+
+class E:
+	var value := 5
+	var computed: int:
+		get:
+			return value * 100
+	func get_value():
+		return computed
+
+class F:
+	var value: int = 7:
+		get:
+			return 70
+	func get_value():
+		return value
+
+func read(receiver):
+	@warning_ignore("unsafe_method_access", "unsafe_property_access")
+	print(receiver.get_value(), " ", receiver.value)
+
+func test():
+	var receivers = [A.new(), B.new(), C.new(), D.new(), E.new(), F.new()]
+	for _i in 2:
+		for receiver in receivers:
+			read(receiver)
+
+	var e = receivers[4]
+	@warning_ignore("unsafe_property_access")
+	e.value = 6
+	@warning_ignore("unsafe_property_access")
+	print(e.computed)
+	read(e)
+
+	for node in [Node.new(), Node2D.new(), Node3D.new(), Node.new()]:
+		@warning_ignore("unsafe_method_access")
+		node.set_name("Node_" + node.get_class())
+		@warning_ignore("unsafe_method_access")
+		print(node.get_name())
+		@warning_ignore("unsafe_method_access")
+		node.free()
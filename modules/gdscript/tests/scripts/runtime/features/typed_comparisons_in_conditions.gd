@@ -0,0 +1,41 @@
+# Typed comparisons directly followed by a conditional jump are fused into one instruction.
+
+func test():
+	var evens := 0
+	var i := 0
+	while i < 10:
+		if i % 2 == 0:
+			evens += 1
+		i += 1
+	print(evens)
+
+	var x := 0.0
+	var above := 0
+	for _j in 10:
+		x += 0.1
+		if x > 0.55:
+			above += 1
+	print(above)
+
+	# The result of the comparison is still stored when it's a variable read afterwards.
+	var done := i >= 10
+	if done:
+		print("done")
+	print(done)
+
+	var nested := 0
+	for a in 3:
+		for b in 3:
+			if a < b and b < 2:
+				nested += 1
+			elif a == b:
+				nested += 10
+	print(nested)
+
+	# The loop start is a jump target, so the comparison before it must not be fused.
+	var k := 0
+	var keep_going := k < 3
+	while keep_going:
+		k += 1
+		keep_going = k < 3
+	print(k)
@@ -0,0 +1,246 @@
+/**************************************************************************/
+/*  test_gdscript_benchmarks.h                                            */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_GDSCRIPT_BENCHMARKS_H
+#define TEST_GDSCRIPT_BENCHMARKS_H
+
+#include "../gdscript.h"
+
+#include "core/os/os.h"
+#include "tests/test_macros.h"
+
+namespace GDScriptTests {
+
+struct BenchmarkWorkload {
+	const char *name;
+	const char *source;
+};
+
+// Micro workloads isolate one kind of instruction, macro workloads mix them like gameplay code does.
+// Each script has a `run()` function, timed on its own after a warm-up call.
+static const BenchmarkWorkload benchmark_workloads[] = {
+	{ "micro: untyped calls on script objects", R"(
+extends RefCounted
+
+class A:
+	var value = 1
+	func step(x):
+		return x + value
+
+class B:
+	var value = 2
+	func step(x):
+		return x * value
+
+class C:
+	var value = 3
+	func step(x):
+		return x - value
+
+func run():
+	var items = [A.new(), B.new(), C.new()]
+	var total = 0
+	for i in 100000:
+		var item = items[i % 3]
+		total = item.step(total) % 1000
+		total += item.value
+	return total
+)" },
+	{ "micro: untyped calls on nodes", R"(
+extends RefCounted
+
+func run():
+	var node = Node2D.new()
+	var total = 0.0
+	for i in 100000:
+		node.set_rotation(i * 0.001)
+		total += node.get_rotation()
+	node.free()
+	return total
+)" },
+	{ "micro: typed comparisons in loops", R"(
+extends RefCounted
+
+func run():
+	var count := 0
+	var i := 0
+	while i < 1000000:
+		if i % 3 == 0:
+			count += 1
+		i += 1
+	return count
+)" },
+	{ "macro: entity update", R"(
+extends RefCounted
+
+class Entity:
+	var position := Vector2()
+	var velocity := Vector2()
+
+	func update(delta: float) -> void:
+		position += velocity * delta
+		if position.x > 100.0 or position.x < 0.0:
+			velocity.x = -velocity.x
+		if position.y > 100.0 or position.y < 0.0:
+			velocity.y = -velocity.y
+
+func run():
+	var entities = []
+	for i in 1000:
+		var entity = Entity.new()
+		entity.position = Vector2(i % 100, (i / 10) % 100)
+		entity.velocity = Vector2(i % 7 - 3, i % 5 - 2)
+		entities.append(entity)
+	for frame in 100:
+		for entity in entities:
+			entity.update(0.016)
+	var sum = Vector2()
+	for entity in entities:
+		sum += entity.position
+	return sum
+)" },
+	{ "macro: strings and dictionaries", R"(
+extends RefCounted
+
+func run():
+	var counts = {}
+	var words = ["alpha", "beta", "gamma", "delta", "epsilon"]
+	for i in 50000:
+		var word = words[i % words.size()] + str(i % 13)
+		counts[word] = counts.get(word, 0) + 1
+	var keys = counts.keys()
+	keys.sort()
+	return keys.size()
+)" },
+};
+
+// Not run by default, since timings are only meaningful on an otherwise idle machine.
+// Run with `--test --no-skip --test-case="*[Benchmark]*"`.
+TEST_CASE("[Modules][GDScript][Benchmark] Micro and macro workloads" * doctest::skip()) {
+	const int runs = 5;
+
+	for (const BenchmarkWorkload &workload : benchmark_workloads) {
+		Ref<GDScript> gdscript = memnew(GDScript);
+		gdscript->set_source_code(workload.source);
+		ERR_PRINT_OFF;
+		const Error error = gdscript->reload();
+		ERR_PRINT_ON;
+		REQUIRE_MESSAGE(error == OK, vformat("The \"%s\" workload should compile.", workload.name));
+
+		Ref<RefCounted> object = memnew(RefCounted);
+		object->set_script(gdscript);
+		const Variant expected = object->call("run");
+
+		uint64_t best_usec = UINT64_MAX;
+		for (int i = 0; i < runs; i++) {
+			const uint64_t begin = OS::get_singleton()->get_ticks_usec();
+			const Variant result = object->call("run");
+			best_usec = MIN(best_usec, OS::get_singleton()->get_ticks_usec() - begin);
+			CHECK(result == expected);
+		}
+
+		MESSAGE(vformat("%s: %d usec (best of %d).", workload.name, best_usec, runs));
+	}
+}
+
+// Not run by default, since timings are only meaningful on an otherwise idle machine.
+// Run with `--test --no-skip --test-case="*[Benchmark]*"`.
+TEST_CASE("[Modules][GDScript][Benchmark] Typed numeric functions, lowered and interpreted" * doctest::skip()) {
+	const String source = R"(
+extends RefCounted
+
+func count_primes(limit: int) -> int:
+	var count := 0
+	for n in limit:
+		if n < 2:
+			continue
+		var is_prime := true
+		var d := 2
+		while d * d <= n:
+			if n % d == 0:
+				is_prime = false
+				break
+			d += 1
+		if is_prime:
+			count += 1
+	return count
+
+func integrate(steps: int) -> float:
+	var total := 0.0
+	var dx := 1.0 / steps
+	for i in steps:
+		var x := (i + 0.5) * dx
+		total += sqrt(1.0 - x * x) * dx
+	return total * 4.0
+)";
+	const int runs = 5;
+	GDScriptLanguage *lang = GDScriptLanguage::get_singleton();
+	const bool was_lowering = lang->is_lowering_typed_functions();
+
+	const Pair<StringName, Variant> calls[] = {
+		{ "count_primes", 200000 },
+		{ "integrate", 1000000 },
+	};
+	Variant results[2][2];
+
+	for (int lower = 0; lower < 2; lower++) {
+		lang->set_lowering_typed_functions(lower);
+		Ref<GDScript> gdscript = memnew(GDScript);
+		gdscript->set_source_code(source);
+		ERR_PRINT_OFF;
+		const Error error = gdscript->reload();
+		ERR_PRINT_ON;
+		lang->set_lowering_typed_functions(was_lowering);
+		REQUIRE(error == OK);
+
+		Ref<RefCounted> object = memnew(RefCounted);
+		object->set_script(gdscript);
+
+		for (int i = 0; i < 2; i++) {
+			results[lower][i] = object->call(calls[i].first, calls[i].second);
+
+			uint64_t best_usec = UINT64_MAX;
+			for (int j = 0; j < runs; j++) {
+				const uint64_t begin = OS::get_singleton()->get_ticks_usec();
+				object->call(calls[i].first, calls[i].second);
+				best_usec = MIN(best_usec, OS::get_singleton()->get_ticks_usec() - begin);
+			}
+			MESSAGE(vformat("%s (%s): %d usec (best of %d).", calls[i].first, lower ? "lowered" : "interpreted", best_usec, runs));
+		}
+	}
+
+	for (int i = 0; i < 2; i++) {
+		CHECK_MESSAGE(results[0][i] == results[1][i], vformat("%s should give the same result either way.", calls[i].first));
+	}
+}
+
+} // namespace GDScriptTests
+
+#endif // TEST_GDSCRIPT_BENCHMARKS_H
@@ -1247,16 +1247,30 @@ void GodotNavigationServer3D::set_active(bool p_active) {
 }
 
 void GodotNavigationServer3D::flush_queries() {
-	// In c++ we can't be sure that this is performed in the main thread
-	// even with mutable functions.
-	MutexLock lock(commands_mutex);
-	MutexLock lock2(operations_mutex);
+	LocalVector<Callable> batch_callbacks;
+
+	{
+		// Running path query batches may still read the regions and links the commands free.
+		// New batches wait for the lock until the commands are flushed, and the callbacks of the
+		// collected batches are only called afterwards, since they may start new batches.
+		MutexLock batches_lock(path_query_batches_mutex);
+		_collect_path_query_batches(batch_callbacks);
+
+		// In c++ we can't be sure that this is performed in the main thread
+		// even with mutable functions.
+		MutexLock lock(commands_mutex);
+		MutexLock lock2(operations_mutex);
+
+		for (SetCommand *command : commands) {
+			command->exec(this);
+			memdelete(command);
+		}
+		commands.clear();
+	}
 
-	for (SetCommand *command : commands) {
-		command->exec(this);
-		memdelete(command);
+	for (const Callable &callback : batch_callbacks) {
+		callback.call();
 	}
-	commands.clear();
 }
 
 void GodotNavigationServer3D::map_force_update(RID p_map) {
@@ -1284,6 +1298,8 @@ void GodotNavigationServer3D::sync() {
 }
 
 void GodotNavigationServer3D::process(real_t p_delta_time) {
+	MemoryTagScope tag_scope(Memory::TAG_NAVIGATION);
+
 	flush_queries();
 
 	if (!active) {
@@ -1352,10 +1368,14 @@ void GodotNavigationServer3D::finish() {
 }
 
 PathQueryResult GodotNavigationServer3D::_query_path(const PathQueryParameters &p_parameters) const {
-	PathQueryResult r_query_result;
-
 	const NavMap *map = map_owner.get_or_null(p_parameters.map);
-	ERR_FAIL_NULL_V(map, r_query_result);
+	ERR_FAIL_NULL_V(map, PathQueryResult());
+
+	return _query_path_on_map(map, p_parameters);
+}
+
+PathQueryResult GodotNavigationServer3D::_query_path_on_map(const NavMap *map, const PathQueryParameters &p_parameters) const {
+	PathQueryResult r_query_result;
 
 	// run the pathfinding
 
@@ -1573,3 +1593,127 @@ int GodotNavigationServer3D::get_process_info(ProcessInfo p_info) const {
 
 #undef COMMAND_1
 #undef COMMAND_2
+
+int64_t GodotNavigationServer3D::query_path_batch(const TypedArray<NavigationPathQueryParameters3D> &p_query_parameters, const TypedArray<NavigationPathQueryResult3D> &p_query_results, const Callable &p_callback) {
+	ERR_FAIL_COND_V_MSG(p_query_parameters.size() != p_query_results.size(), 0, "Path query batches need as many result objects as query parameters.");
+
+	PathQueryBatch *batch = memnew(PathQueryBatch);
+	batch->parameters.resize(p_query_parameters.size());
+	batch->maps.resize(p_query_parameters.size());
+	batch->results.resize(p_query_parameters.size());
+	batch->query_results = p_query_results;
+	batch->callback = p_callback;
+
+	// Resolve the maps here, the map owner is not safe to read from the worker threads.
+	for (uint32_t i = 0; i < batch->parameters.size(); i++) {
+		Ref<NavigationPathQueryParameters3D> query_parameters = p_query_parameters[i];
+		Ref<NavigationPathQueryResult3D> query_result = p_query_results[i];
+		if (query_parameters.is_null() || query_result.is_null()) {
+			memdelete(batch);
+			ERR_FAIL_V_MSG(0, vformat("Invalid query parameters or result object at index %d of the path query batch.", i));
+		}
+
+		batch->parameters[i] = query_parameters->get_parameters();
+		batch->maps[i] = map_owner.get_or_null(batch->parameters[i].map);
+	}
+
+	MutexLock lock(path_query_batches_mutex);
+
+	int64_t batch_id = ++last_path_query_batch_id;
+	if (!batch->parameters.is_empty()) {
+		batch->group_id = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotNavigationServer3D::_query_path_batch_task, batch, batch->parameters.size(), -1, true, SNAME("NavigationServer3DPathQueryBatch"));
+	}
+	path_query_batches.insert(batch_id, batch);
+
+	return batch_id;
+}
+
+void GodotNavigationServer3D::_query_path_batch_task(uint32_t p_index, PathQueryBatch *p_batch) {
+	const NavMap *map = p_batch->maps[p_index];
+	ERR_FAIL_NULL(map);
+
+	p_batch->results[p_index] = _query_path_on_map(map, p_batch->parameters[p_index]);
+}
+
+bool GodotNavigationServer3D::is_query_path_batch_completed(int64_t p_batch_id) {
+	{
+		MutexLock lock(path_query_batches_mutex);
+
+		PathQueryBatch **batch = path_query_batches.getptr(p_batch_id);
+		ERR_FAIL_NULL_V_MSG(batch, false, vformat("Invalid path query batch ID %d, or the batch was already collected.", p_batch_id));
+		if ((*batch)->group_id != -1 && !WorkerThreadPool::get_singleton()->is_group_task_completed((*batch)->group_id)) {
+			return false;
+		}
+	}
+
+	Callable callback;
+	if (_collect_path_query_batch(p_batch_id, callback) && callback.is_valid()) {
+		callback.call();
+	}
+	return true;
+}
+
+void GodotNavigationServer3D::wait_for_query_path_batch(int64_t p_batch_id) {
+	Callable callback;
+	ERR_FAIL_COND_MSG(!_collect_path_query_batch(p_batch_id, callback), vformat("Invalid path query batch ID %d, or the batch was already collected.", p_batch_id));
+
+	if (callback.is_valid()) {
+		callback.call();
+	}
+}
+
+bool GodotNavigationServer3D::_collect_path_query_batch(int64_t p_batch_id, Callable &r_callback) {
+	PathQueryBatch *batch = nullptr;
+	{
+		MutexLock lock(path_query_batches_mutex);
+
+		PathQueryBatch **batch_ptr = path_query_batches.getptr(p_batch_id);
+		if (!batch_ptr) {
+			return false;
+		}
+		batch = *batch_ptr;
+		path_query_batches.erase(p_batch_id);
+	}
+
+	if (batch->group_id != -1) {
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(batch->group_id);
+	}
+
+	for (uint32_t i = 0; i < batch->results.size(); i++) {
+		Ref<NavigationPathQueryResult3D> query_result = batch->query_results[i];
+		const PathQueryResult &result = batch->results[i];
+
+		query_result->set_path(result.path);
+		query_result->set_path_types(result.path_types);
+		query_result->set_path_rids(result.path_rids);
+		query_result->set_path_owner_ids(result.path_owner_ids);
+	}
+
+	// Left to the caller, which may still hold locks the callback must not run under.
+	if (batch->callback.is_valid()) {
+		r_callback = batch->callback.bind(p_batch_id);
+	}
+	memdelete(batch);
+
+	return true;
+}
+
+void GodotNavigationServer3D::_collect_path_query_batches(LocalVector<Callable> &r_callbacks) {
+	LocalVector<int64_t> batch_ids;
+	{
+		MutexLock lock(path_query_batches_mutex);
+
+		for (const KeyValue<int64_t, PathQueryBatch *> &E : path_query_batches) {
+			batch_ids.push_back(E.key);
+		}
+	}
+
+	// In submission order, so callbacks are called in the order the batches were started.
+	batch_ids.sort();
+	for (int64_t batch_id : batch_ids) {
+		Callable callback;
+		if (_collect_path_query_batch(batch_id, callback) && callback.is_valid()) {
+			r_callbacks.push_back(callback);
+		}
+	}
+}
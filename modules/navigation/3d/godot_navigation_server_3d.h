@@ -37,6 +37,7 @@
 #include "../nav_obstacle.h"
 #include "../nav_region.h"
 
+#include "core/templates/hash_map.h"
 #include "core/templates/local_vector.h"
 #include "core/templates/rid.h"
 #include "core/templates/rid_owner.h"
@@ -72,6 +73,22 @@ class GodotNavigationServer3D : public NavigationServer3D {
 
 	LocalVector<SetCommand *> commands;
 
+	struct PathQueryBatch {
+		LocalVector<NavigationUtilities::PathQueryParameters> parameters;
+		LocalVector<const NavMap *> maps;
+		LocalVector<NavigationUtilities::PathQueryResult> results;
+		TypedArray<NavigationPathQueryResult3D> query_results;
+		Callable callback;
+		WorkerThreadPool::GroupID group_id = -1;
+	};
+
+	/// Path query batches still running or waiting to be collected. Commands are only
+	/// flushed once every batch is collected, and the lock is held until they are, so their
+	/// queries never see a freed region, link or map.
+	Mutex path_query_batches_mutex;
+	HashMap<int64_t, PathQueryBatch *> path_query_batches;
+	int64_t last_path_query_batch_id = 0;
+
 	mutable RID_Owner<NavLink> link_owner;
 	mutable RID_Owner<NavMap> map_owner;
 	mutable RID_Owner<NavRegion> region_owner;
@@ -286,9 +303,18 @@ public:
 
 	virtual NavigationUtilities::PathQueryResult _query_path(const NavigationUtilities::PathQueryParameters &p_parameters) const override;
 
+	virtual int64_t query_path_batch(const TypedArray<NavigationPathQueryParameters3D> &p_query_parameters, const TypedArray<NavigationPathQueryResult3D> &p_query_results, const Callable &p_callback = Callable()) override;
+	virtual bool is_query_path_batch_completed(int64_t p_batch_id) override;
+	virtual void wait_for_query_path_batch(int64_t p_batch_id) override;
+
 	int get_process_info(ProcessInfo p_info) const override;
 
 private:
+	NavigationUtilities::PathQueryResult _query_path_on_map(const NavMap *p_map, const NavigationUtilities::PathQueryParameters &p_parameters) const;
+	void _query_path_batch_task(uint32_t p_index, PathQueryBatch *p_batch);
+	bool _collect_path_query_batch(int64_t p_batch_id, Callable &r_callback);
+	void _collect_path_query_batches(LocalVector<Callable> &r_callbacks);
+
 	void internal_free_agent(RID p_object);
 	void internal_free_obstacle(RID p_object);
 };
@@ -37,6 +37,7 @@
 
 #include "core/config/project_settings.h"
 #include "core/object/worker_thread_pool.h"
+#include "core/os/arena_allocator.h"
 
 #include <Obstacle2d.h>
 
@@ -103,7 +104,7 @@ void NavMap::set_use_edge_connections(bool p_enabled) {
 		return;
 	}
 	use_edge_connections = p_enabled;
-	regenerate_links = true;
+	regenerate_connections = true;
 }
 
 void NavMap::set_edge_connection_margin(real_t p_edge_connection_margin) {
@@ -111,7 +112,7 @@ void NavMap::set_edge_connection_margin(real_t p_edge_connection_margin) {
 		return;
 	}
 	edge_connection_margin = p_edge_connection_margin;
-	regenerate_links = true;
+	regenerate_connections = true;
 }
 
 void NavMap::set_link_connection_radius(real_t p_link_connection_radius) {
@@ -161,30 +162,32 @@ Vector<Vector3> NavMap::get_path(Vector3 p_origin, Vector3 p_destination, bool p
 	real_t begin_d = FLT_MAX;
 	real_t end_d = FLT_MAX;
 	// Find the initial poly and the end poly on this map.
-	for (const gd::Polygon &p : polygons) {
-		// Only consider the polygon if it in a region with compatible layers.
-		if ((p_navigation_layers & p.owner->get_navigation_layers()) == 0) {
+	for (const NavRegion *region : regions) {
+		// Only consider the polygons of enabled regions with compatible layers.
+		if (!region->get_enabled() || (p_navigation_layers & region->get_navigation_layers()) == 0) {
 			continue;
 		}
 
-		// For each face check the distance between the origin/destination
-		for (size_t point_id = 2; point_id < p.points.size(); point_id++) {
-			const Face3 face(p.points[0].pos, p.points[point_id - 1].pos, p.points[point_id].pos);
-
-			Vector3 point = face.get_closest_point_to(p_origin);
-			real_t distance_to_point = point.distance_to(p_origin);
-			if (distance_to_point < begin_d) {
-				begin_d = distance_to_point;
-				begin_poly = &p;
-				begin_point = point;
-			}
+		for (const gd::Polygon &p : region->get_polygons()) {
+			// For each face check the distance between the origin/destination
+			for (size_t point_id = 2; point_id < p.points.size(); point_id++) {
+				const Face3 face(p.points[0].pos, p.points[point_id - 1].pos, p.points[point_id].pos);
+
+				Vector3 point = face.get_closest_point_to(p_origin);
+				real_t distance_to_point = point.distance_to(p_origin);
+				if (distance_to_point < begin_d) {
+					begin_d = distance_to_point;
+					begin_poly = &p;
+					begin_point = point;
+				}
 
-			point = face.get_closest_point_to(p_destination);
-			distance_to_point = point.distance_to(p_destination);
-			if (distance_to_point < end_d) {
-				end_d = distance_to_point;
-				end_poly = &p;
-				end_point = point;
+				point = face.get_closest_point_to(p_destination);
+				distance_to_point = point.distance_to(p_destination);
+				if (distance_to_point < end_d) {
+					end_d = distance_to_point;
+					end_poly = &p;
+					end_point = point;
+				}
 			}
 		}
 	}
@@ -219,9 +222,14 @@ Vector<Vector3> NavMap::get_path(Vector3 p_origin, Vector3 p_destination, bool p
 		return path;
 	}
 
-	// List of all reachable navigation polys.
-	LocalVector<gd::NavigationPoly> navigation_polys;
-	navigation_polys.reserve(polygons.size() * 0.75);
+	// List of all reachable navigation polys. Each polygon is added at most once, so they fit in an array sized
+	// for the whole map, taken from the scratch memory of the thread instead of being allocated for every query.
+	// Entries are only constructed when reached, so the cost stays proportional to the searched area.
+	ArenaAllocator &scratch = ArenaAllocator::get_thread_scratch();
+	ArenaScope scratch_scope(scratch);
+	const uint32_t navigation_poly_capacity = pm_polygon_count + link_polygons.size();
+	gd::NavigationPoly *navigation_polys = static_cast<gd::NavigationPoly *>(scratch.alloc(sizeof(gd::NavigationPoly) * navigation_poly_capacity, alignof(gd::NavigationPoly)));
+	uint32_t navigation_poly_count = 0;
 
 	// Add the start polygon to the reachable navigation polygons.
 	gd::NavigationPoly begin_navigation_poly = gd::NavigationPoly(begin_poly);
@@ -229,12 +237,17 @@ Vector<Vector3> NavMap::get_path(Vector3 p_origin, Vector3 p_destination, bool p
 	begin_navigation_poly.entry = begin_point;
 	begin_navigation_poly.back_navigation_edge_pathway_start = begin_point;
 	begin_navigation_poly.back_navigation_edge_pathway_end = begin_point;
-	navigation_polys.push_back(begin_navigation_poly);
+	memnew_placement(&navigation_polys[navigation_poly_count++], gd::NavigationPoly(begin_navigation_poly));
 
 	// List of polygon IDs to visit.
 	List<uint32_t> to_visit;
 	to_visit.push_back(0);
 
+	// On maps with a hierarchy, only expand the polygons in the clusters the path goes through on the cluster graph.
+	// Link polygons are not part of any cluster and can always be expanded.
+	HashSet<int32_t> corridor;
+	bool use_corridor = hierarchical_cluster_size > 0 && hierarchy.find_corridor(begin_poly, end_poly, end_point, corridor);
+
 	// This is an implementation of the A* algorithm.
 	int least_cost_id = 0;
 	int prev_least_cost_id = -1;
@@ -256,6 +269,10 @@ Vector<Vector3> NavMap::get_path(Vector3 p_origin, Vector3 p_destination, bool p
 					continue;
 				}
 
+				if (use_corridor && connection.polygon->hierarchy_cluster != -1 && !corridor.has(connection.polygon->hierarchy_cluster)) {
+					continue;
+				}
+
 				const gd::NavigationPoly &least_cost_poly = navigation_polys[least_cost_id];
 				real_t poly_enter_cost = 0.0;
 				real_t poly_travel_cost = least_cost_poly.poly->owner->get_travel_cost();
@@ -269,7 +286,13 @@ Vector<Vector3> NavMap::get_path(Vector3 p_origin, Vector3 p_destination, bool p
 				const Vector3 new_entry = Geometry3D::get_closest_point_to_segment(least_cost_poly.entry, pathway);
 				const real_t new_distance = (least_cost_poly.entry.distance_to(new_entry) * poly_travel_cost) + poly_enter_cost + least_cost_poly.traveled_distance;
 
-				int64_t already_visited_polygon_index = navigation_polys.find(gd::NavigationPoly(connection.polygon));
+				int64_t already_visited_polygon_index = -1;
+				for (uint32_t i = 0; i < navigation_poly_count; i++) {
+					if (navigation_polys[i].poly == connection.polygon) {
+						already_visited_polygon_index = i;
+						break;
+					}
+				}
 
 				if (already_visited_polygon_index != -1) {
 					// Polygon already visited, check if we can reduce the travel cost.
@@ -284,18 +307,19 @@ Vector<Vector3> NavMap::get_path(Vector3 p_origin, Vector3 p_destination, bool p
 					}
 				} else {
 					// Add the neighbor polygon to the reachable ones.
+					ERR_FAIL_COND_V_MSG(navigation_poly_count >= navigation_poly_capacity, Vector<Vector3>(), "Reached more polygons than the map has.");
 					gd::NavigationPoly new_navigation_poly = gd::NavigationPoly(connection.polygon);
-					new_navigation_poly.self_id = navigation_polys.size();
+					new_navigation_poly.self_id = navigation_poly_count;
 					new_navigation_poly.back_navigation_poly_id = least_cost_id;
 					new_navigation_poly.back_navigation_edge = connection.edge;
 					new_navigation_poly.back_navigation_edge_pathway_start = connection.pathway_start;
 					new_navigation_poly.back_navigation_edge_pathway_end = connection.pathway_end;
 					new_navigation_poly.traveled_distance = new_distance;
 					new_navigation_poly.entry = new_entry;
-					navigation_polys.push_back(new_navigation_poly);
+					memnew_placement(&navigation_polys[navigation_poly_count++], gd::NavigationPoly(new_navigation_poly));
 
 					// Add the neighbor polygon to the polygons to visit.
-					to_visit.push_back(navigation_polys.size() - 1);
+					to_visit.push_back(navigation_poly_count - 1);
 				}
 			}
 		}
@@ -305,6 +329,22 @@ Vector<Vector3> NavMap::get_path(Vector3 p_origin, Vector3 p_destination, bool p
 
 		// When the list of polygons to visit is empty at this point it means the End Polygon is not reachable
 		if (to_visit.size() == 0) {
+			if (use_corridor) {
+				// The cluster graph ignores navigation layers, so the corridor may be blocked. Search the whole map instead.
+				use_corridor = false;
+
+				navigation_poly_count = 1;
+				to_visit.clear();
+				to_visit.push_back(0);
+				least_cost_id = 0;
+				prev_least_cost_id = -1;
+
+				reachable_end = nullptr;
+				reachable_d = FLT_MAX;
+
+				continue;
+			}
+
 			// Thus use the further reachable polygon
 			ERR_BREAK_MSG(is_reachable == false, "It's not expect to not find the most reachable polygons");
 			is_reachable = false;
@@ -367,9 +407,7 @@ Vector<Vector3> NavMap::get_path(Vector3 p_origin, Vector3 p_destination, bool p
 			}
 
 			// Reset open and navigation_polys
-			gd::NavigationPoly np = navigation_polys[0];
-			navigation_polys.clear();
-			navigation_polys.push_back(np);
+			navigation_poly_count = 1;
 			to_visit.clear();
 			to_visit.push_back(0);
 			least_cost_id = 0;
@@ -611,40 +649,46 @@ Vector3 NavMap::get_closest_point_to_segment(const Vector3 &p_from, const Vector
 	Vector3 closest_point;
 	real_t closest_point_d = FLT_MAX;
 
-	for (const gd::Polygon &p : polygons) {
-		// For each face check the distance to the segment
-		for (size_t point_id = 2; point_id < p.points.size(); point_id += 1) {
-			const Face3 f(p.points[0].pos, p.points[point_id - 1].pos, p.points[point_id].pos);
-			Vector3 inters;
-			if (f.intersects_segment(p_from, p_to, &inters)) {
-				const real_t d = closest_point_d = p_from.distance_to(inters);
-				if (use_collision == false) {
-					closest_point = inters;
-					use_collision = true;
-					closest_point_d = d;
-				} else if (closest_point_d > d) {
-					closest_point = inters;
-					closest_point_d = d;
+	for (const NavRegion *region : regions) {
+		if (!region->get_enabled()) {
+			continue;
+		}
+
+		for (const gd::Polygon &p : region->get_polygons()) {
+			// For each face check the distance to the segment
+			for (size_t point_id = 2; point_id < p.points.size(); point_id += 1) {
+				const Face3 f(p.points[0].pos, p.points[point_id - 1].pos, p.points[point_id].pos);
+				Vector3 inters;
+				if (f.intersects_segment(p_from, p_to, &inters)) {
+					const real_t d = closest_point_d = p_from.distance_to(inters);
+					if (use_collision == false) {
+						closest_point = inters;
+						use_collision = true;
+						closest_point_d = d;
+					} else if (closest_point_d > d) {
+						closest_point = inters;
+						closest_point_d = d;
+					}
 				}
 			}
-		}
 
-		if (use_collision == false) {
-			for (size_t point_id = 0; point_id < p.points.size(); point_id += 1) {
-				Vector3 a, b;
-
-				Geometry3D::get_closest_points_between_segments(
-						p_from,
-						p_to,
-						p.points[point_id].pos,
-						p.points[(point_id + 1) % p.points.size()].pos,
-						a,
-						b);
-
-				const real_t d = a.distance_to(b);
-				if (d < closest_point_d) {
-					closest_point_d = d;
-					closest_point = b;
+			if (use_collision == false) {
+				for (size_t point_id = 0; point_id < p.points.size(); point_id += 1) {
+					Vector3 a, b;
+
+					Geometry3D::get_closest_points_between_segments(
+							p_from,
+							p_to,
+							p.points[point_id].pos,
+							p.points[(point_id + 1) % p.points.size()].pos,
+							a,
+							b);
+
+					const real_t d = a.distance_to(b);
+					if (d < closest_point_d) {
+						closest_point_d = d;
+						closest_point = b;
+					}
 				}
 			}
 		}
@@ -689,17 +733,23 @@ gd::ClosestPointQueryResult NavMap::get_closest_point_info(const Vector3 &p_poin
 	gd::ClosestPointQueryResult result;
 	real_t closest_point_ds = FLT_MAX;
 
-	for (const gd::Polygon &p : polygons) {
-		// For each face check the distance to the point
-		for (size_t point_id = 2; point_id < p.points.size(); point_id += 1) {
-			const Face3 f(p.points[0].pos, p.points[point_id - 1].pos, p.points[point_id].pos);
-			const Vector3 inters = f.get_closest_point_to(p_point);
-			const real_t ds = inters.distance_squared_to(p_point);
-			if (ds < closest_point_ds) {
-				result.point = inters;
-				result.normal = f.get_plane().normal;
-				result.owner = p.owner->get_self();
-				closest_point_ds = ds;
+	for (const NavRegion *region : regions) {
+		if (!region->get_enabled()) {
+			continue;
+		}
+
+		for (const gd::Polygon &p : region->get_polygons()) {
+			// For each face check the distance to the point
+			for (size_t point_id = 2; point_id < p.points.size(); point_id += 1) {
+				const Face3 f(p.points[0].pos, p.points[point_id - 1].pos, p.points[point_id].pos);
+				const Vector3 inters = f.get_closest_point_to(p_point);
+				const real_t ds = inters.distance_squared_to(p_point);
+				if (ds < closest_point_ds) {
+					result.point = inters;
+					result.normal = f.get_plane().normal;
+					result.owner = p.owner->get_self();
+					closest_point_ds = ds;
+				}
 			}
 		}
 	}
@@ -708,15 +758,46 @@ gd::ClosestPointQueryResult NavMap::get_closest_point_info(const Vector3 &p_poin
 }
 
 void NavMap::add_region(NavRegion *p_region) {
+	// Its polygons are built and connected on the next sync.
 	regions.push_back(p_region);
-	regenerate_links = true;
 }
 
 void NavMap::remove_region(NavRegion *p_region) {
 	int64_t region_index = regions.find(p_region);
 	if (region_index >= 0) {
+		RWLockWrite write_lock(map_rwlock);
+
 		regions.remove_at_unordered(region_index);
-		regenerate_links = true;
+
+		// The region may be freed or moved to another map before the next sync,
+		// so nothing in this map may keep pointing to its polygons until then.
+		for (NavRegion *region : regions) {
+			if (!_are_regions_near(region->get_bounds(), p_region->get_bounds())) {
+				continue;
+			}
+			for (gd::BoundaryEdge &boundary_edge : region->get_boundary_edges()) {
+				Vector<gd::Edge::Connection> &connections = boundary_edge.connection.polygon->edges[boundary_edge.connection.edge].connections;
+				for (int i = connections.size() - 1; i >= 0; i--) {
+					if (p_region->owns_polygon(connections[i].polygon)) {
+						connections.remove_at(i);
+					}
+				}
+			}
+		}
+		for (gd::Polygon &link_polygon : link_polygons) {
+			for (gd::Edge &edge : link_polygon.edges) {
+				for (int i = edge.connections.size() - 1; i >= 0; i--) {
+					if (p_region->owns_polygon(edge.connections[i].polygon)) {
+						edge.connections.remove_at(i);
+					}
+				}
+			}
+		}
+
+		removed_region_bounds.push_back(p_region->get_bounds());
+
+		// The hierarchy points to the polygons of the region too, and rebuilds its clusters on the next sync.
+		hierarchy.remove_region(p_region);
 	}
 }
 
@@ -892,286 +973,92 @@ void NavMap::sync() {
 	int _new_pm_edge_connection_count = pm_edge_connection_count;
 	int _new_pm_edge_free_count = pm_edge_free_count;
 
-	// Check if we need to update the links.
+	// Check if we need to update the polygons.
 	if (regenerate_polygons) {
 		for (NavRegion *region : regions) {
 			region->scratch_polygons();
 		}
-		regenerate_links = true;
 	}
 
+	// Regions whose polygons are rebuilt lose all their connections, and so do their neighbors,
+	// whose edges might have been merged with or connected to them.
+	HashSet<const NavRegion *> regenerated_regions;
+	LocalVector<AABB> changed_bounds = removed_region_bounds;
+	removed_region_bounds.clear();
+
 	for (NavRegion *region : regions) {
+		AABB previous_bounds = region->get_bounds();
 		if (region->sync()) {
-			regenerate_links = true;
+			regenerated_regions.insert(region);
+			changed_bounds.push_back(previous_bounds);
+			changed_bounds.push_back(region->get_bounds());
 		}
 	}
 
+	bool regions_changed = regenerate_connections || !changed_bounds.is_empty();
+	HashSet<const NavRegion *> reconnected_regions;
+
 	for (NavLink *link : links) {
 		if (link->check_dirty()) {
 			regenerate_links = true;
 		}
 	}
 
-	if (regenerate_links) {
-		_new_pm_polygon_count = 0;
-		_new_pm_edge_count = 0;
-		_new_pm_edge_merge_count = 0;
-		_new_pm_edge_connection_count = 0;
-		_new_pm_edge_free_count = 0;
-
-		// Remove regions connections.
+	if (regions_changed) {
+		LocalVector<NavRegion *> affected_regions;
 		for (NavRegion *region : regions) {
-			region->get_connections().clear();
-		}
-
-		// Resize the polygon count.
-		int count = 0;
-		for (const NavRegion *region : regions) {
-			if (!region->get_enabled()) {
-				continue;
+			bool affected = regenerate_connections || regenerated_regions.has(region);
+			for (uint32_t i = 0; i < changed_bounds.size() && !affected; i++) {
+				affected = _are_regions_near(region->get_bounds(), changed_bounds[i]);
 			}
-			count += region->get_polygons().size();
-		}
-		polygons.resize(count);
-
-		// Copy all region polygons in the map.
-		count = 0;
-		for (const NavRegion *region : regions) {
-			if (!region->get_enabled()) {
-				continue;
-			}
-			const LocalVector<gd::Polygon> &polygons_source = region->get_polygons();
-			for (uint32_t n = 0; n < polygons_source.size(); n++) {
-				polygons[count + n] = polygons_source[n];
+			if (affected) {
+				affected_regions.push_back(region);
 			}
-			count += region->get_polygons().size();
 		}
 
-		_new_pm_polygon_count = polygons.size();
-
-		// Group all edges per key.
-		HashMap<gd::EdgeKey, Vector<gd::Edge::Connection>, gd::EdgeKey> connections;
-		for (gd::Polygon &poly : polygons) {
-			for (uint32_t p = 0; p < poly.points.size(); p++) {
-				int next_point = (p + 1) % poly.points.size();
-				gd::EdgeKey ek(poly.points[p].key, poly.points[next_point].key);
-
-				HashMap<gd::EdgeKey, Vector<gd::Edge::Connection>, gd::EdgeKey>::Iterator connection = connections.find(ek);
-				if (!connection) {
-					connections[ek] = Vector<gd::Edge::Connection>();
-					_new_pm_edge_count += 1;
-				}
-				if (connections[ek].size() <= 1) {
-					// Add the polygon/edge tuple to this key.
-					gd::Edge::Connection new_connection;
-					new_connection.polygon = &poly;
-					new_connection.edge = p;
-					new_connection.pathway_start = poly.points[p].pos;
-					new_connection.pathway_end = poly.points[next_point].pos;
-					connections[ek].push_back(new_connection);
-				} else {
-					// The edge is already connected with another edge, skip.
-					ERR_PRINT_ONCE("Navigation map synchronization error. Attempted to merge a navigation mesh polygon edge with another already-merged edge. This is usually caused by crossing edges, overlapping polygons, or a mismatch of the NavigationMesh / NavigationPolygon baked 'cell_size' and navigation map 'cell_size'. If you're certain none of above is the case, change 'navigation/3d/merge_rasterizer_cell_scale' to 0.001.");
-				}
-			}
+		for (NavRegion *region : affected_regions) {
+			_disconnect_region(region);
+			reconnected_regions.insert(region);
 		}
-
-		Vector<gd::Edge::Connection> free_edges;
-		for (KeyValue<gd::EdgeKey, Vector<gd::Edge::Connection>> &E : connections) {
-			if (E.value.size() == 2) {
-				// Connect edge that are shared in different polygons.
-				gd::Edge::Connection &c1 = E.value.write[0];
-				gd::Edge::Connection &c2 = E.value.write[1];
-				c1.polygon->edges[c1.edge].connections.push_back(c2);
-				c2.polygon->edges[c2.edge].connections.push_back(c1);
-				// Note: The pathway_start/end are full for those connection and do not need to be modified.
-				_new_pm_edge_merge_count += 1;
-			} else {
-				CRASH_COND_MSG(E.value.size() != 1, vformat("Number of connection != 1. Found: %d", E.value.size()));
-				if (use_edge_connections && E.value[0].polygon->owner->get_use_edge_connections()) {
-					free_edges.push_back(E.value[0]);
-				}
-			}
-		}
-
-		// Find the compatible near edges.
-		//
-		// Note:
-		// Considering that the edges must be compatible (for obvious reasons)
-		// to be connected, create new polygons to remove that small gap is
-		// not really useful and would result in wasteful computation during
-		// connection, integration and path finding.
-		_new_pm_edge_free_count = free_edges.size();
-
-		for (int i = 0; i < free_edges.size(); i++) {
-			const gd::Edge::Connection &free_edge = free_edges[i];
-			Vector3 edge_p1 = free_edge.polygon->points[free_edge.edge].pos;
-			Vector3 edge_p2 = free_edge.polygon->points[(free_edge.edge + 1) % free_edge.polygon->points.size()].pos;
-
-			for (int j = 0; j < free_edges.size(); j++) {
-				const gd::Edge::Connection &other_edge = free_edges[j];
-				if (i == j || free_edge.polygon->owner == other_edge.polygon->owner) {
-					continue;
-				}
-
-				Vector3 other_edge_p1 = other_edge.polygon->points[other_edge.edge].pos;
-				Vector3 other_edge_p2 = other_edge.polygon->points[(other_edge.edge + 1) % other_edge.polygon->points.size()].pos;
-
-				// Compute the projection of the opposite edge on the current one
-				Vector3 edge_vector = edge_p2 - edge_p1;
-				real_t projected_p1_ratio = edge_vector.dot(other_edge_p1 - edge_p1) / (edge_vector.length_squared());
-				real_t projected_p2_ratio = edge_vector.dot(other_edge_p2 - edge_p1) / (edge_vector.length_squared());
-				if ((projected_p1_ratio < 0.0 && projected_p2_ratio < 0.0) || (projected_p1_ratio > 1.0 && projected_p2_ratio > 1.0)) {
-					continue;
-				}
-
-				// Check if the two edges are close to each other enough and compute a pathway between the two regions.
-				Vector3 self1 = edge_vector * CLAMP(projected_p1_ratio, 0.0, 1.0) + edge_p1;
-				Vector3 other1;
-				if (projected_p1_ratio >= 0.0 && projected_p1_ratio <= 1.0) {
-					other1 = other_edge_p1;
-				} else {
-					other1 = other_edge_p1.lerp(other_edge_p2, (1.0 - projected_p1_ratio) / (projected_p2_ratio - projected_p1_ratio));
-				}
-				if (other1.distance_to(self1) > edge_connection_margin) {
-					continue;
-				}
-
-				Vector3 self2 = edge_vector * CLAMP(projected_p2_ratio, 0.0, 1.0) + edge_p1;
-				Vector3 other2;
-				if (projected_p2_ratio >= 0.0 && projected_p2_ratio <= 1.0) {
-					other2 = other_edge_p2;
-				} else {
-					other2 = other_edge_p1.lerp(other_edge_p2, (0.0 - projected_p1_ratio) / (projected_p2_ratio - projected_p1_ratio));
-				}
-				if (other2.distance_to(self2) > edge_connection_margin) {
-					continue;
-				}
-
-				// The edges can now be connected.
-				gd::Edge::Connection new_connection = other_edge;
-				new_connection.pathway_start = (self1 + other1) / 2.0;
-				new_connection.pathway_end = (self2 + other2) / 2.0;
-				free_edge.polygon->edges[free_edge.edge].connections.push_back(new_connection);
-
-				// Add the connection to the region_connection map.
-				((NavRegion *)free_edge.polygon->owner)->get_connections().push_back(new_connection);
-				_new_pm_edge_connection_count += 1;
+		for (NavRegion *region : affected_regions) {
+			if (region->get_enabled()) {
+				_connect_region(region);
 			}
 		}
 
-		uint32_t link_poly_idx = 0;
-		link_polygons.resize(links.size());
+		_new_pm_polygon_count = 0;
+		_new_pm_edge_count = 0;
+		_new_pm_edge_merge_count = 0;
+		_new_pm_edge_connection_count = 0;
+		_new_pm_edge_free_count = 0;
 
-		// Search for polygons within range of a nav link.
-		for (const NavLink *link : links) {
-			if (!link->get_enabled()) {
+		uint32_t external_edge_merge_count = 0;
+		for (const NavRegion *region : regions) {
+			if (!region->get_enabled()) {
 				continue;
 			}
-			const Vector3 start = link->get_start_position();
-			const Vector3 end = link->get_end_position();
-
-			gd::Polygon *closest_start_polygon = nullptr;
-			real_t closest_start_distance = link_connection_radius;
-			Vector3 closest_start_point;
-
-			gd::Polygon *closest_end_polygon = nullptr;
-			real_t closest_end_distance = link_connection_radius;
-			Vector3 closest_end_point;
-
-			// Create link to any polygons within the search radius of the start point.
-			for (uint32_t start_index = 0; start_index < polygons.size(); start_index++) {
-				gd::Polygon &start_poly = polygons[start_index];
-
-				// For each face check the distance to the start
-				for (uint32_t start_point_id = 2; start_point_id < start_poly.points.size(); start_point_id += 1) {
-					const Face3 start_face(start_poly.points[0].pos, start_poly.points[start_point_id - 1].pos, start_poly.points[start_point_id].pos);
-					const Vector3 start_point = start_face.get_closest_point_to(start);
-					const real_t start_distance = start_point.distance_to(start);
+			_new_pm_polygon_count += region->get_polygons().size();
+			_new_pm_edge_count += region->get_edge_count();
+			_new_pm_edge_merge_count += region->get_edge_merge_count();
+			_new_pm_edge_connection_count += region->get_connections_count();
+			_new_pm_edge_free_count += region->get_free_edge_count();
+			external_edge_merge_count += region->get_external_edge_merge_count();
+		}
 
-					// Pick the polygon that is within our radius and is closer than anything we've seen yet.
-					if (start_distance <= link_connection_radius && start_distance < closest_start_distance) {
-						closest_start_distance = start_distance;
-						closest_start_point = start_point;
-						closest_start_polygon = &start_poly;
-					}
-				}
-			}
+		// Both regions count the edges merged between them.
+		_new_pm_edge_count -= external_edge_merge_count / 2;
+		_new_pm_edge_merge_count += external_edge_merge_count / 2;
+	}
 
-			// Find any polygons within the search radius of the end point.
-			for (gd::Polygon &end_poly : polygons) {
-				// For each face check the distance to the end
-				for (uint32_t end_point_id = 2; end_point_id < end_poly.points.size(); end_point_id += 1) {
-					const Face3 end_face(end_poly.points[0].pos, end_poly.points[end_point_id - 1].pos, end_poly.points[end_point_id].pos);
-					const Vector3 end_point = end_face.get_closest_point_to(end);
-					const real_t end_distance = end_point.distance_to(end);
+	if (regions_changed || regenerate_links) {
+		_update_links(regenerated_regions);
 
-					// Pick the polygon that is within our radius and is closer than anything we've seen yet.
-					if (end_distance <= link_connection_radius && end_distance < closest_end_distance) {
-						closest_end_distance = end_distance;
-						closest_end_point = end_point;
-						closest_end_polygon = &end_poly;
-					}
-				}
-			}
-
-			// If we have both a start and end point, then create a synthetic polygon to route through.
-			if (closest_start_polygon && closest_end_polygon) {
-				gd::Polygon &new_polygon = link_polygons[link_poly_idx++];
-				new_polygon.owner = link;
-
-				new_polygon.edges.clear();
-				new_polygon.edges.resize(4);
-				new_polygon.points.clear();
-				new_polygon.points.reserve(4);
-
-				// Build a set of vertices that create a thin polygon going from the start to the end point.
-				new_polygon.points.push_back({ closest_start_point, get_point_key(closest_start_point) });
-				new_polygon.points.push_back({ closest_start_point, get_point_key(closest_start_point) });
-				new_polygon.points.push_back({ closest_end_point, get_point_key(closest_end_point) });
-				new_polygon.points.push_back({ closest_end_point, get_point_key(closest_end_point) });
-
-				Vector3 center;
-				for (int p = 0; p < 4; ++p) {
-					center += new_polygon.points[p].pos;
-				}
-				new_polygon.center = center / real_t(new_polygon.points.size());
-				new_polygon.clockwise = true;
-
-				// Setup connections to go forward in the link.
-				{
-					gd::Edge::Connection entry_connection;
-					entry_connection.polygon = &new_polygon;
-					entry_connection.edge = -1;
-					entry_connection.pathway_start = new_polygon.points[0].pos;
-					entry_connection.pathway_end = new_polygon.points[1].pos;
-					closest_start_polygon->edges[0].connections.push_back(entry_connection);
-
-					gd::Edge::Connection exit_connection;
-					exit_connection.polygon = closest_end_polygon;
-					exit_connection.edge = -1;
-					exit_connection.pathway_start = new_polygon.points[2].pos;
-					exit_connection.pathway_end = new_polygon.points[3].pos;
-					new_polygon.edges[2].connections.push_back(exit_connection);
-				}
-
-				// If the link is bi-directional, create connections from the end to the start.
-				if (link->is_bidirectional()) {
-					gd::Edge::Connection entry_connection;
-					entry_connection.polygon = &new_polygon;
-					entry_connection.edge = -1;
-					entry_connection.pathway_start = new_polygon.points[2].pos;
-					entry_connection.pathway_end = new_polygon.points[3].pos;
-					closest_end_polygon->edges[0].connections.push_back(entry_connection);
-
-					gd::Edge::Connection exit_connection;
-					exit_connection.polygon = closest_start_polygon;
-					exit_connection.edge = -1;
-					exit_connection.pathway_start = new_polygon.points[0].pos;
-					exit_connection.pathway_end = new_polygon.points[1].pos;
-					new_polygon.edges[0].connections.push_back(exit_connection);
-				}
+		if (hierarchical_cluster_size > 0) {
+			LocalVector<const gd::Polygon *> link_entry_polygons;
+			for (const LinkConnectedPolygon &link_connected_polygon : link_connected_polygons) {
+				link_entry_polygons.push_back(link_connected_polygon.polygon);
 			}
+			hierarchy.update(regions, reconnected_regions, link_entry_polygons, hierarchical_cluster_size * cell_size);
 		}
 
 		// Some code treats 0 as a failure case, so we avoid returning 0 and modulo wrap UINT32_MAX manually.
@@ -1197,6 +1084,7 @@ void NavMap::sync() {
 	}
 
 	regenerate_polygons = false;
+	regenerate_connections = false;
 	regenerate_links = false;
 	obstacles_dirty = false;
 	agents_dirty = false;
@@ -1212,6 +1100,281 @@ void NavMap::sync() {
 	pm_edge_free_count = _new_pm_edge_free_count;
 }
 
+bool NavMap::_are_regions_near(const AABB &p_bounds_a, const AABB &p_bounds_b) const {
+	// Edges are merged by their cell keys, so allow a cell on top of the connection margin.
+	real_t margin = edge_connection_margin + MAX(cell_size, cell_height);
+	return p_bounds_a.grow(margin).intersects_inclusive(p_bounds_b);
+}
+
+void NavMap::_disconnect_region(NavRegion *p_region) {
+	// Only the boundary edges connect to other regions. Connections from links have no edge and are left to _update_links().
+	for (gd::BoundaryEdge &boundary_edge : p_region->get_boundary_edges()) {
+		Vector<gd::Edge::Connection> &connections = boundary_edge.connection.polygon->edges[boundary_edge.connection.edge].connections;
+		for (int i = connections.size() - 1; i >= 0; i--) {
+			if (connections[i].edge != -1) {
+				connections.remove_at(i);
+			}
+		}
+	}
+
+	p_region->get_connections().clear();
+	p_region->set_external_edge_counts(0, 0);
+}
+
+void NavMap::_connect_region(NavRegion *p_region) {
+	LocalVector<NavRegion *> neighbors;
+	for (NavRegion *region : regions) {
+		if (region != p_region && region->get_enabled() && _are_regions_near(p_region->get_bounds(), region->get_bounds())) {
+			neighbors.push_back(region);
+		}
+	}
+
+	// Group the boundary edges of the region and its neighbors per key.
+	// Edges of the neighbors merged with regions outside of this group are too far away to connect to this region anyway.
+	HashMap<gd::EdgeKey, LocalVector<gd::Edge::Connection>, gd::EdgeKey> connections;
+	for (const gd::BoundaryEdge &boundary_edge : p_region->get_boundary_edges()) {
+		connections[boundary_edge.key].push_back(boundary_edge.connection);
+	}
+	for (NavRegion *region : neighbors) {
+		for (const gd::BoundaryEdge &boundary_edge : region->get_boundary_edges()) {
+			connections[boundary_edge.key].push_back(boundary_edge.connection);
+		}
+	}
+
+	uint32_t edge_merge_count = 0;
+	LocalVector<gd::Edge::Connection> free_edges;
+	for (const gd::BoundaryEdge &boundary_edge : p_region->get_boundary_edges()) {
+		const LocalVector<gd::Edge::Connection> &key_connections = connections[boundary_edge.key];
+		if (key_connections.size() == 2) {
+			// Connect edge that is shared with another region. Both regions add their own side.
+			const gd::Edge::Connection &other = key_connections[0].polygon == boundary_edge.connection.polygon ? key_connections[1] : key_connections[0];
+			boundary_edge.connection.polygon->edges[boundary_edge.connection.edge].connections.push_back(other);
+			edge_merge_count += 1;
+		} else if (key_connections.size() > 2) {
+			ERR_PRINT_ONCE("Navigation map synchronization error. Attempted to merge a navigation mesh polygon edge with another already-merged edge. This is usually caused by crossing edges, overlapping polygons, or a mismatch of the NavigationMesh / NavigationPolygon baked 'cell_size' and navigation map 'cell_size'. If you're certain none of above is the case, change 'navigation/3d/merge_rasterizer_cell_scale' to 0.001.");
+		} else if (use_edge_connections && p_region->get_use_edge_connections()) {
+			free_edges.push_back(boundary_edge.connection);
+		}
+	}
+
+	p_region->set_external_edge_counts(edge_merge_count, free_edges.size());
+
+	if (free_edges.is_empty()) {
+		return;
+	}
+
+	// Find the edges of the neighbors that are not merged with any other edge either.
+	LocalVector<gd::Edge::Connection> other_free_edges;
+	for (NavRegion *region : neighbors) {
+		if (!region->get_use_edge_connections()) {
+			continue;
+		}
+		for (const gd::BoundaryEdge &boundary_edge : region->get_boundary_edges()) {
+			if (connections[boundary_edge.key].size() == 1) {
+				other_free_edges.push_back(boundary_edge.connection);
+			}
+		}
+	}
+
+	// Find the compatible near edges.
+	//
+	// Note:
+	// Considering that the edges must be compatible (for obvious reasons)
+	// to be connected, create new polygons to remove that small gap is
+	// not really useful and would result in wasteful computation during
+	// connection, integration and path finding.
+	for (const gd::Edge::Connection &free_edge : free_edges) {
+		Vector3 edge_p1 = free_edge.polygon->points[free_edge.edge].pos;
+		Vector3 edge_p2 = free_edge.polygon->points[(free_edge.edge + 1) % free_edge.polygon->points.size()].pos;
+
+		for (const gd::Edge::Connection &other_edge : other_free_edges) {
+			Vector3 other_edge_p1 = other_edge.polygon->points[other_edge.edge].pos;
+			Vector3 other_edge_p2 = other_edge.polygon->points[(other_edge.edge + 1) % other_edge.polygon->points.size()].pos;
+
+			// Compute the projection of the opposite edge on the current one
+			Vector3 edge_vector = edge_p2 - edge_p1;
+			real_t projected_p1_ratio = edge_vector.dot(other_edge_p1 - edge_p1) / (edge_vector.length_squared());
+			real_t projected_p2_ratio = edge_vector.dot(other_edge_p2 - edge_p1) / (edge_vector.length_squared());
+			if ((projected_p1_ratio < 0.0 && projected_p2_ratio < 0.0) || (projected_p1_ratio > 1.0 && projected_p2_ratio > 1.0)) {
+				continue;
+			}
+
+			// Check if the two edges are close to each other enough and compute a pathway between the two regions.
+			Vector3 self1 = edge_vector * CLAMP(projected_p1_ratio, 0.0, 1.0) + edge_p1;
+			Vector3 other1;
+			if (projected_p1_ratio >= 0.0 && projected_p1_ratio <= 1.0) {
+				other1 = other_edge_p1;
+			} else {
+				other1 = other_edge_p1.lerp(other_edge_p2, (1.0 - projected_p1_ratio) / (projected_p2_ratio - projected_p1_ratio));
+			}
+			if (other1.distance_to(self1) > edge_connection_margin) {
+				continue;
+			}
+
+			Vector3 self2 = edge_vector * CLAMP(projected_p2_ratio, 0.0, 1.0) + edge_p1;
+			Vector3 other2;
+			if (projected_p2_ratio >= 0.0 && projected_p2_ratio <= 1.0) {
+				other2 = other_edge_p2;
+			} else {
+				other2 = other_edge_p1.lerp(other_edge_p2, (0.0 - projected_p1_ratio) / (projected_p2_ratio - projected_p1_ratio));
+			}
+			if (other2.distance_to(self2) > edge_connection_margin) {
+				continue;
+			}
+
+			// The edges can now be connected.
+			gd::Edge::Connection new_connection = other_edge;
+			new_connection.pathway_start = (self1 + other1) / 2.0;
+			new_connection.pathway_end = (self2 + other2) / 2.0;
+			free_edge.polygon->edges[free_edge.edge].connections.push_back(new_connection);
+
+			// Add the connection to the region_connection map.
+			p_region->get_connections().push_back(new_connection);
+		}
+	}
+}
+
+void NavMap::_update_links(const HashSet<const NavRegion *> &p_regenerated_regions) {
+	// Remove the connections into the previous link polygons, unless the region polygons holding them were rebuilt.
+	for (const LinkConnectedPolygon &link_connected_polygon : link_connected_polygons) {
+		if (p_regenerated_regions.has(link_connected_polygon.region) || regions.find((NavRegion *)link_connected_polygon.region) < 0) {
+			continue;
+		}
+		Vector<gd::Edge::Connection> &connections = link_connected_polygon.polygon->edges[0].connections;
+		for (int i = connections.size() - 1; i >= 0; i--) {
+			if (connections[i].edge == -1) {
+				connections.remove_at(i);
+			}
+		}
+	}
+	link_connected_polygons.clear();
+
+	uint32_t link_poly_idx = 0;
+	link_polygons.resize(links.size());
+
+	// Search for polygons within range of a nav link.
+	for (const NavLink *link : links) {
+		if (!link->get_enabled()) {
+			continue;
+		}
+		const Vector3 start = link->get_start_position();
+		const Vector3 end = link->get_end_position();
+
+		const NavRegion *closest_start_region = nullptr;
+		gd::Polygon *closest_start_polygon = nullptr;
+		real_t closest_start_distance = link_connection_radius;
+		Vector3 closest_start_point;
+
+		const NavRegion *closest_end_region = nullptr;
+		gd::Polygon *closest_end_polygon = nullptr;
+		real_t closest_end_distance = link_connection_radius;
+		Vector3 closest_end_point;
+
+		for (NavRegion *region : regions) {
+			if (!region->get_enabled()) {
+				continue;
+			}
+
+			const AABB search_bounds = region->get_bounds().grow(link_connection_radius);
+			const bool near_start = search_bounds.has_point(start);
+			const bool near_end = search_bounds.has_point(end);
+			if (!near_start && !near_end) {
+				continue;
+			}
+
+			for (gd::Polygon &poly : region->get_polygons()) {
+				// For each face check the distance to the start and end.
+				for (uint32_t point_id = 2; point_id < poly.points.size(); point_id += 1) {
+					const Face3 face(poly.points[0].pos, poly.points[point_id - 1].pos, poly.points[point_id].pos);
+
+					// Pick the polygon that is within our radius and is closer than anything we've seen yet.
+					if (near_start) {
+						const Vector3 start_point = face.get_closest_point_to(start);
+						const real_t start_distance = start_point.distance_to(start);
+						if (start_distance <= link_connection_radius && start_distance < closest_start_distance) {
+							closest_start_distance = start_distance;
+							closest_start_point = start_point;
+							closest_start_polygon = &poly;
+							closest_start_region = region;
+						}
+					}
+
+					if (near_end) {
+						const Vector3 end_point = face.get_closest_point_to(end);
+						const real_t end_distance = end_point.distance_to(end);
+						if (end_distance <= link_connection_radius && end_distance < closest_end_distance) {
+							closest_end_distance = end_distance;
+							closest_end_point = end_point;
+							closest_end_polygon = &poly;
+							closest_end_region = region;
+						}
+					}
+				}
+			}
+		}
+
+		// If we have both a start and end point, then create a synthetic polygon to route through.
+		if (closest_start_polygon && closest_end_polygon) {
+			gd::Polygon &new_polygon = link_polygons[link_poly_idx++];
+			new_polygon.owner = link;
+
+			new_polygon.edges.clear();
+			new_polygon.edges.resize(4);
+			new_polygon.points.clear();
+			new_polygon.points.reserve(4);
+
+			// Build a set of vertices that create a thin polygon going from the start to the end point.
+			new_polygon.points.push_back({ closest_start_point, get_point_key(closest_start_point) });
+			new_polygon.points.push_back({ closest_start_point, get_point_key(closest_start_point) });
+			new_polygon.points.push_back({ closest_end_point, get_point_key(closest_end_point) });
+			new_polygon.points.push_back({ closest_end_point, get_point_key(closest_end_point) });
+
+			Vector3 center;
+			for (int p = 0; p < 4; ++p) {
+				center += new_polygon.points[p].pos;
+			}
+			new_polygon.center = center / real_t(new_polygon.points.size());
+			new_polygon.clockwise = true;
+
+			// Setup connections to go forward in the link.
+			{
+				gd::Edge::Connection entry_connection;
+				entry_connection.polygon = &new_polygon;
+				entry_connection.edge = -1;
+				entry_connection.pathway_start = new_polygon.points[0].pos;
+				entry_connection.pathway_end = new_polygon.points[1].pos;
+				closest_start_polygon->edges[0].connections.push_back(entry_connection);
+				link_connected_polygons.push_back({ closest_start_region, closest_start_polygon });
+
+				gd::Edge::Connection exit_connection;
+				exit_connection.polygon = closest_end_polygon;
+				exit_connection.edge = -1;
+				exit_connection.pathway_start = new_polygon.points[2].pos;
+				exit_connection.pathway_end = new_polygon.points[3].pos;
+				new_polygon.edges[2].connections.push_back(exit_connection);
+			}
+
+			// If the link is bi-directional, create connections from the end to the start.
+			if (link->is_bidirectional()) {
+				gd::Edge::Connection entry_connection;
+				entry_connection.polygon = &new_polygon;
+				entry_connection.edge = -1;
+				entry_connection.pathway_start = new_polygon.points[2].pos;
+				entry_connection.pathway_end = new_polygon.points[3].pos;
+				closest_end_polygon->edges[0].connections.push_back(entry_connection);
+				link_connected_polygons.push_back({ closest_end_region, closest_end_polygon });
+
+				gd::Edge::Connection exit_connection;
+				exit_connection.polygon = closest_start_polygon;
+				exit_connection.edge = -1;
+				exit_connection.pathway_start = new_polygon.points[0].pos;
+				exit_connection.pathway_end = new_polygon.points[1].pos;
+				new_polygon.edges[0].connections.push_back(exit_connection);
+			}
+		}
+	}
+}
+
 void NavMap::_update_rvo_obstacles_tree_2d() {
 	int obstacle_vertex_count = 0;
 	for (NavObstacle *obstacle : obstacles) {
@@ -1340,33 +1503,39 @@ void NavMap::step(real_t p_deltatime) {
 	rvo_simulation_2d.setTimeStep(float(deltatime));
 	rvo_simulation_3d.setTimeStep(float(deltatime));
 
-	if (active_2d_avoidance_agents.size() > 0) {
-		if (use_threads && avoidance_use_multiple_threads) {
-			WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &NavMap::compute_single_avoidance_step_2d, active_2d_avoidance_agents.ptr(), active_2d_avoidance_agents.size(), -1, true, SNAME("RVOAvoidanceAgents2D"));
-			WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
-		} else {
-			for (NavAgent *agent : active_2d_avoidance_agents) {
-				agent->get_rvo_agent_2d()->computeNeighbors(&rvo_simulation_2d);
-				agent->get_rvo_agent_2d()->computeNewVelocity(&rvo_simulation_2d);
-				agent->get_rvo_agent_2d()->update(&rvo_simulation_2d);
-				agent->update();
-			}
-		}
+	// Agents use either 2D or 3D avoidance, each with its own simulation, so both steps can run at the same time.
+	const bool threaded = use_threads && avoidance_use_multiple_threads;
+	WorkerThreadPool::GroupID group_task_2d = WorkerThreadPool::INVALID_TASK_ID;
+	WorkerThreadPool::GroupID group_task_3d = WorkerThreadPool::INVALID_TASK_ID;
+
+	if (threaded && active_2d_avoidance_agents.size() > 0) {
+		group_task_2d = WorkerThreadPool::get_singleton()->add_template_group_task(this, &NavMap::compute_single_avoidance_step_2d, active_2d_avoidance_agents.ptr(), active_2d_avoidance_agents.size(), -1, true, SNAME("RVOAvoidanceAgents2D"));
+	}
+	if (threaded && active_3d_avoidance_agents.size() > 0) {
+		group_task_3d = WorkerThreadPool::get_singleton()->add_template_group_task(this, &NavMap::compute_single_avoidance_step_3d, active_3d_avoidance_agents.ptr(), active_3d_avoidance_agents.size(), -1, true, SNAME("RVOAvoidanceAgents3D"));
 	}
 
-	if (active_3d_avoidance_agents.size() > 0) {
-		if (use_threads && avoidance_use_multiple_threads) {
-			WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &NavMap::compute_single_avoidance_step_3d, active_3d_avoidance_agents.ptr(), active_3d_avoidance_agents.size(), -1, true, SNAME("RVOAvoidanceAgents3D"));
-			WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
-		} else {
-			for (NavAgent *agent : active_3d_avoidance_agents) {
-				agent->get_rvo_agent_3d()->computeNeighbors(&rvo_simulation_3d);
-				agent->get_rvo_agent_3d()->computeNewVelocity(&rvo_simulation_3d);
-				agent->get_rvo_agent_3d()->update(&rvo_simulation_3d);
-				agent->update();
-			}
+	if (!threaded) {
+		for (NavAgent *agent : active_2d_avoidance_agents) {
+			agent->get_rvo_agent_2d()->computeNeighbors(&rvo_simulation_2d);
+			agent->get_rvo_agent_2d()->computeNewVelocity(&rvo_simulation_2d);
+			agent->get_rvo_agent_2d()->update(&rvo_simulation_2d);
+			agent->update();
+		}
+		for (NavAgent *agent : active_3d_avoidance_agents) {
+			agent->get_rvo_agent_3d()->computeNeighbors(&rvo_simulation_3d);
+			agent->get_rvo_agent_3d()->computeNewVelocity(&rvo_simulation_3d);
+			agent->get_rvo_agent_3d()->update(&rvo_simulation_3d);
+			agent->update();
 		}
 	}
+
+	if (group_task_2d != WorkerThreadPool::INVALID_TASK_ID) {
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task_2d);
+	}
+	if (group_task_3d != WorkerThreadPool::INVALID_TASK_ID) {
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task_3d);
+	}
 }
 
 void NavMap::dispatch_callbacks() {
@@ -1379,7 +1548,7 @@ void NavMap::dispatch_callbacks() {
 	}
 }
 
-void NavMap::clip_path(const LocalVector<gd::NavigationPoly> &p_navigation_polys, Vector<Vector3> &path, const gd::NavigationPoly *from_poly, const Vector3 &p_to_point, const gd::NavigationPoly *p_to_poly, Vector<int32_t> *r_path_types, TypedArray<RID> *r_path_rids, Vector<int64_t> *r_path_owners) const {
+void NavMap::clip_path(const gd::NavigationPoly *p_navigation_polys, Vector<Vector3> &path, const gd::NavigationPoly *from_poly, const Vector3 &p_to_point, const gd::NavigationPoly *p_to_poly, Vector<int32_t> *r_path_types, TypedArray<RID> *r_path_rids, Vector<int64_t> *r_path_owners) const {
 	Vector3 from = path[path.size() - 1];
 
 	if (from.is_equal_approx(p_to_point)) {
@@ -1420,6 +1589,7 @@ void NavMap::_update_merge_rasterizer_cell_dimensions() {
 NavMap::NavMap() {
 	avoidance_use_multiple_threads = GLOBAL_GET("navigation/avoidance/thread_model/avoidance_use_multiple_threads");
 	avoidance_use_high_priority_threads = GLOBAL_GET("navigation/avoidance/thread_model/avoidance_use_high_priority_threads");
+	hierarchical_cluster_size = GLOBAL_GET("navigation/pathfinding/hierarchical_cluster_size");
 }
 
 NavMap::~NavMap() {
@@ -31,11 +31,13 @@
 #ifndef NAV_MAP_H
 #define NAV_MAP_H
 
+#include "nav_map_hierarchy.h"
 #include "nav_rid.h"
 #include "nav_utils.h"
 
 #include "core/math/math_defs.h"
 #include "core/object/worker_thread_pool.h"
+#include "core/templates/hash_set.h"
 
 #include <KdTree2d.h>
 #include <KdTree3d.h>
@@ -72,17 +74,29 @@ class NavMap : public NavRid {
 	real_t link_connection_radius = 1.0;
 
 	bool regenerate_polygons = true;
+	bool regenerate_connections = true;
 	bool regenerate_links = true;
 
 	/// Map regions
 	LocalVector<NavRegion *> regions;
 
+	/// Bounds of the regions removed since the last sync, whose neighbors need to be connected again.
+	LocalVector<AABB> removed_region_bounds;
+
 	/// Map links
 	LocalVector<NavLink *> links;
 	LocalVector<gd::Polygon> link_polygons;
 
-	/// Map polygons
-	LocalVector<gd::Polygon> polygons;
+	/// Region polygons the links connect from, to remove those connections when the links change.
+	struct LinkConnectedPolygon {
+		const NavRegion *region = nullptr;
+		gd::Polygon *polygon = nullptr;
+	};
+	LocalVector<LinkConnectedPolygon> link_connected_polygons;
+
+	/// Size of the hierarchy clusters in multiples of the cell size, or 0 to search paths on the polygons only.
+	int hierarchical_cluster_size = 0;
+	NavMapHierarchy hierarchy;
 
 	/// RVO avoidance worlds
 	RVO2D::RVOSimulator2D rvo_simulation_2d;
@@ -223,13 +237,18 @@ private:
 	void compute_single_avoidance_step_2d(uint32_t index, NavAgent **agent);
 	void compute_single_avoidance_step_3d(uint32_t index, NavAgent **agent);
 
-	void clip_path(const LocalVector<gd::NavigationPoly> &p_navigation_polys, Vector<Vector3> &path, const gd::NavigationPoly *from_poly, const Vector3 &p_to_point, const gd::NavigationPoly *p_to_poly, Vector<int32_t> *r_path_types, TypedArray<RID> *r_path_rids, Vector<int64_t> *r_path_owners) const;
+	void clip_path(const gd::NavigationPoly *p_navigation_polys, Vector<Vector3> &path, const gd::NavigationPoly *from_poly, const Vector3 &p_to_point, const gd::NavigationPoly *p_to_poly, Vector<int32_t> *r_path_types, TypedArray<RID> *r_path_rids, Vector<int64_t> *r_path_owners) const;
 	void _update_rvo_simulation();
 	void _update_rvo_obstacles_tree_2d();
 	void _update_rvo_agents_tree_2d();
 	void _update_rvo_agents_tree_3d();
 
 	void _update_merge_rasterizer_cell_dimensions();
+
+	bool _are_regions_near(const AABB &p_bounds_a, const AABB &p_bounds_b) const;
+	void _disconnect_region(NavRegion *p_region);
+	void _connect_region(NavRegion *p_region);
+	void _update_links(const HashSet<const NavRegion *> &p_regenerated_regions);
 };
 
 #endif // NAV_MAP_H
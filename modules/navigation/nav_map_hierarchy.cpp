@@ -0,0 +1,526 @@
+/**************************************************************************/
+/*  nav_map_hierarchy.cpp                                                 */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "nav_map_hierarchy.h"
+
+#include "nav_region.h"
+
+#include "core/templates/sort_array.h"
+
+real_t NavMapHierarchy::_get_step_cost(const gd::Polygon *p_from, const gd::Polygon *p_to) {
+	real_t cost = p_from->center.distance_to(p_to->center) * p_from->owner->get_travel_cost();
+	if (p_from->owner != p_to->owner) {
+		cost += p_to->owner->get_enter_cost();
+	}
+	return cost;
+}
+
+uint32_t NavMapHierarchy::_get_or_create_cluster(const Vector3 &p_position) {
+	const Vector3i cell = (p_position / cluster_size).floor();
+	const uint32_t *existing = cluster_ids.getptr(cell);
+	if (existing) {
+		return *existing;
+	}
+
+	const uint32_t id = clusters.size();
+	clusters.push_back(Cluster());
+	cluster_ids.insert(cell, id);
+	return id;
+}
+
+uint32_t NavMapHierarchy::_get_or_create_node(const gd::Polygon *p_polygon) {
+	const uint32_t *existing = polygon_nodes.getptr(p_polygon);
+	if (existing) {
+		return *existing;
+	}
+
+	uint32_t id;
+	if (free_nodes.is_empty()) {
+		id = nodes.size();
+		nodes.push_back(Node());
+	} else {
+		id = free_nodes[free_nodes.size() - 1];
+		free_nodes.remove_at(free_nodes.size() - 1);
+	}
+	nodes[id].polygon = p_polygon;
+	nodes[id].cluster = p_polygon->hierarchy_cluster;
+	polygon_nodes.insert(p_polygon, id);
+	clusters[p_polygon->hierarchy_cluster].nodes.push_back(id);
+	return id;
+}
+
+void NavMapHierarchy::_add_edge(const gd::Polygon *p_from, const gd::Polygon *p_to, real_t p_cost) {
+	const uint32_t from = _get_or_create_node(p_from);
+	const uint32_t to = _get_or_create_node(p_to);
+	clusters[p_to->hierarchy_cluster].incoming_clusters.insert(p_from->hierarchy_cluster);
+
+	for (Edge &edge : nodes[from].edges) {
+		if (edge.to == to) {
+			edge.cost = MIN(edge.cost, p_cost);
+			return;
+		}
+	}
+
+	Edge edge;
+	edge.to = to;
+	edge.cost = p_cost;
+	nodes[from].edges.push_back(edge);
+}
+
+void NavMapHierarchy::_add_cluster_exits(uint32_t p_cluster, const HashSet<uint32_t> *p_target_clusters) {
+	// The connections leaving a cluster give its nodes and the edges between clusters.
+	for (const gd::Polygon *polygon : clusters[p_cluster].polygons) {
+		for (const gd::Edge &edge : polygon->edges) {
+			for (const gd::Edge::Connection &connection : edge.connections) {
+				const gd::Polygon *next = connection.polygon;
+				if (next->hierarchy_cluster == -1) {
+					// Step over the link to the polygons it leads to.
+					for (const gd::Edge &link_edge : next->edges) {
+						for (const gd::Edge::Connection &link_connection : link_edge.connections) {
+							const gd::Polygon *link_end = link_connection.polygon;
+							if (link_end->hierarchy_cluster == -1 || link_end->hierarchy_cluster == (int32_t)p_cluster) {
+								continue;
+							}
+							if (!p_target_clusters || p_target_clusters->has(link_end->hierarchy_cluster)) {
+								_add_edge(polygon, link_end, _get_step_cost(polygon, next) + _get_step_cost(next, link_end));
+							}
+						}
+					}
+				} else if (next->hierarchy_cluster != (int32_t)p_cluster) {
+					if (!p_target_clusters || p_target_clusters->has(next->hierarchy_cluster)) {
+						_add_edge(polygon, next, _get_step_cost(polygon, next));
+					}
+				}
+			}
+		}
+	}
+}
+
+void NavMapHierarchy::_add_cluster_paths(uint32_t p_cluster) {
+	// The shortest paths between the nodes of the cluster give the edges inside it.
+	const Cluster &cluster = clusters[p_cluster];
+	HashMap<const gd::Polygon *, real_t> costs;
+	for (uint32_t from : cluster.nodes) {
+		_search_cluster(nodes[from].polygon, false, costs);
+		for (uint32_t to : cluster.nodes) {
+			if (to == from) {
+				continue;
+			}
+			const real_t *cost = costs.getptr(nodes[to].polygon);
+			if (cost) {
+				Edge edge;
+				edge.to = to;
+				edge.cost = *cost;
+				nodes[from].edges.push_back(edge);
+			}
+		}
+	}
+}
+
+void NavMapHierarchy::_search_cluster(const gd::Polygon *p_from, bool p_reverse, HashMap<const gd::Polygon *, real_t> &r_costs) const {
+	// Dijkstra from p_from to all the polygons of its cluster, without leaving it.
+	// In reverse, the costs are those from each polygon to p_from instead, which differ with enter costs and one-way connections.
+	r_costs.clear();
+
+	const int32_t cluster_id = p_from->hierarchy_cluster;
+	HashMap<const gd::Polygon *, LocalVector<StepCost>> steps_into;
+	if (p_reverse) {
+		for (const gd::Polygon *polygon : clusters[cluster_id].polygons) {
+			for (const gd::Edge &edge : polygon->edges) {
+				for (const gd::Edge::Connection &connection : edge.connections) {
+					if (connection.polygon->hierarchy_cluster != cluster_id) {
+						continue;
+					}
+					StepCost step;
+					step.polygon = polygon;
+					step.cost = _get_step_cost(polygon, connection.polygon);
+					steps_into[connection.polygon].push_back(step);
+				}
+			}
+		}
+	}
+
+	SortArray<OpenEntry, OpenEntrySort> sorter;
+	LocalVector<OpenEntry> open;
+	LocalVector<const gd::Polygon *> queued;
+
+	r_costs.insert(p_from, 0.0);
+	queued.push_back(p_from);
+	open.push_back(OpenEntry());
+
+	while (!open.is_empty()) {
+		const OpenEntry current = open[0];
+		sorter.pop_heap(0, open.size(), open.ptr());
+		open.remove_at(open.size() - 1);
+
+		const gd::Polygon *polygon = queued[current.id];
+		if (current.cost > r_costs[polygon]) {
+			// Already reached with a lower cost.
+			continue;
+		}
+
+		LocalVector<StepCost> steps;
+		if (p_reverse) {
+			const LocalVector<StepCost> *reverse_steps = steps_into.getptr(polygon);
+			if (reverse_steps) {
+				steps = *reverse_steps;
+			}
+		} else {
+			for (const gd::Edge &edge : polygon->edges) {
+				for (const gd::Edge::Connection &connection : edge.connections) {
+					if (connection.polygon->hierarchy_cluster != cluster_id) {
+						continue;
+					}
+					StepCost step;
+					step.polygon = connection.polygon;
+					step.cost = _get_step_cost(polygon, connection.polygon);
+					steps.push_back(step);
+				}
+			}
+		}
+
+		for (const StepCost &step : steps) {
+			const real_t cost = current.cost + step.cost;
+			const real_t *known_cost = r_costs.getptr(step.polygon);
+			if (known_cost && *known_cost <= cost) {
+				continue;
+			}
+			r_costs[step.polygon] = cost;
+
+			OpenEntry entry;
+			entry.cost = cost;
+			entry.id = queued.size();
+			queued.push_back(step.polygon);
+			open.push_back(entry);
+			sorter.push_heap(0, open.size() - 1, 0, entry, open.ptr());
+		}
+	}
+}
+
+void NavMapHierarchy::clear() {
+	cluster_size = 0.0;
+	min_travel_cost = 1.0;
+	cluster_ids.clear();
+	clusters.clear();
+	nodes.clear();
+	free_nodes.clear();
+	polygon_nodes.clear();
+	region_clusters.clear();
+	link_clusters.clear();
+	removed_clusters.clear();
+}
+
+void NavMapHierarchy::remove_region(const NavRegion *p_region) {
+	const HashSet<uint32_t> *region_cluster_ids = region_clusters.getptr(p_region);
+	if (!region_cluster_ids) {
+		return;
+	}
+
+	for (uint32_t cluster_id : *region_cluster_ids) {
+		removed_clusters.insert(cluster_id);
+		clusters[cluster_id].regions.erase(p_region);
+	}
+	region_clusters.erase(p_region);
+}
+
+void NavMapHierarchy::update(const LocalVector<NavRegion *> &p_regions, const HashSet<const NavRegion *> &p_changed_regions, const LocalVector<const gd::Polygon *> &p_link_entry_polygons, real_t p_cluster_size) {
+	ERR_FAIL_COND(p_cluster_size <= 0.0);
+
+	if (p_cluster_size != cluster_size) {
+		clear();
+		cluster_size = p_cluster_size;
+	}
+
+	// The polygons of these clusters are listed again, since some of them were rebuilt or removed.
+	// Links are rebuilt along with any region, so the clusters they connected are listed again too.
+	HashSet<uint32_t> cleared_clusters = removed_clusters;
+	removed_clusters.clear();
+	for (uint32_t cluster_id : link_clusters) {
+		cleared_clusters.insert(cluster_id);
+	}
+
+	LocalVector<NavRegion *> changed_regions;
+	min_travel_cost = FLT_MAX;
+	for (NavRegion *region : p_regions) {
+		if (region->get_enabled()) {
+			min_travel_cost = MIN(min_travel_cost, region->get_travel_cost());
+		}
+
+		const HashSet<uint32_t> *region_cluster_ids = region_clusters.getptr(region);
+		if (region_cluster_ids && !p_changed_regions.has(region)) {
+			continue;
+		}
+		if (region_cluster_ids) {
+			for (uint32_t cluster_id : *region_cluster_ids) {
+				cleared_clusters.insert(cluster_id);
+			}
+		}
+		changed_regions.push_back(region);
+	}
+
+	HashSet<const NavRegion *> relisted_regions;
+	for (uint32_t cluster_id : cleared_clusters) {
+		Cluster &cluster = clusters[cluster_id];
+		for (const NavRegion *region : cluster.regions) {
+			if (!p_changed_regions.has(region)) {
+				relisted_regions.insert(region);
+			}
+		}
+		cluster.polygons.clear();
+		cluster.regions.clear();
+	}
+
+	// Clusters whose nodes and edges are rebuilt.
+	HashSet<uint32_t> rebuilt_clusters = cleared_clusters;
+
+	for (NavRegion *region : changed_regions) {
+		HashSet<uint32_t> &region_cluster_ids = region_clusters[region];
+		region_cluster_ids.clear();
+
+		const bool enabled = region->get_enabled();
+		for (gd::Polygon &polygon : region->get_polygons()) {
+			if (!enabled) {
+				polygon.hierarchy_cluster = -1;
+				continue;
+			}
+
+			const uint32_t cluster_id = _get_or_create_cluster(polygon.center);
+			polygon.hierarchy_cluster = cluster_id;
+			clusters[cluster_id].polygons.push_back(&polygon);
+			clusters[cluster_id].regions.insert(region);
+			region_cluster_ids.insert(cluster_id);
+			rebuilt_clusters.insert(cluster_id);
+		}
+	}
+
+	// The other regions keep their polygons and clusters, only those in the cleared clusters are listed again.
+	for (const NavRegion *region : relisted_regions) {
+		for (const gd::Polygon &polygon : region->get_polygons()) {
+			if (polygon.hierarchy_cluster != -1 && cleared_clusters.has(polygon.hierarchy_cluster)) {
+				clusters[polygon.hierarchy_cluster].polygons.push_back(&polygon);
+				clusters[polygon.hierarchy_cluster].regions.insert(region);
+			}
+		}
+	}
+
+	// Links are not part of any cluster, since they can join polygons far away from each other.
+	link_clusters.clear();
+	for (const gd::Polygon *entry_polygon : p_link_entry_polygons) {
+		if (entry_polygon->hierarchy_cluster == -1) {
+			continue;
+		}
+		link_clusters.insert(entry_polygon->hierarchy_cluster);
+		for (const gd::Edge &edge : entry_polygon->edges) {
+			for (const gd::Edge::Connection &connection : edge.connections) {
+				if (connection.edge != -1) {
+					continue;
+				}
+				const gd::Polygon *link_polygon = connection.polygon;
+				min_travel_cost = MIN(min_travel_cost, link_polygon->owner->get_travel_cost());
+				for (const gd::Edge &link_edge : link_polygon->edges) {
+					for (const gd::Edge::Connection &link_connection : link_edge.connections) {
+						if (link_connection.polygon->hierarchy_cluster != -1) {
+							link_clusters.insert(link_connection.polygon->hierarchy_cluster);
+						}
+					}
+				}
+			}
+		}
+	}
+	for (uint32_t cluster_id : link_clusters) {
+		rebuilt_clusters.insert(cluster_id);
+	}
+	if (min_travel_cost == FLT_MAX) {
+		min_travel_cost = 1.0;
+	}
+
+	// The edges from the other clusters into the rebuilt ones lead to nodes about to be dropped.
+	HashSet<uint32_t> boundary_clusters;
+	for (uint32_t cluster_id : rebuilt_clusters) {
+		for (uint32_t from_cluster : clusters[cluster_id].incoming_clusters) {
+			if (!rebuilt_clusters.has(from_cluster)) {
+				boundary_clusters.insert(from_cluster);
+			}
+		}
+	}
+	for (uint32_t cluster_id : boundary_clusters) {
+		for (uint32_t id : clusters[cluster_id].nodes) {
+			LocalVector<Edge> &edges = nodes[id].edges;
+			for (int64_t i = edges.size() - 1; i >= 0; i--) {
+				if (rebuilt_clusters.has(nodes[edges[i].to].cluster)) {
+					edges.remove_at_unordered(i);
+				}
+			}
+		}
+	}
+
+	for (uint32_t cluster_id : rebuilt_clusters) {
+		Cluster &cluster = clusters[cluster_id];
+		for (uint32_t id : cluster.nodes) {
+			// The polygon may be freed already, only its address is used here.
+			polygon_nodes.erase(nodes[id].polygon);
+			nodes[id] = Node();
+			free_nodes.push_back(id);
+		}
+		cluster.nodes.clear();
+		cluster.incoming_clusters.clear();
+	}
+
+	HashMap<uint32_t, uint32_t> boundary_node_counts;
+	for (uint32_t cluster_id : boundary_clusters) {
+		boundary_node_counts.insert(cluster_id, clusters[cluster_id].nodes.size());
+	}
+
+	for (uint32_t cluster_id : rebuilt_clusters) {
+		_add_cluster_exits(cluster_id, nullptr);
+	}
+	for (uint32_t cluster_id : boundary_clusters) {
+		_add_cluster_exits(cluster_id, &rebuilt_clusters);
+	}
+
+	for (uint32_t cluster_id : rebuilt_clusters) {
+		_add_cluster_paths(cluster_id);
+	}
+	for (const KeyValue<uint32_t, uint32_t> &E : boundary_node_counts) {
+		Cluster &cluster = clusters[E.key];
+		if (cluster.nodes.size() == E.value) {
+			continue;
+		}
+
+		// A one-way link now ends in this cluster, so its paths are computed again with the new node.
+		for (uint32_t id : cluster.nodes) {
+			LocalVector<Edge> &edges = nodes[id].edges;
+			for (int64_t i = edges.size() - 1; i >= 0; i--) {
+				if (nodes[edges[i].to].cluster == E.key) {
+					edges.remove_at_unordered(i);
+				}
+			}
+		}
+		_add_cluster_paths(E.key);
+	}
+}
+
+bool NavMapHierarchy::find_corridor(const gd::Polygon *p_begin, const gd::Polygon *p_end, const Vector3 &p_end_point, HashSet<int32_t> &r_clusters) const {
+	r_clusters.clear();
+
+	if (!removed_clusters.is_empty()) {
+		// Some nodes point to the polygons of removed regions until the next update.
+		return false;
+	}
+
+	const int32_t begin_cluster = p_begin->hierarchy_cluster;
+	const int32_t end_cluster = p_end->hierarchy_cluster;
+	if (begin_cluster < 0 || end_cluster < 0 || begin_cluster == end_cluster) {
+		return false;
+	}
+	if (begin_cluster >= (int32_t)clusters.size() || end_cluster >= (int32_t)clusters.size()) {
+		return false;
+	}
+
+	HashMap<const gd::Polygon *, real_t> begin_costs;
+	HashMap<const gd::Polygon *, real_t> end_costs;
+	_search_cluster(p_begin, false, begin_costs);
+	_search_cluster(p_end, true, end_costs);
+
+	// Only the nodes this query reaches, since queries run concurrently and the graph can be large.
+	HashMap<uint32_t, CorridorNode> reached;
+
+	SortArray<OpenEntry, OpenEntrySort> sorter;
+	LocalVector<OpenEntry> open;
+
+	for (uint32_t id : clusters[begin_cluster].nodes) {
+		const real_t *cost = begin_costs.getptr(nodes[id].polygon);
+		if (!cost) {
+			continue;
+		}
+		reached[id].traveled = *cost;
+
+		OpenEntry entry;
+		entry.cost = *cost + nodes[id].polygon->center.distance_to(p_end_point) * min_travel_cost;
+		entry.id = id;
+		open.push_back(entry);
+		sorter.push_heap(0, open.size() - 1, 0, entry, open.ptr());
+	}
+
+	// This is an implementation of the A* algorithm over the nodes.
+	real_t best_cost = FLT_MAX;
+	int64_t best_node = -1;
+	while (!open.is_empty()) {
+		const OpenEntry current = open[0];
+		sorter.pop_heap(0, open.size(), open.ptr());
+		open.remove_at(open.size() - 1);
+
+		if (current.cost >= best_cost) {
+			break;
+		}
+
+		const Node &node = nodes[current.id];
+		const real_t cost = reached[current.id].traveled;
+		if (current.cost > cost + node.polygon->center.distance_to(p_end_point) * min_travel_cost + CMP_EPSILON) {
+			// Already reached with a lower cost.
+			continue;
+		}
+
+		if (node.polygon->hierarchy_cluster == end_cluster) {
+			const real_t *end_cost = end_costs.getptr(node.polygon);
+			if (end_cost && cost + *end_cost < best_cost) {
+				best_cost = cost + *end_cost;
+				best_node = current.id;
+			}
+		}
+
+		for (const Edge &edge : node.edges) {
+			const real_t new_cost = cost + edge.cost;
+			CorridorNode &next = reached[edge.to];
+			if (new_cost >= next.traveled) {
+				continue;
+			}
+			next.traveled = new_cost;
+			next.previous = current.id;
+
+			OpenEntry entry;
+			entry.cost = new_cost + nodes[edge.to].polygon->center.distance_to(p_end_point) * min_travel_cost;
+			entry.id = edge.to;
+			open.push_back(entry);
+			sorter.push_heap(0, open.size() - 1, 0, entry, open.ptr());
+		}
+	}
+
+	if (best_node == -1) {
+		return false;
+	}
+
+	r_clusters.insert(begin_cluster);
+	r_clusters.insert(end_cluster);
+	for (int64_t id = best_node; id != -1; id = reached[id].previous) {
+		r_clusters.insert(nodes[id].polygon->hierarchy_cluster);
+	}
+	return true;
+}
@@ -0,0 +1,139 @@
+/**************************************************************************/
+/*  nav_map_hierarchy.h                                                   */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef NAV_MAP_HIERARCHY_H
+#define NAV_MAP_HIERARCHY_H
+
+#include "nav_utils.h"
+
+#include "core/templates/hash_map.h"
+#include "core/templates/hash_set.h"
+#include "core/templates/local_vector.h"
+
+class NavRegion;
+
+/// Abstract graph over the polygons of a map, used to narrow down long path queries.
+///
+/// The polygons are grouped in clusters by their position on a regular grid. The polygons
+/// with connections to other clusters are the nodes of the graph, and its edges are those
+/// connections plus the shortest paths between the nodes of a same cluster, precomputed on update.
+/// A query searches this graph first for the clusters the path goes through, so the polygon
+/// search only has to expand the polygons in those.
+///
+/// Updates only rebuild the clusters holding polygons of changed regions or links, and the edges
+/// leading into them from the other clusters.
+class NavMapHierarchy {
+	struct Edge {
+		uint32_t to = 0;
+		real_t cost = 0.0;
+	};
+
+	struct Node {
+		const gd::Polygon *polygon = nullptr;
+		uint32_t cluster = 0;
+		LocalVector<Edge> edges;
+	};
+
+	struct Cluster {
+		LocalVector<const gd::Polygon *> polygons;
+		LocalVector<uint32_t> nodes;
+		/// Regions with polygons in this cluster.
+		HashSet<const NavRegion *> regions;
+		/// Clusters with edges into this one, which are rebuilt along with it.
+		HashSet<uint32_t> incoming_clusters;
+	};
+
+	struct StepCost {
+		const gd::Polygon *polygon = nullptr;
+		real_t cost = 0.0;
+	};
+
+	struct CorridorNode {
+		real_t traveled = FLT_MAX;
+		int64_t previous = -1;
+	};
+
+	struct OpenEntry {
+		real_t cost = 0.0;
+		uint32_t id = 0;
+	};
+
+	struct OpenEntrySort {
+		_FORCE_INLINE_ bool operator()(const OpenEntry &A, const OpenEntry &B) const {
+			// Lower cost is better, so the heap keeps it on top.
+			return A.cost > B.cost;
+		}
+	};
+
+	real_t cluster_size = 0.0;
+	/// Lowest travel cost of the regions and links, which scales the distance heuristic so it never overestimates.
+	real_t min_travel_cost = 1.0;
+
+	HashMap<Vector3i, uint32_t> cluster_ids;
+	LocalVector<Cluster> clusters;
+	LocalVector<Node> nodes;
+	LocalVector<uint32_t> free_nodes;
+	HashMap<const gd::Polygon *, uint32_t> polygon_nodes;
+
+	HashMap<const NavRegion *, HashSet<uint32_t>> region_clusters;
+	/// Clusters with polygons links start or end on.
+	HashSet<uint32_t> link_clusters;
+	/// Clusters of removed regions, still pointing to their freed polygons until the next update.
+	HashSet<uint32_t> removed_clusters;
+
+	uint32_t _get_or_create_cluster(const Vector3 &p_position);
+	uint32_t _get_or_create_node(const gd::Polygon *p_polygon);
+	void _add_edge(const gd::Polygon *p_from, const gd::Polygon *p_to, real_t p_cost);
+	void _add_cluster_exits(uint32_t p_cluster, const HashSet<uint32_t> *p_target_clusters);
+	void _add_cluster_paths(uint32_t p_cluster);
+	void _search_cluster(const gd::Polygon *p_from, bool p_reverse, HashMap<const gd::Polygon *, real_t> &r_costs) const;
+
+	static real_t _get_step_cost(const gd::Polygon *p_from, const gd::Polygon *p_to);
+
+public:
+	bool is_empty() const { return clusters.is_empty(); }
+	uint32_t get_cluster_count() const { return clusters.size(); }
+	uint32_t get_node_count() const { return nodes.size() - free_nodes.size(); }
+
+	void clear();
+
+	/// Forgets a region removed from the map. Its clusters are rebuilt on the next update, and no corridor is searched until then.
+	void remove_region(const NavRegion *p_region);
+
+	/// Rebuilds the clusters with polygons of `p_changed_regions`, of regions new to the hierarchy, of removed regions and of links.
+	/// `p_link_entry_polygons` are the polygons with connections into links. Everything is rebuilt when `p_cluster_size` changes.
+	void update(const LocalVector<NavRegion *> &p_regions, const HashSet<const NavRegion *> &p_changed_regions, const LocalVector<const gd::Polygon *> &p_link_entry_polygons, real_t p_cluster_size);
+
+	/// Finds the clusters the shortest path from `p_begin` to `p_end` goes through, on the abstract graph.
+	/// Returns false when both polygons are in the same cluster or no path was found, in which case the full map should be searched.
+	bool find_corridor(const gd::Polygon *p_begin, const gd::Polygon *p_end, const Vector3 &p_end_point, HashSet<int32_t> &r_clusters) const;
+};
+
+#endif // NAV_MAP_HIERARCHY_H
@@ -198,6 +198,13 @@ void NavRegion::update_polygons() {
 	surface_area = 0.0;
 	polygons_dirty = false;
 
+	boundary_edges.clear();
+	bounds = AABB();
+	edge_count = 0;
+	edge_merge_count = 0;
+	external_edge_merge_count = 0;
+	free_edge_count = 0;
+
 	if (map == nullptr) {
 		return;
 	}
@@ -301,4 +308,56 @@ void NavRegion::update_polygons() {
 	}
 
 	surface_area = _new_region_surface_area;
+
+	update_internal_connections();
+}
+
+void NavRegion::update_internal_connections() {
+	// Group all edges per key.
+	HashMap<gd::EdgeKey, LocalVector<gd::Edge::Connection>, gd::EdgeKey> connections_by_key;
+	bool first_point = true;
+	for (gd::Polygon &poly : polygons) {
+		for (uint32_t p = 0; p < poly.points.size(); p++) {
+			if (first_point) {
+				bounds.position = poly.points[p].pos;
+				first_point = false;
+			} else {
+				bounds.expand_to(poly.points[p].pos);
+			}
+
+			int next_point = (p + 1) % poly.points.size();
+			gd::EdgeKey ek(poly.points[p].key, poly.points[next_point].key);
+
+			LocalVector<gd::Edge::Connection> &key_connections = connections_by_key[ek];
+			if (key_connections.size() <= 1) {
+				// Add the polygon/edge tuple to this key.
+				gd::Edge::Connection new_connection;
+				new_connection.polygon = &poly;
+				new_connection.edge = p;
+				new_connection.pathway_start = poly.points[p].pos;
+				new_connection.pathway_end = poly.points[next_point].pos;
+				key_connections.push_back(new_connection);
+			} else {
+				// The edge is already connected with another edge, skip.
+				ERR_PRINT_ONCE("Navigation map synchronization error. Attempted to merge a navigation mesh polygon edge with another already-merged edge. This is usually caused by crossing edges, overlapping polygons, or a mismatch of the NavigationMesh / NavigationPolygon baked 'cell_size' and navigation map 'cell_size'. If you're certain none of above is the case, change 'navigation/3d/merge_rasterizer_cell_scale' to 0.001.");
+			}
+		}
+	}
+
+	edge_count = connections_by_key.size();
+
+	for (KeyValue<gd::EdgeKey, LocalVector<gd::Edge::Connection>> &E : connections_by_key) {
+		if (E.value.size() == 2) {
+			// Connect edge that are shared in different polygons.
+			gd::Edge::Connection &c1 = E.value[0];
+			gd::Edge::Connection &c2 = E.value[1];
+			c1.polygon->edges[c1.edge].connections.push_back(c2);
+			c2.polygon->edges[c2.edge].connections.push_back(c1);
+			// Note: The pathway_start/end are full for those connection and do not need to be modified.
+			edge_merge_count += 1;
+		} else {
+			// Left for the map to connect to other regions.
+			boundary_edges.push_back({ E.key, E.value[0] });
+		}
+	}
 }
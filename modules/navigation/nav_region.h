@@ -52,6 +52,15 @@ class NavRegion : public NavBase {
 
 	real_t surface_area = 0.0;
 
+	/// Connection data, kept between map syncs so that only changed regions
+	/// and their neighbors need to be connected again.
+	LocalVector<gd::BoundaryEdge> boundary_edges;
+	AABB bounds;
+	uint32_t edge_count = 0;
+	uint32_t edge_merge_count = 0;
+	uint32_t external_edge_merge_count = 0;
+	uint32_t free_edge_count = 0;
+
 public:
 	NavRegion() {
 		type = NavigationUtilities::PathSegmentType::PATH_SEGMENT_TYPE_REGION;
@@ -94,6 +103,33 @@ public:
 	LocalVector<gd::Polygon> const &get_polygons() const {
 		return polygons;
 	}
+	LocalVector<gd::Polygon> &get_polygons() {
+		return polygons;
+	}
+
+	/// Returns whether the polygon belongs to this region, without dereferencing it.
+	bool owns_polygon(const gd::Polygon *p_polygon) const {
+		return p_polygon >= polygons.ptr() && p_polygon < polygons.ptr() + polygons.size();
+	}
+
+	LocalVector<gd::BoundaryEdge> &get_boundary_edges() {
+		return boundary_edges;
+	}
+	const AABB &get_bounds() const {
+		return bounds;
+	}
+
+	/// Edges and merges between the polygons of this region.
+	uint32_t get_edge_count() const { return edge_count; }
+	uint32_t get_edge_merge_count() const { return edge_merge_count; }
+
+	/// Edges merged with, and edges left free to connect to, other regions. Updated by the map.
+	void set_external_edge_counts(uint32_t p_merge_count, uint32_t p_free_count) {
+		external_edge_merge_count = p_merge_count;
+		free_edge_count = p_free_count;
+	}
+	uint32_t get_external_edge_merge_count() const { return external_edge_merge_count; }
+	uint32_t get_free_edge_count() const { return free_edge_count; }
 
 	Vector3 get_random_point(uint32_t p_navigation_layers, bool p_uniformly) const;
 
@@ -103,6 +139,7 @@ public:
 
 private:
 	void update_polygons();
+	void update_internal_connections();
 };
 
 #endif // NAV_REGION_H
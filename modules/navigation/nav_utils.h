@@ -114,6 +114,16 @@ struct Polygon {
 	Vector3 center;
 
 	real_t surface_area = 0.0;
+
+	/// The cluster of the map hierarchy this `Polygon` belongs to, or -1 when not part of any.
+	int32_t hierarchy_cluster = -1;
+};
+
+/// Polygon edge that is not shared with another polygon of the same region,
+/// so it may connect to the polygons of other regions.
+struct BoundaryEdge {
+	EdgeKey key;
+	Edge::Connection connection;
 };
 
 struct NavigationPoly {
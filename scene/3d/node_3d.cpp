@@ -103,15 +103,29 @@ void Node3D::_propagate_transform_changed_deferred() {
 	}
 }
 
+void Node3D::_invalidate_transform_propagation() {
+	// This node may now need a notification, so ancestors must not skip its subtree as already propagated.
+	for (Node3D *n = this; n; n = n->data.top_level ? nullptr : n->data.parent) {
+		n->data.transform_propagation_epoch = 0;
+	}
+}
+
 void Node3D::_propagate_transform_changed(Node3D *p_origin) {
 	if (!is_inside_tree()) {
 		return;
 	}
 
+	// Subtrees that were already marked dirty and queued since notifications were last sent don't need to be
+	// visited again, so moving many nodes of the same hierarchy in a frame walks each subtree only once.
+	const uint64_t epoch = (!is_group_processing() && is_accessible_from_caller_thread()) ? get_tree()->xform_change_epoch : 0;
+
 	for (Node3D *&E : data.children) {
 		if (E->data.top_level) {
 			continue; //don't propagate to a top_level
 		}
+		if (epoch && E->data.transform_propagation_epoch == epoch && E->_test_dirty_bits(DIRTY_GLOBAL_TRANSFORM)) {
+			continue;
+		}
 		E->_propagate_transform_changed(p_origin);
 	}
 #ifdef TOOLS_ENABLED
@@ -127,6 +141,7 @@ void Node3D::_propagate_transform_changed(Node3D *p_origin) {
 		}
 	}
 	_set_dirty_bits(DIRTY_GLOBAL_TRANSFORM);
+	data.transform_propagation_epoch = epoch;
 }
 
 void Node3D::_notification(int p_what) {
@@ -158,6 +173,7 @@ void Node3D::_notification(int p_what) {
 			}
 
 			_set_dirty_bits(DIRTY_GLOBAL_TRANSFORM); // Global is always dirty upon entering a scene.
+			_invalidate_transform_propagation(); // The new parent may already be marked as propagated.
 			_notify_dirty();
 
 			notification(NOTIFICATION_ENTER_WORLD);
@@ -170,6 +186,7 @@ void Node3D::_notification(int p_what) {
 			notification(NOTIFICATION_EXIT_WORLD, true);
 			if (xform_change.in_list()) {
 				get_tree()->xform_change_list.remove(&xform_change);
+				_invalidate_transform_propagation();
 			}
 			if (data.C) {
 				data.parent->data.children.erase(data.C);
@@ -612,6 +629,7 @@ void Node3D::add_gizmo(Ref<Node3DGizmo> p_gizmo) {
 		return;
 	}
 	data.gizmos.push_back(p_gizmo);
+	_invalidate_transform_propagation();
 
 	if (p_gizmo.is_valid() && is_inside_world()) {
 		p_gizmo->create();
@@ -968,6 +986,9 @@ Vector3 Node3D::to_global(Vector3 p_local) const {
 void Node3D::set_notify_transform(bool p_enabled) {
 	ERR_THREAD_GUARD;
 	data.notify_transform = p_enabled;
+	if (p_enabled) {
+		_invalidate_transform_propagation();
+	}
 }
 
 bool Node3D::is_transform_notification_enabled() const {
@@ -992,6 +1013,8 @@ void Node3D::force_update_transform() {
 		return; //nothing to update
 	}
 	get_tree()->xform_change_list.remove(&xform_change);
+	// No longer queued, so the next move of an ancestor must visit this node again.
+	_invalidate_transform_propagation();
 
 	notification(NOTIFICATION_TRANSFORM_CHANGED);
 }
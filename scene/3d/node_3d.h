@@ -110,6 +110,9 @@ private:
 		List<Node3D *> children;
 		List<Node3D *>::Element *C = nullptr;
 
+		// SceneTree::xform_change_epoch when this node and its subtree were last marked dirty and queued for notification.
+		uint64_t transform_propagation_epoch = 0;
+
 		bool ignore_notification = false;
 		bool notify_local_transform = false;
 		bool notify_transform = false;
@@ -136,6 +139,7 @@ private:
 
 	void _update_gizmos();
 	void _notify_dirty();
+	void _invalidate_transform_propagation();
 	void _propagate_transform_changed(Node3D *p_origin);
 
 	void _propagate_visibility_changed();
@@ -145,7 +149,12 @@ private:
 	void _propagate_transform_changed_deferred();
 
 protected:
-	_FORCE_INLINE_ void set_ignore_transform_notification(bool p_ignore) { data.ignore_notification = p_ignore; }
+	_FORCE_INLINE_ void set_ignore_transform_notification(bool p_ignore) {
+		data.ignore_notification = p_ignore;
+		if (!p_ignore) {
+			_invalidate_transform_propagation();
+		}
+	}
 
 	_FORCE_INLINE_ void _update_local_transform() const;
 	_FORCE_INLINE_ void _update_rotation_and_scale() const;
@@ -31,6 +31,7 @@
 #include "scene_tree.h"
 
 #include "core/config/project_settings.h"
+#include "core/core_string_names.h"
 #include "core/debugger/engine_debugger.h"
 #include "core/input/input.h"
 #include "core/io/dir_access.h"
@@ -184,6 +185,7 @@ void SceneTree::flush_transform_notifications() {
 		Node *node = n->self();
 		SelfList<Node> *nx = n->next();
 		xform_change_list.remove(n);
+		xform_change_epoch++;
 		n = nx;
 		node->notification(NOTIFICATION_TRANSFORM_CHANGED);
 	}
@@ -474,6 +476,8 @@ void SceneTree::iteration_prepare() {
 }
 
 bool SceneTree::physics_process(double p_time) {
+	MemoryTagScope tag_scope(Memory::TAG_SCENE);
+
 	current_frame++;
 
 	flush_transform_notifications();
@@ -498,6 +502,7 @@ bool SceneTree::physics_process(double p_time) {
 
 	flush_transform_notifications();
 
+	_flush_pool_release_queue();
 	_flush_delete_queue();
 	_call_idle_callbacks();
 
@@ -505,6 +510,8 @@ bool SceneTree::physics_process(double p_time) {
 }
 
 bool SceneTree::process(double p_time) {
+	MemoryTagScope tag_scope(Memory::TAG_SCENE);
+
 	if (MainLoop::process(p_time)) {
 		_quit = true;
 	}
@@ -530,6 +537,7 @@ bool SceneTree::process(double p_time) {
 	MessageQueue::get_singleton()->flush(); //small little hack
 	flush_transform_notifications(); //transforms after world update, to avoid unnecessary enter/exit notifications
 
+	_flush_pool_release_queue();
 	_flush_delete_queue();
 
 	if (unlikely(pending_new_scene)) {
@@ -635,6 +643,7 @@ void SceneTree::process_tweens(double p_delta, bool p_physics) {
 }
 
 void SceneTree::finalize() {
+	clear_pools();
 	_flush_delete_queue();
 
 	_flush_ugc();
@@ -1388,6 +1397,282 @@ int SceneTree::get_node_count() const {
 	return nodes_in_tree_count;
 }
 
+void SceneTree::_snapshot_pooled_node(Node *p_node, LocalVector<PooledNodeState> &r_snapshot, HashMap<Ref<Resource>, Ref<Resource>> &r_local_resources) {
+	PooledNodeState state;
+	state.name = p_node->get_name();
+	state.child_count = p_node->get_child_count(false);
+
+	List<Node::GroupInfo> groups;
+	p_node->get_groups(&groups);
+	for (const Node::GroupInfo &E : groups) {
+		state.groups.push_back(Pair<StringName, bool>(E.name, E.persistent));
+	}
+
+	List<PropertyInfo> plist;
+	p_node->get_property_list(&plist);
+	for (const PropertyInfo &E : plist) {
+		if (!(E.usage & PROPERTY_USAGE_STORAGE) || E.name == CoreStringNames::get_singleton()->_script) {
+			continue;
+		}
+
+		const Variant value = p_node->get(E.name);
+		if (value.get_type() == Variant::OBJECT && value.get_validated_object()) {
+			Ref<Resource> res = value;
+			if (res.is_null()) {
+				// Node references belong to each instance, so they are kept.
+				continue;
+			}
+			if (res->is_local_to_scene()) {
+				// Keep an untouched copy, the instance may modify its own before being released.
+				HashMap<Ref<Resource>, Ref<Resource>>::Iterator L = r_local_resources.find(res);
+				if (!L) {
+					L = r_local_resources.insert(res, res->duplicate_for_local_scene(nullptr, r_local_resources));
+				}
+				state.local_resources.push_back(Pair<StringName, Ref<Resource>>(E.name, L->value));
+				continue;
+			}
+		}
+		state.properties.push_back(Pair<StringName, Variant>(E.name, value));
+	}
+	r_snapshot.push_back(state);
+
+	for (int i = 0; i < state.child_count; i++) {
+		_snapshot_pooled_node(p_node->get_child(i, false), r_snapshot, r_local_resources);
+	}
+}
+
+void SceneTree::_disconnect_pooled_node(Node *p_instance, Node *p_node) {
+	// Only connections made at runtime to objects outside the instance, as those would keep calling into or
+	// out of it while pooled. Connections within the instance and to resources are part of its setup.
+	List<Object::Connection> connections;
+	p_node->get_all_signal_connections(&connections);
+	p_node->get_signals_connected_to_this(&connections);
+	for (const Object::Connection &E : connections) {
+		if (E.flags & CONNECT_PERSIST) {
+			continue;
+		}
+
+		Object *other = E.signal.get_object() == p_node ? E.callable.get_object() : E.signal.get_object();
+		if (Object::cast_to<Resource>(other)) {
+			continue;
+		}
+		Node *other_node = Object::cast_to<Node>(other);
+		if (other_node && (other_node == p_instance || p_instance->is_ancestor_of(other_node))) {
+			continue;
+		}
+
+		Signal signal = E.signal;
+		if (signal.is_connected(E.callable)) {
+			signal.disconnect(E.callable);
+		}
+	}
+}
+
+bool SceneTree::_restore_pooled_node(Node *p_instance, Node *p_node, const LocalVector<PooledNodeState> &p_snapshot, uint32_t &r_index, HashMap<Ref<Resource>, Ref<Resource>> &r_local_resources) {
+	if (r_index >= p_snapshot.size()) {
+		return false;
+	}
+
+	const PooledNodeState &state = p_snapshot[r_index];
+	const int child_count = p_node->get_child_count(false);
+	if (child_count != state.child_count) {
+		return false;
+	}
+	if (p_node->get_name() != state.name) {
+		// The root may have been renamed when added next to other instances, but other nodes must not have changed.
+		if (r_index > 0) {
+			return false;
+		}
+		p_node->set_name(state.name);
+	}
+	r_index++;
+
+	_disconnect_pooled_node(p_instance, p_node);
+
+	List<Node::GroupInfo> groups;
+	p_node->get_groups(&groups);
+	for (const Node::GroupInfo &E : groups) {
+		bool in_snapshot = false;
+		for (const Pair<StringName, bool> &G : state.groups) {
+			if (G.first == E.name) {
+				in_snapshot = true;
+				break;
+			}
+		}
+		if (!in_snapshot) {
+			p_node->remove_from_group(E.name);
+		}
+	}
+	for (const Pair<StringName, bool> &E : state.groups) {
+		if (!p_node->is_in_group(E.first)) {
+			p_node->add_to_group(E.first, E.second);
+		}
+	}
+
+	for (const Pair<StringName, Variant> &E : state.properties) {
+		if (E.second.get_type() == Variant::ARRAY || E.second.get_type() == Variant::DICTIONARY) {
+			p_node->set(E.first, E.second.duplicate(true));
+		} else {
+			p_node->set(E.first, E.second);
+		}
+	}
+
+	for (const Pair<StringName, Ref<Resource>> &E : state.local_resources) {
+		HashMap<Ref<Resource>, Ref<Resource>>::Iterator L = r_local_resources.find(E.second);
+		if (!L) {
+			L = r_local_resources.insert(E.second, E.second->duplicate_for_local_scene(p_instance, r_local_resources));
+		}
+		p_node->set(E.first, L->value);
+	}
+
+	for (int i = 0; i < child_count; i++) {
+		if (!_restore_pooled_node(p_instance, p_node->get_child(i, false), p_snapshot, r_index, r_local_resources)) {
+			return false;
+		}
+	}
+	return true;
+}
+
+void SceneTree::_flush_pool_release_queue() {
+	_THREAD_SAFE_METHOD_
+
+	while (pool_release_queue.size()) {
+		const ObjectID id = pool_release_queue.front()->get();
+		pool_release_queue.pop_front();
+
+		Node *node = Object::cast_to<Node>(ObjectDB::get_instance(id));
+		PooledInstance *instance = pooled_instances.getptr(id);
+		if (!node || !instance || instance->in_pool) {
+			continue;
+		}
+
+		if (node->get_parent()) {
+			node->get_parent()->remove_child(node);
+		}
+
+		ScenePool *pool = scene_pools.getptr(instance->scene);
+		bool reusable = pool && !node->is_queued_for_deletion() && (int)pool->instances.size() < pool_capacity;
+		if (reusable) {
+			uint32_t index = 0;
+			HashMap<Ref<Resource>, Ref<Resource>> local_resources;
+			reusable = _restore_pooled_node(node, node, pool->snapshot, index, local_resources) && index == pool->snapshot.size();
+			if (reusable) {
+				// Same as PackedScene::instantiate(), the duplicates are only set up once all of them are assigned.
+				for (KeyValue<Ref<Resource>, Ref<Resource>> &E : local_resources) {
+					E.value->setup_local_to_scene();
+				}
+			}
+		}
+		if (!reusable) {
+			// Full pool, or the instance changed too much to be restored.
+			pooled_instances.erase(id);
+			memdelete(node);
+			continue;
+		}
+
+		node->propagate_notification(Node::NOTIFICATION_RECYCLED);
+
+		instance->in_pool = true;
+		pool->instances.push_back(id);
+		pooled_instance_count++;
+	}
+}
+
+Node *SceneTree::instantiate_pooled(const Ref<PackedScene> &p_scene) {
+	_THREAD_SAFE_METHOD_
+	ERR_FAIL_COND_V(p_scene.is_null(), nullptr);
+
+	const ObjectID scene_id = p_scene->get_instance_id();
+	ScenePool *pool = scene_pools.getptr(scene_id);
+	while (pool && !pool->instances.is_empty()) {
+		const ObjectID id = pool->instances[pool->instances.size() - 1];
+		pool->instances.resize(pool->instances.size() - 1);
+		pooled_instance_count--;
+
+		Node *node = Object::cast_to<Node>(ObjectDB::get_instance(id));
+		if (!node) {
+			// Freed while in the pool.
+			pooled_instances.erase(id);
+			continue;
+		}
+		pooled_instances[id].in_pool = false;
+		pool_reuse_count++;
+		return node;
+	}
+
+	Node *node = p_scene->instantiate();
+	ERR_FAIL_NULL_V(node, nullptr);
+
+	if (!pool) {
+		pool = &scene_pools.insert(scene_id, ScenePool())->value;
+		pool->scene = p_scene;
+		HashMap<Ref<Resource>, Ref<Resource>> local_resources;
+		_snapshot_pooled_node(node, pool->snapshot, local_resources);
+	}
+
+	PooledInstance instance;
+	instance.scene = scene_id;
+	pooled_instances.insert(node->get_instance_id(), instance);
+
+	if (pooled_instances.size() >= pooled_instances_prune_size) {
+		// Instances freed instead of being released leave stale entries behind.
+		LocalVector<ObjectID> stale;
+		for (const KeyValue<ObjectID, PooledInstance> &E : pooled_instances) {
+			if (!ObjectDB::get_instance(E.key)) {
+				stale.push_back(E.key);
+			}
+		}
+		for (const ObjectID &id : stale) {
+			pooled_instances.erase(id);
+		}
+		pooled_instances_prune_size = MAX(64u, pooled_instances.size() * 2);
+	}
+
+	return node;
+}
+
+void SceneTree::release_to_pool(Node *p_node) {
+	_THREAD_SAFE_METHOD_
+	ERR_FAIL_NULL(p_node);
+	ERR_FAIL_COND_MSG(!pooled_instances.has(p_node->get_instance_id()), "Only nodes created with instantiate_pooled() can be released to a pool.");
+	pool_release_queue.push_back(p_node->get_instance_id());
+}
+
+void SceneTree::clear_pools() {
+	_THREAD_SAFE_METHOD_
+
+	_flush_pool_release_queue();
+	for (KeyValue<ObjectID, ScenePool> &E : scene_pools) {
+		for (const ObjectID &id : E.value.instances) {
+			Object *obj = ObjectDB::get_instance(id);
+			if (obj) {
+				memdelete(obj);
+			}
+		}
+	}
+	scene_pools.clear();
+	pooled_instances.clear();
+	pooled_instances_prune_size = 64;
+	pooled_instance_count = 0;
+}
+
+void SceneTree::set_pool_capacity(int p_capacity) {
+	ERR_FAIL_COND(p_capacity < 0);
+	pool_capacity = p_capacity;
+}
+
+int SceneTree::get_pool_capacity() const {
+	return pool_capacity;
+}
+
+int SceneTree::get_pooled_instance_count() const {
+	return pooled_instance_count;
+}
+
+uint64_t SceneTree::get_pool_reuse_count() const {
+	return pool_reuse_count;
+}
+
 void SceneTree::set_edited_scene_root(Node *p_node) {
 #ifdef TOOLS_ENABLED
 	edited_scene_root = p_node;
@@ -1626,6 +1911,14 @@ void SceneTree::_bind_methods() {
 
 	ClassDB::bind_method(D_METHOD("queue_delete", "obj"), &SceneTree::queue_delete);
 
+	ClassDB::bind_method(D_METHOD("instantiate_pooled", "scene"), &SceneTree::instantiate_pooled);
+	ClassDB::bind_method(D_METHOD("release_to_pool", "node"), &SceneTree::release_to_pool);
+	ClassDB::bind_method(D_METHOD("clear_pools"), &SceneTree::clear_pools);
+	ClassDB::bind_method(D_METHOD("set_pool_capacity", "capacity"), &SceneTree::set_pool_capacity);
+	ClassDB::bind_method(D_METHOD("get_pool_capacity"), &SceneTree::get_pool_capacity);
+	ClassDB::bind_method(D_METHOD("get_pooled_instance_count"), &SceneTree::get_pooled_instance_count);
+	ClassDB::bind_method(D_METHOD("get_pool_reuse_count"), &SceneTree::get_pool_reuse_count);
+
 	MethodInfo mi;
 	mi.name = "call_group_flags";
 	mi.arguments.push_back(PropertyInfo(Variant::INT, "flags"));
@@ -1676,6 +1969,7 @@ void SceneTree::_bind_methods() {
 	ADD_PROPERTY(PropertyInfo(Variant::OBJECT, "root", PROPERTY_HINT_RESOURCE_TYPE, "Node", PROPERTY_USAGE_NONE), "", "get_root");
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "multiplayer_poll"), "set_multiplayer_poll_enabled", "is_multiplayer_poll_enabled");
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "physics_interpolation"), "set_physics_interpolation_enabled", "is_physics_interpolation_enabled");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "pool_capacity", PROPERTY_HINT_RANGE, "0,4096,1,or_greater"), "set_pool_capacity", "get_pool_capacity");
 
 	ADD_SIGNAL(MethodInfo("tree_changed"));
 	ADD_SIGNAL(MethodInfo("tree_process_mode_changed")); //editor only signal, but due to API hash it can't be removed in run-time
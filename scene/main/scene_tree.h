@@ -168,6 +168,39 @@ private:
 
 	List<ObjectID> delete_queue;
 
+	// Pools of detached scene instances, to reuse them instead of freeing and instantiating them again.
+	struct PooledNodeState {
+		StringName name;
+		int child_count = 0;
+		LocalVector<Pair<StringName, Variant>> properties;
+		LocalVector<Pair<StringName, bool>> groups; // Name and whether it's persistent.
+		LocalVector<Pair<StringName, Ref<Resource>>> local_resources; // Duplicated again for each released instance.
+	};
+
+	struct ScenePool {
+		Ref<PackedScene> scene;
+		LocalVector<PooledNodeState> snapshot; // Nodes of a fresh instance, in depth-first order.
+		LocalVector<ObjectID> instances;
+	};
+
+	struct PooledInstance {
+		ObjectID scene;
+		bool in_pool = false;
+	};
+
+	HashMap<ObjectID, ScenePool> scene_pools;
+	HashMap<ObjectID, PooledInstance> pooled_instances; // Every instance created by instantiate_pooled().
+	uint32_t pooled_instances_prune_size = 64;
+	List<ObjectID> pool_release_queue;
+	int pool_capacity = 64;
+	int pooled_instance_count = 0;
+	uint64_t pool_reuse_count = 0;
+
+	void _snapshot_pooled_node(Node *p_node, LocalVector<PooledNodeState> &r_snapshot, HashMap<Ref<Resource>, Ref<Resource>> &r_local_resources);
+	void _disconnect_pooled_node(Node *p_instance, Node *p_node);
+	bool _restore_pooled_node(Node *p_instance, Node *p_node, const LocalVector<PooledNodeState> &p_snapshot, uint32_t &r_index, HashMap<Ref<Resource>, Ref<Resource>> &r_local_resources);
+	void _flush_pool_release_queue();
+
 	HashMap<UGCall, Vector<Variant>, UGCall> unique_group_calls;
 	bool ugc_locked = false;
 	void _flush_ugc();
@@ -233,6 +266,7 @@ private:
 	friend class Viewport;
 
 	SelfList<Node>::List xform_change_list;
+	uint64_t xform_change_epoch = 1; // Advanced whenever notifications are flushed. Nodes leaving xform_change_list otherwise invalidate their ancestors.
 
 #ifdef DEBUG_ENABLED // No live editor in release build.
 	friend class LiveEditor;
@@ -383,6 +417,15 @@ public:
 
 	void queue_delete(Object *p_object);
 
+	Node *instantiate_pooled(const Ref<PackedScene> &p_scene);
+	void release_to_pool(Node *p_node);
+	void clear_pools();
+
+	void set_pool_capacity(int p_capacity);
+	int get_pool_capacity() const;
+	int get_pooled_instance_count() const;
+	uint64_t get_pool_reuse_count() const;
+
 	void get_nodes_in_group(const StringName &p_group, List<Node *> *p_list);
 	Node *get_first_node_in_group(const StringName &p_group);
 	bool has_group(const StringName &p_identifier) const;
@@ -166,7 +166,13 @@ Node *SceneState::instantiate(GenEditState p_edit_state) const {
 
 	LocalVector<DeferredNodePathProperties> deferred_node_paths;
 
-	for (int i = 0; i < nc; i++) {
+	// When the scene could be compiled, all nodes are created from its program and the loop below is skipped.
+	int first_node = 0;
+	if (p_edit_state == GEN_EDIT_STATE_DISABLED && _instantiate_from_program(ret_nodes, deferred_node_paths)) {
+		first_node = nc;
+	}
+
+	for (int i = first_node; i < nc; i++) {
 		const NodeData &n = nd[i];
 
 		Node *parent = nullptr;
@@ -591,6 +597,222 @@ Node *SceneState::instantiate(GenEditState p_edit_state) const {
 	return ret_nodes[0];
 }
 
+bool SceneState::_compile_instantiation_program() const {
+	const int nc = nodes.size();
+	if (nc == 0 || base_scene_idx >= 0) {
+		return false;
+	}
+
+	const StringName node_class = SNAME("Node");
+	const int sname_count = names.size();
+	const int prop_count = variants.size();
+
+	InstantiationProgram &program = instantiation_program;
+	program.properties.clear();
+	program.node_property_offsets.resize(nc + 1);
+
+	for (int i = 0; i < nc; i++) {
+		const NodeData &n = nodes[i];
+
+		// Instances, inherited nodes and nodes referred to by path need the generic path.
+		if (n.instance >= 0 || n.type < 0 || n.type >= sname_count || n.name < 0 || n.name >= sname_count) {
+			return false;
+		}
+		if (i == 0 ? n.parent != -1 : (n.parent < 0 || n.parent >= i)) {
+			return false;
+		}
+		if (n.owner >= i || (n.owner < 0 && n.owner != -1)) {
+			return false;
+		}
+		for (int j = 0; j < n.groups.size(); j++) {
+			if (n.groups[j] < 0 || n.groups[j] >= sname_count) {
+				return false;
+			}
+		}
+
+		const StringName &type = names[n.type];
+		if (!ClassDB::can_instantiate(type) || !ClassDB::is_parent_class(type, node_class)) {
+			return false;
+		}
+		// Extension classes may intercept properties before the setters registered in ClassDB.
+		const ClassDB::APIType api = ClassDB::get_api_type(type);
+		bool resolve_setters = api == ClassDB::API_CORE || api == ClassDB::API_EDITOR;
+
+		program.node_property_offsets[i] = program.properties.size();
+
+		for (const NodeData::Property &np : n.properties) {
+			if (np.value < 0 || np.value >= prop_count) {
+				return false;
+			}
+
+			InstantiationProgram::Property property;
+			property.value = np.value;
+
+			if (np.name & FLAG_PATH_PROPERTY_IS_NODE) {
+				property.name = np.name & (FLAG_PATH_PROPERTY_IS_NODE - 1);
+				property.deferred_node_path = true;
+				if (property.name >= sname_count) {
+					return false;
+				}
+				program.properties.push_back(property);
+				continue;
+			}
+
+			property.name = np.name;
+			if (property.name < 0 || property.name >= sname_count) {
+				return false;
+			}
+
+			// Values that are duplicated, retyped or recorded as missing per instance need the generic path.
+			const Variant &value = variants[np.value];
+			if (value.get_type() == Variant::ARRAY || value.get_type() == Variant::DICTIONARY) {
+				return false;
+			}
+			if (value.get_type() == Variant::OBJECT) {
+				Ref<Resource> res = value;
+				if (res.is_valid() && (res->is_local_to_scene() || Object::cast_to<MissingResource>(res.ptr()))) {
+					return false;
+				}
+			}
+
+			const StringName &name = names[property.name];
+			if (name == CoreStringNames::get_singleton()->_script) {
+				// From here on, the script instance gets the first chance to handle properties.
+				resolve_setters = false;
+				property.script = true;
+			} else if (resolve_setters) {
+				const StringName setter = ClassDB::get_property_setter(type, name);
+				if (setter != StringName()) {
+					property.setter = ClassDB::get_method(type, setter);
+					property.setter_index = ClassDB::get_property_index(type, name);
+				}
+			}
+
+			program.properties.push_back(property);
+		}
+	}
+
+	program.node_property_offsets[nc] = program.properties.size();
+	return true;
+}
+
+bool SceneState::_instantiate_from_program(Node **r_nodes, LocalVector<DeferredNodePathProperties> &r_deferred_node_paths) const {
+	if (!use_instantiation_programs || Engine::get_singleton()->is_editor_hint()) {
+		return false;
+	}
+
+	{
+		MutexLock lock(instantiation_program_mutex);
+		if (instantiation_program.state == InstantiationProgram::STATE_NOT_COMPILED) {
+			if (_compile_instantiation_program()) {
+				instantiation_program.state = InstantiationProgram::STATE_COMPILED;
+			} else {
+				instantiation_program.properties.clear();
+				instantiation_program.node_property_offsets.clear();
+				instantiation_program.state = InstantiationProgram::STATE_UNSUPPORTED;
+			}
+		}
+		if (instantiation_program.state != InstantiationProgram::STATE_COMPILED) {
+			return false;
+		}
+	}
+
+	const InstantiationProgram &program = instantiation_program;
+	const NodeData *nd = nodes.ptr();
+	const StringName *snames = names.ptr();
+	const Variant *props = variants.ptr();
+	const int nc = nodes.size();
+
+	for (int i = 0; i < nc; i++) {
+		const NodeData &n = nd[i];
+
+		Object *obj = ClassDB::instantiate(snames[n.type]);
+		Node *node = Object::cast_to<Node>(obj);
+		if (!node) {
+			// The class changed since compiling, let the generic path create a placeholder for it.
+			if (obj) {
+				memdelete(obj);
+			}
+			if (i > 0) {
+				memdelete(r_nodes[0]);
+			}
+			r_deferred_node_paths.clear();
+			return false;
+		}
+
+		for (uint32_t j = program.node_property_offsets[i]; j < program.node_property_offsets[i + 1]; j++) {
+			const InstantiationProgram::Property &property = program.properties[j];
+			const Variant &value = props[property.value];
+
+			if (property.deferred_node_path) {
+				DeferredNodePathProperties dnp;
+				dnp.value = value;
+				dnp.base = node;
+				dnp.property = snames[property.name];
+				r_deferred_node_paths.push_back(dnp);
+			} else if (property.script) {
+				// Same workaround as in instantiate(), so the variables of a previous script carry over.
+				List<Pair<StringName, Variant>> old_state;
+				if (node->get_script_instance()) {
+					node->get_script_instance()->get_property_state(old_state);
+				}
+
+				node->set(snames[property.name], value);
+
+				for (const Pair<StringName, Variant> &E : old_state) {
+					node->set(E.first, E.second);
+				}
+			} else if (property.setter) {
+				Callable::CallError ce;
+				if (property.setter_index >= 0) {
+					const Variant index = property.setter_index;
+					const Variant *args[2] = { &index, &value };
+					property.setter->call(node, args, 2, ce);
+				} else {
+					const Variant *args[1] = { &value };
+					property.setter->call(node, args, 1, ce);
+				}
+			} else {
+				node->set(snames[property.name], value);
+			}
+		}
+
+		for (int j = 0; j < n.groups.size(); j++) {
+			node->add_to_group(snames[n.groups[j]], true);
+		}
+
+		if (i > 0) {
+			Node *parent = r_nodes[n.parent];
+			parent->_add_child_nocheck(node, snames[n.name]);
+			if (n.index >= 0 && n.index < parent->get_child_count() - 1) {
+				parent->move_child(node, n.index);
+			}
+		} else {
+			node->_set_name_nocheck(snames[n.name]);
+		}
+
+		if (n.owner >= 0) {
+			node->_set_owner_nocheck(r_nodes[n.owner]);
+			if (node->data.unique_name_in_owner) {
+				node->_acquire_unique_name_in_owner();
+			}
+		}
+
+		node->remove_meta(SNAME("_edit_pinned_properties_"));
+
+		r_nodes[i] = node;
+	}
+
+	return true;
+}
+
+void SceneState::_clear_instantiation_program() {
+	MutexLock lock(instantiation_program_mutex);
+	instantiation_program.state = InstantiationProgram::STATE_NOT_COMPILED;
+	instantiation_program.properties.clear();
+	instantiation_program.node_property_offsets.clear();
+}
+
 Variant SceneState::make_local_resource(Variant &p_value, const SceneState::NodeData &p_node_data, HashMap<Ref<Resource>, Ref<Resource>> &p_resources_local_to_sub_scene, Node *p_node, const StringName p_sname, HashMap<Ref<Resource>, Ref<Resource>> &p_resources_local_to_scene, int p_i, Node **p_ret_nodes, SceneState::GenEditState p_edit_state) const {
 	Ref<Resource> res = p_value;
 	if (res.is_null() || !res->is_local_to_scene()) {
@@ -1207,6 +1429,7 @@ void SceneState::clear() {
 	node_paths.clear();
 	editable_instances.clear();
 	base_scene_idx = -1;
+	_clear_instantiation_program();
 }
 
 Error SceneState::copy_from(const Ref<SceneState> &p_scene_state) {
@@ -1253,6 +1476,7 @@ Ref<SceneState> SceneState::get_base_scene_state() const {
 
 void SceneState::update_instance_resource(String p_path, Ref<PackedScene> p_packed_scene) {
 	ERR_FAIL_COND(p_packed_scene.is_null());
+	_clear_instantiation_program();
 
 	for (const NodeData &nd : nodes) {
 		if (nd.instance >= 0) {
@@ -1367,6 +1591,16 @@ void SceneState::set_disable_placeholders(bool p_disable) {
 	disable_placeholders = p_disable;
 }
 
+bool SceneState::use_instantiation_programs = true;
+
+void SceneState::set_use_instantiation_programs(bool p_enable) {
+	use_instantiation_programs = p_enable;
+}
+
+bool SceneState::is_using_instantiation_programs() {
+	return use_instantiation_programs;
+}
+
 bool SceneState::is_connection(int p_node, const StringName &p_signal, int p_to_node, const StringName &p_to_method) const {
 	ERR_FAIL_COND_V(p_node < 0, false);
 	ERR_FAIL_COND_V(p_to_node < 0, false);
@@ -1416,6 +1650,8 @@ void SceneState::set_bundled_scene(const Dictionary &p_dictionary) {
 
 	ERR_FAIL_COND_MSG(version > PACKED_SCENE_VERSION, "Save format version too new.");
 
+	_clear_instantiation_program();
+
 	const int node_count = p_dictionary["node_count"];
 	const Vector<int> snodes = p_dictionary["nodes"];
 	ERR_FAIL_COND(snodes.size() < node_count);
@@ -1882,6 +2118,7 @@ int SceneState::add_node_path(const NodePath &p_path) {
 }
 
 int SceneState::add_node(int p_parent, int p_owner, int p_type, int p_name, int p_instance, int p_index) {
+	_clear_instantiation_program();
 	NodeData nd;
 	nd.parent = p_parent;
 	nd.owner = p_owner;
@@ -1899,6 +2136,7 @@ void SceneState::add_node_property(int p_node, int p_name, int p_value, bool p_d
 	ERR_FAIL_INDEX(p_node, nodes.size());
 	ERR_FAIL_INDEX(p_name, names.size());
 	ERR_FAIL_INDEX(p_value, variants.size());
+	_clear_instantiation_program();
 
 	NodeData::Property prop;
 	prop.name = p_name;
@@ -1912,11 +2150,13 @@ void SceneState::add_node_property(int p_node, int p_name, int p_value, bool p_d
 void SceneState::add_node_group(int p_node, int p_group) {
 	ERR_FAIL_INDEX(p_node, nodes.size());
 	ERR_FAIL_INDEX(p_group, names.size());
+	_clear_instantiation_program();
 	nodes.write[p_node].groups.push_back(p_group);
 }
 
 void SceneState::set_base_scene(int p_idx) {
 	ERR_FAIL_INDEX(p_idx, variants.size());
+	_clear_instantiation_program();
 	base_scene_idx = p_idx;
 }
 
@@ -1943,6 +2183,7 @@ void SceneState::add_editable_instance(const NodePath &p_path) {
 }
 
 bool SceneState::remove_group_references(const StringName &p_name) {
+	_clear_instantiation_program();
 	bool edited = false;
 	for (NodeData &node : nodes) {
 		for (const int &group : node.groups) {
@@ -1957,6 +2198,7 @@ bool SceneState::remove_group_references(const StringName &p_name) {
 }
 
 bool SceneState::rename_group_references(const StringName &p_old_name, const StringName &p_new_name) {
+	_clear_instantiation_program();
 	bool edited = false;
 	for (const NodeData &node : nodes) {
 		for (const int &group : node.groups) {
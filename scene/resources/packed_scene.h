@@ -32,6 +32,7 @@
 #define PACKED_SCENE_H
 
 #include "core/io/resource.h"
+#include "core/templates/local_vector.h"
 #include "scene/main/node.h"
 
 class SceneState : public RefCounted {
@@ -89,6 +90,38 @@ class SceneState : public RefCounted {
 
 	Vector<ConnectionData> connections;
 
+	// Scenes made only of their own nodes are compiled on first instantiation into a program
+	// with their property setters already resolved, which is replayed on later instantiations.
+	struct InstantiationProgram {
+		enum State {
+			STATE_NOT_COMPILED,
+			STATE_COMPILED,
+			STATE_UNSUPPORTED,
+		};
+
+		struct Property {
+			MethodBind *setter = nullptr; // When null, the property is set through Object::set().
+			int setter_index = -1;
+			int name = 0;
+			int value = 0;
+			bool deferred_node_path = false;
+			bool script = false; // Keeps the property state of the previous script instance, like generic instantiation.
+		};
+
+		State state = STATE_NOT_COMPILED;
+		LocalVector<Property> properties;
+		LocalVector<uint32_t> node_property_offsets; // Node i owns properties [offsets[i], offsets[i + 1]).
+	};
+
+	mutable InstantiationProgram instantiation_program;
+	mutable BinaryMutex instantiation_program_mutex;
+
+	static bool use_instantiation_programs;
+
+	bool _compile_instantiation_program() const;
+	bool _instantiate_from_program(Node **r_nodes, LocalVector<DeferredNodePathProperties> &r_deferred_node_paths) const;
+	void _clear_instantiation_program();
+
 	Error _parse_node(Node *p_owner, Node *p_node, int p_parent_idx, HashMap<StringName, int> &name_map, HashMap<Variant, int, VariantHasher, VariantComparator> &variant_map, HashMap<Node *, int> &node_map, HashMap<Node *, int> &nodepath_map);
 	Error _parse_connections(Node *p_owner, Node *p_node, HashMap<StringName, int> &name_map, HashMap<Variant, int, VariantHasher, VariantComparator> &variant_map, HashMap<Node *, int> &node_map, HashMap<Node *, int> &nodepath_map);
 
@@ -136,6 +169,8 @@ public:
 	};
 
 	static void set_disable_placeholders(bool p_disable);
+	static void set_use_instantiation_programs(bool p_enable);
+	static bool is_using_instantiation_programs();
 	static Ref<Resource> get_remap_resource(const Ref<Resource> &p_resource, HashMap<Ref<Resource>, Ref<Resource>> &remap_cache, const Ref<Resource> &p_fallback, Node *p_for_scene);
 
 	int find_node_by_path(const NodePath &p_node) const;
@@ -245,6 +245,8 @@ AudioDriver *AudioDriverManager::get_driver(int p_driver) {
 //////////////////////////////////////////////
 
 void AudioServer::_driver_process(int p_frames, int32_t *p_buffer) {
+	MemoryTagScope tag_scope(Memory::TAG_AUDIO);
+
 	mix_count++;
 	int todo = p_frames;
 
@@ -96,6 +96,7 @@ GodotAreaPair2D::GodotAreaPair2D(GodotBody2D *p_body, int p_body_shape, GodotAre
 	area = p_area;
 	body_shape = p_body_shape;
 	area_shape = p_area_shape;
+	shared_pre_solve = true;
 	body->add_constraint(this, 0);
 	area->add_constraint(this);
 	if (p_body->get_mode() == PhysicsServer2D::BODY_MODE_KINEMATIC) { //need to be active to process pair
@@ -179,6 +180,7 @@ GodotArea2Pair2D::GodotArea2Pair2D(GodotArea2D *p_area_a, int p_shape_a, GodotAr
 	area_b = p_area_b;
 	shape_a = p_shape_a;
 	shape_b = p_shape_b;
+	shared_pre_solve = true;
 	area_a_monitorable = area_a->is_monitorable();
 	area_b_monitorable = area_b->is_monitorable();
 	area_a->add_constraint(this);
@@ -34,6 +34,7 @@
 #include "godot_area_2d.h"
 #include "godot_collision_object_2d.h"
 
+#include "core/os/spin_lock.h"
 #include "core/templates/list.h"
 #include "core/templates/pair.h"
 #include "core/templates/vset.h"
@@ -138,6 +139,7 @@ class GodotBody2D : public GodotCollisionObject2D {
 
 	Vector<Contact> contacts; //no contacts by default
 	int contact_count = 0;
+	SpinLock contacts_lock;
 
 	Callable body_state_callback;
 
@@ -349,6 +351,12 @@ void GodotBody2D::add_contact(const Vector2 &p_local_pos, const Vector2 &p_local
 		return;
 	}
 
+	// Static bodies don't belong to any island, so islands being pre-solved in parallel may report to them at once.
+	const bool shared = mode == PhysicsServer2D::BODY_MODE_STATIC;
+	if (shared) {
+		contacts_lock.lock();
+	}
+
 	Contact *c = contacts.ptrw();
 
 	int idx = -1;
@@ -369,6 +377,9 @@ void GodotBody2D::add_contact(const Vector2 &p_local_pos, const Vector2 &p_local
 			idx = least_deep;
 		}
 		if (idx == -1) {
+			if (shared) {
+				contacts_lock.unlock();
+			}
 			return; //none least deepe than this
 		}
 	}
@@ -384,6 +395,10 @@ void GodotBody2D::add_contact(const Vector2 &p_local_pos, const Vector2 &p_local
 	c[idx].collider = p_collider;
 	c[idx].collider_velocity_at_pos = p_collider_velocity_at_pos;
 	c[idx].impulse = p_impulse;
+
+	if (shared) {
+		contacts_lock.unlock();
+	}
 }
 
 #endif // GODOT_BODY_2D_H
@@ -42,6 +42,10 @@ class GodotConstraint2D {
 	RID self;
 
 protected:
+	// Constraints whose pre-solve modifies state shared between islands (e.g. area monitoring)
+	// must be pre-solved serially, while everything else is pre-solved per island in parallel.
+	bool shared_pre_solve = false;
+
 	GodotConstraint2D(GodotBody2D **p_body_ptr = nullptr, int p_body_count = 0) {
 		_body_ptr = p_body_ptr;
 		_body_count = p_body_count;
@@ -60,6 +64,8 @@ public:
 	_FORCE_INLINE_ void disable_collisions_between_bodies(const bool p_disabled) { disabled_collisions_between_bodies = p_disabled; }
 	_FORCE_INLINE_ bool is_disabled_collisions_between_bodies() const { return disabled_collisions_between_bodies; }
 
+	_FORCE_INLINE_ bool has_shared_pre_solve() const { return shared_pre_solve; }
+
 	virtual bool setup(real_t p_step) = 0;
 	virtual bool pre_solve(real_t p_step) = 0;
 	virtual void solve(real_t p_step) = 0;
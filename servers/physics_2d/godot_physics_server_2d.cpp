@@ -1288,6 +1288,8 @@ void GodotPhysicsServer2D::init() {
 }
 
 void GodotPhysicsServer2D::step(real_t p_step) {
+	MemoryTagScope tag_scope(Memory::TAG_PHYSICS);
+
 	if (!active) {
 		return;
 	}
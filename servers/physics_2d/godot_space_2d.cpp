@@ -1131,7 +1131,10 @@ void GodotSpace2D::call_queries() {
 }
 
 void GodotSpace2D::setup() {
-	contact_debug_count = 0;
+	contact_debug_count.set(0);
+	if (is_debugging_contacts()) {
+		contact_debug.ptrw(); // Ensure the buffer is not shared before contacts are added from multiple threads.
+	}
 
 	while (mass_properties_update_list.first()) {
 		mass_properties_update_list.first()->self()->update_mass_properties();
@@ -126,7 +126,7 @@ private:
 	int _cull_aabb_for_body(GodotBody2D *p_body, const Rect2 &p_aabb);
 
 	Vector<Vector2> contact_debug;
-	int contact_debug_count = 0;
+	SafeNumeric<int> contact_debug_count;
 
 	friend class GodotPhysicsDirectSpaceState2D;
 
@@ -194,13 +194,15 @@ public:
 
 	void set_debug_contacts(int p_amount) { contact_debug.resize(p_amount); }
 	_FORCE_INLINE_ bool is_debugging_contacts() const { return !contact_debug.is_empty(); }
+	// Thread-safe, as islands are pre-solved in parallel. The buffer is made unique in setup(), so no copy-on-write happens here.
 	_FORCE_INLINE_ void add_debug_contact(const Vector2 &p_contact) {
-		if (contact_debug_count < contact_debug.size()) {
-			contact_debug.write[contact_debug_count++] = p_contact;
+		int index = contact_debug_count.postincrement();
+		if (index < contact_debug.size()) {
+			contact_debug.ptrw()[index] = p_contact;
 		}
 	}
 	_FORCE_INLINE_ Vector<Vector2> get_debug_contacts() { return contact_debug; }
-	_FORCE_INLINE_ int get_debug_contact_count() { return contact_debug_count; }
+	_FORCE_INLINE_ int get_debug_contact_count() { return MIN(contact_debug_count.get(), contact_debug.size()); }
 
 	GodotPhysicsDirectSpaceState2D *get_direct_state();
 
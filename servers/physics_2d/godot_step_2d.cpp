@@ -53,8 +53,13 @@ void GodotStep2D::_populate_island(GodotBody2D *p_body, LocalVector<GodotBody2D
 			continue; // Already processed.
 		}
 		constraint->set_island_step(_step);
-		p_constraint_island.push_back(constraint);
 		all_constraints.push_back(constraint);
+		if (constraint->has_shared_pre_solve()) {
+			// Never solved, and can't be pre-solved along with the island.
+			shared_constraints.push_back(constraint);
+		} else {
+			p_constraint_island.push_back(constraint);
+		}
 
 		for (int i = 0; i < constraint->get_body_count(); i++) {
 			if (i == E.second) {
@@ -90,6 +95,20 @@ void GodotStep2D::_pre_solve_island(LocalVector<GodotConstraint2D *> &p_constrai
 	p_constraint_island.resize(valid_constraint_count);
 }
 
+void GodotStep2D::_pre_solve_island_threaded(uint32_t p_island_index, void *p_userdata) {
+	_pre_solve_island(constraint_islands[p_island_index]);
+}
+
+void GodotStep2D::_pre_solve_shared_constraints(void *p_userdata) {
+	setup_constraints_end_usec = OS::get_singleton()->get_ticks_usec();
+
+	// Warning: This runs as a single task, because it involves thread-unsafe processing.
+	uint32_t constraint_count = shared_constraints.size();
+	for (uint32_t constraint_index = 0; constraint_index < constraint_count; ++constraint_index) {
+		shared_constraints[constraint_index]->pre_solve(delta);
+	}
+}
+
 void GodotStep2D::_solve_island(uint32_t p_island_index, void *p_userdata) const {
 	const LocalVector<GodotConstraint2D *> &constraint_island = constraint_islands[p_island_index];
 
@@ -101,26 +120,32 @@ void GodotStep2D::_solve_island(uint32_t p_island_index, void *p_userdata) const
 	}
 }
 
-void GodotStep2D::_check_suspend(LocalVector<GodotBody2D *> &p_body_island) const {
+void GodotStep2D::_sleep_test_island(uint32_t p_island_index, void *p_userdata) {
+	const LocalVector<GodotBody2D *> &body_island = body_islands[p_island_index];
 	bool can_sleep = true;
 
-	uint32_t body_count = p_body_island.size();
+	uint32_t body_count = body_island.size();
 	for (uint32_t body_index = 0; body_index < body_count; ++body_index) {
-		GodotBody2D *body = p_body_island[body_index];
+		GodotBody2D *body = body_island[body_index];
 
 		if (!body->sleep_test(delta)) {
 			can_sleep = false;
 		}
 	}
 
+	body_island_can_sleep[p_island_index] = can_sleep;
+}
+
+void GodotStep2D::_check_suspend(LocalVector<GodotBody2D *> &p_body_island, bool p_can_sleep) const {
 	// Put all to sleep or wake up everyone.
+	uint32_t body_count = p_body_island.size();
 	for (uint32_t body_index = 0; body_index < body_count; ++body_index) {
 		GodotBody2D *body = p_body_island[body_index];
 
 		bool active = body->is_active();
 
-		if (active == can_sleep) {
-			body->set_active(!can_sleep);
+		if (active == p_can_sleep) {
+			body->set_active(!p_can_sleep);
 		}
 	}
 }
@@ -165,6 +190,7 @@ void GodotStep2D::step(GodotSpace2D *p_space, real_t p_delta) {
 	/* GENERATE CONSTRAINT ISLANDS FOR MOVING AREAS */
 
 	uint32_t island_count = 0;
+	uint32_t area_island_count = 0;
 
 	const SelfList<GodotArea2D>::List &aml = p_space->get_moved_area_list();
 
@@ -176,16 +202,12 @@ void GodotStep2D::step(GodotSpace2D *p_space, real_t p_delta) {
 			}
 			constraint->set_island_step(_step);
 
-			// Each constraint can be on a separate island for areas as there's no solving phase.
-			++island_count;
-			if (constraint_islands.size() < island_count) {
-				constraint_islands.resize(island_count);
-			}
-			LocalVector<GodotConstraint2D *> &constraint_island = constraint_islands[island_count - 1];
-			constraint_island.clear();
+			// Each constraint counts as a separate island for areas as there's no solving phase.
+			// They are pre-solved along with the other constraints touching shared state.
+			++area_island_count;
 
 			all_constraints.push_back(constraint);
-			constraint_island.push_back(constraint);
+			shared_constraints.push_back(constraint);
 		}
 		p_space->area_remove_from_moved_list((SelfList<GodotArea2D> *)aml.first()); //faster to remove here
 	}
@@ -229,7 +251,7 @@ void GodotStep2D::step(GodotSpace2D *p_space, real_t p_delta) {
 		b = b->next();
 	}
 
-	p_space->set_island_count((int)island_count);
+	p_space->set_island_count((int)(area_island_count + island_count));
 
 	{ //profile
 		profile_endtime = OS::get_singleton()->get_ticks_usec();
@@ -237,33 +259,36 @@ void GodotStep2D::step(GodotSpace2D *p_space, real_t p_delta) {
 		profile_begtime = profile_endtime;
 	}
 
+	// Setup, pre-solve and solve are chained through task dependencies and submitted at once,
+	// so this thread only blocks on the last phase.
+
 	/* SETUP CONSTRAINTS / PROCESS COLLISIONS */
 
 	uint32_t total_constraint_count = all_constraints.size();
-	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep2D::_setup_constraint, nullptr, total_constraint_count, -1, true, SNAME("Physics2DConstraintSetup"));
-	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
-
-	{ //profile
-		profile_endtime = OS::get_singleton()->get_ticks_usec();
-		p_space->set_elapsed_time(GodotSpace2D::ELAPSED_TIME_SETUP_CONSTRAINTS, profile_endtime - profile_begtime);
-		profile_begtime = profile_endtime;
-	}
+	WorkerThreadPool::GroupID setup_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep2D::_setup_constraint, nullptr, total_constraint_count, -1, true, SNAME("Physics2DConstraintSetup"));
 
 	/* PRE-SOLVE CONSTRAINT ISLANDS */
 
-	// Warning: This doesn't run on threads, because it involves thread-unsafe processing.
-	for (uint32_t island_index = 0; island_index < island_count; ++island_index) {
-		_pre_solve_island(constraint_islands[island_index]);
-	}
+	// Islands don't share any dynamic body, so each one can be pre-solved on its own thread.
+	// Constraints touching areas are pre-solved serially meanwhile.
+	WorkerThreadPool::TaskID pre_solve_tasks[2];
+	pre_solve_tasks[0] = WorkerThreadPool::get_singleton()->add_template_task_after(&setup_task, 1, this, &GodotStep2D::_pre_solve_shared_constraints, nullptr, true, SNAME("Physics2DConstraintPreSolveShared"));
+	pre_solve_tasks[1] = WorkerThreadPool::get_singleton()->add_template_group_task_after(&setup_task, 1, this, &GodotStep2D::_pre_solve_island_threaded, nullptr, island_count, -1, true, SNAME("Physics2DConstraintPreSolveIslands"));
 
 	/* SOLVE CONSTRAINT ISLANDS */
 
 	// Warning: _solve_island modifies the constraint islands for optimization purpose,
 	// their content is not reliable after these calls and shouldn't be used anymore.
-	group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep2D::_solve_island, nullptr, island_count, -1, true, SNAME("Physics2DConstraintSolveIslands"));
-	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	WorkerThreadPool::GroupID solve_task = WorkerThreadPool::get_singleton()->add_template_group_task_after(pre_solve_tasks, 2, this, &GodotStep2D::_solve_island, nullptr, island_count, -1, true, SNAME("Physics2DConstraintSolveIslands"));
+
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(solve_task);
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(pre_solve_tasks[1]);
+	WorkerThreadPool::get_singleton()->wait_for_task_completion(pre_solve_tasks[0]);
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(setup_task);
 
 	{ //profile
+		p_space->set_elapsed_time(GodotSpace2D::ELAPSED_TIME_SETUP_CONSTRAINTS, setup_constraints_end_usec - profile_begtime);
+		profile_begtime = setup_constraints_end_usec;
 		profile_endtime = OS::get_singleton()->get_ticks_usec();
 		p_space->set_elapsed_time(GodotSpace2D::ELAPSED_TIME_SOLVE_CONSTRAINTS, profile_endtime - profile_begtime);
 		profile_begtime = profile_endtime;
@@ -280,8 +305,15 @@ void GodotStep2D::step(GodotSpace2D *p_space, real_t p_delta) {
 
 	/* SLEEP / WAKE UP ISLANDS */
 
+	// Sleep tests only touch the bodies of each island, but activation changes the space's active list.
+	if (body_island_can_sleep.size() < body_island_count) {
+		body_island_can_sleep.resize(body_island_count);
+	}
+	WorkerThreadPool::GroupID sleep_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep2D::_sleep_test_island, nullptr, body_island_count, -1, true, SNAME("Physics2DSleepTest"));
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(sleep_task);
+
 	for (uint32_t island_index = 0; island_index < body_island_count; ++island_index) {
-		_check_suspend(body_islands[island_index]);
+		_check_suspend(body_islands[island_index], body_island_can_sleep[island_index]);
 	}
 
 	{ //profile
@@ -291,6 +323,7 @@ void GodotStep2D::step(GodotSpace2D *p_space, real_t p_delta) {
 	}
 
 	all_constraints.clear();
+	shared_constraints.clear();
 
 	p_space->unlock();
 	_step++;
@@ -300,6 +333,7 @@ GodotStep2D::GodotStep2D() {
 	body_islands.reserve(BODY_ISLAND_COUNT_RESERVE);
 	constraint_islands.reserve(ISLAND_COUNT_RESERVE);
 	all_constraints.reserve(CONSTRAINT_COUNT_RESERVE);
+	body_island_can_sleep.reserve(BODY_ISLAND_COUNT_RESERVE);
 }
 
 GodotStep2D::~GodotStep2D() {
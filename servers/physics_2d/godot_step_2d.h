@@ -44,12 +44,19 @@ class GodotStep2D {
 	LocalVector<LocalVector<GodotBody2D *>> body_islands;
 	LocalVector<LocalVector<GodotConstraint2D *>> constraint_islands;
 	LocalVector<GodotConstraint2D *> all_constraints;
+	LocalVector<GodotConstraint2D *> shared_constraints;
+	LocalVector<bool> body_island_can_sleep;
+
+	uint64_t setup_constraints_end_usec = 0;
 
 	void _populate_island(GodotBody2D *p_body, LocalVector<GodotBody2D *> &p_body_island, LocalVector<GodotConstraint2D *> &p_constraint_island);
 	void _setup_constraint(uint32_t p_constraint_index, void *p_userdata = nullptr);
 	void _pre_solve_island(LocalVector<GodotConstraint2D *> &p_constraint_island) const;
+	void _pre_solve_island_threaded(uint32_t p_island_index, void *p_userdata = nullptr);
+	void _pre_solve_shared_constraints(void *p_userdata = nullptr);
 	void _solve_island(uint32_t p_island_index, void *p_userdata = nullptr) const;
-	void _check_suspend(LocalVector<GodotBody2D *> &p_body_island) const;
+	void _sleep_test_island(uint32_t p_island_index, void *p_userdata = nullptr);
+	void _check_suspend(LocalVector<GodotBody2D *> &p_body_island, bool p_can_sleep) const;
 
 public:
 	void step(GodotSpace2D *p_space, real_t p_delta);
@@ -38,6 +38,39 @@
 #define MIN_VELOCITY 0.0001
 #define MAX_BIAS_ROTATION (Math_PI / 8)
 
+int GodotBodyContact3D::find_recycled_contact(const Contact *p_contacts, int p_contact_count, const Contact &p_contact, real_t p_recycle_radius, bool p_closest_unused) {
+	const real_t recycle_radius2 = p_recycle_radius * p_recycle_radius;
+
+	if (!p_closest_unused) {
+		for (int i = 0; i < p_contact_count; i++) {
+			const Contact &c = p_contacts[i];
+			if (c.local_A.distance_squared_to(p_contact.local_A) < recycle_radius2 &&
+					c.local_B.distance_squared_to(p_contact.local_B) < recycle_radius2) {
+				return i;
+			}
+		}
+		return -1;
+	}
+
+	// Contacts already matched during this step are left alone, so that two new contacts
+	// can't both take over the same cached one.
+	real_t closest_distance = recycle_radius2;
+	int closest = -1;
+	for (int i = 0; i < p_contact_count; i++) {
+		const Contact &c = p_contacts[i];
+		if (c.used || c.index_A != p_contact.index_A || c.index_B != p_contact.index_B) {
+			continue;
+		}
+
+		real_t distance = MAX(c.local_A.distance_squared_to(p_contact.local_A), c.local_B.distance_squared_to(p_contact.local_B));
+		if (distance < closest_distance) {
+			closest_distance = distance;
+			closest = i;
+		}
+	}
+	return closest;
+}
+
 void GodotBodyPair3D::_contact_added_callback(const Vector3 &p_point_A, int p_index_A, const Vector3 &p_point_B, int p_index_B, const Vector3 &normal, void *p_userdata) {
 	GodotBodyPair3D *pair = static_cast<GodotBodyPair3D *>(p_userdata);
 	pair->contact_added_callback(p_point_A, p_index_A, p_point_B, p_index_B, normal);
@@ -60,19 +93,15 @@ void GodotBodyPair3D::contact_added_callback(const Vector3 &p_point_A, int p_ind
 	contact.used = true;
 
 	// Attempt to determine if the contact will be reused.
-	real_t contact_recycle_radius = space->get_contact_recycle_radius();
-
-	for (int i = 0; i < contact_count; i++) {
-		Contact &c = contacts[i];
-		if (c.local_A.distance_squared_to(local_A) < (contact_recycle_radius * contact_recycle_radius) &&
-				c.local_B.distance_squared_to(local_B) < (contact_recycle_radius * contact_recycle_radius)) {
-			contact.acc_normal_impulse = c.acc_normal_impulse;
-			contact.acc_bias_impulse = c.acc_bias_impulse;
-			contact.acc_bias_impulse_center_of_mass = c.acc_bias_impulse_center_of_mass;
-			contact.acc_tangent_impulse = c.acc_tangent_impulse;
-			c = contact;
-			return;
-		}
+	int recycled = find_recycled_contact(contacts, contact_count, contact, space->get_contact_recycle_radius(), space->get_contact_manifold_reuse_threshold() > 0.0);
+	if (recycled != -1) {
+		Contact &c = contacts[recycled];
+		contact.acc_normal_impulse = c.acc_normal_impulse;
+		contact.acc_bias_impulse = c.acc_bias_impulse;
+		contact.acc_bias_impulse_center_of_mass = c.acc_bias_impulse_center_of_mass;
+		contact.acc_tangent_impulse = c.acc_tangent_impulse;
+		c = contact;
+		return;
 	}
 
 	// Figure out if the contact amount must be reduced to fit the new contact.
@@ -161,6 +190,31 @@ void GodotBodyPair3D::validate_contacts() {
 	}
 }
 
+bool GodotBodyPair3D::_can_reuse_manifold(const Transform3D &p_relative_xform, const AABB &p_aabb_A, const AABB &p_aabb_B, real_t p_threshold) const {
+	if (!manifold_valid || contact_count == 0) {
+		return false;
+	}
+
+	// Resized shapes keep their transforms, so compare their bounds too.
+	if (p_aabb_A != manifold_aabb_A || p_aabb_B != manifold_aabb_B) {
+		return false;
+	}
+
+	real_t threshold2 = p_threshold * p_threshold;
+	if (p_relative_xform.origin.distance_squared_to(manifold_xform.origin) > threshold2) {
+		return false;
+	}
+
+	// The columns of a rotation basis move by about the rotation angle.
+	for (int i = 0; i < 3; i++) {
+		if (p_relative_xform.basis.get_column(i).distance_squared_to(manifold_xform.basis.get_column(i)) > threshold2) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
 // _test_ccd prevents tunneling by slowing down a high velocity body that is about to collide so that next frame it will be at an appropriate location to collide (i.e. slight overlap)
 // Warning: the way velocity is adjusted down to cause a collision means the momentum will be weaker than it should for a bounce!
 // Process: only proceed if body A's motion is high relative to its size.
@@ -259,10 +313,37 @@ real_t combine_friction(GodotBody3D *A, GodotBody3D *B) {
 }
 
 bool GodotBodyPair3D::setup(real_t p_step) {
+	return _setup(p_step, false);
+}
+
+bool GodotBodyPair3D::setup_separated(real_t p_step, const Vector3 &p_sep_axis) {
+	// Cached like the axis solve_static() finds, so it is tested first once the shapes get closer.
+	if (p_sep_axis != Vector3()) {
+		sep_axis = p_sep_axis;
+	}
+	return _setup(p_step, true);
+}
+
+bool GodotBodyPair3D::get_narrowphase_shapes(const GodotShape3D **r_shapes, Transform3D *r_transforms) const {
+	// Same space as the narrowphase in _setup(), relative to A's origin.
+	const Vector3 &offset_A = A->get_transform().get_origin();
+	r_transforms[0] = Transform3D(A->get_transform().basis, Vector3()) * A->get_shape_transform(shape_A);
+
+	Transform3D xform_Bu = B->get_transform();
+	xform_Bu.origin -= offset_A;
+	r_transforms[1] = xform_Bu * B->get_shape_transform(shape_B);
+
+	r_shapes[0] = A->get_shape(shape_A);
+	r_shapes[1] = B->get_shape(shape_B);
+	return true;
+}
+
+bool GodotBodyPair3D::_setup(real_t p_step, bool p_separated) {
 	check_ccd = false;
 
 	if (!A->interacts_with(B) || A->has_exception(B->get_self()) || B->has_exception(A->get_self())) {
 		collided = false;
+		manifold_valid = false;
 		return false;
 	}
 
@@ -275,6 +356,7 @@ bool GodotBodyPair3D::setup(real_t p_step) {
 			report_contacts_only = true;
 		} else {
 			collided = false;
+			manifold_valid = false;
 			return false;
 		}
 	}
@@ -294,7 +376,34 @@ bool GodotBodyPair3D::setup(real_t p_step) {
 	GodotShape3D *shape_A_ptr = A->get_shape(shape_A);
 	GodotShape3D *shape_B_ptr = B->get_shape(shape_B);
 
-	collided = GodotCollisionSolver3D::solve_static(shape_A_ptr, xform_A, shape_B_ptr, xform_B, _contact_added_callback, this, &sep_axis);
+	real_t reuse_threshold = space->get_contact_manifold_reuse_threshold();
+	if (p_separated) {
+		// Shapes proven separated by the batched test can't collide in the narrowphase either.
+		collided = false;
+		manifold_valid = false;
+	} else if (reuse_threshold > 0.0) {
+		Transform3D relative_xform = xform_A.affine_inverse() * xform_B;
+		const AABB &aabb_A = shape_A_ptr->get_aabb();
+		const AABB &aabb_B = shape_B_ptr->get_aabb();
+
+		if (_can_reuse_manifold(relative_xform, aabb_A, aabb_B, reuse_threshold)) {
+			// The shapes have barely moved relative to each other since the narrowphase last ran, so the contacts
+			// that survived validate_contacts() still describe the collision. Keep them, along with their
+			// accumulated impulses, for warm-starting.
+			for (int i = 0; i < contact_count; i++) {
+				contacts[i].used = true;
+			}
+			collided = true;
+		} else {
+			collided = GodotCollisionSolver3D::solve_static(shape_A_ptr, xform_A, shape_B_ptr, xform_B, _contact_added_callback, this, &sep_axis);
+			manifold_xform = relative_xform;
+			manifold_aabb_A = aabb_A;
+			manifold_aabb_B = aabb_B;
+			manifold_valid = collided;
+		}
+	} else {
+		collided = GodotCollisionSolver3D::solve_static(shape_A_ptr, xform_A, shape_B_ptr, xform_B, _contact_added_callback, this, &sep_axis);
+	}
 
 	if (!collided) {
 		if (A->is_continuous_collision_detection_enabled() && collide_A) {
@@ -38,6 +38,8 @@
 #include "core/templates/local_vector.h"
 
 class GodotBodyContact3D : public GodotConstraint3D {
+	friend class TestGodotBodyContact3DAccessor;
+
 protected:
 	struct Contact {
 		Vector3 position;
@@ -59,6 +61,12 @@ protected:
 		Vector3 rA, rB; // Offset in world orientation with respect to center of mass
 	};
 
+	// Returns the index of the contact from the previous step that p_contact continues, or -1.
+	// By default, that's the first contact within the recycle radius. With p_closest_unused, as when manifolds
+	// are reused, it's the closest one on the same features that no other new contact continues yet.
+	// SAT reports feature 0 for every contact, so between convex shapes only the distance tells them apart.
+	static int find_recycled_contact(const Contact *p_contacts, int p_contact_count, const Contact &p_contact, real_t p_recycle_radius, bool p_closest_unused);
+
 	Vector3 sep_axis;
 	bool collided = false;
 	bool check_ccd = false;
@@ -97,15 +105,25 @@ class GodotBodyPair3D : public GodotBodyContact3D {
 	Contact contacts[MAX_CONTACTS];
 	int contact_count = 0;
 
+	// Relative transform and shape bounds the contacts were last computed with, to reuse them while the shapes barely move.
+	Transform3D manifold_xform;
+	AABB manifold_aabb_A;
+	AABB manifold_aabb_B;
+	bool manifold_valid = false;
+
 	static void _contact_added_callback(const Vector3 &p_point_A, int p_index_A, const Vector3 &p_point_B, int p_index_B, const Vector3 &normal, void *p_userdata);
 
 	void contact_added_callback(const Vector3 &p_point_A, int p_index_A, const Vector3 &p_point_B, int p_index_B, const Vector3 &normal);
 
 	void validate_contacts();
+	bool _can_reuse_manifold(const Transform3D &p_relative_xform, const AABB &p_aabb_A, const AABB &p_aabb_B, real_t p_threshold) const;
 	bool _test_ccd(real_t p_step, GodotBody3D *p_A, int p_shape_A, const Transform3D &p_xform_A, GodotBody3D *p_B, int p_shape_B, const Transform3D &p_xform_B);
+	bool _setup(real_t p_step, bool p_separated);
 
 public:
 	virtual bool setup(real_t p_step) override;
+	virtual bool get_narrowphase_shapes(const GodotShape3D **r_shapes, Transform3D *r_transforms) const override;
+	virtual bool setup_separated(real_t p_step, const Vector3 &p_sep_axis) override;
 	virtual bool pre_solve(real_t p_step) override;
 	virtual void solve(real_t p_step) override;
 
@@ -358,6 +358,322 @@ bool GodotCollisionSolver3D::solve_concave(const GodotShape3D *p_shape_A, const
 	return cinfo.collided;
 }
 
+bool GodotCollisionSolver3D::get_batch_shape(const GodotShape3D *p_shape, const Transform3D &p_transform, BatchShape &r_shape) {
+	// Radii are scaled by a bound on how much the basis can stretch a vector. That's the scale itself
+	// when it's uniform, but the longest column is not a bound for skewed bases, so those use the
+	// Frobenius norm (the length of all three columns together), which always is.
+	const real_t max_scale = p_transform.basis.is_conformal()
+			? p_transform.basis.get_column(0).length()
+			: Math::sqrt(p_transform.basis.get_column(0).length_squared() + p_transform.basis.get_column(1).length_squared() + p_transform.basis.get_column(2).length_squared());
+	r_shape.is_box = false;
+
+	switch (p_shape->get_type()) {
+		case PhysicsServer3D::SHAPE_SPHERE: {
+			r_shape.segment_from = p_transform.origin;
+			r_shape.segment_to = p_transform.origin;
+			r_shape.radius = static_cast<const GodotSphereShape3D *>(p_shape)->get_radius() * max_scale;
+		} break;
+		case PhysicsServer3D::SHAPE_CAPSULE: {
+			const GodotCapsuleShape3D *capsule = static_cast<const GodotCapsuleShape3D *>(p_shape);
+			const real_t half_segment = capsule->get_height() * 0.5 - capsule->get_radius();
+			r_shape.segment_from = p_transform.xform(Vector3(0, -half_segment, 0));
+			r_shape.segment_to = p_transform.xform(Vector3(0, half_segment, 0));
+			r_shape.radius = capsule->get_radius() * max_scale;
+		} break;
+		case PhysicsServer3D::SHAPE_CYLINDER: {
+			// Inside the capsule with the same radius around its whole axis.
+			const GodotCylinderShape3D *cylinder = static_cast<const GodotCylinderShape3D *>(p_shape);
+			const real_t half_height = cylinder->get_height() * 0.5;
+			r_shape.segment_from = p_transform.xform(Vector3(0, -half_height, 0));
+			r_shape.segment_to = p_transform.xform(Vector3(0, half_height, 0));
+			r_shape.radius = cylinder->get_radius() * max_scale;
+		} break;
+		case PhysicsServer3D::SHAPE_BOX: {
+			const Vector3 half_extents = static_cast<const GodotBoxShape3D *>(p_shape)->get_half_extents();
+			r_shape.segment_from = p_transform.origin;
+			r_shape.segment_to = p_transform.origin;
+			r_shape.radius = half_extents.length() * max_scale;
+
+			// Skewed or non-uniformly scaled boxes are only tested through their bounding sphere.
+			if (p_transform.basis.is_conformal()) {
+				const real_t scale = p_transform.basis.get_column(0).length();
+				r_shape.is_box = true;
+				r_shape.box_origin = p_transform.origin;
+				for (int i = 0; i < 3; i++) {
+					r_shape.box_axes[i] = p_transform.basis.get_column(i) / scale;
+				}
+				r_shape.box_half_extents = half_extents * scale;
+			}
+		} break;
+		case PhysicsServer3D::SHAPE_CONVEX_POLYGON: {
+			const AABB &aabb = p_shape->get_aabb();
+			r_shape.segment_from = p_transform.xform(aabb.get_center());
+			r_shape.segment_to = r_shape.segment_from;
+			r_shape.radius = aabb.size.length() * 0.5 * max_scale;
+		} break;
+		default: {
+			// Unbounded, concave or otherwise special shapes always go through the full narrowphase.
+			return false;
+		}
+	}
+
+	return true;
+}
+
+Vector3 GodotCollisionSolver3D::get_batch_separation_axis(const BatchShape &p_A, const BatchShape &p_B) {
+	Vector3 closest_A;
+	Vector3 closest_B;
+	if (p_B.is_box && !p_A.is_box && p_A.segment_from == p_A.segment_to) {
+		closest_A = p_A.segment_from;
+		closest_B = p_B.box_origin;
+		const Vector3 offset = closest_A - p_B.box_origin;
+		for (int i = 0; i < 3; i++) {
+			closest_B += p_B.box_axes[i] * CLAMP(offset.dot(p_B.box_axes[i]), -p_B.box_half_extents[i], p_B.box_half_extents[i]);
+		}
+	} else if (p_A.is_box && !p_B.is_box && p_B.segment_from == p_B.segment_to) {
+		closest_B = p_B.segment_from;
+		closest_A = p_A.box_origin;
+		const Vector3 offset = closest_B - p_A.box_origin;
+		for (int i = 0; i < 3; i++) {
+			closest_A += p_A.box_axes[i] * CLAMP(offset.dot(p_A.box_axes[i]), -p_A.box_half_extents[i], p_A.box_half_extents[i]);
+		}
+	} else {
+		Geometry3D::get_closest_points_between_segments(p_A.segment_from, p_A.segment_to, p_B.segment_from, p_B.segment_to, closest_A, closest_B);
+	}
+
+	const Vector3 axis = closest_B - closest_A;
+	return axis.is_zero_approx() ? Vector3() : axis.normalized();
+}
+
+// The batched tests below are written once over "lanes": plain real_t for the scalar fallback, and 4 floats
+// with SSE2 or NEON, which are part of the x86_64 and arm64 baselines. Double precision builds only use the
+// scalar fallback. The tests are kept branchless, so every lane takes the same path.
+#if !defined(REAL_T_IS_DOUBLE)
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define COLLISION_SOLVER_3D_SSE2
+#include <emmintrin.h>
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define COLLISION_SOLVER_3D_NEON
+#include <arm_neon.h>
+#endif
+#endif
+
+static _FORCE_INLINE_ real_t _lanes_set(real_t p_value, real_t) { return p_value; }
+static _FORCE_INLINE_ real_t _lanes_add(real_t p_a, real_t p_b) { return p_a + p_b; }
+static _FORCE_INLINE_ real_t _lanes_sub(real_t p_a, real_t p_b) { return p_a - p_b; }
+static _FORCE_INLINE_ real_t _lanes_mul(real_t p_a, real_t p_b) { return p_a * p_b; }
+static _FORCE_INLINE_ real_t _lanes_div(real_t p_a, real_t p_b) { return p_a / p_b; }
+static _FORCE_INLINE_ real_t _lanes_min(real_t p_a, real_t p_b) { return p_a < p_b ? p_a : p_b; }
+static _FORCE_INLINE_ real_t _lanes_max(real_t p_a, real_t p_b) { return p_a > p_b ? p_a : p_b; }
+static _FORCE_INLINE_ bool _lanes_less(real_t p_a, real_t p_b) { return p_a < p_b; }
+static _FORCE_INLINE_ bool _lanes_and(bool p_a, bool p_b) { return p_a && p_b; }
+static _FORCE_INLINE_ real_t _lanes_select(bool p_mask, real_t p_a, real_t p_b) { return p_mask ? p_a : p_b; }
+
+#if defined(COLLISION_SOLVER_3D_SSE2)
+static _FORCE_INLINE_ __m128 _lanes_set(real_t p_value, __m128) { return _mm_set1_ps(p_value); }
+static _FORCE_INLINE_ __m128 _lanes_add(__m128 p_a, __m128 p_b) { return _mm_add_ps(p_a, p_b); }
+static _FORCE_INLINE_ __m128 _lanes_sub(__m128 p_a, __m128 p_b) { return _mm_sub_ps(p_a, p_b); }
+static _FORCE_INLINE_ __m128 _lanes_mul(__m128 p_a, __m128 p_b) { return _mm_mul_ps(p_a, p_b); }
+static _FORCE_INLINE_ __m128 _lanes_div(__m128 p_a, __m128 p_b) { return _mm_div_ps(p_a, p_b); }
+static _FORCE_INLINE_ __m128 _lanes_min(__m128 p_a, __m128 p_b) { return _mm_min_ps(p_a, p_b); }
+static _FORCE_INLINE_ __m128 _lanes_max(__m128 p_a, __m128 p_b) { return _mm_max_ps(p_a, p_b); }
+static _FORCE_INLINE_ __m128 _lanes_less(__m128 p_a, __m128 p_b) { return _mm_cmplt_ps(p_a, p_b); }
+static _FORCE_INLINE_ __m128 _lanes_and(__m128 p_a, __m128 p_b) { return _mm_and_ps(p_a, p_b); }
+static _FORCE_INLINE_ __m128 _lanes_select(__m128 p_mask, __m128 p_a, __m128 p_b) { return _mm_or_ps(_mm_and_ps(p_mask, p_a), _mm_andnot_ps(p_mask, p_b)); }
+#elif defined(COLLISION_SOLVER_3D_NEON)
+static _FORCE_INLINE_ float32x4_t _lanes_set(real_t p_value, float32x4_t) { return vdupq_n_f32(p_value); }
+static _FORCE_INLINE_ float32x4_t _lanes_add(float32x4_t p_a, float32x4_t p_b) { return vaddq_f32(p_a, p_b); }
+static _FORCE_INLINE_ float32x4_t _lanes_sub(float32x4_t p_a, float32x4_t p_b) { return vsubq_f32(p_a, p_b); }
+static _FORCE_INLINE_ float32x4_t _lanes_mul(float32x4_t p_a, float32x4_t p_b) { return vmulq_f32(p_a, p_b); }
+static _FORCE_INLINE_ float32x4_t _lanes_div(float32x4_t p_a, float32x4_t p_b) { return vdivq_f32(p_a, p_b); }
+static _FORCE_INLINE_ float32x4_t _lanes_min(float32x4_t p_a, float32x4_t p_b) { return vminq_f32(p_a, p_b); }
+static _FORCE_INLINE_ float32x4_t _lanes_max(float32x4_t p_a, float32x4_t p_b) { return vmaxq_f32(p_a, p_b); }
+static _FORCE_INLINE_ uint32x4_t _lanes_less(float32x4_t p_a, float32x4_t p_b) { return vcltq_f32(p_a, p_b); }
+static _FORCE_INLINE_ uint32x4_t _lanes_and(uint32x4_t p_a, uint32x4_t p_b) { return vandq_u32(p_a, p_b); }
+static _FORCE_INLINE_ float32x4_t _lanes_select(uint32x4_t p_mask, float32x4_t p_a, float32x4_t p_b) { return vbslq_f32(p_mask, p_a, p_b); }
+#endif
+
+template <typename T>
+static _FORCE_INLINE_ T _lanes_clamp01(T p_value) {
+	return _lanes_min(_lanes_max(p_value, _lanes_set(0.0, p_value)), _lanes_set(1.0, p_value));
+}
+
+template <typename T>
+static _FORCE_INLINE_ T _lanes_dot(const T *p_a, const T *p_b) {
+	return _lanes_add(_lanes_add(_lanes_mul(p_a[0], p_b[0]), _lanes_mul(p_a[1], p_b[1])), _lanes_mul(p_a[2], p_b[2]));
+}
+
+// Squared distance between the closest points of two segments, from "Real-Time Collision Detection" (C. Ericson),
+// with the branches on degenerate segments and clamping replaced by selects.
+template <typename T>
+static _FORCE_INLINE_ T _lanes_segment_distance_squared(const T *p_from_A, const T *p_to_A, const T *p_from_B, const T *p_to_B) {
+	const T zero = _lanes_set(0.0, p_from_A[0]);
+	const T one = _lanes_set(1.0, p_from_A[0]);
+	const T epsilon = _lanes_set(CMP_EPSILON2, p_from_A[0]);
+
+	T dir_A[3];
+	T dir_B[3];
+	T offset[3];
+	for (int i = 0; i < 3; i++) {
+		dir_A[i] = _lanes_sub(p_to_A[i], p_from_A[i]);
+		dir_B[i] = _lanes_sub(p_to_B[i], p_from_B[i]);
+		offset[i] = _lanes_sub(p_from_A[i], p_from_B[i]);
+	}
+
+	const T a = _lanes_dot(dir_A, dir_A);
+	const T e = _lanes_dot(dir_B, dir_B);
+	const T f = _lanes_dot(dir_B, offset);
+	const T c = _lanes_dot(dir_A, offset);
+	const T b = _lanes_dot(dir_A, dir_B);
+	const T safe_a = _lanes_max(a, epsilon);
+	const T safe_e = _lanes_max(e, epsilon);
+
+	// Both segments have a length: closest points of the lines, clamped to the segments.
+	const T denom = _lanes_sub(_lanes_mul(a, e), _lanes_mul(b, b));
+	T s = _lanes_select(_lanes_less(epsilon, denom), _lanes_clamp01(_lanes_div(_lanes_sub(_lanes_mul(b, f), _lanes_mul(c, e)), _lanes_max(denom, epsilon))), zero);
+	T t = _lanes_div(_lanes_add(_lanes_mul(b, s), f), safe_e);
+	s = _lanes_select(_lanes_less(t, zero), _lanes_clamp01(_lanes_div(_lanes_sub(zero, c), safe_a)), _lanes_select(_lanes_less(one, t), _lanes_clamp01(_lanes_div(_lanes_sub(b, c), safe_a)), s));
+	t = _lanes_clamp01(t);
+
+	// A segment is a point.
+	const auto point_A = _lanes_less(a, epsilon);
+	const auto point_B = _lanes_less(e, epsilon);
+	s = _lanes_select(point_A, zero, s);
+	t = _lanes_select(point_A, _lanes_clamp01(_lanes_div(f, safe_e)), t);
+	s = _lanes_select(point_B, _lanes_clamp01(_lanes_div(_lanes_sub(zero, c), safe_a)), s);
+	t = _lanes_select(point_B, zero, t);
+	s = _lanes_select(_lanes_and(point_A, point_B), zero, s);
+
+	T difference[3];
+	for (int i = 0; i < 3; i++) {
+		difference[i] = _lanes_sub(_lanes_add(p_from_A[i], _lanes_mul(dir_A[i], s)), _lanes_add(p_from_B[i], _lanes_mul(dir_B[i], t)));
+	}
+	return _lanes_dot(difference, difference);
+}
+
+// Squared distance from a point to an oriented box.
+template <typename T>
+static _FORCE_INLINE_ T _lanes_box_distance_squared(const T *p_point, const T *p_box_origin, const T (*p_box_axes)[3], const T *p_box_half_extents) {
+	const T zero = _lanes_set(0.0, p_point[0]);
+
+	T offset[3];
+	for (int i = 0; i < 3; i++) {
+		offset[i] = _lanes_sub(p_point[i], p_box_origin[i]);
+	}
+
+	T distance_squared = zero;
+	for (int i = 0; i < 3; i++) {
+		const T local = _lanes_dot(offset, p_box_axes[i]);
+		const T outside = _lanes_max(_lanes_sub(_lanes_max(local, _lanes_sub(zero, local)), p_box_half_extents[i]), zero);
+		distance_squared = _lanes_add(distance_squared, _lanes_mul(outside, outside));
+	}
+	return distance_squared;
+}
+
+// Padded, so the batched tests stay conservative with respect to rounding in the exact ones.
+static _FORCE_INLINE_ real_t _get_separation_reach(real_t p_radius) {
+	const real_t reach = p_radius * (real_t)1.0001 + (real_t)CMP_EPSILON;
+	return reach * reach;
+}
+
+void GodotCollisionSolver3D::cull_separated_segment_pairs(const SegmentPairBatch &p_batch, bool *r_separated) {
+	uint32_t i = 0;
+#if defined(COLLISION_SOLVER_3D_SSE2)
+	for (; i + 4 <= p_batch.count; i += 4) {
+		__m128 from_A[3], to_A[3], from_B[3], to_B[3];
+		for (int j = 0; j < 3; j++) {
+			from_A[j] = _mm_loadu_ps(p_batch.from_A[j] + i);
+			to_A[j] = _mm_loadu_ps(p_batch.to_A[j] + i);
+			from_B[j] = _mm_loadu_ps(p_batch.from_B[j] + i);
+			to_B[j] = _mm_loadu_ps(p_batch.to_B[j] + i);
+		}
+		const __m128 reach = _mm_set_ps(_get_separation_reach(p_batch.radius_sum[i + 3]), _get_separation_reach(p_batch.radius_sum[i + 2]), _get_separation_reach(p_batch.radius_sum[i + 1]), _get_separation_reach(p_batch.radius_sum[i]));
+		const int separated = _mm_movemask_ps(_mm_cmpgt_ps(_lanes_segment_distance_squared(from_A, to_A, from_B, to_B), reach));
+		for (int j = 0; j < 4; j++) {
+			r_separated[i + j] = (separated >> j) & 1;
+		}
+	}
+#elif defined(COLLISION_SOLVER_3D_NEON)
+	for (; i + 4 <= p_batch.count; i += 4) {
+		float32x4_t from_A[3], to_A[3], from_B[3], to_B[3];
+		for (int j = 0; j < 3; j++) {
+			from_A[j] = vld1q_f32(p_batch.from_A[j] + i);
+			to_A[j] = vld1q_f32(p_batch.to_A[j] + i);
+			from_B[j] = vld1q_f32(p_batch.from_B[j] + i);
+			to_B[j] = vld1q_f32(p_batch.to_B[j] + i);
+		}
+		const float reach_values[4] = { _get_separation_reach(p_batch.radius_sum[i]), _get_separation_reach(p_batch.radius_sum[i + 1]), _get_separation_reach(p_batch.radius_sum[i + 2]), _get_separation_reach(p_batch.radius_sum[i + 3]) };
+		uint32_t separated[4];
+		vst1q_u32(separated, vcgtq_f32(_lanes_segment_distance_squared(from_A, to_A, from_B, to_B), vld1q_f32(reach_values)));
+		for (int j = 0; j < 4; j++) {
+			r_separated[i + j] = separated[j] != 0;
+		}
+	}
+#endif
+	for (; i < p_batch.count; i++) {
+		real_t from_A[3], to_A[3], from_B[3], to_B[3];
+		for (int j = 0; j < 3; j++) {
+			from_A[j] = p_batch.from_A[j][i];
+			to_A[j] = p_batch.to_A[j][i];
+			from_B[j] = p_batch.from_B[j][i];
+			to_B[j] = p_batch.to_B[j][i];
+		}
+		r_separated[i] = _lanes_segment_distance_squared(from_A, to_A, from_B, to_B) > _get_separation_reach(p_batch.radius_sum[i]);
+	}
+}
+
+void GodotCollisionSolver3D::cull_separated_sphere_box_pairs(const SphereBoxPairBatch &p_batch, bool *r_separated) {
+	uint32_t i = 0;
+#if defined(COLLISION_SOLVER_3D_SSE2)
+	for (; i + 4 <= p_batch.count; i += 4) {
+		__m128 center[3], box_origin[3], box_axes[3][3], box_half_extents[3];
+		for (int j = 0; j < 3; j++) {
+			center[j] = _mm_loadu_ps(p_batch.center[j] + i);
+			box_origin[j] = _mm_loadu_ps(p_batch.box_origin[j] + i);
+			box_half_extents[j] = _mm_loadu_ps(p_batch.box_half_extents[j] + i);
+			for (int k = 0; k < 3; k++) {
+				box_axes[j][k] = _mm_loadu_ps(p_batch.box_axes[j][k] + i);
+			}
+		}
+		const __m128 reach = _mm_set_ps(_get_separation_reach(p_batch.radius[i + 3]), _get_separation_reach(p_batch.radius[i + 2]), _get_separation_reach(p_batch.radius[i + 1]), _get_separation_reach(p_batch.radius[i]));
+		const int separated = _mm_movemask_ps(_mm_cmpgt_ps(_lanes_box_distance_squared(center, box_origin, box_axes, box_half_extents), reach));
+		for (int j = 0; j < 4; j++) {
+			r_separated[i + j] = (separated >> j) & 1;
+		}
+	}
+#elif defined(COLLISION_SOLVER_3D_NEON)
+	for (; i + 4 <= p_batch.count; i += 4) {
+		float32x4_t center[3], box_origin[3], box_axes[3][3], box_half_extents[3];
+		for (int j = 0; j < 3; j++) {
+			center[j] = vld1q_f32(p_batch.center[j] + i);
+			box_origin[j] = vld1q_f32(p_batch.box_origin[j] + i);
+			box_half_extents[j] = vld1q_f32(p_batch.box_half_extents[j] + i);
+			for (int k = 0; k < 3; k++) {
+				box_axes[j][k] = vld1q_f32(p_batch.box_axes[j][k] + i);
+			}
+		}
+		const float reach_values[4] = { _get_separation_reach(p_batch.radius[i]), _get_separation_reach(p_batch.radius[i + 1]), _get_separation_reach(p_batch.radius[i + 2]), _get_separation_reach(p_batch.radius[i + 3]) };
+		uint32_t separated[4];
+		vst1q_u32(separated, vcgtq_f32(_lanes_box_distance_squared(center, box_origin, box_axes, box_half_extents), vld1q_f32(reach_values)));
+		for (int j = 0; j < 4; j++) {
+			r_separated[i + j] = separated[j] != 0;
+		}
+	}
+#endif
+	for (; i < p_batch.count; i++) {
+		real_t center[3], box_origin[3], box_axes[3][3], box_half_extents[3];
+		for (int j = 0; j < 3; j++) {
+			center[j] = p_batch.center[j][i];
+			box_origin[j] = p_batch.box_origin[j][i];
+			box_half_extents[j] = p_batch.box_half_extents[j][i];
+			for (int k = 0; k < 3; k++) {
+				box_axes[j][k] = p_batch.box_axes[j][k][i];
+			}
+		}
+		r_separated[i] = _lanes_box_distance_squared(center, box_origin, box_axes, box_half_extents) > _get_separation_reach(p_batch.radius[i]);
+	}
+}
+
 bool GodotCollisionSolver3D::solve_static(const GodotShape3D *p_shape_A, const Transform3D &p_transform_A, const GodotShape3D *p_shape_B, const Transform3D &p_transform_B, CallbackResult p_result_callback, void *p_userdata, Vector3 *r_sep_axis, real_t p_margin_A, real_t p_margin_B) {
 	PhysicsServer3D::ShapeType type_A = p_shape_A->get_type();
 	PhysicsServer3D::ShapeType type_B = p_shape_B->get_type();
@@ -50,6 +50,75 @@ private:
 	static bool solve_distance_world_boundary(const GodotShape3D *p_shape_A, const Transform3D &p_transform_A, const GodotShape3D *p_shape_B, const Transform3D &p_transform_B, Vector3 &r_point_A, Vector3 &r_point_B);
 
 public:
+	enum {
+		NARROWPHASE_BATCH_SIZE = 32
+	};
+
+	// Conservative stand-in for a shape, precise enough to prove pairs separated before the full narrowphase.
+	// Spheres and capsules are exact swept spheres, boxes keep their orientation when their scale is uniform,
+	// and other convex shapes are bounded by a sphere.
+	struct BatchShape {
+		Vector3 segment_from;
+		Vector3 segment_to;
+		real_t radius = 0.0;
+
+		bool is_box = false;
+		Vector3 box_origin;
+		Vector3 box_axes[3];
+		Vector3 box_half_extents;
+	};
+
+	// Pairs of swept spheres (segments with a radius), in SoA layout so they're tested several at a time.
+	struct SegmentPairBatch {
+		real_t from_A[3][NARROWPHASE_BATCH_SIZE];
+		real_t to_A[3][NARROWPHASE_BATCH_SIZE];
+		real_t from_B[3][NARROWPHASE_BATCH_SIZE];
+		real_t to_B[3][NARROWPHASE_BATCH_SIZE];
+		real_t radius_sum[NARROWPHASE_BATCH_SIZE];
+		uint32_t count = 0;
+
+		_FORCE_INLINE_ void add(const BatchShape &p_A, const BatchShape &p_B) {
+			for (int i = 0; i < 3; i++) {
+				from_A[i][count] = p_A.segment_from[i];
+				to_A[i][count] = p_A.segment_to[i];
+				from_B[i][count] = p_B.segment_from[i];
+				to_B[i][count] = p_B.segment_to[i];
+			}
+			radius_sum[count] = p_A.radius + p_B.radius;
+			count++;
+		}
+	};
+
+	// Pairs of a sphere and an oriented box, in SoA layout.
+	struct SphereBoxPairBatch {
+		real_t center[3][NARROWPHASE_BATCH_SIZE];
+		real_t radius[NARROWPHASE_BATCH_SIZE];
+		real_t box_origin[3][NARROWPHASE_BATCH_SIZE];
+		real_t box_axes[3][3][NARROWPHASE_BATCH_SIZE];
+		real_t box_half_extents[3][NARROWPHASE_BATCH_SIZE];
+		uint32_t count = 0;
+
+		_FORCE_INLINE_ void add(const BatchShape &p_sphere, const BatchShape &p_box) {
+			for (int i = 0; i < 3; i++) {
+				center[i][count] = p_sphere.segment_from[i];
+				box_origin[i][count] = p_box.box_origin[i];
+				box_half_extents[i][count] = p_box.box_half_extents[i];
+				for (int j = 0; j < 3; j++) {
+					box_axes[i][j][count] = p_box.box_axes[i][j];
+				}
+			}
+			radius[count] = p_sphere.radius;
+			count++;
+		}
+	};
+
+	static bool get_batch_shape(const GodotShape3D *p_shape, const Transform3D &p_transform, BatchShape &r_shape);
+	// Direction between the closest points of two separated batch shapes, which separates the shapes they bound.
+	static Vector3 get_batch_separation_axis(const BatchShape &p_A, const BatchShape &p_B);
+	// Each kernel tests 4 pairs per pass with SSE2 or NEON when real_t is float, and the rest one by one.
+	static void cull_separated_segment_pairs(const SegmentPairBatch &p_batch, bool *r_separated);
+	static void cull_separated_sphere_box_pairs(const SphereBoxPairBatch &p_batch, bool *r_separated);
+
 	static bool solve_static(const GodotShape3D *p_shape_A, const Transform3D &p_transform_A, const GodotShape3D *p_shape_B, const Transform3D &p_transform_B, CallbackResult p_result_callback, void *p_userdata, Vector3 *r_sep_axis = nullptr, real_t p_margin_A = 0, real_t p_margin_B = 0);
 	static bool solve_distance(const GodotShape3D *p_shape_A, const Transform3D &p_transform_A, const GodotShape3D *p_shape_B, const Transform3D &p_transform_B, Vector3 &r_point_A, Vector3 &r_point_B, const AABB &p_concave_hint, Vector3 *r_sep_axis = nullptr);
 };
@@ -32,6 +32,7 @@
 #define GODOT_CONSTRAINT_3D_H
 
 class GodotBody3D;
+class GodotShape3D;
 class GodotSoftBody3D;
 
 class GodotConstraint3D {
@@ -72,6 +73,11 @@ public:
 	_FORCE_INLINE_ bool is_disabled_collisions_between_bodies() const { return disabled_collisions_between_bodies; }
 
 	virtual bool setup(real_t p_step) = 0;
+	// Constraints between two shapes can have them tested in batches before setup.
+	// When the batched test proves them separated, setup_separated() is called instead, skipping the narrowphase.
+	// p_sep_axis separates the shapes, and is where the narrowphase should start testing once they get closer.
+	virtual bool get_narrowphase_shapes(const GodotShape3D **r_shapes, Transform3D *r_transforms) const { return false; }
+	virtual bool setup_separated(real_t p_step, const Vector3 &p_sep_axis) { return setup(p_step); }
 	virtual bool pre_solve(real_t p_step) = 0;
 	virtual void solve(real_t p_step) = 0;
 
@@ -1630,6 +1630,8 @@ void GodotPhysicsServer3D::init() {
 
 void GodotPhysicsServer3D::step(real_t p_step) {
 #ifndef _3D_DISABLED
+	MemoryTagScope tag_scope(Memory::TAG_PHYSICS);
+
 
 	if (!active) {
 		return;
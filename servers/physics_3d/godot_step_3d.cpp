@@ -30,6 +30,7 @@
 
 #include "godot_step_3d.h"
 
+#include "godot_collision_solver_3d.h"
 #include "godot_joint_3d.h"
 
 #include "core/object/worker_thread_pool.h"
@@ -112,9 +113,72 @@ void GodotStep3D::_populate_island_soft_body(GodotSoftBody3D *p_soft_body, Local
 	}
 }
 
-void GodotStep3D::_setup_constraint(uint32_t p_constraint_index, void *p_userdata) {
-	GodotConstraint3D *constraint = all_constraints[p_constraint_index];
-	constraint->setup(delta);
+void GodotStep3D::_setup_constraint_batch(uint32_t p_batch_index, void *p_userdata) {
+	const uint32_t batch_size = GodotCollisionSolver3D::NARROWPHASE_BATCH_SIZE;
+	uint32_t from = p_batch_index * batch_size;
+	uint32_t count = MIN(batch_size, all_constraints.size() - from);
+
+	// Gather the shapes of every constraint supporting it by kind of pair, so the separated ones
+	// can be rejected together instead of each going through the narrowphase.
+	enum PairKind : uint8_t {
+		PAIR_NONE,
+		PAIR_SEGMENTS,
+		PAIR_SPHERE_BOX,
+	};
+	GodotCollisionSolver3D::SegmentPairBatch segment_pairs;
+	GodotCollisionSolver3D::SphereBoxPairBatch sphere_box_pairs;
+	PairKind pair_kinds[batch_size];
+	uint32_t pair_indices[batch_size];
+	GodotCollisionSolver3D::BatchShape pair_shapes[batch_size][2];
+	for (uint32_t i = 0; i < count; i++) {
+		pair_kinds[i] = PAIR_NONE;
+
+		const GodotShape3D *shapes[2];
+		Transform3D transforms[2];
+		GodotCollisionSolver3D::BatchShape *batch_shapes = pair_shapes[i];
+		if (!all_constraints[from + i]->get_narrowphase_shapes(shapes, transforms) ||
+				!GodotCollisionSolver3D::get_batch_shape(shapes[0], transforms[0], batch_shapes[0]) ||
+				!GodotCollisionSolver3D::get_batch_shape(shapes[1], transforms[1], batch_shapes[1])) {
+			continue;
+		}
+
+		const GodotCollisionSolver3D::BatchShape &shape_A = batch_shapes[0];
+		const GodotCollisionSolver3D::BatchShape &shape_B = batch_shapes[1];
+		if (shape_B.is_box && !shape_A.is_box && shape_A.segment_from == shape_A.segment_to) {
+			pair_kinds[i] = PAIR_SPHERE_BOX;
+			pair_indices[i] = sphere_box_pairs.count;
+			sphere_box_pairs.add(shape_A, shape_B);
+		} else if (shape_A.is_box && !shape_B.is_box && shape_B.segment_from == shape_B.segment_to) {
+			pair_kinds[i] = PAIR_SPHERE_BOX;
+			pair_indices[i] = sphere_box_pairs.count;
+			sphere_box_pairs.add(shape_B, shape_A);
+		} else {
+			pair_kinds[i] = PAIR_SEGMENTS;
+			pair_indices[i] = segment_pairs.count;
+			segment_pairs.add(shape_A, shape_B);
+		}
+	}
+
+	bool segments_separated[batch_size];
+	bool sphere_box_separated[batch_size];
+	GodotCollisionSolver3D::cull_separated_segment_pairs(segment_pairs, segments_separated);
+	GodotCollisionSolver3D::cull_separated_sphere_box_pairs(sphere_box_pairs, sphere_box_separated);
+
+	for (uint32_t i = 0; i < count; i++) {
+		GodotConstraint3D *constraint = all_constraints[from + i];
+		bool separated = false;
+		if (pair_kinds[i] == PAIR_SEGMENTS) {
+			separated = segments_separated[pair_indices[i]];
+		} else if (pair_kinds[i] == PAIR_SPHERE_BOX) {
+			separated = sphere_box_separated[pair_indices[i]];
+		}
+
+		if (separated) {
+			constraint->setup_separated(delta, GodotCollisionSolver3D::get_batch_separation_axis(pair_shapes[i][0], pair_shapes[i][1]));
+		} else {
+			constraint->setup(delta);
+		}
+	}
 }
 
 void GodotStep3D::_pre_solve_island(LocalVector<GodotConstraint3D *> &p_constraint_island) const {
@@ -130,6 +194,15 @@ void GodotStep3D::_pre_solve_island(LocalVector<GodotConstraint3D *> &p_constrai
 	p_constraint_island.resize(valid_constraint_count);
 }
 
+void GodotStep3D::_pre_solve_islands(uint32_t p_island_count) {
+	setup_constraints_end_usec = OS::get_singleton()->get_ticks_usec();
+
+	// Warning: This runs as a single task, because it involves thread-unsafe processing.
+	for (uint32_t island_index = 0; island_index < p_island_count; ++island_index) {
+		_pre_solve_island(constraint_islands[island_index]);
+	}
+}
+
 void GodotStep3D::_solve_island(uint32_t p_island_index, void *p_userdata) {
 	LocalVector<GodotConstraint3D *> &constraint_island = constraint_islands[p_island_index];
 
@@ -341,33 +414,32 @@ void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
 		profile_begtime = profile_endtime;
 	}
 
+	// Setup, pre-solve and solve are chained through task dependencies and submitted at once,
+	// so this thread only blocks on the last phase.
+
 	/* SETUP CONSTRAINTS / PROCESS COLLISIONS */
 
 	uint32_t total_constraint_count = all_constraints.size();
-	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep3D::_setup_constraint, nullptr, total_constraint_count, -1, true, SNAME("Physics3DConstraintSetup"));
-	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
-
-	{ //profile
-		profile_endtime = OS::get_singleton()->get_ticks_usec();
-		p_space->set_elapsed_time(GodotSpace3D::ELAPSED_TIME_SETUP_CONSTRAINTS, profile_endtime - profile_begtime);
-		profile_begtime = profile_endtime;
-	}
+	uint32_t setup_batch_count = Math::division_round_up(total_constraint_count, (uint32_t)GodotCollisionSolver3D::NARROWPHASE_BATCH_SIZE);
+	WorkerThreadPool::GroupID setup_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep3D::_setup_constraint_batch, nullptr, setup_batch_count, -1, true, SNAME("Physics3DConstraintSetup"));
 
 	/* PRE-SOLVE CONSTRAINT ISLANDS */
 
-	// Warning: This doesn't run on threads, because it involves thread-unsafe processing.
-	for (uint32_t island_index = 0; island_index < island_count; ++island_index) {
-		_pre_solve_island(constraint_islands[island_index]);
-	}
+	WorkerThreadPool::TaskID pre_solve_task = WorkerThreadPool::get_singleton()->add_template_task_after(&setup_task, 1, this, &GodotStep3D::_pre_solve_islands, island_count, true, SNAME("Physics3DConstraintPreSolve"));
 
 	/* SOLVE CONSTRAINT ISLANDS */
 
 	// Warning: _solve_island modifies the constraint islands for optimization purpose,
 	// their content is not reliable after these calls and shouldn't be used anymore.
-	group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep3D::_solve_island, nullptr, island_count, -1, true, SNAME("Physics3DConstraintSolveIslands"));
-	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	WorkerThreadPool::GroupID solve_task = WorkerThreadPool::get_singleton()->add_template_group_task_after(&pre_solve_task, 1, this, &GodotStep3D::_solve_island, nullptr, island_count, -1, true, SNAME("Physics3DConstraintSolveIslands"));
+
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(solve_task);
+	WorkerThreadPool::get_singleton()->wait_for_task_completion(pre_solve_task);
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(setup_task);
 
 	{ //profile
+		p_space->set_elapsed_time(GodotSpace3D::ELAPSED_TIME_SETUP_CONSTRAINTS, setup_constraints_end_usec - profile_begtime);
+		profile_begtime = setup_constraints_end_usec;
 		profile_endtime = OS::get_singleton()->get_ticks_usec();
 		p_space->set_elapsed_time(GodotSpace3D::ELAPSED_TIME_SOLVE_CONSTRAINTS, profile_endtime - profile_begtime);
 		profile_begtime = profile_endtime;
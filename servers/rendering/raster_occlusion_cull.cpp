@@ -0,0 +1,513 @@
+/**************************************************************************/
+/*  raster_occlusion_cull.cpp                                             */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "raster_occlusion_cull.h"
+
+#include "core/object/worker_thread_pool.h"
+
+// The edge functions are evaluated 4 pixels at a time with SSE2 or NEON, which are part of the x86_64 and arm64
+// baselines, with a scalar loop for the remaining pixels and for other architectures. The rasterizer works in
+// single precision even in double precision builds, so this doesn't depend on real_t.
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define RASTER_OCCLUSION_CULL_SSE2
+#include <emmintrin.h>
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define RASTER_OCCLUSION_CULL_NEON
+#include <arm_neon.h>
+#endif
+
+void RasterOcclusionCull::RasterHZBuffer::clear() {
+	HZBuffer::clear();
+
+	view_vertices.clear();
+	triangles.clear();
+	band_offsets.clear();
+	band_triangles.clear();
+}
+
+void RasterOcclusionCull::RasterHZBuffer::_add_screen_triangle(const Vector3 *p_view, const Projection &p_cam_projection, bool p_cam_orthogonal) {
+	const Size2i &buffer_size = sizes[0];
+	ScreenTriangle triangle;
+
+	for (int i = 0; i < 3; i++) {
+		Plane projected = p_cam_projection.xform4(Plane(p_view[i], 1.0));
+		real_t w = projected.d;
+		triangle.points[i] = Vector2((projected.normal.x / w * 0.5f + 0.5f) * buffer_size.x, (projected.normal.y / w * 0.5f + 0.5f) * buffer_size.y);
+
+		float depth = -p_view[i].z;
+		triangle.depths[i] = p_cam_orthogonal ? depth : 1.0f / depth;
+	}
+
+	real_t area = (triangle.points[1] - triangle.points[0]).cross(triangle.points[2] - triangle.points[0]);
+	if (area == 0) {
+		return;
+	}
+	if (area < 0) {
+		// Occluders are double-sided, so flip the winding to keep the edge functions positive inside.
+		SWAP(triangle.points[1], triangle.points[2]);
+		SWAP(triangle.depths[1], triangle.depths[2]);
+	}
+
+	// Only pixels whose center is covered get written, like the center rays of the raycast backend.
+	Vector2 min_point = triangle.points[0].min(triangle.points[1]).min(triangle.points[2]).max(Vector2());
+	Vector2 max_point = triangle.points[0].max(triangle.points[1]).max(triangle.points[2]).min(Vector2(buffer_size));
+
+	int min_x = Math::ceil(min_point.x - 0.5f);
+	int min_y = Math::ceil(min_point.y - 0.5f);
+	int max_x = Math::floor(max_point.x - 0.5f);
+	int max_y = Math::floor(max_point.y - 0.5f);
+
+	if (min_x > max_x || min_y > max_y) {
+		return;
+	}
+
+	triangle.rect = Rect2i(min_x, min_y, max_x - min_x + 1, max_y - min_y + 1);
+	triangles.push_back(triangle);
+}
+
+void RasterOcclusionCull::RasterHZBuffer::_add_triangle(const Vector3 p_view[3], const Projection &p_cam_projection, real_t p_near, bool p_cam_orthogonal) {
+	// Clip against the near plane, which leaves at most four vertices.
+	Vector3 clipped[4];
+	int clipped_count = 0;
+
+	for (int i = 0; i < 3; i++) {
+		const Vector3 &a = p_view[i];
+		const Vector3 &b = p_view[(i + 1) % 3];
+		real_t a_distance = -a.z - p_near;
+		real_t b_distance = -b.z - p_near;
+
+		if (a_distance >= 0) {
+			clipped[clipped_count++] = a;
+		}
+		if ((a_distance >= 0) != (b_distance >= 0)) {
+			clipped[clipped_count++] = a + (b - a) * (a_distance / (a_distance - b_distance));
+		}
+	}
+
+	if (clipped_count < 3) {
+		return;
+	}
+
+	_add_screen_triangle(clipped, p_cam_projection, p_cam_orthogonal);
+
+	if (clipped_count == 4) {
+		const Vector3 second[3] = { clipped[0], clipped[2], clipped[3] };
+		_add_screen_triangle(second, p_cam_projection, p_cam_orthogonal);
+	}
+}
+
+void RasterOcclusionCull::RasterHZBuffer::_rasterize_band_threaded(uint32_t p_band, const RasterThreadData *p_data) {
+	const Size2i &buffer_size = sizes[0];
+	int band_begin = p_band * p_data->band_height;
+	int band_end = MIN(band_begin + (int)p_data->band_height, buffer_size.y);
+	float *depth_buffer = mips[0];
+
+	for (uint32_t i = band_offsets[p_band]; i < band_offsets[p_band + 1]; i++) {
+		const ScreenTriangle &triangle = triangles[band_triangles[i]];
+		int min_y = MAX(triangle.rect.position.y, band_begin);
+		int max_y = MIN(triangle.rect.position.y + triangle.rect.size.y, band_end);
+
+		// Edge functions in the form `a * x + b * y + c`, one per vertex, which are the barycentric weights scaled by the area.
+		float a[3];
+		float b[3];
+		float c[3];
+		for (int j = 0; j < 3; j++) {
+			const Vector2 &from = triangle.points[(j + 1) % 3];
+			const Vector2 &to = triangle.points[(j + 2) % 3];
+			a[j] = from.y - to.y;
+			b[j] = to.x - from.x;
+			c[j] = from.x * to.y - from.y * to.x;
+		}
+
+		float inv_area = 1.0f / (c[0] + c[1] + c[2]);
+		float depth_a = (a[0] * triangle.depths[0] + a[1] * triangle.depths[1] + a[2] * triangle.depths[2]) * inv_area;
+		float depth_b = (b[0] * triangle.depths[0] + b[1] * triangle.depths[1] + b[2] * triangle.depths[2]) * inv_area;
+		float depth_c = (c[0] * triangle.depths[0] + c[1] * triangle.depths[1] + c[2] * triangle.depths[2]) * inv_area;
+
+		int min_x = triangle.rect.position.x;
+		int max_x = min_x + triangle.rect.size.x;
+
+#if defined(RASTER_OCCLUSION_CULL_SSE2)
+		const __m128 lane_offsets = _mm_setr_ps(0.5f, 1.5f, 2.5f, 3.5f);
+		const __m128 zero = _mm_setzero_ps();
+		const __m128 one = _mm_set1_ps(1.0f);
+		const __m128 lanes_a0 = _mm_set1_ps(a[0]);
+		const __m128 lanes_a1 = _mm_set1_ps(a[1]);
+		const __m128 lanes_a2 = _mm_set1_ps(a[2]);
+		const __m128 lanes_depth_a = _mm_set1_ps(depth_a);
+#elif defined(RASTER_OCCLUSION_CULL_NEON)
+		const float lane_offset_values[4] = { 0.5f, 1.5f, 2.5f, 3.5f };
+		const float32x4_t lane_offsets = vld1q_f32(lane_offset_values);
+		const float32x4_t zero = vdupq_n_f32(0.0f);
+		const float32x4_t one = vdupq_n_f32(1.0f);
+		const float32x4_t lanes_a0 = vdupq_n_f32(a[0]);
+		const float32x4_t lanes_a1 = vdupq_n_f32(a[1]);
+		const float32x4_t lanes_a2 = vdupq_n_f32(a[2]);
+		const float32x4_t lanes_depth_a = vdupq_n_f32(depth_a);
+#endif
+
+		for (int y = min_y; y < max_y; y++) {
+			float center_y = y + 0.5f;
+			// The parts of the edge functions that are constant along the row.
+			float row_w0 = b[0] * center_y + c[0];
+			float row_w1 = b[1] * center_y + c[1];
+			float row_w2 = b[2] * center_y + c[2];
+			float row_depth = depth_b * center_y + depth_c;
+			float *row = &depth_buffer[y * buffer_size.x];
+			int x = min_x;
+
+#if defined(RASTER_OCCLUSION_CULL_SSE2)
+			const __m128 lanes_row_w0 = _mm_set1_ps(row_w0);
+			const __m128 lanes_row_w1 = _mm_set1_ps(row_w1);
+			const __m128 lanes_row_w2 = _mm_set1_ps(row_w2);
+			const __m128 lanes_row_depth = _mm_set1_ps(row_depth);
+
+			for (; x + 4 <= max_x; x += 4) {
+				const __m128 center_x = _mm_add_ps(_mm_set1_ps((float)x), lane_offsets);
+				const __m128 w0 = _mm_add_ps(_mm_mul_ps(lanes_a0, center_x), lanes_row_w0);
+				const __m128 w1 = _mm_add_ps(_mm_mul_ps(lanes_a1, center_x), lanes_row_w1);
+				const __m128 w2 = _mm_add_ps(_mm_mul_ps(lanes_a2, center_x), lanes_row_w2);
+				const __m128 inside = _mm_and_ps(_mm_and_ps(_mm_cmpge_ps(w0, zero), _mm_cmpge_ps(w1, zero)), _mm_cmpge_ps(w2, zero));
+				if (_mm_movemask_ps(inside) == 0) {
+					continue;
+				}
+
+				__m128 pixel_depth = _mm_add_ps(_mm_mul_ps(lanes_depth_a, center_x), lanes_row_depth);
+				if (!p_data->camera_orthogonal) {
+					pixel_depth = _mm_div_ps(one, pixel_depth);
+				}
+				const __m128 current = _mm_loadu_ps(&row[x]);
+				const __m128 nearest = _mm_min_ps(current, pixel_depth);
+				_mm_storeu_ps(&row[x], _mm_or_ps(_mm_and_ps(inside, nearest), _mm_andnot_ps(inside, current)));
+			}
+#elif defined(RASTER_OCCLUSION_CULL_NEON)
+			const float32x4_t lanes_row_w0 = vdupq_n_f32(row_w0);
+			const float32x4_t lanes_row_w1 = vdupq_n_f32(row_w1);
+			const float32x4_t lanes_row_w2 = vdupq_n_f32(row_w2);
+			const float32x4_t lanes_row_depth = vdupq_n_f32(row_depth);
+
+			for (; x + 4 <= max_x; x += 4) {
+				const float32x4_t center_x = vaddq_f32(vdupq_n_f32((float)x), lane_offsets);
+				const float32x4_t w0 = vaddq_f32(vmulq_f32(lanes_a0, center_x), lanes_row_w0);
+				const float32x4_t w1 = vaddq_f32(vmulq_f32(lanes_a1, center_x), lanes_row_w1);
+				const float32x4_t w2 = vaddq_f32(vmulq_f32(lanes_a2, center_x), lanes_row_w2);
+				const uint32x4_t inside = vandq_u32(vandq_u32(vcgeq_f32(w0, zero), vcgeq_f32(w1, zero)), vcgeq_f32(w2, zero));
+				if (vmaxvq_u32(inside) == 0) {
+					continue;
+				}
+
+				float32x4_t pixel_depth = vaddq_f32(vmulq_f32(lanes_depth_a, center_x), lanes_row_depth);
+				if (!p_data->camera_orthogonal) {
+					pixel_depth = vdivq_f32(one, pixel_depth);
+				}
+				const float32x4_t current = vld1q_f32(&row[x]);
+				vst1q_f32(&row[x], vbslq_f32(inside, vminq_f32(current, pixel_depth), current));
+			}
+#endif
+
+			// Scalar fallback, and the pixels left over at the end of the row.
+			for (; x < max_x; x++) {
+				float center_x = x + 0.5f;
+				float w0 = a[0] * center_x + row_w0;
+				float w1 = a[1] * center_x + row_w1;
+				float w2 = a[2] * center_x + row_w2;
+				if (w0 >= 0.0f && w1 >= 0.0f && w2 >= 0.0f) {
+					float depth = depth_a * center_x + row_depth;
+					float pixel_depth = p_data->camera_orthogonal ? depth : 1.0f / depth;
+					row[x] = MIN(row[x], pixel_depth);
+				}
+			}
+		}
+	}
+}
+
+void RasterOcclusionCull::RasterHZBuffer::rasterize(const OccluderMesh *p_meshes, uint32_t p_mesh_count, const Transform3D &p_cam_transform, const Projection &p_cam_projection, bool p_cam_orthogonal) {
+	ERR_FAIL_COND(is_empty());
+
+	const Size2i &buffer_size = sizes[0];
+	real_t z_near = p_cam_projection.get_z_near();
+	float z_far = p_cam_projection.get_z_far() * 1.05f;
+	debug_tex_range = z_far;
+
+	// Pixels without occluders are as far as a ray that hits nothing.
+	float *depth_buffer = mips[0];
+	for (int i = 0; i < buffer_size.x * buffer_size.y; i++) {
+		depth_buffer[i] = z_far;
+	}
+
+	Transform3D cam_inv_transform = p_cam_transform.affine_inverse();
+	triangles.clear();
+
+	for (uint32_t i = 0; i < p_mesh_count; i++) {
+		const OccluderMesh &mesh = p_meshes[i];
+
+		view_vertices.resize(mesh.vertex_count);
+		for (uint32_t j = 0; j < mesh.vertex_count; j++) {
+			view_vertices[j] = cam_inv_transform.xform(mesh.vertices[j]);
+		}
+
+		for (uint32_t j = 0; j + 2 < mesh.index_count; j += 3) {
+			const int32_t *indices = &mesh.indices[j];
+			if ((uint32_t)indices[0] >= mesh.vertex_count || (uint32_t)indices[1] >= mesh.vertex_count || (uint32_t)indices[2] >= mesh.vertex_count) {
+				continue;
+			}
+
+			const Vector3 view[3] = { view_vertices[indices[0]], view_vertices[indices[1]], view_vertices[indices[2]] };
+			_add_triangle(view, p_cam_projection, z_near, p_cam_orthogonal);
+		}
+	}
+
+	if (triangles.is_empty()) {
+		return;
+	}
+
+	// Every band of rows is written by a single task, so they don't need to synchronize.
+	RasterThreadData td;
+	td.camera_orthogonal = p_cam_orthogonal;
+	td.band_count = CLAMP(WorkerThreadPool::get_singleton()->get_thread_count(), 1, buffer_size.y);
+	td.band_height = (buffer_size.y + td.band_count - 1) / td.band_count;
+
+	// Bin the triangles by the bands they overlap, so each task only visits its own triangles.
+	band_offsets.resize(td.band_count + 1);
+	for (uint32_t i = 0; i <= td.band_count; i++) {
+		band_offsets[i] = 0;
+	}
+	for (const ScreenTriangle &triangle : triangles) {
+		uint32_t first_band = triangle.rect.position.y / td.band_height;
+		uint32_t last_band = (triangle.rect.position.y + triangle.rect.size.y - 1) / td.band_height;
+		for (uint32_t band = first_band; band <= last_band; band++) {
+			band_offsets[band + 1]++;
+		}
+	}
+	for (uint32_t i = 0; i < td.band_count; i++) {
+		band_offsets[i + 1] += band_offsets[i];
+	}
+
+	band_triangles.resize(band_offsets[td.band_count]);
+	for (uint32_t i = 0; i < triangles.size(); i++) {
+		const ScreenTriangle &triangle = triangles[i];
+		uint32_t first_band = triangle.rect.position.y / td.band_height;
+		uint32_t last_band = (triangle.rect.position.y + triangle.rect.size.y - 1) / td.band_height;
+		for (uint32_t band = first_band; band <= last_band; band++) {
+			// Used as the write cursor of each band, which leaves it at the start of the next band once filled.
+			band_triangles[band_offsets[band]++] = i;
+		}
+	}
+	for (uint32_t i = td.band_count; i > 0; i--) {
+		band_offsets[i] = band_offsets[i - 1];
+	}
+	band_offsets[0] = 0;
+
+	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &RasterHZBuffer::_rasterize_band_threaded, &td, td.band_count, -1, true, SNAME("RasterOcclusionCullRasterize"));
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+}
+
+////////////////////////////////////////////////////////
+
+bool RasterOcclusionCull::is_occluder(RID p_rid) {
+	return occluder_owner.owns(p_rid);
+}
+
+RID RasterOcclusionCull::occluder_allocate() {
+	return occluder_owner.allocate_rid();
+}
+
+void RasterOcclusionCull::occluder_initialize(RID p_occluder) {
+	Occluder *occluder = memnew(Occluder);
+	occluder_owner.initialize_rid(p_occluder, occluder);
+}
+
+void RasterOcclusionCull::occluder_set_mesh(RID p_occluder, const PackedVector3Array &p_vertices, const PackedInt32Array &p_indices) {
+	Occluder *occluder = occluder_owner.get_or_null(p_occluder);
+	ERR_FAIL_NULL(occluder);
+
+	occluder->vertices = p_vertices;
+	occluder->indices = p_indices;
+
+	for (const InstanceID &E : occluder->users) {
+		Scenario *scenario = scenarios.getptr(E.scenario);
+		ERR_CONTINUE(!scenario);
+		OccluderInstance *instance = scenario->instances.getptr(E.instance);
+		ERR_CONTINUE(!instance);
+		instance->dirty = true;
+	}
+}
+
+void RasterOcclusionCull::free_occluder(RID p_occluder) {
+	Occluder *occluder = occluder_owner.get_or_null(p_occluder);
+	ERR_FAIL_NULL(occluder);
+	memdelete(occluder);
+	occluder_owner.free(p_occluder);
+}
+
+////////////////////////////////////////////////////////
+
+void RasterOcclusionCull::add_scenario(RID p_scenario) {
+	ERR_FAIL_COND(scenarios.has(p_scenario));
+	scenarios[p_scenario] = Scenario();
+}
+
+void RasterOcclusionCull::remove_scenario(RID p_scenario) {
+	Scenario *scenario = scenarios.getptr(p_scenario);
+	ERR_FAIL_NULL(scenario);
+
+	for (const KeyValue<RID, OccluderInstance> &E : scenario->instances) {
+		Occluder *occluder = occluder_owner.get_or_null(E.value.occluder);
+		if (occluder) {
+			occluder->users.erase(InstanceID(p_scenario, E.key));
+		}
+	}
+
+	scenarios.erase(p_scenario);
+}
+
+void RasterOcclusionCull::scenario_set_instance(RID p_scenario, RID p_instance, RID p_occluder, const Transform3D &p_xform, bool p_enabled) {
+	Scenario *scenario = scenarios.getptr(p_scenario);
+	ERR_FAIL_NULL(scenario);
+
+	OccluderInstance &instance = scenario->instances[p_instance];
+
+	if (instance.occluder != p_occluder) {
+		Occluder *old_occluder = occluder_owner.get_or_null(instance.occluder);
+		if (old_occluder) {
+			old_occluder->users.erase(InstanceID(p_scenario, p_instance));
+		}
+
+		instance.occluder = p_occluder;
+
+		if (p_occluder.is_valid()) {
+			Occluder *occluder = occluder_owner.get_or_null(p_occluder);
+			ERR_FAIL_NULL(occluder);
+			occluder->users.insert(InstanceID(p_scenario, p_instance));
+		}
+		instance.dirty = true;
+	}
+
+	if (instance.xform != p_xform) {
+		instance.xform = p_xform;
+		instance.dirty = true;
+	}
+
+	instance.enabled = p_enabled;
+}
+
+void RasterOcclusionCull::scenario_remove_instance(RID p_scenario, RID p_instance) {
+	Scenario *scenario = scenarios.getptr(p_scenario);
+	ERR_FAIL_NULL(scenario);
+
+	OccluderInstance *instance = scenario->instances.getptr(p_instance);
+	if (!instance) {
+		return;
+	}
+
+	Occluder *occluder = occluder_owner.get_or_null(instance->occluder);
+	if (occluder) {
+		occluder->users.erase(InstanceID(p_scenario, p_instance));
+	}
+
+	scenario->instances.erase(p_instance);
+}
+
+////////////////////////////////////////////////////////
+
+void RasterOcclusionCull::add_buffer(RID p_buffer) {
+	ERR_FAIL_COND(buffers.has(p_buffer));
+	buffers[p_buffer] = RasterHZBuffer();
+}
+
+void RasterOcclusionCull::remove_buffer(RID p_buffer) {
+	ERR_FAIL_COND(!buffers.has(p_buffer));
+	buffers.erase(p_buffer);
+}
+
+void RasterOcclusionCull::buffer_set_scenario(RID p_buffer, RID p_scenario) {
+	ERR_FAIL_COND(!buffers.has(p_buffer));
+	ERR_FAIL_COND(p_scenario.is_valid() && !scenarios.has(p_scenario));
+	buffers[p_buffer].scenario_rid = p_scenario;
+}
+
+void RasterOcclusionCull::buffer_set_size(RID p_buffer, const Vector2i &p_size) {
+	ERR_FAIL_COND(!buffers.has(p_buffer));
+	buffers[p_buffer].resize(p_size);
+}
+
+void RasterOcclusionCull::buffer_update(RID p_buffer, const Transform3D &p_cam_transform, const Projection &p_cam_projection, bool p_cam_orthogonal) {
+	RasterHZBuffer *buffer = buffers.getptr(p_buffer);
+	if (!buffer || buffer->is_empty()) {
+		return;
+	}
+
+	Scenario *scenario = scenarios.getptr(buffer->scenario_rid);
+	if (!scenario) {
+		return;
+	}
+
+	occluder_meshes.clear();
+
+	for (KeyValue<RID, OccluderInstance> &E : scenario->instances) {
+		OccluderInstance &instance = E.value;
+		const Occluder *occluder = occluder_owner.get_or_null(instance.occluder);
+
+		if (!occluder || !instance.enabled) {
+			continue;
+		}
+
+		if (instance.dirty) {
+			int vertex_count = occluder->vertices.size();
+			const Vector3 *read = occluder->vertices.ptr();
+			instance.xformed_vertices.resize(vertex_count);
+			for (int i = 0; i < vertex_count; i++) {
+				instance.xformed_vertices[i] = instance.xform.xform(read[i]);
+			}
+			instance.dirty = false;
+		}
+
+		RasterHZBuffer::OccluderMesh mesh;
+		mesh.vertices = instance.xformed_vertices.ptr();
+		mesh.vertex_count = instance.xformed_vertices.size();
+		mesh.indices = occluder->indices.ptr();
+		mesh.index_count = occluder->indices.size();
+		occluder_meshes.push_back(mesh);
+	}
+
+	Projection jittered_proj = _jitter_projection(p_cam_projection, buffer->get_occlusion_buffer_size());
+
+	buffer->rasterize(occluder_meshes.ptr(), occluder_meshes.size(), p_cam_transform, jittered_proj, p_cam_orthogonal);
+	buffer->update_mips();
+}
+
+RendererSceneOcclusionCull::HZBuffer *RasterOcclusionCull::buffer_get_ptr(RID p_buffer) {
+	return buffers.getptr(p_buffer);
+}
+
+RID RasterOcclusionCull::buffer_get_debug_texture(RID p_buffer) {
+	ERR_FAIL_COND_V(!buffers.has(p_buffer), RID());
+	return buffers[p_buffer].get_debug_texture();
+}
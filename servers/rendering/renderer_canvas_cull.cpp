@@ -33,6 +33,7 @@
 #include "core/config/project_settings.h"
 #include "core/math/geometry_2d.h"
 #include "core/math/transform_interpolator.h"
+#include "core/object/worker_thread_pool.h"
 #include "renderer_viewport.h"
 #include "rendering_server_default.h"
 #include "rendering_server_globals.h"
@@ -184,7 +185,12 @@ void RendererCanvasCull::_attach_canvas_item_for_draw(RendererCanvasCull::Item *
 		//something to draw?
 
 		if (ci->update_when_visible) {
-			RenderingServerDefault::redraw_request();
+			if (threaded_cull_active) {
+				// Requesting a redraw isn't thread-safe, so it's done once the culling tasks are finished.
+				threaded_cull_redraw_requested.set();
+			} else {
+				RenderingServerDefault::redraw_request();
+			}
 		}
 
 		if (ci->commands != nullptr || ci->copy_back_buffer) {
@@ -212,7 +218,12 @@ void RendererCanvasCull::_attach_canvas_item_for_draw(RendererCanvasCull::Item *
 
 		if (ci->visibility_notifier) {
 			if (!ci->visibility_notifier->visible_element.in_list()) {
-				visibility_notifier_list.add(&ci->visibility_notifier->visible_element);
+				if (threaded_cull_active) {
+					MutexLock lock(visibility_notifier_mutex);
+					visibility_notifier_list.add(&ci->visibility_notifier->visible_element);
+				} else {
+					visibility_notifier_list.add(&ci->visibility_notifier->visible_element);
+				}
 				ci->visibility_notifier->just_visible = true;
 			}
 
@@ -372,6 +383,23 @@ void RendererCanvasCull::_cull_canvas_item(Item *p_canvas_item, const Transform2
 			_cull_canvas_item(child_items[i], final_xform, p_clip_rect, modulate, p_z, r_z_list, r_z_last_list, (Item *)ci->final_clip_owner, p_material_owner, true, p_canvas_cull_mask, repeat_size, repeat_times);
 		}
 		_attach_canvas_item_for_draw(ci, p_canvas_clip, r_z_list, r_z_last_list, final_xform, p_clip_rect, global_rect, modulate, p_z, p_material_owner, use_canvas_group, canvas_group_from);
+
+		if (!use_canvas_group && !threaded_cull_active && threaded_cull_minimum_child_items > 0 && (uint32_t)child_item_count >= threaded_cull_minimum_child_items && WorkerThreadPool::get_singleton()->get_thread_count() > 1) {
+			ThreadedCullData data;
+			data.canvas_item = ci;
+			data.transform = final_xform;
+			data.clip_rect = p_clip_rect;
+			data.modulate = modulate;
+			data.z = p_z;
+			data.canvas_clip = (Item *)ci->final_clip_owner;
+			data.material_owner = p_material_owner;
+			data.canvas_cull_mask = p_canvas_cull_mask;
+			data.repeat_size = repeat_size;
+			data.repeat_times = repeat_times;
+			_cull_canvas_item_children_threaded(data, r_z_list, r_z_last_list);
+			return;
+		}
+
 		for (int i = 0; i < child_item_count; i++) {
 			if (child_items[i]->behind || use_canvas_group) {
 				continue;
@@ -381,6 +409,66 @@ void RendererCanvasCull::_cull_canvas_item(Item *p_canvas_item, const Transform2
 	}
 }
 
+void RendererCanvasCull::_cull_canvas_item_children_task(uint32_t p_task, ThreadedCullData *p_data) {
+	ThreadedCullLists &lists = threaded_cull_lists[p_task];
+	Item **child_items = p_data->canvas_item->child_items.ptrw();
+	uint32_t from = p_task * p_data->child_items_per_task;
+	uint32_t to = MIN(from + p_data->child_items_per_task, (uint32_t)p_data->canvas_item->child_items.size());
+
+	for (uint32_t i = from; i < to; i++) {
+		if (child_items[i]->behind) {
+			continue;
+		}
+		_cull_canvas_item(child_items[i], p_data->transform, p_data->clip_rect, p_data->modulate, p_data->z, lists.z_list, lists.z_last_list, p_data->canvas_clip, p_data->material_owner, true, p_data->canvas_cull_mask, p_data->repeat_size, p_data->repeat_times);
+	}
+}
+
+void RendererCanvasCull::_cull_canvas_item_children_threaded(const ThreadedCullData &p_data, RendererCanvasRender::Item **r_z_list, RendererCanvasRender::Item **r_z_last_list) {
+	// Sibling subtrees only write to their own items, so each task culls a contiguous range of children.
+	// Appending the per-task lists in task order afterwards gives the same draw order as culling serially.
+	uint32_t child_item_count = p_data.canvas_item->child_items.size();
+	uint32_t task_count = MIN((uint32_t)WorkerThreadPool::get_singleton()->get_thread_count(), child_item_count);
+
+	while (threaded_cull_lists.size() < task_count) {
+		ThreadedCullLists lists;
+		lists.z_list = (RendererCanvasRender::Item **)memalloc(z_range * sizeof(RendererCanvasRender::Item *));
+		lists.z_last_list = (RendererCanvasRender::Item **)memalloc(z_range * sizeof(RendererCanvasRender::Item *));
+		memset(lists.z_list, 0, z_range * sizeof(RendererCanvasRender::Item *));
+		memset(lists.z_last_list, 0, z_range * sizeof(RendererCanvasRender::Item *));
+		threaded_cull_lists.push_back(lists);
+	}
+
+	ThreadedCullData data = p_data;
+	data.child_items_per_task = (child_item_count + task_count - 1) / task_count;
+
+	threaded_cull_active = true;
+	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &RendererCanvasCull::_cull_canvas_item_children_task, &data, task_count, -1, true, SNAME("CullCanvasItems"));
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	threaded_cull_active = false;
+
+	if (threaded_cull_redraw_requested.is_set()) {
+		threaded_cull_redraw_requested.clear();
+		RenderingServerDefault::redraw_request();
+	}
+
+	for (uint32_t i = 0; i < task_count; i++) {
+		ThreadedCullLists &lists = threaded_cull_lists[i];
+		for (int j = 0; j < z_range; j++) {
+			if (!lists.z_list[j]) {
+				continue;
+			}
+			if (r_z_last_list[j]) {
+				r_z_last_list[j]->next = lists.z_list[j];
+			} else {
+				r_z_list[j] = lists.z_list[j];
+			}
+			r_z_last_list[j] = lists.z_last_list[j];
+			lists.z_list[j] = nullptr;
+			lists.z_last_list[j] = nullptr;
+		}
+	}
+}
+
 void RendererCanvasCull::render_canvas(RID p_render_target, Canvas *p_canvas, const Transform2D &p_transform, RendererCanvasRender::Light *p_lights, RendererCanvasRender::Light *p_directional_lights, const Rect2 &p_clip_rect, RenderingServer::CanvasItemTextureFilter p_default_filter, RenderingServer::CanvasItemTextureRepeat p_default_repeat, bool p_snap_2d_transforms_to_pixel, bool p_snap_2d_vertices_to_pixel, uint32_t canvas_cull_mask, RenderingMethod::RenderInfo *r_render_info) {
 	RENDER_TIMESTAMP("> Render Canvas");
 
@@ -2367,9 +2455,15 @@ RendererCanvasCull::RendererCanvasCull() {
 
 	debug_redraw_time = GLOBAL_DEF("debug/canvas_items/debug_redraw_time", 1.0);
 	debug_redraw_color = GLOBAL_DEF("debug/canvas_items/debug_redraw_color", Color(1.0, 0.2, 0.2, 0.5));
+	threaded_cull_minimum_child_items = GLOBAL_DEF(PropertyInfo(Variant::INT, "rendering/2d/culling/threaded_cull_minimum_child_items", PROPERTY_HINT_RANGE, "0,65536,1"), 512);
 }
 
 RendererCanvasCull::~RendererCanvasCull() {
 	memfree(z_list);
 	memfree(z_last_list);
+
+	for (ThreadedCullLists &lists : threaded_cull_lists) {
+		memfree(lists.z_list);
+		memfree(lists.z_last_list);
+	}
 }
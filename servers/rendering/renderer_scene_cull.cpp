@@ -33,6 +33,7 @@
 #include "core/config/project_settings.h"
 #include "core/object/worker_thread_pool.h"
 #include "core/os/os.h"
+#include "raster_occlusion_cull.h"
 #include "rendering_light_culler.h"
 #include "rendering_server_default.h"
 
@@ -3048,26 +3049,42 @@ void RendererSceneCull::_render_scene(const RendererSceneRender::CameraData *p_c
 			scenario_add_viewport_visibility_mask(scenario->self, p_viewport);
 		}
 
-		VisibilityCullData visibility_cull_data;
-		visibility_cull_data.scenario = scenario;
-		visibility_cull_data.viewport_mask = scenario->viewport_visibility_masks[p_viewport];
-		visibility_cull_data.camera_position = camera_position;
-
-		for (int i = scenario->instance_visibility.get_bin_count() - 1; i > 0; i--) { // We skip bin 0
-			visibility_cull_data.cull_offset = scenario->instance_visibility.get_bin_start(i);
-			visibility_cull_data.cull_count = scenario->instance_visibility.get_bin_size(i);
-
-			if (visibility_cull_data.cull_count == 0) {
+		// Each bin needs the previous one to be culled, since it reads the visibility of its parents.
+		// Once a bin is culled on threads, the following ones are posted after it instead of waiting
+		// here for every bin, so each bin keeps its own data.
+		const int bin_count = scenario->instance_visibility.get_bin_count();
+		LocalVector<VisibilityCullData> visibility_cull_data;
+		visibility_cull_data.resize(bin_count);
+		LocalVector<WorkerThreadPool::GroupID> visibility_cull_groups;
+		const uint64_t viewport_mask = scenario->viewport_visibility_masks[p_viewport];
+
+		for (int i = bin_count - 1; i > 0; i--) { // We skip bin 0
+			VisibilityCullData &bin_cull_data = visibility_cull_data[i];
+			bin_cull_data.scenario = scenario;
+			bin_cull_data.viewport_mask = viewport_mask;
+			bin_cull_data.camera_position = camera_position;
+			bin_cull_data.cull_offset = scenario->instance_visibility.get_bin_start(i);
+			bin_cull_data.cull_count = scenario->instance_visibility.get_bin_size(i);
+
+			if (bin_cull_data.cull_count == 0) {
 				continue;
 			}
 
-			if (visibility_cull_data.cull_count > thread_cull_threshold) {
-				WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &RendererSceneCull::_visibility_cull_threaded, &visibility_cull_data, WorkerThreadPool::get_singleton()->get_thread_count(), -1, true, SNAME("VisibilityCullInstances"));
-				WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+			const bool threaded = bin_cull_data.cull_count > thread_cull_threshold;
+			if (threaded || !visibility_cull_groups.is_empty()) {
+				// Small bins after a threaded one are still posted, but culled by a single task.
+				const uint32_t dependency_count = visibility_cull_groups.is_empty() ? 0 : 1;
+				const WorkerThreadPool::GroupID *dependency = visibility_cull_groups.is_empty() ? nullptr : &visibility_cull_groups[visibility_cull_groups.size() - 1];
+				visibility_cull_groups.push_back(WorkerThreadPool::get_singleton()->add_template_group_task_after(dependency, dependency_count, this, &RendererSceneCull::_visibility_cull_threaded, &bin_cull_data, WorkerThreadPool::get_singleton()->get_thread_count(), threaded ? -1 : 1, true, SNAME("VisibilityCullInstances")));
 			} else {
-				_visibility_cull(visibility_cull_data, visibility_cull_data.cull_offset, visibility_cull_data.cull_offset + visibility_cull_data.cull_count);
+				_visibility_cull(bin_cull_data, bin_cull_data.cull_offset, bin_cull_data.cull_offset + bin_cull_data.cull_count);
 			}
 		}
+
+		// The last group completes after all the others, so only waiting for it blocks.
+		for (int i = int(visibility_cull_groups.size()) - 1; i >= 0; i--) {
+			WorkerThreadPool::get_singleton()->wait_for_group_task_completion(visibility_cull_groups[i]);
+		}
 	}
 
 	RENDER_TIMESTAMP("Cull 3D Scene");
@@ -4263,7 +4280,7 @@ RendererSceneCull::RendererSceneCull() {
 	thread_cull_threshold = MAX(thread_cull_threshold, (uint32_t)WorkerThreadPool::get_singleton()->get_thread_count()); //make sure there is at least one thread per CPU
 	RendererSceneOcclusionCull::HZBuffer::occlusion_jitter_enabled = GLOBAL_GET("rendering/occlusion_culling/jitter_projection");
 
-	dummy_occlusion_culling = memnew(RendererSceneOcclusionCull);
+	software_occlusion_culling = memnew(RasterOcclusionCull);
 
 	light_culler = memnew(RenderingLightCuller);
 
@@ -4289,8 +4306,8 @@ RendererSceneCull::~RendererSceneCull() {
 	}
 	scene_cull_result_threads.clear();
 
-	if (dummy_occlusion_culling) {
-		memdelete(dummy_occlusion_culling);
+	if (software_occlusion_culling) {
+		memdelete(software_occlusion_culling);
 	}
 
 	if (light_culler) {
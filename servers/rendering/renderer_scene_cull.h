@@ -123,7 +123,7 @@ public:
 
 	/* VISIBILITY NOTIFIER API */
 
-	RendererSceneOcclusionCull *dummy_occlusion_culling = nullptr;
+	RendererSceneOcclusionCull *software_occlusion_culling = nullptr;
 
 	/* SCENARIO API */
 
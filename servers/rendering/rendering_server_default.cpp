@@ -69,6 +69,8 @@ void RenderingServerDefault::request_frame_drawn_callback(const Callable &p_call
 }
 
 void RenderingServerDefault::_draw(bool p_swap_buffers, double frame_step) {
+	MemoryTagScope tag_scope(Memory::TAG_RENDERING);
+
 	changes = 0;
 
 	RSG::rasterizer->begin_frame(frame_step);
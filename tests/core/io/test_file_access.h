@@ -107,6 +107,42 @@ TEST_CASE("[FileAccess] Get as UTF-8 String") {
 	CHECK(s_cr == "Hello darkness\rMy old friend\rI've come to talk\rWith you again\r");
 	CHECK(s_cr_nocr == "Hello darknessMy old friendI've come to talkWith you again");
 }
+
+TEST_CASE("[FileAccess] Mapped read") {
+	const String path = TestUtils::get_data_path("line_endings_crlf.test.txt");
+	const Vector<uint8_t> expected = FileAccess::get_file_as_bytes(path);
+	REQUIRE(expected.size() > 8);
+
+	for (int pack = 0; pack < 2; pack++) {
+		// Data files aren't in res://, so only open_mapped_pack() maps them.
+		Ref<FileAccess> f = pack ? FileAccess::open_mapped_pack(path) : FileAccess::open_mapped(path);
+		REQUIRE(!f.is_null());
+		CHECK(f->get_length() == (uint64_t)expected.size());
+
+		// Same reads as a regular file, whether or not the platform maps it.
+		CHECK(f->get_8() == expected[0]);
+		CHECK(f->get_buffer(expected.size() - 1) == expected.slice(1));
+		CHECK_FALSE(f->eof_reached());
+		CHECK(f->get_8() == 0);
+		CHECK(f->eof_reached());
+		f->seek(2);
+		CHECK_FALSE(f->eof_reached());
+		CHECK(f->get_16() == (expected[2] | (expected[3] << 8)));
+
+		const uint8_t *mapped = f->get_mapped_range(0, expected.size());
+		if (mapped) {
+			CHECK(memcmp(mapped, expected.ptr(), expected.size()) == 0);
+			CHECK(f->get_mapped_range(4, expected.size() - 4) == mapped + 4);
+			CHECK(f->get_mapped_range(4, expected.size()) == nullptr);
+			CHECK(f->get_position() == 4); // Doesn't move the read position.
+		}
+
+		ERR_PRINT_OFF;
+		f->store_8(0);
+		ERR_PRINT_ON;
+		CHECK(FileAccess::get_file_as_bytes(path) == expected);
+	}
+}
 } // namespace TestFileAccess
 
 #endif // TEST_FILE_ACCESS_H
@@ -32,8 +32,9 @@
 #define TEST_JSON_H
 
 #include "core/io/json.h"
+#include "core/os/os.h"
 
-#include "thirdparty/doctest/doctest.h"
+#include "tests/test_macros.h"
 
 namespace TestJSON {
 
@@ -232,6 +233,403 @@ TEST_CASE("[JSON] Parsing escape sequences") {
 		ERR_PRINT_ON
 	}
 }
+
+static inline Array build_array() {
+	return Array();
+}
+template <typename... Targs>
+static inline Array build_array(Variant item, Targs... Fargs) {
+	Array a = build_array(Fargs...);
+	a.push_front(item);
+	return a;
+}
+
+static Array _json_reader_events(JSONReader &p_reader, Error &r_error) {
+	Array events;
+	while ((r_error = p_reader.read()) == OK) {
+		events.push_back(build_array(p_reader.get_event(), p_reader.get_value()));
+	}
+	return events;
+}
+
+TEST_CASE("[JSON] Reader events") {
+	JSONReader reader;
+	reader.open_string(R"({"a": [1, true, null], "b": {"c": "d\u00e9"}, "e": []})");
+
+	Error err = OK;
+	const Array events = _json_reader_events(reader, err);
+	CHECK(err == ERR_FILE_EOF);
+
+	const Array expected = build_array(
+			build_array(JSONReader::EVENT_OBJECT_START, Variant()),
+			build_array(JSONReader::EVENT_KEY, "a"),
+			build_array(JSONReader::EVENT_ARRAY_START, Variant()),
+			build_array(JSONReader::EVENT_NUMBER, 1.0),
+			build_array(JSONReader::EVENT_BOOL, true),
+			build_array(JSONReader::EVENT_NULL, Variant()),
+			build_array(JSONReader::EVENT_ARRAY_END, Variant()),
+			build_array(JSONReader::EVENT_KEY, "b"),
+			build_array(JSONReader::EVENT_OBJECT_START, Variant()),
+			build_array(JSONReader::EVENT_KEY, "c"),
+			build_array(JSONReader::EVENT_STRING, U"d\u00e9"),
+			build_array(JSONReader::EVENT_OBJECT_END, Variant()),
+			build_array(JSONReader::EVENT_KEY, "e"),
+			build_array(JSONReader::EVENT_ARRAY_START, Variant()),
+			build_array(JSONReader::EVENT_ARRAY_END, Variant()),
+			build_array(JSONReader::EVENT_OBJECT_END, Variant()));
+	CHECK(events == expected);
+	CHECK(reader.get_depth() == 0);
+}
+
+TEST_CASE("[JSON] Reader values match JSON::parse()") {
+	static const char *documents[] = {
+		"null",
+		"  -12.5e2  ",
+		R"("tab\tquote\"slash\/ \ud83c\udfa4")",
+		R"([1, [2, [3, []]], {}, {"x": {"y": [false]}}])",
+		"{\"multi\nline\": \"text\nwith\nnewlines\", \"trailing\": [1, 2,],}",
+	};
+
+	for (const char *document : documents) {
+		JSON json;
+		REQUIRE(json.parse(document) == OK);
+
+		JSONReader reader;
+		reader.open_string(document);
+		REQUIRE(reader.read() == OK);
+		Variant value;
+		CHECK(reader.read_value(value) == OK);
+		CHECK_MESSAGE(value == json.get_data(), vformat("Reading `%s` should give the same value as JSON::parse().", document));
+		CHECK(reader.read() == ERR_FILE_EOF);
+	}
+}
+
+TEST_CASE("[JSON] Reader skipping values") {
+	JSONReader reader;
+	reader.open_string(R"({"skipped": {"a": [1, {"b": 2}]}, "kept": [3, 4], "last": 5})");
+	REQUIRE(reader.read() == OK);
+
+	REQUIRE(reader.read() == OK);
+	CHECK(reader.get_key() == "skipped");
+	CHECK(reader.skip_value() == OK);
+	CHECK(reader.get_event() == JSONReader::EVENT_OBJECT_END);
+	CHECK(reader.get_depth() == 1);
+
+	REQUIRE(reader.read() == OK);
+	CHECK(reader.get_key() == "kept");
+	Variant kept;
+	CHECK(reader.read_value(kept) == OK);
+	CHECK(kept == build_array(3.0, 4.0));
+
+	REQUIRE(reader.read() == OK);
+	CHECK(reader.get_key() == "last");
+	CHECK(reader.skip_value() == OK);
+	CHECK(reader.get_number() == 5.0);
+
+	REQUIRE(reader.read() == OK);
+	CHECK(reader.get_event() == JSONReader::EVENT_OBJECT_END);
+	CHECK(reader.read() == ERR_FILE_EOF);
+}
+
+TEST_CASE("[JSON] Reader errors") {
+	static const char *documents[][2] = {
+		{ "[1 2]", "Expected ','" },
+		{ "{\"a\" 1}", "Expected ':'" },
+		{ "{1: 2}", "Expected key" },
+		{ "{\"a\": 1 \"b\": 2}", "Expected '}' or ','" },
+		{ "[1,\n2", "Expected ']'" },
+		{ "[1] 2", "Expected 'EOF'" },
+		{ "[tru]", "Expected 'true','false' or 'null', got 'tru'." },
+		{ "[\"open", "Unterminated String" },
+		{ "[\"\\x\"]", "Invalid escape sequence." },
+		{ "[\"\\ud800\"]", "Invalid UTF-16 sequence in string, unpaired lead surrogate" },
+		{ "{\"a\": }", "Expected value, got '}'." },
+	};
+
+	for (const auto &document : documents) {
+		JSONReader reader;
+		reader.open_string(document[0]);
+		Error err = OK;
+		_json_reader_events(reader, err);
+		CHECK_MESSAGE(err == ERR_PARSE_ERROR, vformat("Reading `%s` should fail.", document[0]));
+		CHECK(reader.get_error_message() == document[1]);
+		// Errors stick.
+		CHECK(reader.read() == ERR_PARSE_ERROR);
+	}
+
+	JSONReader reader;
+	reader.open_string("[1,\n2");
+	Error err = OK;
+	_json_reader_events(reader, err);
+	CHECK(reader.get_error_line() == 1);
+}
+
+// Hands out the data it's given a few bytes at a time, like a network connection would.
+class JSONTrickleStreamPeer : public StreamPeer {
+public:
+	Vector<uint8_t> data;
+	int available = 0;
+	int offset = 0;
+
+	virtual Error put_data(const uint8_t *p_data, int p_bytes) override { return ERR_UNAVAILABLE; }
+	virtual Error put_partial_data(const uint8_t *p_data, int p_bytes, int &r_sent) override { return ERR_UNAVAILABLE; }
+	virtual Error get_data(uint8_t *p_buffer, int p_bytes) override { return ERR_UNAVAILABLE; }
+	virtual Error get_partial_data(uint8_t *p_buffer, int p_bytes, int &r_received) override {
+		r_received = MIN(p_bytes, available);
+		memcpy(p_buffer, data.ptr() + offset, r_received);
+		offset += r_received;
+		available -= r_received;
+		return OK;
+	}
+	virtual int get_available_bytes() const override { return available; }
+};
+
+TEST_CASE("[JSON] Reader on streams and large inputs") {
+	// Long enough for tokens to straddle the reader's chunks.
+	Array source;
+	for (int i = 0; i < 2000; i++) {
+		Dictionary d;
+		d["id"] = i;
+		d["name"] = vformat(U"item \u00e9 %d", i);
+		d["tags"] = build_array("a", "b\n", i % 2 == 0);
+		source.push_back(d);
+	}
+	source.push_back(String("x").repeat(200000));
+	const String text = JSON::stringify(source, "\t");
+
+	SUBCASE("StreamPeerBuffer") {
+		Ref<StreamPeerBuffer> peer;
+		peer.instantiate();
+		peer->set_data_array(text.to_utf8_buffer());
+
+		JSONReader reader;
+		reader.open_stream(peer);
+		REQUIRE(reader.read() == OK);
+		Variant value;
+		CHECK(reader.read_value(value) == OK);
+		CHECK(value == JSON::parse_string(text));
+		CHECK(reader.read() == ERR_FILE_EOF);
+	}
+
+	SUBCASE("Data arriving in pieces") {
+		Ref<JSONTrickleStreamPeer> peer;
+		peer.instantiate();
+		peer->data = text.to_utf8_buffer();
+
+		JSONReader reader;
+		reader.open_stream(peer);
+		int event_count = 0;
+		int busy_count = 0;
+		while (true) {
+			const Error err = reader.read();
+			if (err == ERR_BUSY) {
+				// Nothing more arrives once everything was sent, so the stream is left open.
+				REQUIRE(peer->offset < peer->data.size());
+				peer->available = MIN(997, peer->data.size() - peer->offset);
+				busy_count++;
+				continue;
+			}
+			REQUIRE(err == OK);
+			event_count++;
+			if (reader.get_depth() == 0) {
+				break;
+			}
+		}
+		CHECK(busy_count > 0);
+
+		JSONReader buffer_reader;
+		buffer_reader.open_string(text);
+		Error err = OK;
+		CHECK(_json_reader_events(buffer_reader, err).size() == event_count);
+	}
+
+	SUBCASE("Reading and skipping values arriving in pieces") {
+		Ref<JSONTrickleStreamPeer> peer;
+		peer.instantiate();
+		peer->data = ("[" + text + ", " + text + ", true]").to_utf8_buffer();
+
+		JSONReader reader;
+		reader.open_stream(peer);
+		int busy_count = 0;
+		const auto receive_more = [&]() {
+			REQUIRE(peer->offset < peer->data.size());
+			peer->available = MIN(997, peer->data.size() - peer->offset);
+			busy_count++;
+		};
+
+		Error err;
+		while ((err = reader.read()) == ERR_BUSY) {
+			receive_more();
+		}
+		REQUIRE(err == OK);
+		while ((err = reader.read()) == ERR_BUSY) {
+			receive_more();
+		}
+		REQUIRE(err == OK);
+		REQUIRE(reader.get_event() == JSONReader::EVENT_ARRAY_START);
+
+		const int skip_busy_count = busy_count;
+		while ((err = reader.skip_value()) == ERR_BUSY) {
+			receive_more();
+		}
+		REQUIRE(err == OK);
+		CHECK(busy_count > skip_busy_count);
+		CHECK(reader.get_depth() == 1);
+
+		while ((err = reader.read()) == ERR_BUSY) {
+			receive_more();
+		}
+		REQUIRE(err == OK);
+		REQUIRE(reader.get_event() == JSONReader::EVENT_ARRAY_START);
+
+		const int read_busy_count = busy_count;
+		Variant value;
+		while ((err = reader.read_value(value)) == ERR_BUSY) {
+			receive_more();
+		}
+		REQUIRE(err == OK);
+		CHECK(busy_count > read_busy_count);
+		CHECK(value == JSON::parse_string(text));
+
+		while ((err = reader.read()) == ERR_BUSY) {
+			receive_more();
+		}
+		REQUIRE(err == OK);
+		CHECK(reader.get_event() == JSONReader::EVENT_BOOL);
+		CHECK(reader.get_bool());
+	}
+}
+
+TEST_CASE("[JSON] Writer output matches JSON::stringify()") {
+	Dictionary nested;
+	nested["z"] = Array();
+	nested["y"] = Dictionary();
+	nested["x"] = build_array(1, 2.5, "three", Variant(), false);
+	Dictionary source;
+	source["b"] = nested;
+	source["a"] = PackedInt32Array({ 4, 5 });
+	source[U"\u00e9\"quoted\""] = "\t";
+
+	static const char *indents[] = { "", "\t", "  " };
+	for (const char *indent : indents) {
+		for (int sort = 0; sort < 2; sort++) {
+			Ref<StreamPeerBuffer> peer;
+			peer.instantiate();
+			{
+				JSONWriter writer;
+				writer.open_stream(peer);
+				writer.set_indent(indent);
+				writer.set_sort_keys(sort);
+				CHECK(writer.write_value(source) == OK);
+				CHECK(writer.flush() == OK);
+			}
+			const Vector<uint8_t> bytes = peer->get_data_array();
+			const String written = String::utf8((const char *)bytes.ptr(), bytes.size());
+			CHECK(written == JSON::stringify(source, indent, sort));
+		}
+	}
+}
+
+TEST_CASE("[JSON] Writer events") {
+	Ref<StreamPeerBuffer> peer;
+	peer.instantiate();
+	JSONWriter writer;
+	writer.open_stream(peer);
+
+	CHECK(writer.begin_object() == OK);
+	CHECK(writer.write_key("list") == OK);
+	CHECK(writer.begin_array() == OK);
+	for (int i = 0; i < 3; i++) {
+		CHECK(writer.write_value(i) == OK);
+	}
+	CHECK(writer.end_array() == OK);
+
+	ERR_PRINT_OFF;
+	CHECK_MESSAGE(writer.write_value(1) != OK, "Values in an object need a key.");
+	CHECK_MESSAGE(writer.end_array() != OK, "Only the innermost container can be ended.");
+	ERR_PRINT_ON;
+
+	CHECK(writer.write_key("done") == OK);
+	CHECK(writer.write_value(true) == OK);
+	CHECK(writer.end_object() == OK);
+
+	ERR_PRINT_OFF;
+	CHECK_MESSAGE(writer.write_value(2) != OK, "There is only one top-level value.");
+	ERR_PRINT_ON;
+
+	CHECK(writer.flush() == OK);
+	const Vector<uint8_t> bytes = peer->get_data_array();
+	CHECK(String::utf8((const char *)bytes.ptr(), bytes.size()) == R"({"list":[0,1,2],"done":true})");
+}
+
+// Not run by default, since timings are only meaningful on an otherwise idle machine.
+// Run with `--test --no-skip --test-case="*[Benchmark]*"`.
+TEST_CASE("[JSON][Benchmark] Streaming reader and writer against parse() and stringify()" * doctest::skip()) {
+	const int runs = 3;
+
+	// Telemetry-like records.
+	Array source;
+	for (int i = 0; i < 50000; i++) {
+		Dictionary d;
+		d["frame"] = i;
+		d["time"] = i * 0.016;
+		d["event"] = i % 3 == 0 ? "spawn" : "move";
+		d["position"] = build_array(i % 100, i % 37, i % 11);
+		d["label"] = vformat(U"entity \u00e9 %d", i);
+		source.push_back(d);
+	}
+	const String text = JSON::stringify(source, "\t");
+	const Vector<uint8_t> bytes = text.to_utf8_buffer();
+	MESSAGE(vformat("%d bytes of JSON.", bytes.size()));
+
+	uint64_t best_usec[5];
+	for (uint64_t &usec : best_usec) {
+		usec = UINT64_MAX;
+	}
+	for (int i = 0; i < runs; i++) {
+		uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		JSON json;
+		json.parse(String::utf8((const char *)bytes.ptr(), bytes.size()));
+		best_usec[0] = MIN(best_usec[0], OS::get_singleton()->get_ticks_usec() - begin);
+
+		begin = OS::get_singleton()->get_ticks_usec();
+		JSONReader reader;
+		reader.open_buffer(bytes);
+		int events = 0;
+		while (reader.read() == OK) {
+			events++;
+		}
+		best_usec[1] = MIN(best_usec[1], OS::get_singleton()->get_ticks_usec() - begin);
+
+		begin = OS::get_singleton()->get_ticks_usec();
+		reader.open_buffer(bytes);
+		reader.read();
+		Variant value;
+		reader.read_value(value);
+		best_usec[2] = MIN(best_usec[2], OS::get_singleton()->get_ticks_usec() - begin);
+		CHECK(value == json.get_data());
+
+		begin = OS::get_singleton()->get_ticks_usec();
+		JSON::stringify(source, "\t").utf8();
+		best_usec[3] = MIN(best_usec[3], OS::get_singleton()->get_ticks_usec() - begin);
+
+		begin = OS::get_singleton()->get_ticks_usec();
+		Ref<StreamPeerBuffer> peer;
+		peer.instantiate();
+		JSONWriter writer;
+		writer.open_stream(peer);
+		writer.set_indent("\t");
+		writer.write_value(source);
+		writer.flush();
+		best_usec[4] = MIN(best_usec[4], OS::get_singleton()->get_ticks_usec() - begin);
+	}
+
+	MESSAGE(vformat("JSON::parse() from UTF-8: %d usec (best of %d).", best_usec[0], runs));
+	MESSAGE(vformat("JSONReader, events only: %d usec (best of %d).", best_usec[1], runs));
+	MESSAGE(vformat("JSONReader, read_value(): %d usec (best of %d).", best_usec[2], runs));
+	MESSAGE(vformat("JSON::stringify() to UTF-8: %d usec (best of %d).", best_usec[3], runs));
+	MESSAGE(vformat("JSONWriter: %d usec (best of %d).", best_usec[4], runs));
+}
 } // namespace TestJSON
 
 #endif // TEST_JSON_H
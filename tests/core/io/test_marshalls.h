@@ -32,6 +32,7 @@
 #define TEST_MARSHALLS_H
 
 #include "core/io/marshalls.h"
+#include "core/os/os.h"
 
 #include "tests/test_macros.h"
 
@@ -386,6 +387,195 @@ TEST_CASE("[Marshalls] Typed array decoding") {
 	CHECK(array[0] == Variant(uint64_t(0x0f123456789abcdef)));
 }
 
+static Dictionary _make_nested_dictionary(int p_entries) {
+	Dictionary root;
+	for (int i = 0; i < p_entries; i++) {
+		Dictionary entry;
+		entry["name"] = vformat("entry_%d", i);
+		entry[StringName("id")] = i;
+		entry["big"] = int64_t(i) << 40;
+		entry["ratio"] = i / 3.0;
+		entry["position"] = Vector3(i, -i, 0.5);
+		entry["transform"] = Transform3D(Basis(), Vector3(i, 0, 0));
+		entry["color"] = Color(0.25, 0.5, 0.75, 1.0);
+		entry["path"] = NodePath("Root/Child:position");
+
+		PackedByteArray bytes;
+		bytes.resize(i % 7);
+		for (int j = 0; j < bytes.size(); j++) {
+			bytes.write[j] = i + j;
+		}
+		entry["bytes"] = bytes;
+		PackedFloat32Array floats;
+		PackedInt64Array longs;
+		PackedStringArray strings;
+		PackedColorArray colors;
+		for (int j = 0; j < 16; j++) {
+			floats.push_back(j * 0.5);
+			longs.push_back(int64_t(j) << 33);
+			strings.push_back(String("s").repeat(j));
+			colors.push_back(Color(j, 0, 0, 1));
+		}
+		entry["floats"] = floats;
+		entry["longs"] = longs;
+		entry["strings"] = strings;
+		entry["colors"] = colors;
+
+		Array typed;
+		typed.set_typed(Variant::INT, StringName(), Ref<Script>());
+		typed.push_back(i);
+		entry["typed"] = typed;
+		Array untyped;
+		untyped.push_back(Variant());
+		untyped.push_back(true);
+		untyped.push_back(Dictionary());
+		entry["untyped"] = untyped;
+
+		root[i] = entry;
+	}
+	return root;
+}
+
+static Vector<uint8_t> _encode_two_pass(const Variant &p_variant) {
+	int len = 0;
+	Vector<uint8_t> buffer;
+	if (encode_variant(p_variant, nullptr, len) != OK) {
+		return buffer;
+	}
+	buffer.resize(len);
+	encode_variant(p_variant, buffer.ptrw(), len);
+	return buffer;
+}
+
+TEST_CASE("[Marshalls] Single-pass encoding into a growable buffer") {
+	const Variant values[] = {
+		Variant(),
+		42,
+		int64_t(1) << 40,
+		0.5,
+		1.0 / 3.0,
+		"",
+		"odd",
+		String::utf8("été"),
+		StringName("name"),
+		Vector2(1, 2),
+		Projection(),
+		NodePath("a/b:c"),
+		_make_nested_dictionary(3),
+	};
+
+	for (const Variant &value : values) {
+		const Vector<uint8_t> expected = _encode_two_pass(value);
+
+		Vector<uint8_t> buffer;
+		CHECK(encode_variant(value, buffer) == OK);
+		CHECK_MESSAGE(buffer == expected, vformat("Single-pass encoding of a %s should match the two-pass encoding.", Variant::get_type_name(value.get_type())));
+
+		Variant decoded;
+		int r_len = 0;
+		CHECK(decode_variant(decoded, buffer.ptr(), buffer.size(), &r_len) == OK);
+		CHECK(r_len == buffer.size());
+		CHECK(decoded.hash_compare(value));
+	}
+
+	SUBCASE("Appends after existing data") {
+		Vector<uint8_t> buffer;
+		buffer.push_back(0xAB);
+		buffer.push_back(0xCD);
+		CHECK(encode_variant("abc", buffer) == OK);
+		REQUIRE(buffer.size() == 2 + 12);
+		CHECK(buffer[0] == 0xAB);
+		CHECK(buffer[1] == 0xCD);
+		CHECK(buffer.slice(2) == _encode_two_pass("abc"));
+	}
+
+	SUBCASE("Leaves the buffer untouched on error") {
+		Array array;
+		Array inner = array;
+		array.push_back(inner); // Self-referencing.
+
+		Vector<uint8_t> buffer;
+		buffer.push_back(1);
+		ERR_PRINT_OFF;
+		CHECK(encode_variant(array, buffer) == ERR_OUT_OF_MEMORY);
+		ERR_PRINT_ON;
+		CHECK(buffer.size() == 1);
+		array.clear(); // Break the cycle.
+	}
+}
+
+TEST_CASE("[Marshalls] Packed array decoding") {
+	PackedByteArray bytes = { 1, 2, 3, 4, 5 };
+	PackedInt32Array ints = { -1, 0, 0x7fffffff };
+	PackedInt64Array longs = { int64_t(-1) << 40, 7 };
+	PackedFloat32Array floats = { 0.5, -2.25 };
+	PackedFloat64Array doubles = { 1.0 / 3.0, -1e300 };
+	PackedColorArray colors = { Color(0.25, 0.5, 0.75, 1.0), Color(1, 0, 0, 0) };
+	const Variant values[] = { bytes, ints, longs, floats, doubles, colors };
+
+	for (const Variant &value : values) {
+		Vector<uint8_t> buffer;
+		REQUIRE(encode_variant(value, buffer) == OK);
+
+		Variant decoded;
+		int r_len = 0;
+		CHECK(decode_variant(decoded, buffer.ptr(), buffer.size(), &r_len) == OK);
+		CHECK(r_len == buffer.size());
+		CHECK_MESSAGE(decoded == value, vformat("A %s should survive an encoding round trip.", Variant::get_type_name(value.get_type())));
+	}
+
+	// Little-endian on the wire, whatever the host.
+	Variant decoded;
+	const uint8_t int32_buffer[] = {
+		0x1e, 0x00, 0x00, 0x00, // Variant::PACKED_INT32_ARRAY
+		0x02, 0x00, 0x00, 0x00, // Array size.
+		0x01, 0x02, 0x03, 0x04, 0xff, 0xff, 0xff, 0xff, // Elements.
+	};
+	CHECK(decode_variant(decoded, int32_buffer, 16) == OK);
+	CHECK(decoded == Variant(PackedInt32Array({ 0x04030201, -1 })));
+
+	const uint8_t truncated_array_buffer[] = {
+		0x1c, 0x00, 0x00, 0x00, // Variant::ARRAY
+		0xff, 0xff, 0xff, 0x00, // Array size, larger than the data.
+		0x00, 0x00, 0x00, 0x00, // One element.
+	};
+	ERR_PRINT_OFF;
+	CHECK(decode_variant(decoded, truncated_array_buffer, 12) == ERR_INVALID_DATA);
+	ERR_PRINT_ON;
+}
+
+// Not run by default, since timings are only meaningful on an otherwise idle machine.
+// Run with `--test --no-skip --test-case="*[Benchmark]*"`.
+TEST_CASE("[Marshalls][Benchmark] Encoding and decoding large nested dictionaries" * doctest::skip()) {
+	const Dictionary data = _make_nested_dictionary(20000);
+	const int runs = 5;
+
+	uint64_t two_pass_usec = UINT64_MAX;
+	uint64_t single_pass_usec = UINT64_MAX;
+	uint64_t decode_usec = UINT64_MAX;
+	Vector<uint8_t> encoded;
+
+	for (int i = 0; i < runs; i++) {
+		uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		const Vector<uint8_t> expected = _encode_two_pass(data);
+		two_pass_usec = MIN(two_pass_usec, OS::get_singleton()->get_ticks_usec() - begin);
+
+		encoded.clear();
+		begin = OS::get_singleton()->get_ticks_usec();
+		CHECK(encode_variant(data, encoded) == OK);
+		single_pass_usec = MIN(single_pass_usec, OS::get_singleton()->get_ticks_usec() - begin);
+		CHECK(encoded == expected);
+
+		Variant decoded;
+		begin = OS::get_singleton()->get_ticks_usec();
+		CHECK(decode_variant(decoded, encoded.ptr(), encoded.size()) == OK);
+		decode_usec = MIN(decode_usec, OS::get_singleton()->get_ticks_usec() - begin);
+		CHECK(Dictionary(decoded).size() == data.size());
+	}
+
+	MESSAGE(vformat("%d bytes encoded in two passes: %d usec, in a single pass: %d usec, decoded: %d usec (best of %d).", encoded.size(), two_pass_usec, single_pass_usec, decode_usec, runs));
+}
+
 } // namespace TestMarshalls
 
 #endif // TEST_MARSHALLS_H
@@ -166,6 +166,49 @@ TEST_CASE("[Resource] Breaking circular references on save") {
 	// Break circular reference to avoid memory leak
 	resource_c->remove_meta("next");
 }
+
+TEST_CASE("[Resource] Threaded loading of external dependencies") {
+	const int dependency_count = 16;
+	const String save_path = OS::get_singleton()->get_cache_path().path_join("resource_with_dependencies.res");
+
+	{
+		Ref<Resource> resource = memnew(Resource);
+		for (int i = 0; i < dependency_count; i++) {
+			// Each dependency has one of its own, so nested loads queue up past the high priority ones.
+			Ref<Resource> nested_dependency = memnew(Resource);
+			nested_dependency->set_name(vformat("Nested dependency %d", i));
+			REQUIRE(ResourceSaver::save(nested_dependency, OS::get_singleton()->get_cache_path().path_join(vformat("resource_nested_dependency_%d.res", i)), ResourceSaver::FLAG_CHANGE_PATH) == OK);
+
+			Ref<Resource> dependency = memnew(Resource);
+			dependency->set_name(vformat("Dependency %d", i));
+			dependency->set_meta("dependency", nested_dependency);
+			const String dependency_path = OS::get_singleton()->get_cache_path().path_join(vformat("resource_dependency_%d.res", i));
+			// Saved on their own first, so the resource refers to them as external resources.
+			REQUIRE(ResourceSaver::save(dependency, dependency_path, ResourceSaver::FLAG_CHANGE_PATH) == OK);
+			resource->set_meta(vformat("dependency_%d", i), dependency);
+		}
+		REQUIRE(ResourceSaver::save(resource, save_path) == OK);
+	}
+
+	List<String> dependencies;
+	ResourceLoader::get_dependencies(save_path, &dependencies);
+	CHECK(dependencies.size() == dependency_count);
+
+	REQUIRE(ResourceLoader::load_threaded_request(save_path, "", true) == OK);
+	Error error = FAILED;
+	const Ref<Resource> loaded = ResourceLoader::load_threaded_get(save_path, &error);
+	REQUIRE(error == OK);
+	REQUIRE(loaded.is_valid());
+
+	for (int i = 0; i < dependency_count; i++) {
+		const Ref<Resource> dependency = loaded->get_meta(vformat("dependency_%d", i));
+		REQUIRE(dependency.is_valid());
+		CHECK(dependency->get_name() == vformat("Dependency %d", i));
+		const Ref<Resource> nested_dependency = dependency->get_meta("dependency");
+		REQUIRE(nested_dependency.is_valid());
+		CHECK(nested_dependency->get_name() == vformat("Nested dependency %d", i));
+	}
+}
 } // namespace TestResource
 
 #endif // TEST_RESOURCE_H
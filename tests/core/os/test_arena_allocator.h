@@ -0,0 +1,113 @@
+/**************************************************************************/
+/*  test_arena_allocator.h                                                */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_ARENA_ALLOCATOR_H
+#define TEST_ARENA_ALLOCATOR_H
+
+#include "core/os/arena_allocator.h"
+
+#include "tests/test_macros.h"
+
+namespace TestArenaAllocator {
+
+TEST_CASE("[ArenaAllocator] Allocation and alignment") {
+	ArenaAllocator arena(256);
+
+	uint8_t *bytes = arena.alloc_array<uint8_t>(3);
+	double *doubles = arena.alloc_array<double>(4);
+	void *aligned = arena.alloc(16, 64);
+
+	CHECK(bytes != nullptr);
+	CHECK_MESSAGE((uintptr_t)doubles % alignof(double) == 0, "Allocations should be aligned for their type.");
+	CHECK_MESSAGE((uintptr_t)aligned % 64 == 0, "Allocations should honor alignments stricter than max_align_t.");
+
+	for (int i = 0; i < 4; i++) {
+		doubles[i] = i;
+	}
+	bytes[0] = bytes[1] = bytes[2] = 0xFF;
+	CHECK_MESSAGE(doubles[0] == 0.0, "Allocations should not overlap.");
+	CHECK(doubles[3] == 3.0);
+
+	uint32_t *large = arena.alloc_array<uint32_t>(1000);
+	large[999] = 42;
+	CHECK_MESSAGE(arena.get_capacity() >= 256 + 4000, "Allocations larger than a chunk should get a chunk of their own.");
+	CHECK(large[999] == 42);
+	CHECK(doubles[3] == 3.0);
+}
+
+TEST_CASE("[ArenaAllocator] Reset and scopes reuse memory") {
+	ArenaAllocator arena(1024);
+
+	void *first = arena.alloc(100);
+	arena.alloc(2000);
+	const size_t capacity = arena.get_capacity();
+	CHECK(arena.get_used() > 2000);
+
+	arena.reset();
+	CHECK(arena.get_used() == 0);
+	CHECK_MESSAGE(arena.alloc(100) == first, "Memory should be reused after a reset.");
+	arena.alloc(2000);
+	CHECK_MESSAGE(arena.get_capacity() == capacity, "Chunks should be kept and reused after a reset.");
+
+	arena.reset();
+	arena.alloc(100);
+	const size_t used = arena.get_used();
+	void *inside = nullptr;
+	{
+		ArenaScope scope(arena);
+		inside = arena.alloc(500);
+		arena.alloc(3000);
+		CHECK(arena.get_used() > used + 3000);
+	}
+	CHECK_MESSAGE(arena.get_used() == used, "Leaving a scope should free what was allocated in it.");
+	CHECK(arena.alloc(500) == inside);
+
+	arena.clear();
+	CHECK(arena.get_capacity() == 0);
+	CHECK(arena.get_used() == 0);
+}
+
+TEST_CASE("[ArenaAllocator] Thread scratch arena") {
+	ArenaAllocator &scratch = ArenaAllocator::get_thread_scratch();
+	CHECK_MESSAGE(&scratch == &ArenaAllocator::get_thread_scratch(), "Each thread should always get the same scratch arena.");
+
+	const size_t used = scratch.get_used();
+	{
+		ArenaScope scope(scratch);
+		int *values = scratch.alloc_array<int>(16);
+		values[15] = 1;
+		CHECK(scratch.get_used() >= used + 16 * sizeof(int));
+	}
+	CHECK(scratch.get_used() == used);
+}
+
+} // namespace TestArenaAllocator
+
+#endif // TEST_ARENA_ALLOCATOR_H
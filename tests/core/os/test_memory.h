@@ -0,0 +1,70 @@
+/**************************************************************************/
+/*  test_memory.h                                                         */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_MEMORY_H
+#define TEST_MEMORY_H
+
+#include "core/os/memory.h"
+
+#include "tests/test_macros.h"
+
+namespace TestMemory {
+
+#ifdef DEBUG_ENABLED
+// The navigation tag is used, since navigation is only processed on the main thread, when a test asks for it.
+TEST_CASE("[Memory] Allocations are attributed to the tag they were made with") {
+	const uint64_t navigation_before = Memory::get_mem_usage_by_tag(Memory::TAG_NAVIGATION);
+
+	void *mem = nullptr;
+	{
+		MemoryTagScope tag_scope(Memory::TAG_NAVIGATION);
+		mem = memalloc(1000);
+		{
+			MemoryTagScope nested_tag_scope(Memory::TAG_GENERAL);
+			void *other = memalloc(500);
+			CHECK_MESSAGE(Memory::get_mem_usage_by_tag(Memory::TAG_NAVIGATION) == navigation_before + 1000, "Nested scopes should take over the tag.");
+			memfree(other);
+		}
+	}
+	CHECK(Memory::get_mem_usage_by_tag(Memory::TAG_NAVIGATION) == navigation_before + 1000);
+
+	mem = memrealloc(mem, 3000);
+	CHECK_MESSAGE(Memory::get_mem_usage_by_tag(Memory::TAG_NAVIGATION) == navigation_before + 3000, "Reallocations should keep the original tag.");
+	mem = memrealloc(mem, 200);
+	CHECK(Memory::get_mem_usage_by_tag(Memory::TAG_NAVIGATION) == navigation_before + 200);
+
+	memfree(mem);
+	CHECK_MESSAGE(Memory::get_mem_usage_by_tag(Memory::TAG_NAVIGATION) == navigation_before, "Freeing should give the memory back to the original tag.");
+}
+#endif // DEBUG_ENABLED
+
+} // namespace TestMemory
+
+#endif // TEST_MEMORY_H
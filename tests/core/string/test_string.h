@@ -31,6 +31,7 @@
 #ifndef TEST_STRING_H
 #define TEST_STRING_H
 
+#include "core/os/os.h"
 #include "core/string/ustring.h"
 
 #include "tests/test_macros.h"
@@ -166,6 +167,39 @@ TEST_CASE("[String] UTF8 with CR") {
 	CHECK(no_cr == base.replace("\r", ""));
 }
 
+TEST_CASE("[String] UTF8 with long ASCII runs") {
+	// The ASCII fast paths work on whole vectors, so put other characters at every offset within and around them.
+	for (int offset = 0; offset < 40; offset++) {
+		String expected;
+		for (int i = 0; i < 100; i++) {
+			if (i == offset || i == offset + 17 || i == 99 - offset) {
+				expected += i % 2 ? U"\u00e9" : U"\U0001f3a4";
+			} else {
+				expected += String::chr('a' + (i % 26));
+			}
+		}
+
+		const CharString utf8 = expected.utf8();
+		String decoded;
+		CHECK(decoded.parse_utf8(utf8.get_data()) == OK);
+		CHECK(decoded == expected);
+		CHECK(String::utf8(utf8.get_data(), utf8.length()) == expected);
+		CHECK(decoded.utf8() == utf8);
+
+		// Carriage returns end an ASCII run when they're skipped.
+		const String with_cr = expected.insert(offset, "\r");
+		String no_cr;
+		CHECK(no_cr.parse_utf8(with_cr.utf8().get_data(), -1, true) == OK);
+		CHECK(no_cr == expected);
+	}
+
+	// Decoding stops at the first NUL, even past a known length.
+	static const char with_nul[] = "abcdefghijklmnopqrstuvwxyz\0abcdefghijklmnopqrstuvwxyz";
+	String s;
+	CHECK(s.parse_utf8(with_nul, sizeof(with_nul) - 1) == OK);
+	CHECK(s == "abcdefghijklmnopqrstuvwxyz");
+}
+
 TEST_CASE("[String] Invalid UTF8 (non-standard)") {
 	ERR_PRINT_OFF
 	static const uint8_t u8str[] = { 0x45, 0xE3, 0x81, 0x8A, 0xE3, 0x82, 0x88, 0xE3, 0x81, 0x86, 0xF0, 0x9F, 0x8E, 0xA4, 0xF0, 0x82, 0x82, 0xAC, 0xED, 0xA0, 0x81, 0 };
@@ -366,6 +400,27 @@ TEST_CASE("[String] Find") {
 	CHECK(s.rfind("man") == 15);
 }
 
+TEST_CASE("[String] Find in long strings") {
+	const String haystack = String("abcdefghij").repeat(10) + U"\u00e9xyz" + String("abcdefghij").repeat(3);
+	CHECK(haystack.find("xyz") == 101);
+	CHECK(haystack.find(U"\u00e9x") == 100);
+	CHECK(haystack.find("jab", 95) == 113);
+	CHECK(haystack.find("abcdefghijx") == -1);
+	CHECK(haystack.find("j", 0) == 9);
+	CHECK(haystack.find("z", 60) == 103);
+	CHECK(haystack.find("", 5) == 5);
+	CHECK(haystack.find_char('x') == 101);
+	CHECK(haystack.find_char(U'\u00e9', 101) == -1);
+	CHECK(haystack.find_char('a', 131) == -1);
+
+	// Many partial matches of the first character.
+	const String repeated = String("a").repeat(200) + "ab";
+	CHECK(repeated.find("ab") == 200);
+	CHECK(repeated.find(String("a").repeat(50) + "b") == 151);
+	CHECK(repeated.replace("a", "") == "b");
+	CHECK(repeated.split("a", false).size() == 1);
+}
+
 TEST_CASE("[String] Find no case") {
 	String s = "Pretty Whale Whale";
 	CHECK(s.findn("WHA") == 7);
@@ -1382,6 +1437,19 @@ TEST_CASE("[String] Checking case conversion methods") {
 	}
 }
 
+TEST_CASE("[String] Case conversion of long strings") {
+	const String mixed = String("Hello World, ").repeat(5) + U"\u0100\u0416 ABC xyz" + String(" The Quick Brown Fox").repeat(3);
+	const String lower = String("hello world, ").repeat(5) + U"\u0101\u0436 abc xyz" + String(" the quick brown fox").repeat(3);
+	const String upper = String("HELLO WORLD, ").repeat(5) + U"\u0100\u0416 ABC XYZ" + String(" THE QUICK BROWN FOX").repeat(3);
+	CHECK(mixed.to_lower() == lower);
+	CHECK(mixed.to_upper() == upper);
+	CHECK(lower.to_lower() == lower);
+	CHECK(upper.to_upper() == upper);
+	// Characters just outside the letter ranges.
+	CHECK(String("@[`{@[`{@[`{@[`{").to_lower() == "@[`{@[`{@[`{@[`{");
+	CHECK(String("@[`{@[`{@[`{@[`{").to_upper() == "@[`{@[`{@[`{@[`{");
+}
+
 TEST_CASE("[String] Checking string is empty when it should be") {
 	bool state = true;
 	bool success;
@@ -1896,6 +1964,44 @@ TEST_CASE("[String] Variant ptr indexed set") {
 	CHECK_EQ(s, String("azcd"));
 }
 
+// Not run by default, since timings are only meaningful on an otherwise idle machine.
+// Run with `--test --no-skip --test-case="*[Benchmark]*"`.
+TEST_CASE("[String][Benchmark] Transcoding, search and case conversion" * doctest::skip()) {
+	const int runs = 5;
+
+	// JSON-like text, mostly ASCII with some accented and CJK characters.
+	String text;
+	for (int i = 0; i < 20000; i++) {
+		text += vformat(U"{\"id\": %d, \"name\": \"Item_%d\", \"label\": \"Caf\u00e9 \u6f22\u5b57\", \"value\": %d}\n", i, i, i * 7);
+	}
+	const CharString utf8 = text.utf8();
+
+	struct Workload {
+		const char *name;
+		void (*func)(const String &, const CharString &);
+	};
+	static const Workload workloads[] = {
+		{ "parse_utf8", [](const String &, const CharString &p_utf8) { String().parse_utf8(p_utf8.get_data(), p_utf8.length()); } },
+		{ "utf8", [](const String &p_text, const CharString &) { p_text.utf8(); } },
+		{ "find", [](const String &p_text, const CharString &) { p_text.find("\"id\": 19999"); } },
+		{ "find_char", [](const String &p_text, const CharString &) { p_text.find_char('#'); } },
+		{ "split", [](const String &p_text, const CharString &) { p_text.split("\n"); } },
+		{ "replace", [](const String &p_text, const CharString &) { p_text.replace("Item", "Entry"); } },
+		{ "to_lower", [](const String &p_text, const CharString &) { p_text.to_lower(); } },
+	};
+
+	MESSAGE(vformat("%d characters, %d UTF-8 bytes.", text.length(), utf8.length()));
+	for (const Workload &workload : workloads) {
+		uint64_t best_usec = UINT64_MAX;
+		for (int i = 0; i < runs; i++) {
+			const uint64_t begin = OS::get_singleton()->get_ticks_usec();
+			workload.func(text, utf8);
+			best_usec = MIN(best_usec, OS::get_singleton()->get_ticks_usec() - begin);
+		}
+		MESSAGE(vformat("%s: %d usec (best of %d).", workload.name, best_usec, runs));
+	}
+}
+
 TEST_CASE("[Stress][String] Empty via ' == String()'") {
 	for (int i = 0; i < 100000; ++i) {
 		String str = "Hello World!";
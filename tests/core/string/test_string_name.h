@@ -0,0 +1,168 @@
+/**************************************************************************/
+/*  test_string_name.h                                                    */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_STRING_NAME_H
+#define TEST_STRING_NAME_H
+
+#include "core/os/os.h"
+#include "core/os/thread.h"
+#include "core/string/string_name.h"
+
+#include "tests/test_macros.h"
+
+namespace TestStringName {
+
+TEST_CASE("[StringName] Interning") {
+	const StringName from_cstring = StringName("test_string_name_interning");
+	const StringName from_string = StringName(String("test_string_name_interning"));
+	const StringName from_static = SNAME("test_string_name_interning");
+
+	CHECK_MESSAGE(from_cstring.data_unique_pointer() == from_string.data_unique_pointer(), "Equal names should share their data.");
+	CHECK_MESSAGE(from_cstring.data_unique_pointer() == from_static.data_unique_pointer(), "Equal names should share their data.");
+	CHECK(StringName::search("test_string_name_interning") == from_cstring);
+	CHECK(StringName::search(String("test_string_name_interning")) == from_cstring);
+
+	CHECK_MESSAGE(StringName::search("test_string_name_not_interned") == StringName(), "Names nobody holds should not be found.");
+	{
+		const StringName temporary = StringName("test_string_name_temporary");
+		CHECK(StringName::search("test_string_name_temporary") == temporary);
+	}
+	CHECK_MESSAGE(StringName::search("test_string_name_temporary") == StringName(), "Names should be removed when their last reference is dropped.");
+}
+
+#ifdef THREADS_ENABLED
+struct StringNameThreadData {
+	const Vector<String> *names = nullptr;
+	int iterations = 0;
+	// Filled by the thread with the data pointer of every name it interned last.
+	Vector<const void *> pointers;
+};
+
+static void string_name_thread_func(void *p_userdata) {
+	StringNameThreadData *data = static_cast<StringNameThreadData *>(p_userdata);
+	const Vector<String> &names = *data->names;
+	data->pointers.resize(names.size());
+
+	for (int i = 0; i < data->iterations; i++) {
+		for (int j = 0; j < names.size(); j++) {
+			// Dropped right away, so most iterations insert into and remove from the table.
+			const StringName name = StringName(names[j]);
+			data->pointers.write[j] = name.data_unique_pointer();
+		}
+	}
+}
+
+TEST_CASE("[StringName] Concurrent interning") {
+	Vector<String> names;
+	Vector<StringName> held;
+	for (int i = 0; i < 64; i++) {
+		names.push_back(vformat("test_string_name_concurrent_%d", i));
+		// Keep every other name alive so both lookups and insertions race.
+		if (i % 2 == 0) {
+			held.push_back(StringName(names[i]));
+		}
+	}
+
+	const int thread_count = 8;
+	Thread threads[thread_count];
+	StringNameThreadData data[thread_count];
+	for (int i = 0; i < thread_count; i++) {
+		data[i].names = &names;
+		data[i].iterations = 200;
+		threads[i].start(string_name_thread_func, &data[i]);
+	}
+	for (int i = 0; i < thread_count; i++) {
+		threads[i].wait_to_finish();
+	}
+
+	for (int i = 0; i < held.size(); i++) {
+		for (int j = 0; j < thread_count; j++) {
+			CHECK_MESSAGE(data[j].pointers[i * 2] == held[i].data_unique_pointer(), "Every thread should have found the name that was kept alive.");
+		}
+	}
+	for (int i = 0; i < names.size(); i++) {
+		if (i % 2 == 1) {
+			CHECK_MESSAGE(StringName::search(names[i]) == StringName(), "Names dropped by every thread should be gone from the table.");
+		}
+	}
+}
+
+// Not run by default, since timings are only meaningful on an otherwise idle machine.
+// Run with `--test --no-skip --test-case="*[Benchmark]*"`.
+TEST_CASE("[StringName][Benchmark] Concurrent interning scaling" * doctest::skip()) {
+	const int runs = 3;
+	const int iterations = 2000;
+	const int max_threads = MAX(OS::get_singleton()->get_processor_count(), 1);
+
+	// Each thread works on its own names, like loaders and scene instancing on separate threads do.
+	Vector<Vector<String>> names;
+	names.resize(max_threads);
+	for (int i = 0; i < max_threads; i++) {
+		for (int j = 0; j < 128; j++) {
+			names.write[i].push_back(vformat("benchmark_%d_%d", i, j));
+		}
+	}
+
+	double single_thread_rate = 0.0;
+	for (int thread_count = 1; thread_count <= max_threads; thread_count *= 2) {
+		uint64_t best_usec = UINT64_MAX;
+		for (int run = 0; run < runs; run++) {
+			Vector<Thread *> threads;
+			Vector<StringNameThreadData> data;
+			data.resize(thread_count);
+			for (int i = 0; i < thread_count; i++) {
+				data.write[i].names = &names[i];
+				data.write[i].iterations = iterations;
+			}
+
+			const uint64_t begin = OS::get_singleton()->get_ticks_usec();
+			for (int i = 0; i < thread_count; i++) {
+				threads.push_back(memnew(Thread));
+				threads[i]->start(string_name_thread_func, &data.write[i]);
+			}
+			for (int i = 0; i < thread_count; i++) {
+				threads[i]->wait_to_finish();
+				memdelete(threads[i]);
+			}
+			best_usec = MIN(best_usec, OS::get_singleton()->get_ticks_usec() - begin);
+		}
+
+		const double rate = double(thread_count) * iterations * 128 / MAX(best_usec, (uint64_t)1);
+		if (thread_count == 1) {
+			single_thread_rate = rate;
+		}
+		MESSAGE(vformat("%d thread(s): %d usec (best of %d), %.1f names/usec, %.2fx the single thread rate.", thread_count, best_usec, runs, rate, rate / single_thread_rate));
+	}
+}
+#endif // THREADS_ENABLED
+
+} // namespace TestStringName
+
+#endif // TEST_STRING_NAME_H
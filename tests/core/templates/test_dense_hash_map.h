@@ -0,0 +1,340 @@
+/**************************************************************************/
+/*  test_dense_hash_map.h                                                 */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_DENSE_HASH_MAP_H
+#define TEST_DENSE_HASH_MAP_H
+
+#include "core/os/os.h"
+#include "core/templates/dense_hash_map.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/oa_hash_map.h"
+
+#include "tests/test_macros.h"
+
+namespace TestDenseHashMap {
+
+TEST_CASE("[DenseHashMap] Insert element") {
+	DenseHashMap<int, int> map;
+	DenseHashMap<int, int>::Iterator e = map.insert(42, 84);
+
+	CHECK(e);
+	CHECK(e->key == 42);
+	CHECK(e->value == 84);
+	CHECK(map[42] == 84);
+	CHECK(map.has(42));
+	CHECK(map.find(42));
+}
+
+TEST_CASE("[DenseHashMap] Overwrite element") {
+	DenseHashMap<int, int> map;
+	map.insert(42, 84);
+	map.insert(42, 1234);
+
+	CHECK(map[42] == 1234);
+	CHECK(map.size() == 1);
+}
+
+TEST_CASE("[DenseHashMap] Erase via element") {
+	DenseHashMap<int, int> map;
+	DenseHashMap<int, int>::Iterator e = map.insert(42, 84);
+	map.remove(e);
+	CHECK(!map.has(42));
+	CHECK(!map.find(42));
+}
+
+TEST_CASE("[DenseHashMap] Erase via key") {
+	DenseHashMap<int, int> map;
+	map.insert(42, 84);
+	map.erase(42);
+	CHECK(!map.has(42));
+	CHECK(!map.find(42));
+}
+
+TEST_CASE("[DenseHashMap] Erase moves the last element into the hole") {
+	DenseHashMap<int, int> map;
+	map.insert(1, 10);
+	map.insert(2, 20);
+	map.insert(3, 30);
+	map.insert(4, 40);
+	CHECK(map.erase(2));
+	CHECK_FALSE(map.erase(2));
+
+	Vector<int> expected = { 1, 4, 3 };
+	int idx = 0;
+	for (const KeyValue<int, int> &E : map) {
+		CHECK(E.key == expected[idx]);
+		CHECK(E.value == expected[idx] * 10);
+		++idx;
+	}
+	CHECK(idx == 3);
+	CHECK(map[4] == 40);
+}
+
+TEST_CASE("[DenseHashMap] Size") {
+	DenseHashMap<int, int> map;
+	map.insert(42, 84);
+	map.insert(123, 84);
+	map.insert(123, 84);
+	map.insert(0, 84);
+	map.insert(123485, 84);
+
+	CHECK(map.size() == 4);
+}
+
+TEST_CASE("[DenseHashMap] Iteration") {
+	DenseHashMap<int, int> map;
+	map.insert(42, 84);
+	map.insert(123, 12385);
+	map.insert(0, 12934);
+	map.insert(123485, 1238888);
+	map.insert(123, 111111);
+
+	Vector<Pair<int, int>> expected;
+	expected.push_back(Pair<int, int>(42, 84));
+	expected.push_back(Pair<int, int>(123, 111111));
+	expected.push_back(Pair<int, int>(0, 12934));
+	expected.push_back(Pair<int, int>(123485, 1238888));
+
+	int idx = 0;
+	for (const KeyValue<int, int> &E : map) {
+		CHECK(expected[idx] == Pair<int, int>(E.key, E.value));
+		++idx;
+	}
+	CHECK(idx == expected.size());
+
+	for (DenseHashMap<int, int>::Iterator it = map.last(); it; --it) {
+		--idx;
+		CHECK(expected[idx] == Pair<int, int>(it->key, it->value));
+	}
+	CHECK(idx == 0);
+}
+
+TEST_CASE("[DenseHashMap] Const iteration") {
+	DenseHashMap<int, int> map;
+	map.insert(42, 84);
+	map.insert(123, 12385);
+	map.insert(0, 12934);
+	map.insert(123485, 1238888);
+	map.insert(123, 111111);
+
+	const DenseHashMap<int, int> const_map = map;
+
+	Vector<Pair<int, int>> expected;
+	expected.push_back(Pair<int, int>(42, 84));
+	expected.push_back(Pair<int, int>(123, 111111));
+	expected.push_back(Pair<int, int>(0, 12934));
+	expected.push_back(Pair<int, int>(123485, 1238888));
+
+	int idx = 0;
+	for (const KeyValue<int, int> &E : const_map) {
+		CHECK(expected[idx] == Pair<int, int>(E.key, E.value));
+		++idx;
+	}
+	CHECK(idx == expected.size());
+}
+
+TEST_CASE("[DenseHashMap] Replace key") {
+	DenseHashMap<String, int> map;
+	map.insert("a", 1);
+	map.insert("b", 2);
+	CHECK(map.replace_key("a", "c"));
+	CHECK_FALSE(map.has("a"));
+	CHECK(map["c"] == 1);
+	CHECK(map.begin()->key == "c");
+}
+
+TEST_CASE("[DenseHashMap] Reserve and bulk insert") {
+	DenseHashMap<int, int> map;
+	map.reserve(1000);
+	const uint32_t capacity = map.get_capacity();
+
+	HashMap<int, int> entries;
+	for (int i = 0; i < 1000; i++) {
+		entries.insert(i, i * 2);
+	}
+	map.insert_all(entries);
+	CHECK_MESSAGE(map.get_capacity() == capacity, "Inserting what was reserved should not grow the map.");
+	CHECK(map.size() == 1000);
+
+	for (int i = 0; i < 1000; i += 2) {
+		map.erase(i);
+	}
+	for (int i = 0; i < 1000; i++) {
+		if (i % 2 == 0) {
+			CHECK_FALSE(map.has(i));
+		} else {
+			CHECK(map[i] == i * 2);
+		}
+	}
+
+	map.clear();
+	CHECK(map.is_empty());
+	CHECK_FALSE(map.begin());
+	map.insert_new(7, 14);
+	CHECK(map[7] == 14);
+}
+
+TEST_CASE("[DenseHashMap] Insert elements of the map itself when it grows") {
+	DenseHashMap<String, String> map;
+	map.insert("key_0", "value_0");
+	const uint32_t capacity = map.get_capacity();
+	const uint32_t element_capacity = DenseHashMap<String, String>::MAX_OCCUPANCY * capacity;
+	for (uint32_t i = 1; i < element_capacity; i++) {
+		map.insert(vformat("key_%d", i), vformat("value_%d", i));
+	}
+	REQUIRE(map.get_capacity() == capacity);
+
+	// The key and value are references into the elements, which the insertion reallocates.
+	map.insert(map["key_0"], map["key_1"]);
+	CHECK(map.get_capacity() > capacity);
+	CHECK(map.size() == element_capacity + 1);
+	CHECK(map["value_0"] == "value_1");
+
+	map.clear();
+	map.insert("key_0", "value_0");
+	for (uint32_t i = 1; i < element_capacity; i++) {
+		map.insert(vformat("key_%d", i), vformat("value_%d", i));
+	}
+	REQUIRE(map.get_capacity() == capacity);
+
+	// Same through operator[], which inserts a default value.
+	map[map.begin()->value] = "inserted";
+	CHECK(map.size() == element_capacity + 1);
+	CHECK(map["value_0"] == "inserted");
+}
+
+// Not run by default, since timings are only meaningful on an otherwise idle machine.
+// Run with `--test --no-skip --test-case="*[Benchmark]*"`.
+TEST_CASE("[DenseHashMap][Benchmark] Against HashMap and OAHashMap" * doctest::skip()) {
+	const int runs = 5;
+	const int count = 200000;
+
+	Vector<uint32_t> keys;
+	for (int i = 0; i < count; i++) {
+		keys.push_back(hash_murmur3_one_32(i));
+	}
+
+	uint64_t insert_usec[3] = { UINT64_MAX, UINT64_MAX, UINT64_MAX };
+	uint64_t lookup_usec[3] = { UINT64_MAX, UINT64_MAX, UINT64_MAX };
+	uint64_t iterate_usec[3] = { UINT64_MAX, UINT64_MAX, UINT64_MAX };
+	uint64_t erase_usec[3] = { UINT64_MAX, UINT64_MAX, UINT64_MAX };
+	uint64_t sums[3] = { 0, 0, 0 };
+
+	for (int run = 0; run < runs; run++) {
+		DenseHashMap<uint32_t, uint32_t> dense;
+		HashMap<uint32_t, uint32_t> hash_map;
+		OAHashMap<uint32_t, uint32_t> oa_map;
+		sums[0] = sums[1] = sums[2] = 0;
+
+		uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		for (int i = 0; i < count; i++) {
+			dense.insert(keys[i], i);
+		}
+		insert_usec[0] = MIN(insert_usec[0], OS::get_singleton()->get_ticks_usec() - begin);
+
+		begin = OS::get_singleton()->get_ticks_usec();
+		for (int i = 0; i < count; i++) {
+			hash_map.insert(keys[i], i);
+		}
+		insert_usec[1] = MIN(insert_usec[1], OS::get_singleton()->get_ticks_usec() - begin);
+
+		begin = OS::get_singleton()->get_ticks_usec();
+		for (int i = 0; i < count; i++) {
+			oa_map.insert(keys[i], i);
+		}
+		insert_usec[2] = MIN(insert_usec[2], OS::get_singleton()->get_ticks_usec() - begin);
+
+		begin = OS::get_singleton()->get_ticks_usec();
+		for (int i = 0; i < count; i++) {
+			sums[0] += *dense.getptr(keys[i]);
+		}
+		lookup_usec[0] = MIN(lookup_usec[0], OS::get_singleton()->get_ticks_usec() - begin);
+
+		begin = OS::get_singleton()->get_ticks_usec();
+		for (int i = 0; i < count; i++) {
+			sums[1] += *hash_map.getptr(keys[i]);
+		}
+		lookup_usec[1] = MIN(lookup_usec[1], OS::get_singleton()->get_ticks_usec() - begin);
+
+		begin = OS::get_singleton()->get_ticks_usec();
+		for (int i = 0; i < count; i++) {
+			sums[2] += *oa_map.lookup_ptr(keys[i]);
+		}
+		lookup_usec[2] = MIN(lookup_usec[2], OS::get_singleton()->get_ticks_usec() - begin);
+
+		begin = OS::get_singleton()->get_ticks_usec();
+		for (const KeyValue<uint32_t, uint32_t> &E : dense) {
+			sums[0] += E.value;
+		}
+		iterate_usec[0] = MIN(iterate_usec[0], OS::get_singleton()->get_ticks_usec() - begin);
+
+		begin = OS::get_singleton()->get_ticks_usec();
+		for (const KeyValue<uint32_t, uint32_t> &E : hash_map) {
+			sums[1] += E.value;
+		}
+		iterate_usec[1] = MIN(iterate_usec[1], OS::get_singleton()->get_ticks_usec() - begin);
+
+		begin = OS::get_singleton()->get_ticks_usec();
+		for (OAHashMap<uint32_t, uint32_t>::Iterator it = oa_map.iter(); it.valid; it = oa_map.next_iter(it)) {
+			sums[2] += *it.value;
+		}
+		iterate_usec[2] = MIN(iterate_usec[2], OS::get_singleton()->get_ticks_usec() - begin);
+
+		begin = OS::get_singleton()->get_ticks_usec();
+		for (int i = 0; i < count; i += 2) {
+			dense.erase(keys[i]);
+		}
+		erase_usec[0] = MIN(erase_usec[0], OS::get_singleton()->get_ticks_usec() - begin);
+
+		begin = OS::get_singleton()->get_ticks_usec();
+		for (int i = 0; i < count; i += 2) {
+			hash_map.erase(keys[i]);
+		}
+		erase_usec[1] = MIN(erase_usec[1], OS::get_singleton()->get_ticks_usec() - begin);
+
+		begin = OS::get_singleton()->get_ticks_usec();
+		for (int i = 0; i < count; i += 2) {
+			oa_map.remove(keys[i]);
+		}
+		erase_usec[2] = MIN(erase_usec[2], OS::get_singleton()->get_ticks_usec() - begin);
+	}
+
+	CHECK(sums[0] == sums[1]);
+	CHECK(sums[0] == sums[2]);
+
+	const char *names[3] = { "DenseHashMap", "HashMap", "OAHashMap" };
+	for (int i = 0; i < 3; i++) {
+		MESSAGE(vformat("%s, %d keys (best of %d): insert %d usec, lookup %d usec, iterate %d usec, erase half %d usec.", names[i], count, runs, insert_usec[i], lookup_usec[i], iterate_usec[i], erase_usec[i]));
+	}
+}
+
+} // namespace TestDenseHashMap
+
+#endif // TEST_DENSE_HASH_MAP_H
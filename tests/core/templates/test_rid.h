@@ -31,7 +31,9 @@
 #ifndef TEST_RID_H
 #define TEST_RID_H
 
+#include "core/os/thread.h"
 #include "core/templates/rid.h"
+#include "core/templates/rid_owner.h"
 
 #include "tests/test_macros.h"
 
@@ -96,6 +98,125 @@ TEST_CASE("[RID] 'get_local_index'") {
 	CHECK(RID::from_uint64(4'294'967'295).get_local_index() == 4'294'967'295);
 	CHECK(RID::from_uint64(4'294'967'297).get_local_index() == 1);
 }
+
+TEST_CASE("[RID_Owner] Allocation, lookup and free") {
+	// A tiny chunk size, so a handful of RIDs already spans several chunks.
+	RID_Owner<uint64_t> owner(32);
+	Vector<RID> rids;
+	for (uint64_t i = 0; i < 100; i++) {
+		rids.push_back(owner.make_rid(i * 3));
+	}
+	CHECK(owner.get_rid_count() == 100);
+
+	for (int i = 0; i < rids.size(); i++) {
+		uint64_t *value = owner.get_or_null(rids[i]);
+		REQUIRE(value != nullptr);
+		CHECK(*value == uint64_t(i) * 3);
+		CHECK(owner.owns(rids[i]));
+	}
+
+	for (int i = 0; i < rids.size(); i += 2) {
+		owner.free(rids[i]);
+	}
+	CHECK(owner.get_rid_count() == 50);
+	for (int i = 0; i < rids.size(); i++) {
+		CHECK_MESSAGE(owner.owns(rids[i]) == (i % 2 == 1), "Only the RIDs that weren't freed should still be owned.");
+		CHECK((owner.get_or_null(rids[i]) != nullptr) == (i % 2 == 1));
+	}
+
+	// Freed slots are reused, but with new validators.
+	const RID reused = owner.make_rid(7);
+	CHECK(reused.get_local_index() == rids[98].get_local_index());
+	CHECK(reused != rids[98]);
+	CHECK(*owner.get_or_null(reused) == 7);
+	CHECK(owner.get_or_null(rids[98]) == nullptr);
+
+	List<RID> owned;
+	owner.get_owned_list(&owned);
+	CHECK(owned.size() == 51);
+	for (const RID &rid : owned) {
+		owner.free(rid);
+	}
+	CHECK(owner.get_rid_count() == 0);
+}
+
+#ifdef THREADS_ENABLED
+struct RIDOwnerThreadData {
+	RID_Owner<uint64_t, true> *owner = nullptr;
+	const Vector<RID> *shared = nullptr;
+	uint64_t thread_index = 0;
+	int iterations = 0;
+	int failures = 0;
+};
+
+static void rid_owner_thread_func(void *p_userdata) {
+	RIDOwnerThreadData *data = static_cast<RIDOwnerThreadData *>(p_userdata);
+	RID_Owner<uint64_t, true> &owner = *data->owner;
+	const Vector<RID> &shared = *data->shared;
+	RID own[16];
+
+	for (int i = 0; i < data->iterations; i++) {
+		// Each thread keeps a few of its own RIDs alive, so allocating keeps growing the owner's chunks while
+		// every thread is looking up the shared ones.
+		const uint64_t value = (data->thread_index << 32) | uint64_t(i);
+		RID &slot = own[i % 16];
+		if (slot.is_valid()) {
+			const uint64_t *previous = owner.get_or_null(slot);
+			if (!previous || (*previous >> 32) != data->thread_index) {
+				data->failures++;
+			}
+			owner.free(slot);
+			if (owner.owns(slot) || owner.get_or_null(slot)) {
+				data->failures++;
+			}
+		}
+		slot = owner.make_rid(value);
+
+		const RID &other = shared[i % shared.size()];
+		const uint64_t *shared_value = owner.get_or_null(other);
+		if (!shared_value || *shared_value != other.get_local_index() + 1000 || !owner.owns(other)) {
+			data->failures++;
+		}
+	}
+
+	for (int i = 0; i < 16; i++) {
+		if (own[i].is_valid()) {
+			owner.free(own[i]);
+		}
+	}
+}
+
+TEST_CASE("[RID_Owner] Concurrent allocation, lookup and free") {
+	RID_Owner<uint64_t, true> owner(64);
+	Vector<RID> shared;
+	for (int i = 0; i < 32; i++) {
+		const RID rid = owner.allocate_rid();
+		owner.initialize_rid(rid, rid.get_local_index() + 1000);
+		shared.push_back(rid);
+	}
+
+	const int thread_count = 8;
+	Thread threads[thread_count];
+	RIDOwnerThreadData data[thread_count];
+	for (int i = 0; i < thread_count; i++) {
+		data[i].owner = &owner;
+		data[i].shared = &shared;
+		data[i].thread_index = i;
+		data[i].iterations = 20000;
+		threads[i].start(rid_owner_thread_func, &data[i]);
+	}
+	for (int i = 0; i < thread_count; i++) {
+		threads[i].wait_to_finish();
+		CHECK_MESSAGE(data[i].failures == 0, vformat("Thread %d should only have seen its own values and the shared ones.", i));
+	}
+
+	CHECK(owner.get_rid_count() == uint32_t(shared.size()));
+	for (const RID &rid : shared) {
+		owner.free(rid);
+	}
+	CHECK(owner.get_rid_count() == 0);
+}
+#endif // THREADS_ENABLED
 } // namespace TestRID
 
 #endif // TEST_RID_H
@@ -173,6 +173,134 @@ TEST_CASE("[WorkerThreadPool] Run a yielding daemon as the only hope for other t
 	CHECK_MESSAGE(all_needed_yield, "All legit tasks should have needed the daemon yielding to run.");
 }
 
+static void static_dependency_group_phase(void *p_arg, uint32_t p_index) {
+	// Phase 0 writes, phase 1 checks that phase 0 completed for every element.
+	if ((uintptr_t)p_arg == 0) {
+		counter[p_index].increment();
+	} else if (counter[p_index].get() == 1) {
+		counter[p_index].increment();
+	}
+}
+
+static void static_dependency_join(void *p_arg) {
+	int count = (int)(uintptr_t)p_arg;
+	bool all_done = true;
+	for (int i = 0; i < count; i++) {
+		all_done &= counter[i].get() == 2;
+	}
+	exit.set_to(all_done);
+}
+
+TEST_CASE("[WorkerThreadPool] Tasks and groups posted after their dependencies") {
+	for (int iterations = 0; iterations < 200; iterations++) {
+		const int count = Math::pow(2.0f, Math::random(0.0f, 7.0f));
+		const int tasks = Math::pow(2.0f, Math::random(0.0f, 4.0f));
+		const bool low_priority = Math::rand() % 2;
+
+		counter.clear();
+		counter.resize(count);
+		exit.clear();
+
+		WorkerThreadPool::GroupID first = WorkerThreadPool::get_singleton()->add_native_group_task(static_dependency_group_phase, (void *)0, count, tasks, !low_priority);
+		WorkerThreadPool::GroupID second = WorkerThreadPool::get_singleton()->add_native_group_task_after(&first, 1, static_dependency_group_phase, (void *)1, count, tasks, !low_priority);
+		WorkerThreadPool::TaskID dependencies[2] = { first, second };
+		WorkerThreadPool::TaskID join = WorkerThreadPool::get_singleton()->add_native_task_after(dependencies, 2, static_dependency_join, (void *)(uintptr_t)count, low_priority);
+
+		CHECK(WorkerThreadPool::get_singleton()->wait_for_task_completion(join) == OK);
+		CHECK_MESSAGE(exit.is_set(), "Each phase should have run after the previous one completed.");
+
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(second);
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(first);
+	}
+
+	// Dependencies already completed and released don't hold anything back.
+	counter.clear();
+	counter.resize(1);
+	exit.clear();
+	WorkerThreadPool::GroupID done = WorkerThreadPool::get_singleton()->add_native_group_task(static_dependency_group_phase, (void *)0, 1);
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(done);
+	counter[0].increment();
+	WorkerThreadPool::TaskID join = WorkerThreadPool::get_singleton()->add_native_task_after(&done, 1, static_dependency_join, (void *)1);
+	CHECK(WorkerThreadPool::get_singleton()->wait_for_task_completion(join) == OK);
+	CHECK(exit.is_set());
+
+	// An empty group still completes only after its dependencies.
+	for (int iterations = 0; iterations < 50; iterations++) {
+		const int count = 64;
+		counter.clear();
+		counter.resize(count);
+		exit.clear();
+
+		WorkerThreadPool::GroupID first = WorkerThreadPool::get_singleton()->add_native_group_task(static_dependency_group_phase, (void *)0, count);
+		WorkerThreadPool::GroupID empty = WorkerThreadPool::get_singleton()->add_native_group_task_after(&first, 1, static_dependency_group_phase, (void *)0, 0);
+		WorkerThreadPool::GroupID second = WorkerThreadPool::get_singleton()->add_native_group_task_after(&empty, 1, static_dependency_group_phase, (void *)1, count);
+		join = WorkerThreadPool::get_singleton()->add_native_task_after(&second, 1, static_dependency_join, (void *)(uintptr_t)count);
+
+		CHECK(WorkerThreadPool::get_singleton()->wait_for_task_completion(join) == OK);
+		CHECK_MESSAGE(exit.is_set(), "The phase after the empty group should have run after the first one completed.");
+
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(second);
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(empty);
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(first);
+	}
+}
+
+static const int NESTED_TASKS_PER_ELEMENT = 16;
+
+static void static_nested_leaf(void *p_arg) {
+	counter[0].increment();
+}
+
+static void static_nested_spawner(void *p_arg, uint32_t p_index) {
+	WorkerThreadPool::TaskID nested[NESTED_TASKS_PER_ELEMENT];
+	for (int i = 0; i < NESTED_TASKS_PER_ELEMENT; i++) {
+		nested[i] = WorkerThreadPool::get_singleton()->add_native_task(static_nested_leaf, nullptr, true);
+	}
+	bool all_ok = true;
+	for (int i = 0; i < NESTED_TASKS_PER_ELEMENT; i++) {
+		all_ok &= WorkerThreadPool::get_singleton()->wait_for_task_completion(nested[i]) == OK;
+	}
+	if (all_ok) {
+		counter[1].increment();
+	}
+}
+
+TEST_CASE("[WorkerThreadPool] Nested tasks posted from pool threads") {
+	for (int iterations = 0; iterations < 100; iterations++) {
+		const int elements = Math::pow(2.0f, Math::random(0.0f, 6.0f));
+		const int tasks = Math::pow(2.0f, Math::random(0.0f, 4.0f));
+
+		counter.clear();
+		counter.resize(2);
+		WorkerThreadPool::GroupID group = WorkerThreadPool::get_singleton()->add_native_group_task(static_nested_spawner, nullptr, elements, tasks, true);
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group);
+
+		CHECK(counter[0].get() == elements * NESTED_TASKS_PER_ELEMENT);
+		CHECK(counter[1].get() == elements);
+	}
+}
+
+// Not run by default, since timings are only meaningful on an otherwise idle machine.
+// Run with `--test --no-skip --test-case="*[Benchmark]*"`.
+TEST_CASE("[WorkerThreadPool][Benchmark] Nested task throughput per thread count" * doctest::skip()) {
+	const int elements = 4096;
+	const int thread_count = WorkerThreadPool::get_singleton()->get_thread_count();
+
+	for (int tasks = 1; tasks <= MAX(1, thread_count); tasks *= 2) {
+		counter.clear();
+		counter.resize(2);
+
+		uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		WorkerThreadPool::GroupID group = WorkerThreadPool::get_singleton()->add_native_group_task(static_nested_spawner, nullptr, elements, tasks, true);
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group);
+		uint64_t elapsed = MAX(1u, OS::get_singleton()->get_ticks_usec() - begin);
+
+		const int64_t tasks_run = elements * (NESTED_TASKS_PER_ELEMENT + 1);
+		MESSAGE(vformat("%d threads: %d tasks/s.", tasks, tasks_run * 1000000 / (int64_t)elapsed));
+		CHECK(counter[0].get() == elements * NESTED_TASKS_PER_ELEMENT);
+	}
+}
+
 } // namespace TestWorkerThreadPool
 
 #endif // TEST_WORKER_THREAD_POOL_H
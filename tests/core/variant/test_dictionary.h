@@ -31,6 +31,8 @@
 #ifndef TEST_DICTIONARY_H
 #define TEST_DICTIONARY_H
 
+#include "core/os/os.h"
+#include "core/templates/hash_map.h"
 #include "core/variant/dictionary.h"
 #include "tests/test_macros.h"
 
@@ -537,6 +539,155 @@ TEST_CASE("[Dictionary] Order and find") {
 	CHECK_EQ(d.find_key("does not exist"), Variant());
 }
 
+TEST_CASE("[Dictionary] Order and lookups past the small size") {
+	// Small dictionaries are scanned, larger ones get an index. Both must behave the same.
+	Dictionary d;
+	Array keys;
+	for (int i = 0; i < 100; i++) {
+		d[i] = i * 10;
+		keys.append(i);
+	}
+	CHECK_EQ(d.keys(), keys);
+
+	for (int i = 0; i < 100; i += 3) {
+		CHECK(d.erase(i));
+		keys.erase(i);
+	}
+	CHECK_FALSE(d.erase(0));
+	CHECK_EQ(d.size(), keys.size());
+	CHECK_EQ(d.keys(), keys);
+
+	// Erased keys are added back at the end.
+	d[0] = "zero";
+	keys.append(0);
+	CHECK_EQ(d.keys(), keys);
+	CHECK_EQ(d.get_key_at_index(keys.size() - 1), Variant(0));
+
+	for (int i = 1; i < 100; i++) {
+		if (i % 3 == 0) {
+			CHECK_FALSE(d.has(i));
+		} else {
+			CHECK_EQ(d[i], Variant(i * 10));
+		}
+	}
+
+	// String and StringName keys are interchangeable, whatever the size.
+	d["name"] = 1;
+	CHECK(d.has(StringName("name")));
+	d[StringName("other_name")] = 2;
+	CHECK_EQ(d.get("other_name", Variant()), Variant(2));
+
+	int count = 0;
+	for (const Variant *key = d.next(); key; key = d.next(key)) {
+		count++;
+	}
+	CHECK_EQ(count, d.size());
+
+	d.clear();
+	CHECK(d.is_empty());
+	CHECK(d.next() == nullptr);
+	d[1] = 1;
+	CHECK_EQ(d.size(), 1);
+}
+
+TEST_CASE("[Dictionary] Values don't move when the dictionary grows") {
+	Dictionary d;
+	d["first"] = 1;
+	const Variant *first = d.getptr("first");
+	for (int i = 0; i < 1000; i++) {
+		d[i] = i;
+	}
+	d.erase(10);
+	CHECK_MESSAGE(d.getptr("first") == first, "Pointers to values should stay valid, as with the previous storage.");
+}
+
+// Not run by default, since timings are only meaningful on an otherwise idle machine.
+// Run with `--test --no-skip --test-case="*[Benchmark]*"`.
+TEST_CASE("[Dictionary][Benchmark] Compact storage against HashMap" * doctest::skip()) {
+	typedef HashMap<Variant, Variant, VariantHasher, StringLikeVariantComparator> PreviousMap;
+	const int runs = 5;
+	const int sizes[] = { 4, 8, 64 };
+
+	for (int size : sizes) {
+		const int repeats = 100000 / size;
+		Vector<Variant> keys;
+		for (int i = 0; i < size; i++) {
+			keys.push_back(vformat("key_%d", i));
+		}
+
+		uint64_t create_usec[2] = { UINT64_MAX, UINT64_MAX };
+		uint64_t lookup_usec[2] = { UINT64_MAX, UINT64_MAX };
+		uint64_t iterate_usec[2] = { UINT64_MAX, UINT64_MAX };
+		int64_t checksums[2] = { 0, 0 };
+
+		for (int run = 0; run < runs; run++) {
+			checksums[0] = 0;
+			checksums[1] = 0;
+
+			uint64_t begin = OS::get_singleton()->get_ticks_usec();
+			for (int r = 0; r < repeats; r++) {
+				Dictionary d;
+				for (int i = 0; i < size; i++) {
+					d[keys[i]] = i;
+				}
+			}
+			create_usec[0] = MIN(create_usec[0], OS::get_singleton()->get_ticks_usec() - begin);
+
+			begin = OS::get_singleton()->get_ticks_usec();
+			for (int r = 0; r < repeats; r++) {
+				PreviousMap map;
+				for (int i = 0; i < size; i++) {
+					map[keys[i]] = i;
+				}
+			}
+			create_usec[1] = MIN(create_usec[1], OS::get_singleton()->get_ticks_usec() - begin);
+
+			Dictionary d;
+			PreviousMap map;
+			for (int i = 0; i < size; i++) {
+				d[keys[i]] = i;
+				map[keys[i]] = i;
+			}
+
+			begin = OS::get_singleton()->get_ticks_usec();
+			for (int r = 0; r < repeats; r++) {
+				for (int i = 0; i < size; i++) {
+					checksums[0] += int64_t(*d.getptr(keys[i]));
+				}
+			}
+			lookup_usec[0] = MIN(lookup_usec[0], OS::get_singleton()->get_ticks_usec() - begin);
+
+			begin = OS::get_singleton()->get_ticks_usec();
+			for (int r = 0; r < repeats; r++) {
+				for (int i = 0; i < size; i++) {
+					checksums[1] += int64_t(*map.getptr(keys[i]));
+				}
+			}
+			lookup_usec[1] = MIN(lookup_usec[1], OS::get_singleton()->get_ticks_usec() - begin);
+
+			begin = OS::get_singleton()->get_ticks_usec();
+			for (int r = 0; r < repeats; r++) {
+				for (const Variant *key = d.next(); key; key = d.next(key)) {
+					checksums[0]++;
+				}
+			}
+			iterate_usec[0] = MIN(iterate_usec[0], OS::get_singleton()->get_ticks_usec() - begin);
+
+			begin = OS::get_singleton()->get_ticks_usec();
+			for (int r = 0; r < repeats; r++) {
+				for (const KeyValue<Variant, Variant> &E : map) {
+					checksums[1] += E.key.get_type() != Variant::NIL;
+				}
+			}
+			iterate_usec[1] = MIN(iterate_usec[1], OS::get_singleton()->get_ticks_usec() - begin);
+		}
+
+		CHECK(checksums[0] == checksums[1]);
+		MESSAGE(vformat("%d keys, %d times (best of %d): create %d / %d usec, lookup %d / %d usec, iterate %d / %d usec (Dictionary / HashMap).",
+				size, repeats, runs, create_usec[0], create_usec[1], lookup_usec[0], lookup_usec[1], iterate_usec[0], iterate_usec[1]));
+	}
+}
+
 } // namespace TestDictionary
 
 #endif // TEST_DICTIONARY_H
@@ -0,0 +1,202 @@
+/**************************************************************************/
+/*  test_node_3d.h                                                        */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_NODE_3D_H
+#define TEST_NODE_3D_H
+
+#include "scene/3d/node_3d.h"
+#include "scene/main/window.h"
+
+#include "core/os/os.h"
+#include "tests/test_macros.h"
+
+namespace TestNode3D {
+
+class TransformNotifiedNode3D : public Node3D {
+	GDCLASS(TransformNotifiedNode3D, Node3D);
+
+protected:
+	void _notification(int p_what) {
+		if (p_what == NOTIFICATION_TRANSFORM_CHANGED) {
+			notification_count++;
+		}
+	}
+
+public:
+	int notification_count = 0;
+
+	void ignore_transform_notification(bool p_ignore) { set_ignore_transform_notification(p_ignore); }
+};
+
+TEST_CASE("[SceneTree][Node3D] Transform propagation") {
+	Node3D *root = memnew(Node3D);
+	Node3D *middle = memnew(Node3D);
+	TransformNotifiedNode3D *leaf = memnew(TransformNotifiedNode3D);
+	root->add_child(middle);
+	middle->add_child(leaf);
+	SceneTree::get_singleton()->get_root()->add_child(root);
+	SceneTree::get_singleton()->flush_transform_notifications();
+
+	SUBCASE("Global transforms follow repeated moves of ancestors") {
+		root->set_position(Vector3(1, 0, 0));
+		middle->set_position(Vector3(0, 1, 0));
+		root->set_position(Vector3(2, 0, 0));
+		leaf->set_position(Vector3(0, 0, 1));
+		middle->set_rotation(Vector3(0, Math_PI, 0));
+
+		CHECK(leaf->get_global_position().is_equal_approx(Vector3(2, 1, -1)));
+		CHECK(middle->get_global_position().is_equal_approx(Vector3(2, 1, 0)));
+
+		root->set_position(Vector3(3, 0, 0));
+		CHECK(leaf->get_global_position().is_equal_approx(Vector3(3, 1, -1)));
+	}
+
+	SUBCASE("Notifications are sent once per flush, however often ancestors move") {
+		leaf->set_notify_transform(true);
+		leaf->notification_count = 0;
+
+		root->set_position(Vector3(1, 0, 0));
+		middle->set_position(Vector3(0, 1, 0));
+		root->set_position(Vector3(2, 0, 0));
+		SceneTree::get_singleton()->flush_transform_notifications();
+		CHECK(leaf->notification_count == 1);
+
+		// Not reading the global transform keeps the leaf dirty, it must still be notified again.
+		root->set_position(Vector3(3, 0, 0));
+		SceneTree::get_singleton()->flush_transform_notifications();
+		CHECK(leaf->notification_count == 2);
+	}
+
+	SUBCASE("Nodes that start listening in a dirty subtree are notified") {
+		root->set_position(Vector3(1, 0, 0));
+		leaf->set_notify_transform(true);
+		leaf->notification_count = 0;
+		root->set_position(Vector3(2, 0, 0));
+		SceneTree::get_singleton()->flush_transform_notifications();
+		CHECK(leaf->notification_count == 1);
+
+		leaf->ignore_transform_notification(true);
+		root->set_position(Vector3(3, 0, 0));
+		leaf->ignore_transform_notification(false);
+		middle->set_position(Vector3(0, 2, 0));
+		root->set_position(Vector3(4, 0, 0));
+		SceneTree::get_singleton()->flush_transform_notifications();
+		CHECK(leaf->notification_count == 2);
+	}
+
+	SUBCASE("Nodes entering a dirty subtree are notified") {
+		root->set_position(Vector3(1, 0, 0));
+
+		TransformNotifiedNode3D *entered = memnew(TransformNotifiedNode3D);
+		entered->set_notify_transform(true);
+		middle->add_child(entered);
+		root->set_position(Vector3(2, 0, 0));
+		root->set_position(Vector3(3, 0, 0));
+		SceneTree::get_singleton()->flush_transform_notifications();
+		CHECK(entered->notification_count == 1);
+		CHECK(entered->get_global_position().is_equal_approx(Vector3(3, 0, 0)));
+
+		// Same when moving in from another dirty subtree.
+		leaf->set_notify_transform(true);
+		leaf->notification_count = 0;
+		root->set_position(Vector3(4, 0, 0));
+		middle->remove_child(leaf);
+		entered->add_child(leaf);
+		root->set_position(Vector3(5, 0, 0));
+		root->set_position(Vector3(6, 0, 0));
+		SceneTree::get_singleton()->flush_transform_notifications();
+		CHECK(leaf->notification_count == 1);
+		CHECK(entered->notification_count == 2);
+	}
+
+	SUBCASE("Nodes updated early are notified of later moves") {
+		leaf->set_notify_transform(true);
+		leaf->notification_count = 0;
+
+		root->set_position(Vector3(1, 0, 0));
+		// The notification doesn't read the global transform, so the leaf stays dirty.
+		leaf->force_update_transform();
+		CHECK(leaf->notification_count == 1);
+
+		root->set_position(Vector3(2, 0, 0));
+		SceneTree::get_singleton()->flush_transform_notifications();
+		CHECK(leaf->notification_count == 2);
+		CHECK(leaf->get_global_position().is_equal_approx(Vector3(2, 0, 0)));
+	}
+
+	memdelete(root);
+}
+
+// Not run by default, since timings are only meaningful on an otherwise idle machine.
+// Run with `--test --no-skip --test-case="*[Benchmark]*"`.
+TEST_CASE("[SceneTree][Node3D][Benchmark] Moving nodes of a deep hierarchy" * doctest::skip()) {
+	const int branch_count = 32;
+	const int depth = 64;
+	const int runs = 5;
+
+	// A few long chains, like skeletons or attached props, each moved at several depths every frame.
+	Node3D *root = memnew(Node3D);
+	LocalVector<Node3D *> moved;
+	for (int i = 0; i < branch_count; i++) {
+		Node3D *parent = root;
+		for (int j = 0; j < depth; j++) {
+			TransformNotifiedNode3D *node = memnew(TransformNotifiedNode3D);
+			node->set_notify_transform(true);
+			parent->add_child(node);
+			if (j % 8 == 0) {
+				moved.push_back(node);
+			}
+			parent = node;
+		}
+	}
+	SceneTree::get_singleton()->get_root()->add_child(root);
+	SceneTree::get_singleton()->flush_transform_notifications();
+
+	uint64_t best_usec = UINT64_MAX;
+	for (int i = 0; i < runs; i++) {
+		const uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		for (int frame = 0; frame < 100; frame++) {
+			root->set_position(Vector3(frame, 0, 0));
+			for (Node3D *node : moved) {
+				node->set_rotation(Vector3(0, frame * 0.01, 0));
+			}
+			SceneTree::get_singleton()->flush_transform_notifications();
+		}
+		best_usec = MIN(best_usec, OS::get_singleton()->get_ticks_usec() - begin);
+	}
+
+	MESSAGE(vformat("%d nodes, 100 frames: %d usec (best of %d).", branch_count * depth, best_usec, runs));
+
+	memdelete(root);
+}
+
+} // namespace TestNode3D
+
+#endif // TEST_NODE_3D_H
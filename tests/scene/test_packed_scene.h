@@ -31,8 +31,11 @@
 #ifndef TEST_PACKED_SCENE_H
 #define TEST_PACKED_SCENE_H
 
+#include "scene/2d/node_2d.h"
+#include "scene/main/window.h"
 #include "scene/resources/packed_scene.h"
 
+#include "core/os/os.h"
 #include "tests/test_macros.h"
 
 namespace TestPackedScene {
@@ -215,6 +218,261 @@ TEST_CASE("[PackedScene] Recreate State") {
 	memdelete(scene);
 }
 
+
+static Node *_make_scene_with_properties(int p_child_count) {
+	Node2D *scene = memnew(Node2D);
+	scene->set_name("TestScene");
+	scene->set_position(Vector2(1, 2));
+	scene->add_to_group("root_group", true);
+
+	for (int i = 0; i < p_child_count; i++) {
+		Node2D *child = memnew(Node2D);
+		child->set_name(vformat("Child%d", i));
+		child->set_position(Vector2(i, -i));
+		child->set_rotation(0.5 * i);
+		child->set_z_index(i % 4);
+		child->set_modulate(Color(1, 0, 0));
+		child->set_visible(i % 2 == 0);
+		child->add_to_group("children", true);
+		scene->add_child(child);
+		child->set_owner(scene);
+
+		Node *grandchild = memnew(Node);
+		grandchild->set_name("Grandchild");
+		grandchild->set_process_priority(i);
+		child->add_child(grandchild);
+		grandchild->set_owner(scene);
+		grandchild->set_unique_name_in_owner(i == 0);
+	}
+
+	scene->get_child(0)->connect("visibility_changed", Callable(scene, "queue_free"), Object::CONNECT_PERSIST);
+	return scene;
+}
+
+TEST_CASE("[PackedScene] Instantiation programs give the same nodes as generic instantiation") {
+	Node *scene = _make_scene_with_properties(4);
+	PackedScene packed_scene;
+	REQUIRE(packed_scene.pack(scene) == OK);
+	memdelete(scene);
+
+	const bool was_using_programs = SceneState::is_using_instantiation_programs();
+	SceneState::set_use_instantiation_programs(false);
+	Node *generic = packed_scene.instantiate();
+	SceneState::set_use_instantiation_programs(true);
+	// The first instantiation compiles the program, later ones replay it.
+	Node *compiled = packed_scene.instantiate();
+	memdelete(compiled);
+	compiled = packed_scene.instantiate();
+	SceneState::set_use_instantiation_programs(was_using_programs);
+
+	REQUIRE(generic != nullptr);
+	REQUIRE(compiled != nullptr);
+	CHECK(compiled->get_name() == "TestScene");
+	CHECK(Object::cast_to<Node2D>(compiled)->get_position() == Vector2(1, 2));
+	CHECK(compiled->is_in_group("root_group"));
+	REQUIRE(compiled->get_child_count() == generic->get_child_count());
+
+	for (int i = 0; i < generic->get_child_count(); i++) {
+		const Node2D *expected = Object::cast_to<Node2D>(generic->get_child(i));
+		const Node2D *child = Object::cast_to<Node2D>(compiled->get_child(i));
+		REQUIRE(child != nullptr);
+		CHECK(child->get_name() == expected->get_name());
+		CHECK(child->get_owner() == compiled);
+		CHECK(child->get_position() == expected->get_position());
+		CHECK(child->get_rotation() == expected->get_rotation());
+		CHECK(child->get_z_index() == expected->get_z_index());
+		CHECK(child->get_modulate() == expected->get_modulate());
+		CHECK(child->is_visible() == expected->is_visible());
+		CHECK(child->is_in_group("children"));
+
+		REQUIRE(child->get_child_count() == 1);
+		const Node *grandchild = child->get_child(0);
+		CHECK(grandchild->get_name() == "Grandchild");
+		CHECK(grandchild->get_owner() == compiled);
+		CHECK(grandchild->get_process_priority() == i);
+	}
+
+	CHECK(compiled->get_node_or_null(NodePath("%Grandchild")) == compiled->get_child(0)->get_child(0));
+	CHECK(compiled->get_child(0)->is_connected("visibility_changed", Callable(compiled, "queue_free")));
+
+	memdelete(generic);
+	memdelete(compiled);
+}
+
+TEST_CASE("[PackedScene] Instantiation programs give each instance its own values where generic instantiation does") {
+	Node2D *scene = memnew(Node2D);
+	scene->set_name("TestScene");
+	Array list;
+	list.push_back(1);
+	scene->set_meta("list", list);
+	Ref<Resource> local_resource;
+	local_resource.instantiate();
+	local_resource->set_local_to_scene(true);
+	scene->set_meta("local_resource", local_resource);
+	Ref<Resource> shared_resource;
+	shared_resource.instantiate();
+	scene->set_meta("shared_resource", shared_resource);
+	PackedScene packed_scene;
+	REQUIRE(packed_scene.pack(scene) == OK);
+	memdelete(scene);
+
+	const bool was_using_programs = SceneState::is_using_instantiation_programs();
+	SceneState::set_use_instantiation_programs(true);
+	Node *first = packed_scene.instantiate();
+	Node *second = packed_scene.instantiate();
+	SceneState::set_use_instantiation_programs(was_using_programs);
+
+	REQUIRE(first != nullptr);
+	REQUIRE(second != nullptr);
+	Array first_list = first->get_meta("list");
+	first_list.push_back(2);
+	CHECK_MESSAGE(Array(second->get_meta("list")).size() == 1, "Arrays should not be shared between instances.");
+	CHECK_MESSAGE(Ref<Resource>(first->get_meta("local_resource")) != Ref<Resource>(second->get_meta("local_resource")), "Resources local to the scene should be duplicated for each instance.");
+	CHECK(Ref<Resource>(first->get_meta("shared_resource")) == shared_resource);
+	CHECK(Ref<Resource>(second->get_meta("shared_resource")) == shared_resource);
+
+	memdelete(first);
+	memdelete(second);
+}
+
+TEST_CASE("[SceneTree][PackedScene] Pooled instances") {
+	Node *scene = _make_scene_with_properties(2);
+	Ref<Resource> local_resource = memnew(Resource);
+	local_resource->set_name("Original");
+	local_resource->set_local_to_scene(true);
+	scene->set_meta("local_resource", local_resource);
+	Ref<PackedScene> packed_scene = memnew(PackedScene);
+	REQUIRE(packed_scene->pack(scene) == OK);
+	memdelete(scene);
+
+	SceneTree *tree = SceneTree::get_singleton();
+	const uint64_t reuse_count = tree->get_pool_reuse_count();
+
+	Node2D *instance = Object::cast_to<Node2D>(tree->instantiate_pooled(packed_scene));
+	REQUIRE(instance != nullptr);
+	const ObjectID instance_id = instance->get_instance_id();
+	tree->get_root()->add_child(instance);
+	instance->set_position(Vector2(100, 100));
+	Object::cast_to<Node2D>(instance->get_child(1))->set_z_index(10);
+
+	SUBCASE("Released instances are restored and reused") {
+		tree->release_to_pool(instance);
+		tree->process(0);
+		CHECK(instance->get_parent() == nullptr);
+		CHECK(tree->get_pooled_instance_count() == 1);
+
+		Node2D *reused = Object::cast_to<Node2D>(tree->instantiate_pooled(packed_scene));
+		CHECK(reused == instance);
+		CHECK(tree->get_pooled_instance_count() == 0);
+		CHECK(tree->get_pool_reuse_count() == reuse_count + 1);
+		CHECK(reused->get_position() == Vector2(1, 2));
+		CHECK(Object::cast_to<Node2D>(reused->get_child(1))->get_z_index() == 1);
+		CHECK(reused->is_in_group("root_group"));
+
+		memdelete(reused);
+	}
+
+	SUBCASE("Runtime connections to other objects are disconnected") {
+		Node *listener = memnew(Node);
+		Node *child = instance->get_child(0);
+		instance->connect("renamed", callable_mp(listener, &Node::print_tree));
+		listener->connect("renamed", callable_mp(child, &Node::print_tree));
+		instance->connect("visibility_changed", callable_mp(listener, &Node::print_tree), Object::CONNECT_PERSIST);
+		instance->connect("visibility_changed", callable_mp(child, &Node::print_tree));
+
+		tree->release_to_pool(instance);
+		tree->process(0);
+		REQUIRE(tree->get_pooled_instance_count() == 1);
+		CHECK_FALSE(instance->is_connected("renamed", callable_mp(listener, &Node::print_tree)));
+		CHECK_FALSE(listener->is_connected("renamed", callable_mp(child, &Node::print_tree)));
+		CHECK(instance->is_connected("visibility_changed", callable_mp(listener, &Node::print_tree)));
+		CHECK(instance->is_connected("visibility_changed", callable_mp(child, &Node::print_tree)));
+
+		memdelete(listener);
+		memdelete(tree->instantiate_pooled(packed_scene));
+	}
+
+	SUBCASE("Groups are restored") {
+		instance->add_to_group("runtime_group");
+		instance->get_child(1)->remove_from_group("children");
+
+		tree->release_to_pool(instance);
+		tree->process(0);
+		REQUIRE(tree->get_pooled_instance_count() == 1);
+		CHECK_FALSE(instance->is_in_group("runtime_group"));
+		CHECK(instance->is_in_group("root_group"));
+		CHECK(instance->get_child(1)->is_in_group("children"));
+
+		memdelete(tree->instantiate_pooled(packed_scene));
+	}
+
+	SUBCASE("Resources local to scene are duplicated again") {
+		Ref<Resource> used_resource = instance->get_meta("local_resource");
+		REQUIRE(used_resource.is_valid());
+		CHECK(used_resource != local_resource);
+		used_resource->set_name("Modified");
+
+		tree->release_to_pool(instance);
+		tree->process(0);
+		REQUIRE(tree->get_pooled_instance_count() == 1);
+		Ref<Resource> reused_resource = instance->get_meta("local_resource");
+		REQUIRE(reused_resource.is_valid());
+		CHECK(reused_resource != used_resource);
+		CHECK(reused_resource->get_name() == "Original");
+		CHECK(reused_resource->is_local_to_scene());
+		CHECK(reused_resource->get_local_scene() == instance);
+
+		memdelete(tree->instantiate_pooled(packed_scene));
+	}
+
+	SUBCASE("Instances with a changed structure are freed") {
+		instance->add_child(memnew(Node));
+		tree->release_to_pool(instance);
+		tree->process(0);
+		CHECK(ObjectDB::get_instance(instance_id) == nullptr);
+		CHECK(tree->get_pooled_instance_count() == 0);
+	}
+
+	tree->clear_pools();
+}
+
+// Not run by default, since timings are only meaningful on an otherwise idle machine.
+// Run with `--test --no-skip --test-case="*[Benchmark]*"`.
+TEST_CASE("[PackedScene][Benchmark] Instantiation with and without programs" * doctest::skip()) {
+	Node *scene = _make_scene_with_properties(16);
+	PackedScene packed_scene;
+	REQUIRE(packed_scene.pack(scene) == OK);
+	memdelete(scene);
+
+	const int instance_count = 1000;
+	const int runs = 5;
+	const bool was_using_programs = SceneState::is_using_instantiation_programs();
+	Vector<Node *> instances;
+	instances.resize(instance_count);
+
+	for (int use_programs = 0; use_programs < 2; use_programs++) {
+		SceneState::set_use_instantiation_programs(use_programs);
+		memdelete(packed_scene.instantiate()); // Warm up, and compile the program.
+
+		uint64_t best_usec = UINT64_MAX;
+		for (int i = 0; i < runs; i++) {
+			const uint64_t begin = OS::get_singleton()->get_ticks_usec();
+			for (int j = 0; j < instance_count; j++) {
+				instances.write[j] = packed_scene.instantiate();
+			}
+			best_usec = MIN(best_usec, OS::get_singleton()->get_ticks_usec() - begin);
+
+			for (Node *instance : instances) {
+				memdelete(instance);
+			}
+		}
+
+		MESSAGE(vformat("%s: %d instances per second (best of %d).", use_programs ? "Programs" : "Generic", instance_count * 1000000 / MAX(best_usec, (uint64_t)1), runs));
+	}
+
+	SceneState::set_use_instantiation_programs(was_using_programs);
+}
+
 } // namespace TestPackedScene
 
 #endif // TEST_PACKED_SCENE_H
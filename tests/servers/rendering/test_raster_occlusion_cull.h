@@ -0,0 +1,119 @@
+/**************************************************************************/
+/*  test_raster_occlusion_cull.h                                          */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_RASTER_OCCLUSION_CULL_H
+#define TEST_RASTER_OCCLUSION_CULL_H
+
+#include "servers/rendering/raster_occlusion_cull.h"
+
+#include "tests/test_macros.h"
+
+namespace TestRasterOcclusionCull {
+
+// Counts the boxes of size 1 placed every 3 units along the X axis, with the given lowest Y and farthest Z, which pass the occlusion test.
+static int _count_visible(const RasterOcclusionCull::RasterHZBuffer &p_buffer, const Transform3D &p_cam_transform, const Projection &p_cam_projection, real_t p_y, real_t p_z) {
+	int visible = 0;
+	Transform3D cam_inv_transform = p_cam_transform.affine_inverse();
+	for (int i = -3; i <= 3; i++) {
+		const real_t bounds[6] = { i * 3 - 0.5f, p_y, p_z, i * 3 + 0.5f, p_y + 1, p_z + 1 };
+		uint64_t occlusion_timeout = 0;
+		if (!p_buffer.is_occluded(bounds, p_cam_transform.origin, cam_inv_transform, p_cam_projection, p_cam_projection.get_z_near(), occlusion_timeout)) {
+			visible++;
+		}
+	}
+	return visible;
+}
+
+TEST_CASE("[RasterOcclusionCull] Wall occludes the boxes behind it") {
+	// A wall 5 units wide, 10 units in front of the camera.
+	const PackedVector3Array vertices = { Vector3(-2.5, -5, -10), Vector3(2.5, -5, -10), Vector3(2.5, 5, -10), Vector3(-2.5, 5, -10) };
+	const PackedInt32Array indices = { 0, 1, 2, 0, 2, 3 };
+
+	RasterOcclusionCull::RasterHZBuffer::OccluderMesh mesh;
+	mesh.vertices = vertices.ptr();
+	mesh.vertex_count = vertices.size();
+	mesh.indices = indices.ptr();
+	mesh.index_count = indices.size();
+
+	RasterOcclusionCull::RasterHZBuffer buffer;
+	buffer.resize(Size2i(64, 64));
+
+	Projection projection;
+	projection.set_perspective(90, 1, 0.05, 100);
+	Transform3D cam_transform;
+
+	buffer.rasterize(&mesh, 1, cam_transform, projection, false);
+	buffer.update_mips();
+
+	// At twice the distance, the wall hides the boxes within 5 units of the center.
+	CHECK_MESSAGE(_count_visible(buffer, cam_transform, projection, 0, -21) == 4, "The 3 boxes behind the wall should be occluded.");
+	CHECK_MESSAGE(_count_visible(buffer, cam_transform, projection, 0, -6) == 7, "Boxes in front of the wall should be visible.");
+
+	mesh.index_count = 0;
+	buffer.rasterize(&mesh, 1, cam_transform, projection, false);
+	buffer.update_mips();
+	CHECK_MESSAGE(_count_visible(buffer, cam_transform, projection, 0, -21) == 7, "Without occluders, all boxes should be visible.");
+
+	Projection orthogonal;
+	orthogonal.set_orthogonal(40, 1, 0.05, 100);
+	mesh.index_count = indices.size();
+	buffer.rasterize(&mesh, 1, cam_transform, orthogonal, true);
+	buffer.update_mips();
+	CHECK_MESSAGE(_count_visible(buffer, cam_transform, orthogonal, 0, -21) == 6, "With an orthogonal camera, the wall should only hide the box right behind it.");
+}
+
+TEST_CASE("[RasterOcclusionCull] Floor crossing the near plane") {
+	// A floor which extends behind the camera, so it's clipped against the near plane.
+	const PackedVector3Array vertices = { Vector3(-50, -1, 10), Vector3(50, -1, 10), Vector3(50, -1, -90), Vector3(-50, -1, -90) };
+	const PackedInt32Array indices = { 0, 1, 2, 0, 2, 3 };
+
+	RasterOcclusionCull::RasterHZBuffer::OccluderMesh mesh;
+	mesh.vertices = vertices.ptr();
+	mesh.vertex_count = vertices.size();
+	mesh.indices = indices.ptr();
+	mesh.index_count = indices.size();
+
+	RasterOcclusionCull::RasterHZBuffer buffer;
+	buffer.resize(Size2i(64, 64));
+
+	Projection projection;
+	projection.set_perspective(90, 1, 0.05, 100);
+	Transform3D cam_transform;
+
+	buffer.rasterize(&mesh, 1, cam_transform, projection, false);
+	buffer.update_mips();
+
+	CHECK_MESSAGE(_count_visible(buffer, cam_transform, projection, -4, -21) == 0, "Boxes under the floor should be occluded.");
+	CHECK_MESSAGE(_count_visible(buffer, cam_transform, projection, 1, -21) == 7, "Boxes above the floor should be visible.");
+}
+
+} // namespace TestRasterOcclusionCull
+
+#endif // TEST_RASTER_OCCLUSION_CULL_H
@@ -0,0 +1,150 @@
+/**************************************************************************/
+/*  test_renderer_canvas_cull.h                                           */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_RENDERER_CANVAS_CULL_H
+#define TEST_RENDERER_CANVAS_CULL_H
+
+#include "core/os/os.h"
+#include "servers/rendering/renderer_canvas_cull.h"
+#include "servers/rendering/rendering_server_globals.h"
+
+#include "tests/test_macros.h"
+
+namespace TestRendererCanvasCull {
+
+struct CanvasSetup {
+	RID canvas;
+	LocalVector<RID> items;
+};
+
+// A root item with many children, some of which are drawn behind it, use other z indices or have y-sorted children of their own.
+static CanvasSetup _make_canvas(int p_child_count) {
+	RenderingServer *rs = RenderingServer::get_singleton();
+	CanvasSetup setup;
+	setup.canvas = rs->canvas_create();
+
+	RID root = rs->canvas_item_create();
+	rs->canvas_item_set_parent(root, setup.canvas);
+	rs->canvas_item_add_rect(root, Rect2(0, 0, 1024, 600), Color(1, 1, 1));
+	setup.items.push_back(root);
+
+	for (int i = 0; i < p_child_count; i++) {
+		RID item = rs->canvas_item_create();
+		rs->canvas_item_set_parent(item, root);
+		rs->canvas_item_set_transform(item, Transform2D(0, Vector2((i * 37) % 1000, (i * 13) % 580)));
+		rs->canvas_item_add_rect(item, Rect2(0, 0, 16, 16), Color(1, 1, 1));
+		rs->canvas_item_set_z_index(item, i % 3 - 1);
+		rs->canvas_item_set_draw_behind_parent(item, i % 7 == 0);
+		setup.items.push_back(item);
+
+		if (i % 11 == 0) {
+			rs->canvas_item_set_sort_children_by_y(item, true);
+			for (int j = 0; j < 3; j++) {
+				RID child = rs->canvas_item_create();
+				rs->canvas_item_set_parent(child, item);
+				rs->canvas_item_set_transform(child, Transform2D(0, Vector2(0, 8 - j * 4)));
+				rs->canvas_item_add_rect(child, Rect2(0, 0, 8, 8), Color(1, 1, 1));
+				setup.items.push_back(child);
+			}
+		}
+	}
+
+	return setup;
+}
+
+static void _free_canvas(const CanvasSetup &p_setup) {
+	for (int i = p_setup.items.size() - 1; i >= 0; i--) {
+		RenderingServer::get_singleton()->free(p_setup.items[i]);
+	}
+	RenderingServer::get_singleton()->free(p_setup.canvas);
+}
+
+static void _render_canvas(const CanvasSetup &p_setup) {
+	RendererCanvasCull *canvas_cull = RSG::canvas;
+	RendererCanvasCull::Canvas *canvas = canvas_cull->canvas_owner.get_or_null(p_setup.canvas);
+	canvas_cull->render_canvas(RID(), canvas, Transform2D(), nullptr, nullptr, Rect2(0, 0, 1024, 600), RS::CANVAS_ITEM_TEXTURE_FILTER_LINEAR, RS::CANVAS_ITEM_TEXTURE_REPEAT_DISABLED, false, false, 0xFFFFFFFF);
+}
+
+TEST_CASE("[SceneTree][RendererCanvasCull] Threaded culling keeps the serial draw order") {
+	RendererCanvasCull *canvas_cull = RSG::canvas;
+	const uint32_t minimum_child_items = canvas_cull->threaded_cull_minimum_child_items;
+	CanvasSetup setup = _make_canvas(2000);
+
+	LocalVector<RendererCanvasRender::Item *> serial_next;
+	LocalVector<int> serial_z;
+	canvas_cull->threaded_cull_minimum_child_items = 0;
+	_render_canvas(setup);
+	for (const RID &rid : setup.items) {
+		RendererCanvasCull::Item *item = canvas_cull->canvas_item_owner.get_or_null(rid);
+		serial_next.push_back(item->next);
+		serial_z.push_back(item->z_final);
+	}
+
+	canvas_cull->threaded_cull_minimum_child_items = 1;
+	_render_canvas(setup);
+	bool same_order = true;
+	for (uint32_t i = 0; i < setup.items.size(); i++) {
+		RendererCanvasCull::Item *item = canvas_cull->canvas_item_owner.get_or_null(setup.items[i]);
+		same_order = same_order && item->next == serial_next[i] && item->z_final == serial_z[i];
+	}
+	CHECK_MESSAGE(same_order, "Culling on worker threads should link the items in the same order as culling serially.");
+
+	canvas_cull->threaded_cull_minimum_child_items = minimum_child_items;
+	_free_canvas(setup);
+}
+
+// Not run by default, since timings are only meaningful on an otherwise idle machine.
+// Run with `--test --no-skip --test-case="*[Benchmark]*"`.
+TEST_CASE("[SceneTree][RendererCanvasCull][Benchmark] Culling 50000 canvas items" * doctest::skip()) {
+	RendererCanvasCull *canvas_cull = RSG::canvas;
+	const uint32_t minimum_child_items = canvas_cull->threaded_cull_minimum_child_items;
+	CanvasSetup setup = _make_canvas(50000);
+	const int runs = 10;
+
+	for (int threaded = 0; threaded < 2; threaded++) {
+		canvas_cull->threaded_cull_minimum_child_items = threaded ? 1 : 0;
+		_render_canvas(setup);
+
+		uint64_t best_usec = UINT64_MAX;
+		for (int i = 0; i < runs; i++) {
+			const uint64_t begin = OS::get_singleton()->get_ticks_usec();
+			_render_canvas(setup);
+			best_usec = MIN(best_usec, OS::get_singleton()->get_ticks_usec() - begin);
+		}
+		MESSAGE(vformat("%s culling: %d usec (best of %d).", threaded ? "Threaded" : "Serial", best_usec, runs));
+	}
+
+	canvas_cull->threaded_cull_minimum_child_items = minimum_child_items;
+	_free_canvas(setup);
+}
+
+} // namespace TestRendererCanvasCull
+
+#endif // TEST_RENDERER_CANVAS_CULL_H
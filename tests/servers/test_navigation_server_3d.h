@@ -31,6 +31,7 @@
 #ifndef TEST_NAVIGATION_SERVER_3D_H
 #define TEST_NAVIGATION_SERVER_3D_H
 
+#include "core/config/project_settings.h"
 #include "scene/3d/mesh_instance_3d.h"
 #include "scene/resources/3d/primitive_meshes.h"
 #include "servers/navigation_server_3d.h"
@@ -51,6 +52,20 @@ public:
 	Variant function1_latest_arg0{};
 };
 
+// Starts another path query batch from the callback of a collected one.
+class PathQueryBatchChainer : public Object {
+	GDCLASS(PathQueryBatchChainer, Object);
+
+public:
+	TypedArray<NavigationPathQueryParameters3D> parameters;
+	TypedArray<NavigationPathQueryResult3D> results;
+	int64_t chained_batch_id = 0;
+
+	void on_batch_collected(int64_t p_batch_id) {
+		chained_batch_id = NavigationServer3D::get_singleton()->query_path_batch(parameters, results);
+	}
+};
+
 static inline Array build_array() {
 	return Array();
 }
@@ -61,6 +76,41 @@ static inline Array build_array(Variant item, Targs... Fargs) {
 	return a;
 }
 
+// Flat square grid of quads, one polygon per cell.
+static Ref<NavigationMesh> create_grid_navigation_mesh(int p_cells, real_t p_cell_size) {
+	Ref<NavigationMesh> navigation_mesh = memnew(NavigationMesh);
+
+	Vector<Vector3> vertices;
+	for (int z = 0; z <= p_cells; z++) {
+		for (int x = 0; x <= p_cells; x++) {
+			vertices.push_back(Vector3(x * p_cell_size, 0, z * p_cell_size));
+		}
+	}
+	navigation_mesh->set_vertices(vertices);
+
+	for (int z = 0; z < p_cells; z++) {
+		for (int x = 0; x < p_cells; x++) {
+			int first = z * (p_cells + 1) + x;
+			Vector<int> polygon;
+			polygon.push_back(first);
+			polygon.push_back(first + 1);
+			polygon.push_back(first + p_cells + 2);
+			polygon.push_back(first + p_cells + 1);
+			navigation_mesh->add_polygon(polygon);
+		}
+	}
+
+	return navigation_mesh;
+}
+
+static real_t get_path_length(const Vector<Vector3> &p_path) {
+	real_t length = 0.0;
+	for (int i = 1; i < p_path.size(); i++) {
+		length += p_path[i - 1].distance_to(p_path[i]);
+	}
+	return length;
+}
+
 TEST_SUITE("[Navigation]") {
 	TEST_CASE("[NavigationServer3D] Server should be empty when initialized") {
 		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
@@ -764,6 +814,478 @@ TEST_SUITE("[Navigation]") {
 		navigation_server->process(0.0); // Give server some cycles to commit.
 	}
 
+	TEST_CASE("[NavigationServer3D] Map should keep region connections up to date when regions change") {
+		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
+		RID map = navigation_server->map_create();
+		navigation_server->map_set_active(map, true);
+
+		// Two 4x4 grids sharing the edge at x = 4, and one far away that is never touched.
+		Ref<NavigationMesh> navigation_mesh = create_grid_navigation_mesh(4, 1.0);
+		RID region_a = navigation_server->region_create();
+		RID region_b = navigation_server->region_create();
+		RID region_far = navigation_server->region_create();
+		navigation_server->region_set_map(region_a, map);
+		navigation_server->region_set_map(region_b, map);
+		navigation_server->region_set_map(region_far, map);
+		navigation_server->region_set_navigation_mesh(region_a, navigation_mesh);
+		navigation_server->region_set_navigation_mesh(region_b, navigation_mesh);
+		navigation_server->region_set_navigation_mesh(region_far, navigation_mesh);
+		navigation_server->region_set_transform(region_b, Transform3D(Basis(), Vector3(4, 0, 0)));
+		navigation_server->region_set_transform(region_far, Transform3D(Basis(), Vector3(100, 0, 100)));
+		navigation_server->process(0.0); // Give server some cycles to commit.
+
+		// Per grid: 16 polygons, 40 edges of which 24 are merged inside the grid. 4 more are merged between A and B.
+		CHECK_EQ(navigation_server->get_process_info(NavigationServer3D::INFO_POLYGON_COUNT), 48);
+		CHECK_EQ(navigation_server->get_process_info(NavigationServer3D::INFO_EDGE_COUNT), 116);
+		CHECK_EQ(navigation_server->get_process_info(NavigationServer3D::INFO_EDGE_MERGE_COUNT), 76);
+		CHECK_EQ(navigation_server->get_process_info(NavigationServer3D::INFO_EDGE_FREE_COUNT), 40);
+		Vector<Vector3> path = navigation_server->map_get_path(map, Vector3(0.5, 0, 0.5), Vector3(7.5, 0, 3.5), true);
+		REQUIRE_FALSE(path.is_empty());
+		CHECK(path[path.size() - 1].is_equal_approx(Vector3(7.5, 0, 3.5)));
+
+		SUBCASE("Moving a region away should disconnect it, moving it back should connect it again") {
+			navigation_server->region_set_transform(region_b, Transform3D(Basis(), Vector3(4, 0, 10)));
+			navigation_server->process(0.0); // Give server some cycles to commit.
+			CHECK_EQ(navigation_server->get_process_info(NavigationServer3D::INFO_EDGE_MERGE_COUNT), 72);
+			path = navigation_server->map_get_path(map, Vector3(0.5, 0, 0.5), Vector3(7.5, 0, 13.5), true);
+			REQUIRE_FALSE(path.is_empty());
+			CHECK_FALSE(path[path.size() - 1].is_equal_approx(Vector3(7.5, 0, 13.5)));
+
+			navigation_server->region_set_transform(region_b, Transform3D(Basis(), Vector3(4, 0, 0)));
+			navigation_server->process(0.0); // Give server some cycles to commit.
+			CHECK_EQ(navigation_server->get_process_info(NavigationServer3D::INFO_EDGE_MERGE_COUNT), 76);
+			path = navigation_server->map_get_path(map, Vector3(0.5, 0, 0.5), Vector3(7.5, 0, 3.5), true);
+			REQUIRE_FALSE(path.is_empty());
+			CHECK(path[path.size() - 1].is_equal_approx(Vector3(7.5, 0, 3.5)));
+		}
+
+		SUBCASE("Disabling and freeing a region should disconnect it") {
+			navigation_server->region_set_enabled(region_b, false);
+			navigation_server->process(0.0); // Give server some cycles to commit.
+			CHECK_EQ(navigation_server->get_process_info(NavigationServer3D::INFO_POLYGON_COUNT), 32);
+			CHECK_EQ(navigation_server->get_process_info(NavigationServer3D::INFO_EDGE_MERGE_COUNT), 48);
+			path = navigation_server->map_get_path(map, Vector3(0.5, 0, 0.5), Vector3(7.5, 0, 3.5), true);
+			REQUIRE_FALSE(path.is_empty());
+			CHECK(path[path.size() - 1].x < 4.001);
+
+			navigation_server->region_set_enabled(region_b, true);
+			navigation_server->process(0.0); // Give server some cycles to commit.
+			CHECK_EQ(navigation_server->get_process_info(NavigationServer3D::INFO_EDGE_MERGE_COUNT), 76);
+
+			navigation_server->free(region_b);
+			navigation_server->process(0.0); // Give server some cycles to commit.
+			CHECK_EQ(navigation_server->get_process_info(NavigationServer3D::INFO_POLYGON_COUNT), 32);
+			CHECK_EQ(navigation_server->get_process_info(NavigationServer3D::INFO_EDGE_FREE_COUNT), 32);
+			path = navigation_server->map_get_path(map, Vector3(0.5, 0, 0.5), Vector3(7.5, 0, 3.5), true);
+			REQUIRE_FALSE(path.is_empty());
+			CHECK(path[path.size() - 1].x < 4.001);
+			region_b = RID();
+		}
+
+		if (region_b.is_valid()) {
+			navigation_server->free(region_b);
+		}
+		navigation_server->free(region_a);
+		navigation_server->free(region_far);
+		navigation_server->free(map);
+		navigation_server->process(0.0); // Give server some cycles to commit.
+	}
+
+	// Not run by default, since timings are only meaningful on an otherwise idle machine.
+	// Run with `--test --no-skip --test-case="*[Benchmark]*"`.
+	TEST_CASE("[NavigationServer3D][Benchmark] Map sync after streaming in one chunk" * doctest::skip()) {
+		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
+		RID map = navigation_server->map_create();
+		navigation_server->map_set_active(map, true);
+
+		const int chunks_per_side = 16;
+		Ref<NavigationMesh> navigation_mesh = create_grid_navigation_mesh(16, 1.0);
+		LocalVector<RID> regions;
+		for (int z = 0; z < chunks_per_side; z++) {
+			for (int x = 0; x < chunks_per_side; x++) {
+				RID region = navigation_server->region_create();
+				navigation_server->region_set_map(region, map);
+				navigation_server->region_set_navigation_mesh(region, navigation_mesh);
+				navigation_server->region_set_transform(region, Transform3D(Basis(), Vector3(x * 16, 0, z * 16)));
+				regions.push_back(region);
+			}
+		}
+
+		uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		navigation_server->map_force_update(map);
+		uint64_t full_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+		// Stream one chunk out and back in.
+		RID chunk = regions[regions.size() / 2];
+		navigation_server->region_set_enabled(chunk, false);
+		navigation_server->map_force_update(map);
+		navigation_server->region_set_enabled(chunk, true);
+
+		begin = OS::get_singleton()->get_ticks_usec();
+		navigation_server->map_force_update(map);
+		uint64_t chunk_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+		MESSAGE(vformat("%d chunks: full sync %d usec, sync after one chunk changed %d usec.", regions.size(), full_usec, chunk_usec));
+		CHECK_FALSE(navigation_server->map_get_path(map, Vector3(0.5, 0, 0.5), Vector3(chunks_per_side * 16 - 0.5, 0, chunks_per_side * 16 - 0.5), true).is_empty());
+
+		for (const RID &region : regions) {
+			navigation_server->free(region);
+		}
+		navigation_server->free(map);
+		navigation_server->process(0.0); // Give server some cycles to commit.
+	}
+
+	TEST_CASE("[NavigationServer3D] Path query batches should yield the same results as single queries") {
+		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
+		RID map = navigation_server->map_create();
+		RID region = navigation_server->region_create();
+		navigation_server->map_set_active(map, true);
+		navigation_server->region_set_map(region, map);
+		navigation_server->region_set_navigation_mesh(region, create_grid_navigation_mesh(16, 1.0));
+		navigation_server->process(0.0); // Give server some cycles to commit.
+
+		TypedArray<NavigationPathQueryParameters3D> parameters;
+		TypedArray<NavigationPathQueryResult3D> results;
+		for (int i = 0; i < 32; i++) {
+			Ref<NavigationPathQueryParameters3D> query_parameters = memnew(NavigationPathQueryParameters3D);
+			query_parameters->set_map(map);
+			query_parameters->set_start_position(Vector3(0.5 + (i % 16), 0, 0.5));
+			query_parameters->set_target_position(Vector3(15.5 - (i % 16), 0, 15.5 - (i / 16)));
+			parameters.push_back(query_parameters);
+			results.push_back(Ref<NavigationPathQueryResult3D>(memnew(NavigationPathQueryResult3D)));
+		}
+
+		SUBCASE("Results should be available after waiting for the batch") {
+			int64_t batch_id = navigation_server->query_path_batch(parameters, results);
+			CHECK_NE(batch_id, 0);
+			navigation_server->wait_for_query_path_batch(batch_id);
+
+			for (int i = 0; i < parameters.size(); i++) {
+				Ref<NavigationPathQueryResult3D> expected = memnew(NavigationPathQueryResult3D);
+				navigation_server->query_path(parameters[i], expected);
+				Ref<NavigationPathQueryResult3D> result = results[i];
+				CHECK_NE(result->get_path().size(), 0);
+				CHECK_EQ(result->get_path(), expected->get_path());
+				CHECK_EQ(result->get_path_rids(), expected->get_path_rids());
+			}
+		}
+
+		SUBCASE("Callback should be called with the batch ID once the batch is collected") {
+			CallableMock batch_callback_mock;
+			int64_t batch_id = navigation_server->query_path_batch(parameters, results, callable_mp(&batch_callback_mock, &CallableMock::function1));
+			navigation_server->process(0.0); // Pending batches are collected before the maps are updated.
+			CHECK_EQ(batch_callback_mock.function1_calls, 1);
+			CHECK_EQ(int64_t(batch_callback_mock.function1_latest_arg0), batch_id);
+		}
+
+		SUBCASE("Polling should collect the batch once") {
+			CallableMock batch_callback_mock;
+			int64_t batch_id = navigation_server->query_path_batch(parameters, results, callable_mp(&batch_callback_mock, &CallableMock::function1));
+			while (!navigation_server->is_query_path_batch_completed(batch_id)) {
+				OS::get_singleton()->delay_usec(100);
+			}
+			CHECK_EQ(batch_callback_mock.function1_calls, 1);
+			Ref<NavigationPathQueryResult3D> result = results[0];
+			CHECK_NE(result->get_path().size(), 0);
+
+			ERR_PRINT_OFF;
+			CHECK_FALSE(navigation_server->is_query_path_batch_completed(batch_id));
+			ERR_PRINT_ON;
+			CHECK_EQ(batch_callback_mock.function1_calls, 1);
+		}
+
+		SUBCASE("Unknown batch IDs should be rejected") {
+			ERR_PRINT_OFF;
+			CHECK_FALSE(navigation_server->is_query_path_batch_completed(0));
+			CHECK_FALSE(navigation_server->is_query_path_batch_completed(navigation_server->query_path_batch(parameters, results) + 1));
+			navigation_server->wait_for_query_path_batch(-1);
+			ERR_PRINT_ON;
+			navigation_server->process(0.0); // Collect the pending batch.
+		}
+
+		SUBCASE("Batches started from a callback during a flush should only start after the flush") {
+			PathQueryBatchChainer chainer;
+			for (int i = 0; i < parameters.size(); i++) {
+				chainer.parameters.push_back(parameters[i]);
+				chainer.results.push_back(Ref<NavigationPathQueryResult3D>(memnew(NavigationPathQueryResult3D)));
+			}
+			RID other_region = navigation_server->region_create();
+			navigation_server->region_set_map(other_region, map);
+			navigation_server->region_set_navigation_mesh(other_region, create_grid_navigation_mesh(4, 1.0));
+			navigation_server->process(0.0); // Give server some cycles to commit.
+
+			// The flush frees the region, and the chained batch must not start before it is.
+			navigation_server->query_path_batch(parameters, results, callable_mp(&chainer, &PathQueryBatchChainer::on_batch_collected));
+			navigation_server->free(other_region);
+			navigation_server->process(0.0);
+
+			CHECK_NE(chainer.chained_batch_id, 0);
+			navigation_server->wait_for_query_path_batch(chainer.chained_batch_id);
+			Ref<NavigationPathQueryResult3D> chained_result = chainer.results[0];
+			CHECK_NE(chained_result->get_path().size(), 0);
+		}
+
+		SUBCASE("Mismatched result count should be rejected") {
+			ERR_PRINT_OFF;
+			results.pop_back();
+			CHECK_EQ(navigation_server->query_path_batch(parameters, results), 0);
+			ERR_PRINT_ON;
+		}
+
+		navigation_server->free(region);
+		navigation_server->free(map);
+		navigation_server->process(0.0); // Give server some cycles to commit.
+	}
+
+	// Not run by default, since timings are only meaningful on an otherwise idle machine.
+	// Run with `--test --no-skip --test-case="*[Benchmark]*"`.
+	TEST_CASE("[NavigationServer3D][Benchmark] Path queries per second, single and batched" * doctest::skip()) {
+		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
+		RID map = navigation_server->map_create();
+		RID region = navigation_server->region_create();
+		navigation_server->map_set_active(map, true);
+		navigation_server->region_set_map(region, map);
+		navigation_server->region_set_navigation_mesh(region, create_grid_navigation_mesh(100, 1.0));
+		navigation_server->process(0.0); // Give server some cycles to commit.
+
+		const int query_count = 1000;
+		TypedArray<NavigationPathQueryParameters3D> parameters;
+		TypedArray<NavigationPathQueryResult3D> results;
+		for (int i = 0; i < query_count; i++) {
+			Ref<NavigationPathQueryParameters3D> query_parameters = memnew(NavigationPathQueryParameters3D);
+			query_parameters->set_map(map);
+			query_parameters->set_start_position(Vector3((i * 37) % 100 + 0.5, 0, (i * 13) % 100 + 0.5));
+			query_parameters->set_target_position(Vector3((i * 71) % 100 + 0.5, 0, (i * 59) % 100 + 0.5));
+			parameters.push_back(query_parameters);
+			results.push_back(Ref<NavigationPathQueryResult3D>(memnew(NavigationPathQueryResult3D)));
+		}
+
+		uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		for (int i = 0; i < query_count; i++) {
+			navigation_server->query_path(parameters[i], results[i]);
+		}
+		uint64_t single_usec = MAX(1u, OS::get_singleton()->get_ticks_usec() - begin);
+
+		begin = OS::get_singleton()->get_ticks_usec();
+		navigation_server->wait_for_query_path_batch(navigation_server->query_path_batch(parameters, results));
+		uint64_t batch_usec = MAX(1u, OS::get_singleton()->get_ticks_usec() - begin);
+
+		MESSAGE(vformat("Single queries: %d/s, batched queries: %d/s.", int64_t(query_count * 1000000.0 / single_usec), int64_t(query_count * 1000000.0 / batch_usec)));
+		CHECK_NE(Ref<NavigationPathQueryResult3D>(results[0])->get_path().size(), 0);
+
+		navigation_server->free(region);
+		navigation_server->free(map);
+		navigation_server->process(0.0); // Give server some cycles to commit.
+	}
+
+	TEST_CASE("[NavigationServer3D] Hierarchical path queries should find the same paths as full searches") {
+		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
+		RID map = navigation_server->map_create();
+		// Maps read the setting when created. With the default cell size of 0.25, 16 cells make clusters of 4x4 polygons.
+		ProjectSettings::get_singleton()->set_setting("navigation/pathfinding/hierarchical_cluster_size", 16);
+		RID hierarchical_map = navigation_server->map_create();
+		ProjectSettings::get_singleton()->set_setting("navigation/pathfinding/hierarchical_cluster_size", 0);
+
+		// A 16x16 grid, and a second one on layer 2 past a gap that only a link crosses.
+		Ref<NavigationMesh> navigation_mesh = create_grid_navigation_mesh(16, 1.0);
+		LocalVector<RID> rids;
+		for (const RID &m : { map, hierarchical_map }) {
+			navigation_server->map_set_active(m, true);
+
+			RID region = navigation_server->region_create();
+			navigation_server->region_set_map(region, m);
+			navigation_server->region_set_navigation_mesh(region, navigation_mesh);
+
+			RID far_region = navigation_server->region_create();
+			navigation_server->region_set_map(far_region, m);
+			navigation_server->region_set_navigation_mesh(far_region, navigation_mesh);
+			navigation_server->region_set_navigation_layers(far_region, 2);
+			navigation_server->region_set_transform(far_region, Transform3D(Basis(), Vector3(20, 0, 0)));
+
+			RID link = navigation_server->link_create();
+			navigation_server->link_set_map(link, m);
+			navigation_server->link_set_start_position(link, Vector3(15.5, 0, 8.5));
+			navigation_server->link_set_end_position(link, Vector3(20.5, 0, 8.5));
+
+			rids.push_back(region);
+			rids.push_back(far_region);
+			rids.push_back(link);
+		}
+		navigation_server->process(0.0); // Give server some cycles to commit.
+
+		SUBCASE("Paths across clusters should reach the same destination, at most slightly longer") {
+			for (int i = 0; i < 16; i++) {
+				const Vector3 from = Vector3(0.5 + (i * 7) % 16, 0, 0.5 + (i * 3) % 16);
+				const Vector3 to = Vector3(15.5 - (i * 5) % 16, 0, 15.5 - i);
+				const Vector<Vector3> path = navigation_server->map_get_path(map, from, to, true);
+				const Vector<Vector3> hierarchical_path = navigation_server->map_get_path(hierarchical_map, from, to, true);
+				REQUIRE_FALSE(hierarchical_path.is_empty());
+				CHECK(hierarchical_path[hierarchical_path.size() - 1].is_equal_approx(path[path.size() - 1]));
+				CHECK(get_path_length(hierarchical_path) <= get_path_length(path) * 1.1 + 0.01);
+			}
+		}
+
+		SUBCASE("Paths should follow links to other regions") {
+			const Vector<Vector3> path = navigation_server->map_get_path(hierarchical_map, Vector3(0.5, 0, 8.5), Vector3(35.5, 0, 8.5), true, 3);
+			REQUIRE_FALSE(path.is_empty());
+			CHECK(path[path.size() - 1].is_equal_approx(Vector3(35.5, 0, 8.5)));
+		}
+
+		SUBCASE("Paths should match full searches after regions are added, disabled and removed") {
+			// Only the clusters of the changed regions and their neighbors are rebuilt on these syncs.
+			LocalVector<RID> extra_regions;
+			for (const RID &m : { map, hierarchical_map }) {
+				RID extra_region = navigation_server->region_create();
+				navigation_server->region_set_map(extra_region, m);
+				navigation_server->region_set_navigation_mesh(extra_region, navigation_mesh);
+				navigation_server->region_set_transform(extra_region, Transform3D(Basis(), Vector3(0, 0, 16)));
+				extra_regions.push_back(extra_region);
+			}
+
+			const Vector3 from = Vector3(0.5, 0, 0.5);
+			const Vector3 to = Vector3(12.5, 0, 28.5);
+			for (int step = 0; step < 3; step++) {
+				navigation_server->process(0.0); // Give server some cycles to commit.
+
+				const Vector<Vector3> path = navigation_server->map_get_path(map, from, to, true);
+				const Vector<Vector3> hierarchical_path = navigation_server->map_get_path(hierarchical_map, from, to, true);
+				REQUIRE_FALSE(hierarchical_path.is_empty());
+				CHECK(hierarchical_path[hierarchical_path.size() - 1].is_equal_approx(path[path.size() - 1]));
+				CHECK(get_path_length(hierarchical_path) <= get_path_length(path) * 1.1 + 0.01);
+
+				for (const RID &extra_region : extra_regions) {
+					if (step == 0) {
+						navigation_server->region_set_enabled(extra_region, false);
+					} else if (step == 1) {
+						navigation_server->free(extra_region);
+					}
+				}
+			}
+		}
+
+		SUBCASE("Paths should prefer regions with lower travel costs and avoid enter costs like full searches") {
+			LocalVector<RID> extra_regions;
+			for (const RID &m : { map, hierarchical_map }) {
+				// Cheap to travel, so the distance alone overestimates the remaining cost there.
+				RID cheap_region = navigation_server->region_create();
+				navigation_server->region_set_travel_cost(cheap_region, 0.1);
+				navigation_server->region_set_map(cheap_region, m);
+				navigation_server->region_set_navigation_mesh(cheap_region, navigation_mesh);
+				navigation_server->region_set_transform(cheap_region, Transform3D(Basis(), Vector3(0, 0, 16)));
+				extra_regions.push_back(cheap_region);
+
+				// Expensive to enter while free to leave, so the costs to and from its polygons differ.
+				RID expensive_region = navigation_server->region_create();
+				navigation_server->region_set_enter_cost(expensive_region, 1000.0);
+				navigation_server->region_set_map(expensive_region, m);
+				navigation_server->region_set_navigation_mesh(expensive_region, navigation_mesh);
+				navigation_server->region_set_transform(expensive_region, Transform3D(Basis(), Vector3(0, 0, -16)));
+				extra_regions.push_back(expensive_region);
+			}
+			navigation_server->process(0.0); // Give server some cycles to commit.
+
+			const Vector<Vector3> cheap_path = navigation_server->map_get_path(hierarchical_map, Vector3(0.5, 0, 15.5), Vector3(15.5, 0, 15.5), true);
+			REQUIRE_FALSE(cheap_path.is_empty());
+			real_t max_z = 0.0;
+			for (const Vector3 &point : cheap_path) {
+				max_z = MAX(max_z, point.z);
+			}
+			CHECK(max_z > 16.0);
+
+			for (const Vector3 &direction : { Vector3(1, 0, 1), Vector3(-1, 0, -1) }) {
+				const Vector3 from = Vector3(8, 0, 0) - direction * Vector3(7.5, 0, 0.5);
+				const Vector3 to = Vector3(8, 0, 0) + direction * Vector3(7.5, 0, 0.5);
+				const Vector<Vector3> path = navigation_server->map_get_path(map, from, to, true);
+				const Vector<Vector3> hierarchical_path = navigation_server->map_get_path(hierarchical_map, from, to, true);
+				REQUIRE_FALSE(hierarchical_path.is_empty());
+				CHECK(hierarchical_path[hierarchical_path.size() - 1].is_equal_approx(path[path.size() - 1]));
+				CHECK(get_path_length(hierarchical_path) <= get_path_length(path) * 1.1 + 0.01);
+			}
+
+			for (const RID &extra_region : extra_regions) {
+				navigation_server->free(extra_region);
+			}
+		}
+
+		SUBCASE("Paths should not follow one-way links backwards") {
+			navigation_server->link_set_bidirectional(rids[2], false);
+			navigation_server->link_set_bidirectional(rids[5], false);
+			navigation_server->process(0.0); // Give server some cycles to commit.
+
+			const Vector<Vector3> path = navigation_server->map_get_path(map, Vector3(35.5, 0, 8.5), Vector3(0.5, 0, 8.5), true, 3);
+			const Vector<Vector3> hierarchical_path = navigation_server->map_get_path(hierarchical_map, Vector3(35.5, 0, 8.5), Vector3(0.5, 0, 8.5), true, 3);
+			REQUIRE_FALSE(hierarchical_path.is_empty());
+			CHECK(hierarchical_path[hierarchical_path.size() - 1].is_equal_approx(path[path.size() - 1]));
+			CHECK(hierarchical_path[hierarchical_path.size() - 1].x >= 20.0);
+
+			const Vector<Vector3> forward_path = navigation_server->map_get_path(hierarchical_map, Vector3(0.5, 0, 8.5), Vector3(35.5, 0, 8.5), true, 3);
+			REQUIRE_FALSE(forward_path.is_empty());
+			CHECK(forward_path[forward_path.size() - 1].is_equal_approx(Vector3(35.5, 0, 8.5)));
+		}
+
+		SUBCASE("Paths should fall back to a full search when the cluster graph leads through excluded layers") {
+			const Vector<Vector3> path = navigation_server->map_get_path(map, Vector3(0.5, 0, 8.5), Vector3(35.5, 0, 8.5), true, 1);
+			const Vector<Vector3> hierarchical_path = navigation_server->map_get_path(hierarchical_map, Vector3(0.5, 0, 8.5), Vector3(35.5, 0, 8.5), true, 1);
+			REQUIRE_FALSE(hierarchical_path.is_empty());
+			CHECK(hierarchical_path[hierarchical_path.size() - 1].is_equal_approx(path[path.size() - 1]));
+		}
+
+		for (const RID &rid : rids) {
+			navigation_server->free(rid);
+		}
+		navigation_server->free(hierarchical_map);
+		navigation_server->free(map);
+		navigation_server->process(0.0); // Give server some cycles to commit.
+	}
+
+	// Not run by default, since timings are only meaningful on an otherwise idle machine.
+	// Run with `--test --no-skip --test-case="*[Benchmark]*"`.
+	TEST_CASE("[NavigationServer3D][Benchmark] Long path queries with and without hierarchy" * doctest::skip()) {
+		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
+		RID map = navigation_server->map_create();
+		ProjectSettings::get_singleton()->set_setting("navigation/pathfinding/hierarchical_cluster_size", 64);
+		RID hierarchical_map = navigation_server->map_create();
+		ProjectSettings::get_singleton()->set_setting("navigation/pathfinding/hierarchical_cluster_size", 0);
+
+		Ref<NavigationMesh> navigation_mesh = create_grid_navigation_mesh(200, 1.0);
+		RID region = navigation_server->region_create();
+		RID hierarchical_region = navigation_server->region_create();
+		navigation_server->map_set_active(map, true);
+		navigation_server->map_set_active(hierarchical_map, true);
+		navigation_server->region_set_map(region, map);
+		navigation_server->region_set_map(hierarchical_region, hierarchical_map);
+		navigation_server->region_set_navigation_mesh(region, navigation_mesh);
+		navigation_server->region_set_navigation_mesh(hierarchical_region, navigation_mesh);
+
+		uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		navigation_server->map_force_update(map);
+		uint64_t sync_usec = OS::get_singleton()->get_ticks_usec() - begin;
+		begin = OS::get_singleton()->get_ticks_usec();
+		navigation_server->map_force_update(hierarchical_map);
+		uint64_t hierarchical_sync_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+		const int query_count = 20;
+		begin = OS::get_singleton()->get_ticks_usec();
+		for (int i = 0; i < query_count; i++) {
+			navigation_server->map_get_path(map, Vector3(0.5, 0, i * 10 + 0.5), Vector3(199.5, 0, 199.5 - i * 10), true);
+		}
+		uint64_t query_usec = OS::get_singleton()->get_ticks_usec() - begin;
+		begin = OS::get_singleton()->get_ticks_usec();
+		for (int i = 0; i < query_count; i++) {
+			navigation_server->map_get_path(hierarchical_map, Vector3(0.5, 0, i * 10 + 0.5), Vector3(199.5, 0, 199.5 - i * 10), true);
+		}
+		uint64_t hierarchical_query_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+		MESSAGE(vformat("Sync: %d usec, with hierarchy %d usec. %d queries: %d usec, with hierarchy %d usec.", sync_usec, hierarchical_sync_usec, query_count, query_usec, hierarchical_query_usec));
+		CHECK_FALSE(navigation_server->map_get_path(hierarchical_map, Vector3(0.5, 0, 0.5), Vector3(199.5, 0, 199.5), true).is_empty());
+
+		navigation_server->free(region);
+		navigation_server->free(hierarchical_region);
+		navigation_server->free(hierarchical_map);
+		navigation_server->free(map);
+		navigation_server->process(0.0); // Give server some cycles to commit.
+	}
+
 	// FIXME: The race condition mentioned below is actually a problem and fails on CI (GH-90613).
 	/*
 	TEST_CASE("[NavigationServer3D] Server should be able to bake asynchronously") {
@@ -0,0 +1,141 @@
+/**************************************************************************/
+/*  test_physics_server_2d.h                                              */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_PHYSICS_SERVER_2D_H
+#define TEST_PHYSICS_SERVER_2D_H
+
+#include "servers/physics_server_2d.h"
+
+#include "tests/test_macros.h"
+
+namespace TestPhysicsServer2D {
+
+static RID create_space(PhysicsServer2D *p_server) {
+	RID space = p_server->space_create();
+	p_server->space_set_active(space, true);
+	p_server->area_set_param(space, PhysicsServer2D::AREA_PARAM_GRAVITY, 980.0);
+	p_server->area_set_param(space, PhysicsServer2D::AREA_PARAM_GRAVITY_VECTOR, Vector2(0, 1));
+	return space;
+}
+
+static RID create_body(PhysicsServer2D *p_server, RID p_space, RID p_shape, PhysicsServer2D::BodyMode p_mode, const Vector2 &p_position) {
+	RID body = p_server->body_create();
+	p_server->body_set_mode(body, p_mode);
+	p_server->body_add_shape(body, p_shape);
+	p_server->body_set_space(body, p_space);
+	p_server->body_set_state(body, PhysicsServer2D::BODY_STATE_TRANSFORM, Transform2D(0, p_position));
+	return body;
+}
+
+TEST_CASE("[SceneTree][PhysicsServer2D] Falling bodies come to rest on the floor and sleep") {
+	PhysicsServer2D *server = PhysicsServer2D::get_singleton();
+	RID space = create_space(server);
+
+	RID floor_shape = server->rectangle_shape_create();
+	server->shape_set_data(floor_shape, Vector2(1000, 10));
+	RID floor = create_body(server, space, floor_shape, PhysicsServer2D::BODY_MODE_STATIC, Vector2(0, 100));
+
+	const real_t radius = 4;
+	RID circle_shape = server->circle_shape_create();
+	server->shape_set_data(circle_shape, radius);
+
+	// Well apart from each other, so every body ends up in its own island.
+	LocalVector<RID> bodies;
+	for (int i = 0; i < 64; i++) {
+		bodies.push_back(create_body(server, space, circle_shape, PhysicsServer2D::BODY_MODE_RIGID, Vector2(-640 + i * 20, 0)));
+	}
+
+	for (int frame = 0; frame < 600; frame++) {
+		server->step(1.0 / 60.0);
+	}
+
+	bool all_on_floor = true;
+	bool all_sleeping = true;
+	for (const RID &body : bodies) {
+		Transform2D xform = server->body_get_state(body, PhysicsServer2D::BODY_STATE_TRANSFORM);
+		all_on_floor &= xform.get_origin().y > 80 && xform.get_origin().y < 90;
+		all_sleeping &= bool(server->body_get_state(body, PhysicsServer2D::BODY_STATE_SLEEPING));
+	}
+	CHECK_MESSAGE(all_on_floor, "All bodies should be resting on the floor.");
+	CHECK_MESSAGE(all_sleeping, "All bodies should have gone to sleep.");
+
+	for (const RID &body : bodies) {
+		server->free(body);
+	}
+	server->free(floor);
+	server->free(circle_shape);
+	server->free(floor_shape);
+	server->free(space);
+}
+
+// Not run by default, since timings are only meaningful on an otherwise idle machine.
+// Run with `--test --no-skip --test-case="*[Benchmark]*"`.
+TEST_CASE("[SceneTree][PhysicsServer2D][Benchmark] Step a pile of bodies" * doctest::skip()) {
+	PhysicsServer2D *server = PhysicsServer2D::get_singleton();
+	RID space = create_space(server);
+
+	RID floor_shape = server->rectangle_shape_create();
+	server->shape_set_data(floor_shape, Vector2(1000, 10));
+	RID floor = create_body(server, space, floor_shape, PhysicsServer2D::BODY_MODE_STATIC, Vector2(0, 600));
+
+	RID box_shape = server->rectangle_shape_create();
+	server->shape_set_data(box_shape, Vector2(4, 4));
+
+	LocalVector<RID> bodies;
+	for (int y = 0; y < 60; y++) {
+		for (int x = 0; x < 100; x++) {
+			bodies.push_back(create_body(server, space, box_shape, PhysicsServer2D::BODY_MODE_RIGID, Vector2(-500 + x * 10, y * 10)));
+		}
+	}
+
+	const int frames = 300;
+	uint64_t body_steps = 0;
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	for (int frame = 0; frame < frames; frame++) {
+		server->step(1.0 / 60.0);
+		body_steps += server->get_process_info(PhysicsServer2D::INFO_ACTIVE_OBJECTS);
+	}
+	uint64_t elapsed = MAX(1u, OS::get_singleton()->get_ticks_usec() - begin);
+
+	MESSAGE(vformat("%d bodies, %d frames: %.1f bodies/ms.", bodies.size(), frames, double(body_steps) * 1000.0 / double(elapsed)));
+	CHECK(body_steps > 0);
+
+	for (const RID &body : bodies) {
+		server->free(body);
+	}
+	server->free(floor);
+	server->free(box_shape);
+	server->free(floor_shape);
+	server->free(space);
+}
+
+} // namespace TestPhysicsServer2D
+
+#endif // TEST_PHYSICS_SERVER_2D_H
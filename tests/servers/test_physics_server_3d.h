@@ -0,0 +1,376 @@
+/**************************************************************************/
+/*  test_physics_server_3d.h                                              */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_PHYSICS_SERVER_3D_H
+#define TEST_PHYSICS_SERVER_3D_H
+
+#include "core/config/project_settings.h"
+#include "core/math/random_pcg.h"
+#include "servers/physics_3d/godot_body_pair_3d.h"
+#include "servers/physics_3d/godot_collision_solver_3d.h"
+#include "servers/physics_server_3d.h"
+
+#include "tests/test_macros.h"
+
+class TestGodotBodyContact3DAccessor {
+public:
+	typedef GodotBodyContact3D::Contact Contact;
+
+	static int find_recycled_contact(const Contact *p_contacts, int p_contact_count, const Contact &p_contact, real_t p_recycle_radius, bool p_closest_unused) {
+		return GodotBodyContact3D::find_recycled_contact(p_contacts, p_contact_count, p_contact, p_recycle_radius, p_closest_unused);
+	}
+};
+
+namespace TestPhysicsServer3D {
+
+static RID create_space(PhysicsServer3D *p_server) {
+	RID space = p_server->space_create();
+	p_server->space_set_active(space, true);
+	p_server->area_set_param(space, PhysicsServer3D::AREA_PARAM_GRAVITY, 9.8);
+	p_server->area_set_param(space, PhysicsServer3D::AREA_PARAM_GRAVITY_VECTOR, Vector3(0, -1, 0));
+	return space;
+}
+
+static RID create_body(PhysicsServer3D *p_server, RID p_space, RID p_shape, PhysicsServer3D::BodyMode p_mode, const Vector3 &p_position) {
+	RID body = p_server->body_create();
+	p_server->body_set_mode(body, p_mode);
+	p_server->body_add_shape(body, p_shape);
+	p_server->body_set_space(body, p_space);
+	p_server->body_set_state(body, PhysicsServer3D::BODY_STATE_TRANSFORM, Transform3D(Basis(), p_position));
+	return body;
+}
+
+static LocalVector<RID> create_primitive_shapes(PhysicsServer3D *p_server) {
+	LocalVector<RID> shapes;
+
+	RID sphere = p_server->sphere_shape_create();
+	p_server->shape_set_data(sphere, 0.5);
+	shapes.push_back(sphere);
+
+	RID box = p_server->box_shape_create();
+	p_server->shape_set_data(box, Vector3(0.5, 0.5, 0.5));
+	shapes.push_back(box);
+
+	RID capsule = p_server->capsule_shape_create();
+	Dictionary capsule_data;
+	capsule_data["radius"] = 0.5;
+	capsule_data["height"] = 1.0;
+	p_server->shape_set_data(capsule, capsule_data);
+	shapes.push_back(capsule);
+
+	return shapes;
+}
+
+TEST_CASE("[SceneTree][PhysicsServer3D] Primitive bodies come to rest on the floor") {
+	PhysicsServer3D *server = PhysicsServer3D::get_singleton();
+	RID space = create_space(server);
+
+	RID floor_shape = server->box_shape_create();
+	server->shape_set_data(floor_shape, Vector3(100, 1, 100));
+	RID floor = create_body(server, space, floor_shape, PhysicsServer3D::BODY_MODE_STATIC, Vector3(0, -1, 0));
+
+	// Spread out, so most pairs found by the broadphase are separated at first, then touching once fallen.
+	LocalVector<RID> shapes = create_primitive_shapes(server);
+	LocalVector<RID> bodies;
+	for (int i = 0; i < 48; i++) {
+		bodies.push_back(create_body(server, space, shapes[i % shapes.size()], PhysicsServer3D::BODY_MODE_RIGID, Vector3((i % 8) * 1.5 - 6, 1 + (i / 8) * 0.25, (i / 8) * 1.5 - 4)));
+	}
+
+	for (int frame = 0; frame < 600; frame++) {
+		server->step(1.0 / 60.0);
+	}
+
+	bool all_on_floor = true;
+	for (const RID &body : bodies) {
+		Transform3D xform = server->body_get_state(body, PhysicsServer3D::BODY_STATE_TRANSFORM);
+		all_on_floor &= xform.origin.y > 0.0 && xform.origin.y < 1.0;
+	}
+	CHECK_MESSAGE(all_on_floor, "All bodies should be resting on the floor, neither falling through nor floating.");
+
+	for (const RID &body : bodies) {
+		server->free(body);
+	}
+	for (const RID &shape : shapes) {
+		server->free(shape);
+	}
+	server->free(floor);
+	server->free(floor_shape);
+	server->free(space);
+}
+
+static void ignore_contact(const Vector3 &p_point_A, int p_index_A, const Vector3 &p_point_B, int p_index_B, const Vector3 &p_normal, void *p_userdata) {}
+
+TEST_CASE("[PhysicsServer3D] Batched narrowphase tests only reject pairs the full narrowphase finds separated") {
+	GodotSphereShape3D sphere;
+	sphere.set_data(0.5);
+	GodotBoxShape3D box;
+	box.set_data(Vector3(0.5, 0.25, 1.0));
+	GodotCapsuleShape3D capsule;
+	Dictionary capsule_data;
+	capsule_data["radius"] = 0.25;
+	capsule_data["height"] = 2.0;
+	capsule.set_data(capsule_data);
+	GodotCylinderShape3D cylinder;
+	Dictionary cylinder_data;
+	cylinder_data["radius"] = 0.5;
+	cylinder_data["height"] = 1.0;
+	cylinder.set_data(cylinder_data);
+	const GodotShape3D *shapes[] = { &sphere, &box, &capsule, &cylinder };
+
+	// Enough pairs of each kind to fill the vectorized passes and the scalar remainder.
+	RandomPCG rng(4242);
+	int rejected_count = 0;
+	for (int round = 0; round < 20; round++) {
+		GodotCollisionSolver3D::SegmentPairBatch segment_pairs;
+		GodotCollisionSolver3D::SphereBoxPairBatch sphere_box_pairs;
+		const GodotShape3D *pair_shapes[2][GodotCollisionSolver3D::NARROWPHASE_BATCH_SIZE];
+		Transform3D pair_transforms[2][GodotCollisionSolver3D::NARROWPHASE_BATCH_SIZE];
+		const GodotShape3D *sphere_box_shapes[2][GodotCollisionSolver3D::NARROWPHASE_BATCH_SIZE];
+		Transform3D sphere_box_transforms[2][GodotCollisionSolver3D::NARROWPHASE_BATCH_SIZE];
+
+		while (segment_pairs.count < 23 || sphere_box_pairs.count < 13) {
+			const GodotShape3D *shape_A = shapes[rng.rand(4)];
+			const GodotShape3D *shape_B = shapes[rng.rand(4)];
+			Transform3D xform_A(Basis::from_euler(Vector3(rng.randf(), rng.randf(), rng.randf()) * Math_TAU), Vector3());
+			Transform3D xform_B(Basis::from_euler(Vector3(rng.randf(), rng.randf(), rng.randf()) * Math_TAU), Vector3(rng.randf() - 0.5, rng.randf() - 0.5, rng.randf() - 0.5) * 4.0);
+			GodotCollisionSolver3D::BatchShape batch_A;
+			GodotCollisionSolver3D::BatchShape batch_B;
+			REQUIRE(GodotCollisionSolver3D::get_batch_shape(shape_A, xform_A, batch_A));
+			REQUIRE(GodotCollisionSolver3D::get_batch_shape(shape_B, xform_B, batch_B));
+
+			if (shape_A == &sphere && shape_B == &box) {
+				if (sphere_box_pairs.count < GodotCollisionSolver3D::NARROWPHASE_BATCH_SIZE) {
+					sphere_box_shapes[0][sphere_box_pairs.count] = shape_A;
+					sphere_box_shapes[1][sphere_box_pairs.count] = shape_B;
+					sphere_box_transforms[0][sphere_box_pairs.count] = xform_A;
+					sphere_box_transforms[1][sphere_box_pairs.count] = xform_B;
+					sphere_box_pairs.add(batch_A, batch_B);
+				}
+			} else if (segment_pairs.count < GodotCollisionSolver3D::NARROWPHASE_BATCH_SIZE) {
+				pair_shapes[0][segment_pairs.count] = shape_A;
+				pair_shapes[1][segment_pairs.count] = shape_B;
+				pair_transforms[0][segment_pairs.count] = xform_A;
+				pair_transforms[1][segment_pairs.count] = xform_B;
+				segment_pairs.add(batch_A, batch_B);
+			}
+		}
+
+		bool separated[GodotCollisionSolver3D::NARROWPHASE_BATCH_SIZE];
+		GodotCollisionSolver3D::cull_separated_segment_pairs(segment_pairs, separated);
+		for (uint32_t i = 0; i < segment_pairs.count; i++) {
+			if (separated[i]) {
+				rejected_count++;
+				CHECK_FALSE(GodotCollisionSolver3D::solve_static(pair_shapes[0][i], pair_transforms[0][i], pair_shapes[1][i], pair_transforms[1][i], ignore_contact, nullptr));
+			}
+		}
+
+		GodotCollisionSolver3D::cull_separated_sphere_box_pairs(sphere_box_pairs, separated);
+		for (uint32_t i = 0; i < sphere_box_pairs.count; i++) {
+			if (separated[i]) {
+				rejected_count++;
+				CHECK_FALSE(GodotCollisionSolver3D::solve_static(sphere_box_shapes[0][i], sphere_box_transforms[0][i], sphere_box_shapes[1][i], sphere_box_transforms[1][i], ignore_contact, nullptr));
+			}
+		}
+	}
+	CHECK(rejected_count > 0);
+
+	SUBCASE("Parallel capsules with overlapping bounding spheres should be rejected") {
+		GodotCollisionSolver3D::BatchShape batch_A;
+		GodotCollisionSolver3D::BatchShape batch_B;
+		GodotCollisionSolver3D::get_batch_shape(&capsule, Transform3D(), batch_A);
+		GodotCollisionSolver3D::get_batch_shape(&capsule, Transform3D(Basis(), Vector3(0.6, 0.5, 0)), batch_B);
+		GodotCollisionSolver3D::SegmentPairBatch segment_pairs;
+		for (int i = 0; i < 5; i++) {
+			segment_pairs.add(batch_A, batch_B);
+		}
+
+		bool separated[GodotCollisionSolver3D::NARROWPHASE_BATCH_SIZE];
+		GodotCollisionSolver3D::cull_separated_segment_pairs(segment_pairs, separated);
+		for (int i = 0; i < 5; i++) {
+			CHECK(separated[i]);
+		}
+	}
+
+	SUBCASE("Spheres past the corner of a box, inside its bounding sphere, should be rejected") {
+		GodotCollisionSolver3D::BatchShape batch_sphere;
+		GodotCollisionSolver3D::BatchShape batch_box;
+		GodotCollisionSolver3D::get_batch_shape(&sphere, Transform3D(Basis(), Vector3(0.8, 0.55, 1.3)), batch_sphere);
+		GodotCollisionSolver3D::get_batch_shape(&box, Transform3D(), batch_box);
+		REQUIRE(batch_box.is_box);
+		GodotCollisionSolver3D::SphereBoxPairBatch sphere_box_pairs;
+		for (int i = 0; i < 5; i++) {
+			sphere_box_pairs.add(batch_sphere, batch_box);
+		}
+
+		bool separated[GodotCollisionSolver3D::NARROWPHASE_BATCH_SIZE];
+		GodotCollisionSolver3D::cull_separated_sphere_box_pairs(sphere_box_pairs, separated);
+		for (int i = 0; i < 5; i++) {
+			CHECK(separated[i]);
+		}
+
+		// The separating axis goes from the sphere to the corner of the box.
+		CHECK(GodotCollisionSolver3D::get_batch_separation_axis(batch_sphere, batch_box).is_equal_approx(Vector3(-1, -1, -1).normalized()));
+		CHECK(GodotCollisionSolver3D::get_batch_separation_axis(batch_box, batch_sphere).is_equal_approx(Vector3(1, 1, 1).normalized()));
+	}
+
+	SUBCASE("Skewed shapes should be bounded beyond their longest basis column") {
+		// Both columns have a length of about 1, but their diagonal is stretched to about 1.41.
+		const Basis skewed(Vector3(1, 0, 0), Vector3(0.99, 0.141, 0), Vector3(0, 0, 1));
+		GodotCollisionSolver3D::BatchShape batch_A;
+		GodotCollisionSolver3D::BatchShape batch_B;
+		GodotCollisionSolver3D::get_batch_shape(&sphere, Transform3D(skewed, Vector3()), batch_A);
+		GodotCollisionSolver3D::get_batch_shape(&sphere, Transform3D(Basis(), Vector3(1.1, 0.1, 0)), batch_B);
+		CHECK(batch_A.radius >= skewed.xform(Vector3(0.5, 0.5, 0) / Math_SQRT2).length());
+
+		GodotCollisionSolver3D::SegmentPairBatch segment_pairs;
+		for (int i = 0; i < 5; i++) {
+			segment_pairs.add(batch_A, batch_B);
+		}
+
+		bool separated[GodotCollisionSolver3D::NARROWPHASE_BATCH_SIZE];
+		GodotCollisionSolver3D::cull_separated_segment_pairs(segment_pairs, separated);
+		for (int i = 0; i < 5; i++) {
+			CHECK_FALSE(separated[i]);
+		}
+	}
+}
+
+TEST_CASE("[PhysicsServer3D] Contacts are recycled by position unless manifolds are reused") {
+	typedef TestGodotBodyContact3DAccessor::Contact Contact;
+
+	Contact cached[3];
+	cached[0].local_A = Vector3(0.0, 0.0, 0.009);
+	cached[0].local_B = cached[0].local_A;
+	cached[0].index_A = 1;
+	cached[0].used = true;
+	cached[1].local_A = Vector3(0.0, 0.0, 0.002);
+	cached[1].local_B = cached[1].local_A;
+	cached[2].local_A = Vector3(1.0, 0.0, 0.0);
+	cached[2].local_B = cached[2].local_A;
+
+	Contact contact;
+	contact.local_A = Vector3();
+	contact.local_B = Vector3();
+	const real_t recycle_radius = 0.01;
+
+	SUBCASE("Default matching takes the first contact in range, whatever its features and state") {
+		CHECK(TestGodotBodyContact3DAccessor::find_recycled_contact(cached, 3, contact, recycle_radius, false) == 0);
+		CHECK(TestGodotBodyContact3DAccessor::find_recycled_contact(cached + 1, 2, contact, recycle_radius, false) == 0);
+		CHECK(TestGodotBodyContact3DAccessor::find_recycled_contact(cached + 2, 1, contact, recycle_radius, false) == -1);
+	}
+
+	SUBCASE("Reused manifolds take the closest unused contact on the same features") {
+		CHECK(TestGodotBodyContact3DAccessor::find_recycled_contact(cached, 3, contact, recycle_radius, true) == 1);
+		cached[1].used = true;
+		CHECK(TestGodotBodyContact3DAccessor::find_recycled_contact(cached, 3, contact, recycle_radius, true) == -1);
+		cached[0].used = false;
+		CHECK(TestGodotBodyContact3DAccessor::find_recycled_contact(cached, 3, contact, recycle_radius, true) == -1);
+		contact.index_A = 1;
+		CHECK(TestGodotBodyContact3DAccessor::find_recycled_contact(cached, 3, contact, recycle_radius, true) == 0);
+	}
+}
+
+TEST_CASE("[SceneTree][PhysicsServer3D] Stacked boxes stay stacked when reusing contact manifolds") {
+	ProjectSettings::get_singleton()->set_setting("physics/3d/solver/contact_manifold_reuse_threshold", 0.001);
+	PhysicsServer3D *server = PhysicsServer3D::get_singleton();
+	RID space = create_space(server);
+	ProjectSettings::get_singleton()->set_setting("physics/3d/solver/contact_manifold_reuse_threshold", 0.0);
+
+	RID floor_shape = server->box_shape_create();
+	server->shape_set_data(floor_shape, Vector3(100, 1, 100));
+	RID floor = create_body(server, space, floor_shape, PhysicsServer3D::BODY_MODE_STATIC, Vector3(0, -1, 0));
+
+	RID box = server->box_shape_create();
+	server->shape_set_data(box, Vector3(0.5, 0.5, 0.5));
+	LocalVector<RID> bodies;
+	for (int i = 0; i < 5; i++) {
+		bodies.push_back(create_body(server, space, box, PhysicsServer3D::BODY_MODE_RIGID, Vector3(0, 0.5 + i, 0)));
+	}
+
+	for (int frame = 0; frame < 600; frame++) {
+		server->step(1.0 / 60.0);
+	}
+
+	for (uint32_t i = 0; i < bodies.size(); i++) {
+		Transform3D xform = server->body_get_state(bodies[i], PhysicsServer3D::BODY_STATE_TRANSFORM);
+		CHECK_MESSAGE(xform.origin.distance_to(Vector3(0, 0.5 + i, 0)) < 0.05, vformat("Box %d should still be in its place in the stack.", i));
+	}
+
+	for (const RID &body : bodies) {
+		server->free(body);
+	}
+	server->free(box);
+	server->free(floor);
+	server->free(floor_shape);
+	server->free(space);
+}
+
+// Not run by default, since timings are only meaningful on an otherwise idle machine.
+// Run with `--test --no-skip --test-case="*[Benchmark]*"`.
+TEST_CASE("[SceneTree][PhysicsServer3D][Benchmark] Step a crowd of primitive bodies" * doctest::skip()) {
+	PhysicsServer3D *server = PhysicsServer3D::get_singleton();
+	RID space = create_space(server);
+
+	RID floor_shape = server->box_shape_create();
+	server->shape_set_data(floor_shape, Vector3(200, 1, 200));
+	RID floor = create_body(server, space, floor_shape, PhysicsServer3D::BODY_MODE_STATIC, Vector3(0, -1, 0));
+
+	LocalVector<RID> shapes = create_primitive_shapes(server);
+	LocalVector<RID> bodies;
+	for (int z = 0; z < 50; z++) {
+		for (int x = 0; x < 60; x++) {
+			bodies.push_back(create_body(server, space, shapes[(x + z) % shapes.size()], PhysicsServer3D::BODY_MODE_RIGID, Vector3(x * 1.1 - 33, 0.6 + (x % 3), z * 1.1 - 27.5)));
+		}
+	}
+
+	const int frames = 300;
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	for (int frame = 0; frame < frames; frame++) {
+		server->step(1.0 / 60.0);
+	}
+	uint64_t elapsed = MAX(1u, OS::get_singleton()->get_ticks_usec() - begin);
+
+	MESSAGE(vformat("%d bodies, %d frames: %.3f ms/frame.", bodies.size(), frames, double(elapsed) / 1000.0 / frames));
+	CHECK(elapsed > 0);
+
+	for (const RID &body : bodies) {
+		server->free(body);
+	}
+	for (const RID &shape : shapes) {
+		server->free(shape);
+	}
+	server->free(floor);
+	server->free(floor_shape);
+	server->free(space);
+}
+
+} // namespace TestPhysicsServer3D
+
+#endif // TEST_PHYSICS_SERVER_3D_H